@@ -0,0 +1,515 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <semaphore>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include "sff/formats.hpp"
+#include "sff/utilities/asyncReader.hpp"
+#include "sff/utilities/reader.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/traceGroup.hpp"
+#include "sff/segy/trace.hpp"
+#ifdef USE_MSEED
+ #include "sff/miniseed/traceGroup.hpp"
+ #include "sff/miniseed/sncl.hpp"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+void printUsage()
+{
+    std::cout
+        << "Usage: sff-convert INPUT [INPUT ...] OUTPUT [options]\n\n"
+        << "Converts SAC, miniSEED, Silixa SEGY, and SEG-Y files to SAC.  Each\n"
+        << "INPUT is a file or a directory that is searched recursively.\n"
+        << "OUTPUT is a directory; the input directory structure is preserved.\n"
+        << "Files are read asynchronously and unpacked, transformed, and\n"
+        << "written by a pool of worker threads.\n\n"
+        << "Options:\n"
+        << "  --threads N         Number of worker threads; 0 uses all cores [0]\n"
+        << "  --queue-depth N     Maximum number of outstanding reads [64]\n"
+        << "  --byte-order ORDER  Output byte order: native, little, or big [native]\n"
+        << "  --start EPOCH       Discard samples before this UTC epoch time\n"
+        << "  --end EPOCH         Discard samples after this UTC epoch time\n"
+        << "  --channels A:B      Keep only traces A through B (0-based,\n"
+        << "                      inclusive) of each multi-trace file\n"
+        << "  --help              Print this message\n\n"
+        << "Inputs whose outputs would have the same name, e.g., files with\n"
+        << "the same stem from different directories, are not converted.\n";
+}
+
+struct Options
+{
+    std::vector<std::string> inputs;
+    fs::path output;
+    double startTime = std::numeric_limits<double>::lowest();
+    double endTime = std::numeric_limits<double>::max();
+    int firstChannel = 0;
+    int lastChannel = std::numeric_limits<int>::max();
+    int nThreads = 0;
+    int queueDepth = 64;
+    bool swap = false;
+};
+
+struct Job
+{
+    fs::path input;
+    fs::path relativePath;
+    SFF::Format format;
+};
+
+struct Statistics
+{
+    std::atomic<int64_t> nFiles{0};
+    std::atomic<int64_t> nFailed{0};
+    std::atomic<int64_t> nSkipped{0};
+    std::atomic<int64_t> nTraces{0};
+    std::atomic<int64_t> nSamples{0};
+    std::atomic<int64_t> nBytesRead{0};
+    std::atomic<int64_t> nBytesWritten{0};
+};
+
+std::mutex gOutputMutex;
+
+void printError(const std::string &message)
+{
+    std::lock_guard<std::mutex> lock(gOutputMutex);
+    std::cerr << "sff-convert: " << message << std::endl;
+}
+
+/// Parses A:B
+void parseChannels(const std::string &value, Options *options)
+{
+    auto colon = value.find(':');
+    if (colon == std::string::npos)
+    {
+        options->firstChannel = std::stoi(value);
+        options->lastChannel = options->firstChannel;
+    }
+    else
+    {
+        options->firstChannel = std::stoi(value.substr(0, colon));
+        options->lastChannel = std::stoi(value.substr(colon + 1));
+    }
+    if (options->firstChannel < 0 ||
+        options->lastChannel < options->firstChannel)
+    {
+        throw std::invalid_argument("Invalid channel range " + value);
+    }
+}
+
+/// Releases a semaphore slot however the job finishes
+class SlotGuard
+{
+public:
+    explicit SlotGuard(std::counting_semaphore<> &slots) :
+        mSlots(slots)
+    {
+    }
+    SlotGuard(const SlotGuard &) = delete;
+    SlotGuard& operator=(const SlotGuard &) = delete;
+    ~SlotGuard()
+    {
+        mSlots.release();
+    }
+private:
+    std::counting_semaphore<> &mSlots;
+};
+
+/// Expands directories into the files to convert
+std::vector<Job> getJobs(const Options &options, Statistics &statistics)
+{
+    std::vector<Job> jobs;
+    // The output names are derived from the relative path's directory and
+    // stem so, e.g., a/x.sac and b/x.sac given as files would overwrite
+    // each other
+    std::map<fs::path, fs::path> outputs;
+    auto addFile = [&](const fs::path &file, const fs::path &root)
+    {
+        Job job;
+        job.input = file;
+        job.relativePath = root.empty() ? file.filename() :
+                           fs::relative(file, root);
+        auto output = job.relativePath.parent_path()/job.relativePath.stem();
+        auto collision = outputs.find(output);
+        if (collision != outputs.end())
+        {
+            printError("Not converting " + file.string()
+                     + ": its output names collide with those of "
+                     + collision->second.string());
+            statistics.nFailed += 1;
+            return;
+        }
+        try
+        {
+            job.format = SFF::Utilities::detectFormat(file.string());
+        }
+        catch (const std::exception &e)
+        {
+            printError("Skipping " + file.string() + ": " + e.what());
+            statistics.nSkipped += 1;
+            return;
+        }
+        outputs.emplace(output, file);
+        jobs.push_back(std::move(job));
+    };
+    for (const auto &input : options.inputs)
+    {
+        fs::path path(input);
+        if (fs::is_directory(path))
+        {
+            std::vector<fs::path> files;
+            for (const auto &entry : fs::recursive_directory_iterator(path))
+            {
+                if (entry.is_regular_file()){files.push_back(entry.path());}
+            }
+            std::sort(files.begin(), files.end());
+            for (const auto &file : files){addFile(file, path);}
+        }
+        else if (fs::exists(path))
+        {
+            addFile(path, fs::path{});
+        }
+        else
+        {
+            throw std::invalid_argument(input + " does not exist");
+        }
+    }
+    return jobs;
+}
+
+/// Restricts the waveform to [t0, t1].  Returns false if nothing remains.
+bool window(SFF::SAC::Waveform &waveform, const Options &options)
+{
+    if (options.startTime == std::numeric_limits<double>::lowest() &&
+        options.endTime == std::numeric_limits<double>::max())
+    {
+        return true;
+    }
+    auto npts = waveform.getNumberOfSamples();
+    auto dt = waveform.getSamplingPeriod();
+    auto startTime = waveform.getStartTime();
+    auto t0 = startTime.getEpoch();
+    // Same convention as SAC::Waveform::read()
+    auto i0 = 0;
+    if (options.startTime > t0)
+    {
+        i0 = static_cast<int> (std::round((options.startTime - dt/4 - t0)/dt));
+    }
+    auto i1 = npts;
+    if (options.endTime < t0 + (npts - 1)*dt)
+    {
+        i1 = static_cast<int> (std::round((options.endTime + dt/4 - t0)/dt)) + 1;
+    }
+    i0 = std::max(0, i0);
+    i1 = std::min(npts, i1);
+    if (i1 <= i0){return false;}
+    if (i0 == 0 && i1 == npts){return true;}
+    auto data = waveform.getDataSpan();
+    std::vector<float> subset(data.begin() + i0, data.begin() + i1);
+    waveform.setData(static_cast<int> (subset.size()), subset.data());
+    startTime.setEpoch(t0 + i0*dt);
+    waveform.setStartTime(startTime);
+    return true;
+}
+
+/// Creates a SAC waveform from a generic trace
+template<typename T>
+SFF::SAC::Waveform toWaveform(const T &trace)
+{
+    SFF::SAC::Waveform waveform;
+    waveform.setSamplingRate(trace.getSamplingRate());
+    waveform.setStartTime(trace.getStartTime());
+    auto npts = trace.getNumberOfSamples();
+    std::vector<float> data(static_cast<size_t> (std::max(0, npts)));
+    trace.copyTo(std::span<float> (data));
+    waveform.setData(npts, data.data());
+    return waveform;
+}
+
+/// Unpacks the file into SAC waveforms paired with their output names
+std::vector<std::pair<std::string, SFF::SAC::Waveform>>
+    unpack(const Job &job, const std::vector<char> &bytes,
+           const Options &options)
+{
+    std::vector<std::pair<std::string, SFF::SAC::Waveform>> waveforms;
+    auto stem = job.relativePath.stem().string();
+    auto keep = [&options](const int i)
+    {
+        return i >= options.firstChannel && i <= options.lastChannel;
+    };
+    if (job.format == SFF::Format::SAC)
+    {
+        SFF::SAC::Waveform waveform;
+        waveform.set(bytes.size(), bytes.data());
+        if (keep(0)){waveforms.emplace_back(stem + ".sac", std::move(waveform));}
+    }
+    else if (job.format == SFF::Format::SILIXA_SEGY)
+    {
+        SFF::SEGY::Silixa::TraceGroup group;
+        group.set(bytes.size(), bytes.data());
+        int i = 0;
+        for (const auto &trace : group)
+        {
+            if (keep(i))
+            {
+                auto waveform = toWaveform(trace);
+                auto traceNumber = std::to_string(trace.getTraceNumber());
+                waveform.setHeader(SFF::SAC::Character::KSTNM, traceNumber);
+                std::array<char, 32> suffix{};
+                std::snprintf(suffix.data(), suffix.size(), ".%05d.sac", i);
+                waveforms.emplace_back(stem + suffix.data(),
+                                       std::move(waveform));
+            }
+            i = i + 1;
+        }
+    }
+    else if (job.format == SFF::Format::SEGY)
+    {
+        SFF::SEGY::TraceGroup group;
+        group.set(bytes.size(), bytes.data());
+        auto nTraces = group.getNumberOfTraces();
+        for (int64_t i = 0; i < nTraces; ++i)
+        {
+            if (!keep(static_cast<int> (i))){continue;}
+            auto trace = group.getTrace(i);
+            auto waveform = toWaveform(trace);
+            auto traceNumber = std::to_string(trace.getTraceNumber());
+            waveform.setHeader(SFF::SAC::Character::KSTNM, traceNumber);
+            std::array<char, 32> suffix{};
+            std::snprintf(suffix.data(), suffix.size(), ".%05lld.sac",
+                          static_cast<long long> (i));
+            waveforms.emplace_back(stem + suffix.data(), std::move(waveform));
+        }
+    }
+#ifdef USE_MSEED
+    else if (job.format == SFF::Format::MINISEED)
+    {
+        SFF::MiniSEED::TraceGroup group;
+        group.set(bytes.size(), bytes.data());
+        auto sncls = group.getSNCLs();
+        for (int i = 0; i < static_cast<int> (sncls.size()); ++i)
+        {
+            if (!keep(i)){continue;}
+            const auto &sncl = sncls[i];
+            auto waveform = toWaveform(group.getTrace(sncl));
+            std::string network{sncl.getNetwork()};
+            std::string station{sncl.getStation()};
+            std::string channel{sncl.getChannel()};
+            std::string location{sncl.getLocationCode()};
+            waveform.setHeader(SFF::SAC::Character::KNETWK, network);
+            waveform.setHeader(SFF::SAC::Character::KSTNM, station);
+            waveform.setHeader(SFF::SAC::Character::KCMPNM, channel);
+            if (!location.empty())
+            {
+                waveform.setHeader(SFF::SAC::Character::KHOLE, location);
+            }
+            auto name = stem + "." + network + "." + station + "."
+                      + channel + "." + location + ".sac";
+            waveforms.emplace_back(name, std::move(waveform));
+        }
+    }
+#endif
+    else
+    {
+        throw std::runtime_error("Library was compiled without miniSEED");
+    }
+    return waveforms;
+}
+
+/// Transforms and writes the contents of one file
+void convert(const Job &job, const std::vector<char> &bytes,
+             const Options &options, Statistics &statistics)
+{
+    auto waveforms = unpack(job, bytes, options);
+    auto directory = options.output / job.relativePath.parent_path();
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error)
+    {
+        throw std::runtime_error("Could not create " + directory.string()
+                               + ": " + error.message());
+    }
+    for (auto &[name, waveform] : waveforms)
+    {
+        if (!window(waveform, options)){continue;}
+        auto npts = waveform.getNumberOfSamples();
+        waveform.write((directory/name).string(), options.swap);
+        statistics.nTraces += 1;
+        statistics.nSamples += npts;
+        statistics.nBytesWritten += 632 + 4*static_cast<int64_t> (npts);
+    }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    std::vector<std::string> positional;
+    Options options;
+    Statistics statistics;
+    try
+    {
+        for (size_t i = 0; i < arguments.size(); ++i)
+        {
+            const auto &argument = arguments[i];
+            if (argument == "--help" || argument == "-h")
+            {
+                printUsage();
+                return EXIT_SUCCESS;
+            }
+            if (argument.rfind("--", 0) != 0)
+            {
+                positional.push_back(argument);
+                continue;
+            }
+            if (i + 1 >= arguments.size())
+            {
+                throw std::invalid_argument(argument + " requires a value");
+            }
+            const auto &value = arguments[++i];
+            if (argument == "--threads")
+            {
+                options.nThreads = std::stoi(value);
+            }
+            else if (argument == "--queue-depth")
+            {
+                options.queueDepth = std::stoi(value);
+            }
+            else if (argument == "--byte-order")
+            {
+                if (value == "native")
+                {
+                    options.swap = false;
+                }
+                else if (value == "little")
+                {
+                    options.swap = std::endian::native != std::endian::little;
+                }
+                else if (value == "big")
+                {
+                    options.swap = std::endian::native != std::endian::big;
+                }
+                else
+                {
+                    throw std::invalid_argument("Unknown byte order " + value);
+                }
+            }
+            else if (argument == "--start")
+            {
+                options.startTime = std::stod(value);
+            }
+            else if (argument == "--end")
+            {
+                options.endTime = std::stod(value);
+            }
+            else if (argument == "--channels")
+            {
+                parseChannels(value, &options);
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option " + argument);
+            }
+        }
+        if (positional.size() < 2)
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+        if (options.startTime >= options.endTime)
+        {
+            throw std::invalid_argument("--start must be less than --end");
+        }
+        options.output = positional.back();
+        positional.pop_back();
+        options.inputs = positional;
+        auto jobs = getJobs(options, statistics);
+        auto startTime = std::chrono::steady_clock::now();
+        {
+        SFF::Utilities::AsyncReader reader(options.queueDepth,
+                                           options.nThreads);
+        auto nWorkers = options.nThreads > 0 ? options.nThreads :
+                        static_cast<int> (std::thread::hardware_concurrency());
+        // Bound the number of files held in memory between the read and
+        // write stages
+        std::counting_semaphore<> slots(options.queueDepth
+                                      + 2*std::max(1, nWorkers));
+        for (const auto &job : jobs)
+        {
+            slots.acquire();
+            reader.readFile(job.input.string(),
+                            [&, job](std::vector<char> &&bytes,
+                                     std::exception_ptr error)
+            {
+                SlotGuard guard(slots);
+                try
+                {
+                    if (error){std::rethrow_exception(error);}
+                    statistics.nBytesRead
+                        += static_cast<int64_t> (bytes.size());
+                    convert(job, bytes, options, statistics);
+                    statistics.nFiles += 1;
+                }
+                catch (const std::exception &e)
+                {
+                    printError("Failed to convert " + job.input.string()
+                             + ": " + e.what());
+                    statistics.nFailed += 1;
+                }
+                catch (...)
+                {
+                    printError("Failed to convert " + job.input.string());
+                    statistics.nFailed += 1;
+                }
+            });
+        }
+        reader.wait();
+        }
+        std::chrono::duration<double> elapsed
+            = std::chrono::steady_clock::now() - startTime;
+        auto seconds = std::max(elapsed.count(), 1.e-9);
+        auto megaBytesRead = static_cast<double> (statistics.nBytesRead)/1.e6;
+        auto megaBytesWritten
+            = static_cast<double> (statistics.nBytesWritten)/1.e6;
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Converted " << statistics.nFiles << " files ("
+                  << statistics.nTraces << " traces, "
+                  << statistics.nSamples << " samples) in "
+                  << seconds << " s\n"
+                  << "Read " << megaBytesRead << " MB ("
+                  << megaBytesRead/seconds << " MB/s); wrote "
+                  << megaBytesWritten << " MB ("
+                  << megaBytesWritten/seconds << " MB/s); "
+                  << statistics.nSamples/seconds << " samples/s\n"
+                  << "Failed: " << statistics.nFailed
+                  << "; skipped: " << statistics.nSkipped << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "sff-convert: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return statistics.nFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
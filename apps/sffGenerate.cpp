@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "sff/utilities/syntheticDataGenerator.hpp"
+
+namespace
+{
+
+void printUsage()
+{
+    std::cout
+        << "Usage: sff-generate FORMAT OUTPUT [options]\n\n"
+        << "Writes deterministic synthetic data for testing and benchmarking.\n\n"
+        << "FORMAT is one of sac, miniseed, silixa, or hypo.  For sac OUTPUT\n"
+        << "is a directory; otherwise it is a file name.\n\n"
+        << "Options:\n"
+        << "  --seed N            Random number generator seed [0]\n"
+        << "  --channels N        Number of channels [1]\n"
+        << "  --samples N         Samples per channel [1000]\n"
+        << "  --rate R            Sampling rate in Hz [100]\n"
+        << "  --gap-every N       Samples between gaps; 0 disables gaps [0]\n"
+        << "  --gap-length N      Samples missing in each gap [0]\n"
+        << "  --record-length N   miniSEED record length in bytes [4096]\n"
+        << "  --events N          Number of events in a hypo archive [10]\n"
+        << "  --picks N           Picks per event in a hypo archive [10]\n"
+        << "  --help              Print this message\n";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    std::vector<std::string> positional;
+    SFF::Utilities::SyntheticDataGenerator generator;
+    int64_t segmentLength = 0;
+    int64_t gapLength = 0;
+    int recordLength = 4096;
+    int nEvents = 10;
+    int nPicks = 10;
+    try
+    {
+        for (size_t i = 0; i < arguments.size(); ++i)
+        {
+            const auto &argument = arguments[i];
+            if (argument == "--help" || argument == "-h")
+            {
+                printUsage();
+                return EXIT_SUCCESS;
+            }
+            if (argument.rfind("--", 0) != 0)
+            {
+                positional.push_back(argument);
+                continue;
+            }
+            if (i + 1 >= arguments.size())
+            {
+                throw std::invalid_argument(argument + " requires a value");
+            }
+            const auto &value = arguments[++i];
+            if (argument == "--seed")
+            {
+                generator.setSeed(std::stoull(value));
+            }
+            else if (argument == "--channels")
+            {
+                generator.setNumberOfChannels(std::stoi(value));
+            }
+            else if (argument == "--samples")
+            {
+                generator.setNumberOfSamples(std::stoll(value));
+            }
+            else if (argument == "--rate")
+            {
+                generator.setSamplingRate(std::stod(value));
+            }
+            else if (argument == "--gap-every")
+            {
+                segmentLength = std::stoll(value);
+            }
+            else if (argument == "--gap-length")
+            {
+                gapLength = std::stoll(value);
+            }
+            else if (argument == "--record-length")
+            {
+                recordLength = std::stoi(value);
+            }
+            else if (argument == "--events")
+            {
+                nEvents = std::stoi(value);
+            }
+            else if (argument == "--picks")
+            {
+                nPicks = std::stoi(value);
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option " + argument);
+            }
+        }
+        if (positional.size() != 2)
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+        generator.setGapPattern(segmentLength, gapLength);
+        const auto &format = positional[0];
+        const auto &output = positional[1];
+        if (format == "sac")
+        {
+            auto fileNames = generator.writeSAC(output);
+            std::cout << "Wrote " << fileNames.size() << " SAC files to "
+                      << output << std::endl;
+        }
+        else if (format == "miniseed" || format == "mseed")
+        {
+            generator.writeMiniSEED(output, recordLength);
+        }
+        else if (format == "silixa" || format == "segy")
+        {
+            generator.writeSilixaSEGY(output);
+        }
+        else if (format == "hypo" || format == "hypoinverse2000")
+        {
+            generator.writeHypoInverse2000Archive(output, nEvents,
+                std::min(nPicks, generator.getNumberOfChannels()));
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown format " + format);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "sff-generate: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+#include <string>
+#include <map>
+#include <tuple>
+#include <filesystem>
+#include "sff/compressed/lossyReader.hpp"
+#include "sff/compressed/lossyWriter.hpp"
+#include "sff/compressed/reader.hpp"
+#include "sff/compressed/writer.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/time.hpp"
+#include <benchmark/benchmark.h>
+#include "temporaryFile.hpp"
+
+namespace
+{
+using namespace SFF::Compressed;
+
+/// Writes a synthetic Silixa SEGY file once
+const std::string &getSilixaFile(const int nTraces, const int nSamples)
+{
+    static std::map<std::pair<int, int>, SFF::Benchmarks::TemporaryFile> fileNames;
+    auto key = std::pair(nTraces, nSamples);
+    auto it = fileNames.find(key);
+    if (it != fileNames.end()){return it->second.getName();}
+    auto path = std::filesystem::temp_directory_path()
+              / ("sffCompressedBenchmark_" + std::to_string(nTraces) + "x"
+               + std::to_string(nSamples) + ".sgy");
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(nTraces);
+    generator.setNumberOfSamples(nSamples);
+    generator.setSamplingRate(2000);
+    generator.setStartTime(SFF::Utilities::Time(1556323208.0));
+    generator.writeSilixaSEGY(path.string());
+    return fileNames.emplace(key, path).first->second.getName();
+}
+
+/// Compresses the synthetic Silixa SEGY file once
+const std::string &getCompressedFile(const int nTraces, const int nSamples,
+                                     const Transform transform)
+{
+    static std::map<std::tuple<int, int, Transform>, SFF::Benchmarks::TemporaryFile> fileNames;
+    auto key = std::tuple(nTraces, nSamples, transform);
+    auto it = fileNames.find(key);
+    if (it != fileNames.end()){return it->second.getName();}
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(getSilixaFile(nTraces, nSamples));
+    auto path = std::filesystem::temp_directory_path()
+              / ("sffCompressedBenchmark_" + std::to_string(nTraces) + "x"
+               + std::to_string(nSamples) + "_"
+               + std::to_string(static_cast<int> (transform)) + ".sffc");
+    Writer writer;
+    writer.setTransform(transform);
+    writer.write(path.string(), group);
+    return fileNames.emplace(key, path).first->second.getName();
+}
+
+/// The baseline: reading the uncompressed file
+void BM_CompressedBaselineSilixaRead(benchmark::State &state)
+{
+    auto nTraces = static_cast<int> (state.range(0));
+    auto nSamples = static_cast<int> (state.range(1));
+    const auto &fileName = getSilixaFile(nTraces, nSamples);
+    SFF::SEGY::Silixa::TraceGroup group;
+    for (auto _ : state)
+    {
+        group.read(fileName);
+        benchmark::DoNotOptimize(group.getNumberOfTraces());
+    }
+    state.SetBytesProcessed(state.iterations()*4*int64_t {nTraces}*nSamples);
+}
+BENCHMARK(BM_CompressedBaselineSilixaRead)->Args({128, 30000})
+                                          ->Args({1280, 30000})
+                                          ->Unit(benchmark::kMillisecond);
+
+/// Decompresses every channel.  The bytes processed are the uncompressed
+/// bytes so the rate is comparable to the baseline.
+void BM_CompressedReadAll(benchmark::State &state)
+{
+    auto nTraces = static_cast<int> (state.range(0));
+    auto nSamples = static_cast<int> (state.range(1));
+    auto transform = static_cast<Transform> (state.range(2));
+    Reader reader;
+    reader.open(getCompressedFile(nTraces, nSamples, transform));
+    for (auto _ : state)
+    {
+        auto x = reader.readAll();
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetBytesProcessed(state.iterations()*reader.getUncompressedSize());
+    state.counters["ratio"]
+        = static_cast<double> (reader.getUncompressedSize())
+         /static_cast<double> (reader.getCompressedSize());
+}
+BENCHMARK(BM_CompressedReadAll)->Args({128, 30000, 1})
+                               ->Args({128, 30000, 2})
+                               ->Args({1280, 30000, 1})
+                               ->Args({1280, 30000, 2})
+                               ->Unit(benchmark::kMillisecond);
+
+/// Random access to a one second window of one channel
+void BM_CompressedReadWindow(benchmark::State &state)
+{
+    Reader reader;
+    reader.open(getCompressedFile(1280, 30000, Transform::XOR_DELTA));
+    int channel = 0;
+    for (auto _ : state)
+    {
+        auto x = reader.read(channel, 12000, 13999);
+        benchmark::DoNotOptimize(x.data());
+        channel = (channel + 97)%1280;
+    }
+    state.SetBytesProcessed(state.iterations()*4*2000);
+}
+BENCHMARK(BM_CompressedReadWindow);
+
+void BM_CompressedWrite(benchmark::State &state)
+{
+    auto nTraces = static_cast<int> (state.range(0));
+    auto nSamples = static_cast<int> (state.range(1));
+    auto transform = static_cast<Transform> (state.range(2));
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(getSilixaFile(nTraces, nSamples));
+    auto path = std::filesystem::temp_directory_path()
+              / "sffCompressedBenchmarkWrite.sffc";
+    Writer writer;
+    writer.setTransform(transform);
+    for (auto _ : state)
+    {
+        writer.write(path.string(), group);
+    }
+    state.SetBytesProcessed(state.iterations()*4*int64_t {nTraces}*nSamples);
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CompressedWrite)->Args({1280, 30000, 1})
+                             ->Args({1280, 30000, 2})
+                             ->Unit(benchmark::kMillisecond);
+
+/// Error bounded compression.  The third argument is the absolute error
+/// bound in counts.
+void BM_CompressedLossyWrite(benchmark::State &state)
+{
+    auto nTraces = static_cast<int> (state.range(0));
+    auto nSamples = static_cast<int> (state.range(1));
+    auto tolerance = static_cast<double> (state.range(2));
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(getSilixaFile(nTraces, nSamples));
+    auto path = std::filesystem::temp_directory_path()
+              / "sffCompressedBenchmarkLossyWrite.sffl";
+    LossyWriter writer;
+    writer.setErrorBound(ErrorBound::ABSOLUTE, tolerance);
+    for (auto _ : state)
+    {
+        writer.write(path.string(), group);
+    }
+    state.SetBytesProcessed(state.iterations()*4*int64_t {nTraces}*nSamples);
+    state.counters["ratio"] = writer.getCompressionRatio();
+    state.counters["maxError"] = writer.getMaximumError();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CompressedLossyWrite)->Args({1280, 30000, 1})
+                                  ->Args({1280, 30000, 16})
+                                  ->Unit(benchmark::kMillisecond);
+
+void BM_CompressedLossyReadAll(benchmark::State &state)
+{
+    auto nTraces = static_cast<int> (state.range(0));
+    auto nSamples = static_cast<int> (state.range(1));
+    auto tolerance = static_cast<double> (state.range(2));
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(getSilixaFile(nTraces, nSamples));
+    auto path = std::filesystem::temp_directory_path()
+              / "sffCompressedBenchmarkLossyRead.sffl";
+    LossyWriter writer;
+    writer.setErrorBound(ErrorBound::ABSOLUTE, tolerance);
+    writer.write(path.string(), group);
+    LossyReader reader;
+    reader.open(path.string());
+    for (auto _ : state)
+    {
+        auto x = reader.readAll();
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetBytesProcessed(state.iterations()*reader.getUncompressedSize());
+    state.counters["ratio"] = writer.getCompressionRatio();
+    reader.close();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CompressedLossyReadAll)->Args({1280, 30000, 1})
+                                    ->Args({1280, 30000, 16})
+                                    ->Unit(benchmark::kMillisecond);
+
+}
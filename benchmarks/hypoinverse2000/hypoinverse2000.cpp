@@ -0,0 +1,93 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <filesystem>
+#include "sff/hypoinverse2000/stationArchiveLine.hpp"
+#include "sff/hypoinverse2000/eventSummaryLine.hpp"
+#include "sff/hypoinverse2000/eventSummary.hpp"
+#include "sff/hypoinverse2000/archiveWriter.hpp"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using namespace SFF::HypoInverse2000;
+
+const std::string originLine = "202003181320217640 4594112  399  771    24 83  4  1633184  88154 5  44298     33    1  44  87  4     100    47       D 24 L237 20         60363637L237  20        5FUUP1";
+const std::string pPickLine = "RBU  UU  EHZ IPU0202003181320 2596 -14198        0                   0     218110 0      84 85227    300     D 02";
+const std::string sPickLine = "NOQ  UU  HHN    4202003181320             2689ES 2  -8   1424 0 24       0 1341210  14     199   251       0J L01";
+
+void BM_StationArchiveLineUnpack(benchmark::State &state)
+{
+    StationArchiveLine line;
+    for (auto _ : state)
+    {
+        line.unpackString(state.range(0) == 0 ? pPickLine : sPickLine);
+        benchmark::DoNotOptimize(line);
+    }
+    state.SetBytesProcessed(state.iterations()*pPickLine.size());
+}
+BENCHMARK(BM_StationArchiveLineUnpack)->Arg(0)->Arg(1);
+
+void BM_StationArchiveLinePack(benchmark::State &state)
+{
+    StationArchiveLine line;
+    line.unpackString(pPickLine);
+    std::array<char, StationArchiveLine::PACKED_LENGTH> buffer{};
+    for (auto _ : state)
+    {
+        line.packString(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+BENCHMARK(BM_StationArchiveLinePack);
+
+void BM_EventSummaryLineUnpack(benchmark::State &state)
+{
+    EventSummaryLine line;
+    for (auto _ : state)
+    {
+        line.unpackString(originLine);
+        benchmark::DoNotOptimize(line);
+    }
+    state.SetBytesProcessed(state.iterations()*originLine.size());
+}
+BENCHMARK(BM_EventSummaryLineUnpack);
+
+void BM_EventSummaryLinePack(benchmark::State &state)
+{
+    EventSummaryLine line;
+    line.unpackString(originLine);
+    std::array<char, EventSummaryLine::PACKED_LENGTH> buffer{};
+    for (auto _ : state)
+    {
+        line.packString(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+BENCHMARK(BM_EventSummaryLinePack);
+
+/// Writes an archive with the given number of events
+void BM_ArchiveWriter(benchmark::State &state)
+{
+    auto nEvents = static_cast<int> (state.range(0));
+    EventSummary event;
+    event.unpackString(
+        std::vector<std::string> {originLine, pPickLine, sPickLine});
+    auto fileName = (std::filesystem::temp_directory_path()
+                   / "sffBenchmark_archive.arc").string();
+    for (auto _ : state)
+    {
+        ArchiveWriter writer;
+        writer.open(fileName);
+        for (int i = 0; i < nEvents; ++i){writer.write(event);}
+        writer.close();
+    }
+    state.SetItemsProcessed(state.iterations()*nEvents);
+    state.SetBytesProcessed(state.iterations()*nEvents
+                           *int64_t {event.getPackedLength()});
+    std::filesystem::remove(fileName);
+}
+BENCHMARK(BM_ArchiveWriter)->RangeMultiplier(10)->Range(100, 100000)
+                           ->Unit(benchmark::kMillisecond);
+
+}
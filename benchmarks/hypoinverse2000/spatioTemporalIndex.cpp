@@ -0,0 +1,151 @@
+#include <vector>
+#include <random>
+#include <cstdint>
+#include "sff/hypoinverse2000/spatioTemporalIndex.hpp"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using namespace SFF::HypoInverse2000;
+
+/// A synthetic catalog of events spread over the western US and a year.
+struct SyntheticCatalog
+{
+    explicit SyntheticCatalog(const int nEvents)
+    {
+        std::mt19937 generator(86332);
+        std::uniform_real_distribution<double> latitudeDistribution(31, 49);
+        std::uniform_real_distribution<double> longitudeDistribution(-125, -102);
+        std::uniform_real_distribution<double> depthDistribution(0, 30);
+        std::uniform_real_distribution<double> magnitudeDistribution(-1, 5);
+        std::uniform_int_distribution<int64_t>
+            timeDistribution(0, 365*86400*int64_t {1000000000});
+        mTimes.resize(nEvents);
+        mLatitudes.resize(nEvents);
+        mLongitudes.resize(nEvents);
+        mDepths.resize(nEvents);
+        mMagnitudes.resize(nEvents);
+        for (int i = 0; i < nEvents; ++i)
+        {
+            mTimes[i] = timeDistribution(generator);
+            mLatitudes[i] = latitudeDistribution(generator);
+            mLongitudes[i] = longitudeDistribution(generator);
+            mDepths[i] = depthDistribution(generator);
+            mMagnitudes[i] = magnitudeDistribution(generator);
+        }
+    }
+    std::vector<int64_t> mTimes;
+    std::vector<double> mLatitudes;
+    std::vector<double> mLongitudes;
+    std::vector<double> mDepths;
+    std::vector<double> mMagnitudes;
+};
+
+const SyntheticCatalog &getCatalog()
+{
+    static const SyntheticCatalog catalog(1000000);
+    return catalog;
+}
+
+const SpatioTemporalIndex &getIndex()
+{
+    static const SpatioTemporalIndex index = []()
+    {
+        const auto &catalog = getCatalog();
+        SpatioTemporalIndex result;
+        result.initialize(catalog.mTimes, catalog.mLatitudes,
+                          catalog.mLongitudes, catalog.mDepths,
+                          catalog.mMagnitudes);
+        return result;
+    }();
+    return index;
+}
+
+void BM_SpatioTemporalIndexBuild(benchmark::State &state)
+{
+    const auto &catalog = getCatalog();
+    for (auto _ : state)
+    {
+        SpatioTemporalIndex index;
+        index.initialize(catalog.mTimes, catalog.mLatitudes,
+                         catalog.mLongitudes, catalog.mDepths,
+                         catalog.mMagnitudes);
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(state.iterations()*catalog.mTimes.size());
+}
+BENCHMARK(BM_SpatioTemporalIndexBuild)->Unit(benchmark::kMillisecond);
+
+/// Events within 20 km of Salt Lake City in a month with M >= 2
+void BM_SpatioTemporalIndexRangeQuery(benchmark::State &state)
+{
+    const auto &index = getIndex();
+    const int64_t t0 = 100*86400*int64_t {1000000000};
+    const int64_t t1 = t0 + 30*86400*int64_t {1000000000};
+    const auto radius = static_cast<double> (state.range(0));
+    for (auto _ : state)
+    {
+        auto indices = index.findEvents(40.76, -111.89, radius, t0, t1, 2);
+        benchmark::DoNotOptimize(indices);
+    }
+}
+BENCHMARK(BM_SpatioTemporalIndexRangeQuery)->Arg(20)->Arg(100)->Arg(500);
+
+/// Brute force scan for comparison
+void BM_LinearScanRangeQuery(benchmark::State &state)
+{
+    const auto &catalog = getCatalog();
+    const int64_t t0 = 100*86400*int64_t {1000000000};
+    const int64_t t1 = t0 + 30*86400*int64_t {1000000000};
+    const auto radius = static_cast<double> (state.range(0));
+    const double d2r = M_PI/180;
+    const double lat = 40.76*d2r;
+    const double lon = -111.89*d2r;
+    for (auto _ : state)
+    {
+        std::vector<int> indices;
+        for (int i = 0; i < static_cast<int> (catalog.mTimes.size()); ++i)
+        {
+            if (catalog.mTimes[i] < t0 || catalog.mTimes[i] > t1){continue;}
+            if (catalog.mMagnitudes[i] < 2){continue;}
+            auto sinDLat = std::sin(0.5*(catalog.mLatitudes[i]*d2r - lat));
+            auto sinDLon = std::sin(0.5*(catalog.mLongitudes[i]*d2r - lon));
+            auto a = sinDLat*sinDLat
+                   + std::cos(lat)*std::cos(catalog.mLatitudes[i]*d2r)
+                    *sinDLon*sinDLon;
+            if (2*6371*std::asin(std::sqrt(a)) <= radius)
+            {
+                indices.push_back(i);
+            }
+        }
+        benchmark::DoNotOptimize(indices);
+    }
+}
+BENCHMARK(BM_LinearScanRangeQuery)->Arg(20)->Unit(benchmark::kMillisecond);
+
+void BM_SpatioTemporalIndexNearestEvents(benchmark::State &state)
+{
+    const auto &index = getIndex();
+    const auto k = static_cast<int> (state.range(0));
+    for (auto _ : state)
+    {
+        auto indices = index.findNearestEvents(40.76, -111.89, 5, k);
+        benchmark::DoNotOptimize(indices);
+    }
+}
+BENCHMARK(BM_SpatioTemporalIndexNearestEvents)->Arg(1)->Arg(10)->Arg(100);
+
+void BM_SpatioTemporalIndexTimeQuery(benchmark::State &state)
+{
+    const auto &index = getIndex();
+    const int64_t t0 = 100*86400*int64_t {1000000000};
+    const int64_t t1 = t0 + 86400*int64_t {1000000000};
+    for (auto _ : state)
+    {
+        auto indices = index.findEventsInTimeRange(t0, t1);
+        benchmark::DoNotOptimize(indices);
+    }
+}
+BENCHMARK(BM_SpatioTemporalIndexTimeQuery);
+
+}
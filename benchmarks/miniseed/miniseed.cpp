@@ -0,0 +1,52 @@
+#include <string>
+#include <filesystem>
+#include "sff/miniseed/sncl.hpp"
+#include "sff/miniseed/trace.hpp"
+#include "sff/miniseed/traceGroup.hpp"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using namespace SFF::MiniSEED;
+
+const std::string fileName = "data/WY.YWB.EHZ.01.mseed";
+
+SNCL getSNCL()
+{
+    SNCL sncl;
+    sncl.setNetwork("WY");
+    sncl.setStation("YWB");
+    sncl.setChannel("EHZ");
+    sncl.setLocationCode("01");
+    return sncl;
+}
+
+/// Decodes the Steim compressed test trace
+void BM_MiniSEEDTraceRead(benchmark::State &state)
+{
+    auto sncl = getSNCL();
+    Trace trace;
+    for (auto _ : state)
+    {
+        trace.read(fileName, sncl);
+        benchmark::DoNotOptimize(trace.getNumberOfSamples());
+    }
+    state.SetBytesProcessed(state.iterations()
+                           *std::filesystem::file_size(fileName));
+}
+BENCHMARK(BM_MiniSEEDTraceRead);
+
+void BM_MiniSEEDTraceGroupRead(benchmark::State &state)
+{
+    TraceGroup group;
+    for (auto _ : state)
+    {
+        group.read(fileName);
+        benchmark::DoNotOptimize(group.getNumberOfTraces());
+    }
+    state.SetBytesProcessed(state.iterations()
+                           *std::filesystem::file_size(fileName));
+}
+BENCHMARK(BM_MiniSEEDTraceGroupRead);
+
+}
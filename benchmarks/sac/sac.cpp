@@ -0,0 +1,114 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <random>
+#include <filesystem>
+#include "sff/sac/waveform.hpp"
+#include "sff/sac/header.hpp"
+#include "sff/sac/enums.hpp"
+#include "sff/utilities/time.hpp"
+#include <benchmark/benchmark.h>
+#include "temporaryFile.hpp"
+
+namespace
+{
+using namespace SFF::SAC;
+
+/// Creates a synthetic waveform with the given number of samples
+Waveform makeWaveform(const int nSamples)
+{
+    std::mt19937 generator(392);
+    std::normal_distribution<double> noise(0, 1000);
+    std::vector<double> data(nSamples);
+    for (auto &sample : data){sample = noise(generator);}
+    Waveform waveform;
+    waveform.setData(nSamples, data.data());
+    waveform.setHeader(Double::DELTA, 0.01);
+    waveform.setStartTime(SFF::Utilities::Time(1577836800.0));
+    waveform.setHeader(Character::KNETWK, "UU");
+    waveform.setHeader(Character::KSTNM, "FORK");
+    waveform.setHeader(Character::KCMPNM, "HHZ");
+    return waveform;
+}
+
+/// Writes the synthetic waveform in native or swapped byte order once
+const std::string &getFile(const int nSamples, const bool swap)
+{
+    static std::map<std::pair<int, bool>, SFF::Benchmarks::TemporaryFile> fileNames;
+    auto key = std::pair(nSamples, swap);
+    auto it = fileNames.find(key);
+    if (it != fileNames.end()){return it->second.getName();}
+    auto path = std::filesystem::temp_directory_path()
+              / ("sffBenchmark_" + std::to_string(nSamples)
+               + (swap ? "_swapped" : "") + ".sac");
+    makeWaveform(nSamples).write(path.string(), swap);
+    return fileNames.emplace(key, path).first->second.getName();
+}
+
+void BM_SACRead(benchmark::State &state)
+{
+    auto nSamples = static_cast<int> (state.range(0));
+    const auto &fileName = getFile(nSamples, false);
+    Waveform waveform;
+    for (auto _ : state)
+    {
+        waveform.read(fileName);
+        benchmark::DoNotOptimize(waveform.getDataPointer());
+    }
+    state.SetBytesProcessed(state.iterations()*(632 + 4*int64_t {nSamples}));
+}
+BENCHMARK(BM_SACRead)->RangeMultiplier(10)->Range(1000, 10000000)
+                     ->Unit(benchmark::kMicrosecond);
+
+/// Exercises the byte swapping path
+void BM_SACReadSwapped(benchmark::State &state)
+{
+    auto nSamples = static_cast<int> (state.range(0));
+    const auto &fileName = getFile(nSamples, true);
+    Waveform waveform;
+    for (auto _ : state)
+    {
+        waveform.read(fileName);
+        benchmark::DoNotOptimize(waveform.getDataPointer());
+    }
+    state.SetBytesProcessed(state.iterations()*(632 + 4*int64_t {nSamples}));
+}
+BENCHMARK(BM_SACReadSwapped)->RangeMultiplier(10)->Range(1000, 10000000)
+                            ->Unit(benchmark::kMicrosecond);
+
+void BM_SACWrite(benchmark::State &state)
+{
+    auto nSamples = static_cast<int> (state.range(0));
+    auto swap = state.range(1) != 0;
+    auto waveform = makeWaveform(nSamples);
+    auto fileName = (std::filesystem::temp_directory_path()
+                   / "sffBenchmark_write.sac").string();
+    for (auto _ : state)
+    {
+        waveform.write(fileName, swap);
+    }
+    state.SetBytesProcessed(state.iterations()*(632 + 4*int64_t {nSamples}));
+    std::filesystem::remove(fileName);
+}
+BENCHMARK(BM_SACWrite)->ArgsProduct({{1000, 100000, 10000000}, {0, 1}})
+                      ->Unit(benchmark::kMicrosecond);
+
+void BM_SACHeaderFromBinary(benchmark::State &state)
+{
+    auto swap = state.range(0) != 0;
+    Header header;
+    header.setHeader(Double::DELTA, 0.01);
+    header.setHeader(Integer::NPTS, 100);
+    header.setHeader(Character::KSTNM, "FORK");
+    std::array<char, 632> binaryHeader{};
+    header.getBinaryHeader(binaryHeader.data(), swap);
+    for (auto _ : state)
+    {
+        header.setFromBinaryHeader(binaryHeader.data(), swap);
+        benchmark::DoNotOptimize(header);
+    }
+}
+BENCHMARK(BM_SACHeaderFromBinary)->Arg(0)->Arg(1);
+
+}
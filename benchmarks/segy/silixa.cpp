@@ -0,0 +1,148 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <random>
+#include <fstream>
+#include <filesystem>
+#include "sff/segy/textualFileHeader.hpp"
+#include "sff/segy/silixa/binaryFileHeader.hpp"
+#include "sff/segy/silixa/traceHeader.hpp"
+#include "sff/segy/silixa/trace.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/utilities/time.hpp"
+#include <benchmark/benchmark.h>
+#include "temporaryFile.hpp"
+
+namespace
+{
+using namespace SFF::SEGY::Silixa;
+
+/// Packs a big endian float
+void packFloat(const float value, char *c)
+{
+    union
+    {
+        float f4;
+        char c4[4];
+    };
+    f4 = value;
+    c[0] = c4[3]; c[1] = c4[2]; c[2] = c4[1]; c[3] = c4[0];
+}
+
+/// Packs a trace header and trace with the given number of samples
+std::vector<char> makeTrace(const int traceNumber, const int nSamples,
+                            std::mt19937 &generator)
+{
+    std::normal_distribution<float> noise(0, 1);
+    std::vector<char> trace(240 + 4*static_cast<size_t> (nSamples));
+    TraceHeader header;
+    header.setTraceNumber(traceNumber);
+    header.setNumberOfSamples(nSamples);
+    header.setSampleInterval(500);
+    header.setStartTime(SFF::Utilities::Time(1556323208.0));
+    auto headerPtr = trace.data();
+    header.get(&headerPtr);
+    for (int i = 0; i < nSamples; ++i)
+    {
+        packFloat(noise(generator), trace.data() + 240 + 4*i);
+    }
+    return trace;
+}
+
+/// Writes a synthetic Silixa SEGY file once
+const std::string &getFile(const int nTraces, const int nSamples)
+{
+    static std::map<std::pair<int, int>, SFF::Benchmarks::TemporaryFile> fileNames;
+    auto key = std::pair(nTraces, nSamples);
+    auto it = fileNames.find(key);
+    if (it != fileNames.end()){return it->second.getName();}
+    auto path = std::filesystem::temp_directory_path()
+              / ("sffBenchmark_" + std::to_string(nTraces) + "x"
+               + std::to_string(nSamples) + ".sgy");
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    SFF::SEGY::TextualFileHeader textualHeader;
+    auto text = textualHeader.getEBCDIC();
+    text.resize(3200, ' ');
+    file.write(text.data(), 3200);
+    BinaryFileHeader binaryHeader;
+    binaryHeader.setNumberOfTraces(nTraces);
+    binaryHeader.setSampleInterval(500);
+    binaryHeader.setNumberOfSamplesPerTrace(nSamples);
+    auto binary = binaryHeader.get();
+    file.write(binary.data(), 400);
+    std::mt19937 generator(1280);
+    for (int i = 0; i < nTraces; ++i)
+    {
+        auto trace = makeTrace(i + 1, nSamples, generator);
+        file.write(trace.data(), trace.size());
+    }
+    file.close();
+    return fileNames.emplace(key, path).first->second.getName();
+}
+
+void BM_SilixaTraceGroupRead(benchmark::State &state)
+{
+    auto nTraces = static_cast<int> (state.range(0));
+    auto nSamples = static_cast<int> (state.range(1));
+    const auto &fileName = getFile(nTraces, nSamples);
+    TraceGroup group;
+    for (auto _ : state)
+    {
+        group.read(fileName);
+        benchmark::DoNotOptimize(group.getNumberOfTraces());
+    }
+    state.SetBytesProcessed(state.iterations()
+                           *(3600 + int64_t {nTraces}*(240 + 4*nSamples)));
+}
+BENCHMARK(BM_SilixaTraceGroupRead)->Args({16, 2000})
+                                  ->Args({128, 30000})
+                                  ->Args({1280, 30000})
+                                  ->Unit(benchmark::kMillisecond);
+
+/// Unpacks a trace which byte swaps the samples on little endian machines
+void BM_SilixaTraceSet(benchmark::State &state)
+{
+    auto nSamples = static_cast<int> (state.range(0));
+    std::mt19937 generator(88);
+    auto data = makeTrace(1, nSamples, generator);
+    Trace trace;
+    for (auto _ : state)
+    {
+        trace.set(static_cast<int> (data.size()), data.data());
+        benchmark::DoNotOptimize(trace.getDataPointer());
+    }
+    state.SetBytesProcessed(state.iterations()*data.size());
+}
+BENCHMARK(BM_SilixaTraceSet)->RangeMultiplier(4)->Range(2000, 32000);
+
+void BM_SilixaTraceHeaderSet(benchmark::State &state)
+{
+    std::mt19937 generator(88);
+    auto data = makeTrace(1, 1, generator);
+    TraceHeader header;
+    for (auto _ : state)
+    {
+        header.set(data.data());
+        benchmark::DoNotOptimize(header);
+    }
+}
+BENCHMARK(BM_SilixaTraceHeaderSet);
+
+void BM_SilixaBinaryFileHeaderSet(benchmark::State &state)
+{
+    BinaryFileHeader reference;
+    reference.setNumberOfTraces(1280);
+    reference.setSampleInterval(500);
+    reference.setNumberOfSamplesPerTrace(30000);
+    auto binary = reference.get();
+    BinaryFileHeader header;
+    for (auto _ : state)
+    {
+        header.set(binary.data());
+        benchmark::DoNotOptimize(header);
+    }
+}
+BENCHMARK(BM_SilixaBinaryFileHeaderSet);
+
+}
@@ -0,0 +1,40 @@
+#ifndef SFF_BENCHMARKS_TEMPORARYFILE_HPP
+#define SFF_BENCHMARKS_TEMPORARYFILE_HPP
+#include <string>
+#include <filesystem>
+#include <system_error>
+namespace SFF::Benchmarks
+{
+/// @brief A generated input file that is removed when this is destroyed.
+///        The benchmarks cache these in function-local statics so each
+///        input is written once per run and deleted when the run exits.
+class TemporaryFile
+{
+public:
+    explicit TemporaryFile(const std::filesystem::path &path) :
+        mName(path.string())
+    {
+    }
+    TemporaryFile(const TemporaryFile &) = delete;
+    TemporaryFile(TemporaryFile &&file) noexcept :
+        mName(std::move(file.mName))
+    {
+        file.mName.clear();
+    }
+    TemporaryFile& operator=(const TemporaryFile &) = delete;
+    TemporaryFile& operator=(TemporaryFile &&) = delete;
+    ~TemporaryFile()
+    {
+        if (mName.empty()){return;}
+        std::error_code error;
+        std::filesystem::remove(mName, error);
+    }
+    [[nodiscard]] const std::string &getName() const noexcept
+    {
+        return mName;
+    }
+private:
+    std::string mName;
+};
+}
+#endif
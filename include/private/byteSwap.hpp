@@ -39,6 +39,12 @@ union SI4
     int32_t val;
 }; 
 
+union SI8
+{
+    char c8[8];
+    int64_t val;
+};
+
 union SF4 
 {   
     char c4[4];
@@ -89,6 +95,35 @@ union SF8
     return s.val;
 }
 
+#pragma omp declare simd uniform(lswap)
+[[maybe_unused]] int64_t unpackLong(const char c[8], const bool lswap)
+{
+    SI8 s;
+    if (lswap)
+    {
+        s.c8[0] = c[7];
+        s.c8[1] = c[6];
+        s.c8[2] = c[5];
+        s.c8[3] = c[4];
+        s.c8[4] = c[3];
+        s.c8[5] = c[2];
+        s.c8[6] = c[1];
+        s.c8[7] = c[0];
+    }
+    else
+    {
+        s.c8[0] = c[0];
+        s.c8[1] = c[1];
+        s.c8[2] = c[2];
+        s.c8[3] = c[3];
+        s.c8[4] = c[4];
+        s.c8[5] = c[5];
+        s.c8[6] = c[6];
+        s.c8[7] = c[7];
+    }
+    return s.val;
+}
+
 #pragma omp declare simd uniform(lswap)
 [[maybe_unused]] float unpackFloat(const char c[4], const bool lswap)
 {
@@ -182,6 +217,36 @@ union SF8
     }
 }
 
+#pragma omp declare simd uniform(lswap)
+[[maybe_unused]] void packLong(const int64_t valIn, char c[8],
+                               const bool lswap)
+{
+    SI8 s;
+    s.val = valIn;
+    if (lswap)
+    {
+        c[0] = s.c8[7];
+        c[1] = s.c8[6];
+        c[2] = s.c8[5];
+        c[3] = s.c8[4];
+        c[4] = s.c8[3];
+        c[5] = s.c8[2];
+        c[6] = s.c8[1];
+        c[7] = s.c8[0];
+    }
+    else
+    {
+        c[0] = s.c8[0];
+        c[1] = s.c8[1];
+        c[2] = s.c8[2];
+        c[3] = s.c8[3];
+        c[4] = s.c8[4];
+        c[5] = s.c8[5];
+        c[6] = s.c8[6];
+        c[7] = s.c8[7];
+    }
+}
+
 #pragma omp declare simd uniform(lswap)
 [[maybe_unused]] void packFloat(const float valIn, char c[4], const bool lswap)
 {
@@ -0,0 +1,217 @@
+#ifndef SFF_PRIVATE_COMPRESSEDFORMAT_HPP
+#define SFF_PRIVATE_COMPRESSEDFORMAT_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "sff/compressed/enums.hpp"
+#include "private/byteSwap.hpp"
+namespace
+{
+
+//----------------------------------------------------------------------------//
+//                                File Layout                                 //
+//----------------------------------------------------------------------------//
+// All values are little endian.  The file is
+//   1. The 64 byte file header.
+//   2. The compressed chunks.  The chunks of channel 0 are followed by the
+//      chunks of channel 1, and so on, so that a channel's chunks are
+//      contiguous.
+//   3. The chunk index.  This is 16 bytes per chunk in the same order as
+//      the chunks.
+//   4. The channel names.  Each name is a 4 byte length then the name.
+//
+// The file header is
+//   [0,4)   "SFFC"
+//   [4,8)   The format version
+//   [8]     The transform
+//   [12,16) The number of samples in a chunk
+//   [16,20) The number of channels
+//   [24,32) The number of samples in each channel
+//   [32,40) The sampling period in seconds
+//   [40,48) The start time as seconds since the epoch
+//   [48,56) The offset of the chunk index
+//   [56,64) The offset of the channel names
+//
+// An index entry is
+//   [0,8)   The chunk's offset
+//   [8,12)  The chunk's compressed size
+//   [12]    The codec
+
+constexpr std::array<char, 4> COMPRESSED_MAGIC{'S', 'F', 'F', 'C'};
+constexpr int32_t COMPRESSED_VERSION = 1;
+constexpr size_t COMPRESSED_HEADER_SIZE = 64;
+constexpr size_t COMPRESSED_INDEX_ENTRY_SIZE = 16;
+
+/// Defines how a chunk's transformed bytes were stored
+enum class Codec : uint8_t
+{
+    STORED = 0, /*!< The bytes did not compress and are stored as is. */
+    LZ = 1      /*!< The bytes are an LZ block. */
+};
+
+/// Locates a chunk in the file
+struct ChunkIndexEntry
+{
+    int64_t offset{0};
+    int32_t size{0};
+    Codec codec{Codec::STORED};
+};
+
+/// The file header
+struct CompressedFileHeader
+{
+    /// Packs the header into 64 bytes
+    void pack(char c[]) const
+    {
+        const bool swap = (testByteOrder() == BIG_ENDIAN);
+        std::fill(c, c + COMPRESSED_HEADER_SIZE, 0);
+        std::copy(COMPRESSED_MAGIC.begin(), COMPRESSED_MAGIC.end(), c);
+        packInt(COMPRESSED_VERSION, &c[4], swap);
+        c[8] = static_cast<char> (transform);
+        packInt(chunkLength, &c[12], swap);
+        packInt(nChannels, &c[16], swap);
+        packLong(nSamples, &c[24], swap);
+        packDouble(samplingPeriod, &c[32], swap);
+        packDouble(startTime, &c[40], swap);
+        packLong(indexOffset, &c[48], swap);
+        packLong(namesOffset, &c[56], swap);
+    }
+    /// Unpacks and checks the header from 64 bytes
+    void unpack(const char c[])
+    {
+        const bool swap = (testByteOrder() == BIG_ENDIAN);
+        if (!std::equal(COMPRESSED_MAGIC.begin(), COMPRESSED_MAGIC.end(), c))
+        {
+            throw std::invalid_argument("Not an sff compressed file");
+        }
+        auto version = unpackInt(&c[4], swap);
+        if (version != COMPRESSED_VERSION)
+        {
+            throw std::invalid_argument("Unsupported compressed file version "
+                                      + std::to_string(version));
+        }
+        auto transformValue = static_cast<uint8_t> (c[8]);
+        if (transformValue > 2)
+        {
+            throw std::invalid_argument("Unknown transform "
+                                      + std::to_string(transformValue));
+        }
+        transform = static_cast<SFF::Compressed::Transform> (transformValue);
+        chunkLength = unpackInt(&c[12], swap);
+        nChannels = unpackInt(&c[16], swap);
+        nSamples = unpackLong(&c[24], swap);
+        samplingPeriod = unpackDouble(&c[32], swap);
+        startTime = unpackDouble(&c[40], swap);
+        indexOffset = unpackLong(&c[48], swap);
+        namesOffset = unpackLong(&c[56], swap);
+        if (chunkLength < 1 || nChannels < 1 || nSamples < 1 ||
+            !(samplingPeriod > 0) || indexOffset < 0 || namesOffset < 0)
+        {
+            throw std::invalid_argument("Corrupt compressed file header");
+        }
+    }
+    SFF::Compressed::Transform transform{SFF::Compressed::Transform::NONE};
+    int64_t nSamples{0};
+    int64_t indexOffset{0};
+    int64_t namesOffset{0};
+    double samplingPeriod{0};
+    double startTime{0};
+    int32_t chunkLength{0};
+    int32_t nChannels{0};
+};
+
+//----------------------------------------------------------------------------//
+//                                 Transforms                                 //
+//----------------------------------------------------------------------------//
+
+/// @brief Transforms n samples into 4*n bytes.  The bytes are little endian
+///        irrespective of the architecture.
+[[maybe_unused]]
+void forwardTransform(const SFF::Compressed::Transform transform,
+                      const float x[], const int n, char bytes[])
+{
+    auto u = reinterpret_cast<uint8_t *> (bytes);
+    if (transform == SFF::Compressed::Transform::NONE)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            auto bits = std::bit_cast<uint32_t> (x[i]);
+            u[4*i]     = static_cast<uint8_t> (bits);
+            u[4*i + 1] = static_cast<uint8_t> (bits >> 8);
+            u[4*i + 2] = static_cast<uint8_t> (bits >> 16);
+            u[4*i + 3] = static_cast<uint8_t> (bits >> 24);
+        }
+        return;
+    }
+    auto b0 = u;
+    auto b1 = u + n;
+    auto b2 = u + 2*static_cast<size_t> (n);
+    auto b3 = u + 3*static_cast<size_t> (n);
+    uint32_t previous = 0;
+    const bool delta = (transform == SFF::Compressed::Transform::XOR_DELTA);
+    for (int i = 0; i < n; ++i)
+    {
+        auto bits = std::bit_cast<uint32_t> (x[i]);
+        auto value = delta ? bits^previous : bits;
+        previous = bits;
+        b0[i] = static_cast<uint8_t> (value);
+        b1[i] = static_cast<uint8_t> (value >> 8);
+        b2[i] = static_cast<uint8_t> (value >> 16);
+        b3[i] = static_cast<uint8_t> (value >> 24);
+    }
+}
+
+/// @brief Inverts forwardTransform().
+[[maybe_unused]]
+void inverseTransform(const SFF::Compressed::Transform transform,
+                      const char bytes[], const int n, float y[])
+{
+    auto u = reinterpret_cast<const uint8_t *> (bytes);
+    if (transform == SFF::Compressed::Transform::NONE)
+    {
+        #pragma omp simd
+        for (int i = 0; i < n; ++i)
+        {
+            auto bits = static_cast<uint32_t> (u[4*i])
+                     | (static_cast<uint32_t> (u[4*i + 1]) << 8)
+                     | (static_cast<uint32_t> (u[4*i + 2]) << 16)
+                     | (static_cast<uint32_t> (u[4*i + 3]) << 24);
+            y[i] = std::bit_cast<float> (bits);
+        }
+        return;
+    }
+    auto b0 = u;
+    auto b1 = u + n;
+    auto b2 = u + 2*static_cast<size_t> (n);
+    auto b3 = u + 3*static_cast<size_t> (n);
+    if (transform == SFF::Compressed::Transform::XOR_DELTA)
+    {
+        uint32_t previous = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            previous = previous
+                     ^ (static_cast<uint32_t> (b0[i])
+                     | (static_cast<uint32_t> (b1[i]) << 8)
+                     | (static_cast<uint32_t> (b2[i]) << 16)
+                     | (static_cast<uint32_t> (b3[i]) << 24));
+            y[i] = std::bit_cast<float> (previous);
+        }
+        return;
+    }
+    #pragma omp simd
+    for (int i = 0; i < n; ++i)
+    {
+        auto bits = static_cast<uint32_t> (b0[i])
+                 | (static_cast<uint32_t> (b1[i]) << 8)
+                 | (static_cast<uint32_t> (b2[i]) << 16)
+                 | (static_cast<uint32_t> (b3[i]) << 24);
+        y[i] = std::bit_cast<float> (bits);
+    }
+}
+
+}
+#endif
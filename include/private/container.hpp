@@ -0,0 +1,209 @@
+#ifndef SFF_PRIVATE_CONTAINER_HPP
+#define SFF_PRIVATE_CONTAINER_HPP
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/silixa/trace.hpp"
+#include "private/byteSwap.hpp"
+#include "private/fileIO.hpp"
+#include "private/instrumentation.hpp"
+namespace
+{
+
+//----------------------------------------------------------------------------//
+//                              Container Layout                              //
+//----------------------------------------------------------------------------//
+// The lossless and lossy compressed formats share a layout.  The file is
+//   1. The fixed size file header.  This holds the offsets of 3 and 4.
+//   2. The encoded records, i.e., the chunks or channel blocks.
+//   3. The record index.  This is a fixed size entry per record.
+//   4. The channel names.  Each name is a 4 byte length then the name.
+// All values are little endian.
+
+/// @brief Writes a container file.  The header is reserved, the records
+///        are encoded in batches with each batch written while the next
+///        batch is encoded, then the index and channel names are appended.
+///        The header is written last since it holds the index offset.
+/// @param[in] fileName         The name of the file to write.
+/// @param[in,out] header       The file header.  On exit its index and
+///                             channel name offsets are set.  This must
+///                             have indexOffset, namesOffset, and
+///                             pack(char[]).
+/// @param[in] nRecords         The number of records.
+/// @param[in] recordsPerBatch  The number of records encoded before a write
+///                             is issued.
+/// @param[in] nChannels        The number of channels.
+/// @param[in] channelNames     The channel names.  If this is empty then
+///                             the names are blank.
+/// @param[in] encodeBatch      Called as encodeBatch(r0, batch) to encode
+///                             the records [r0, r0 + batch.size()) into
+///                             batch.
+/// @param[in] packEntry        Called as packEntry(r, offset, size, c) to
+///                             pack record r's index entry into c.
+/// @result The size of the file in bytes.
+/// @throws std::runtime_error if the file cannot be written.
+template<size_t HeaderSize, size_t EntrySize,
+         typename Header, typename EncodeBatch, typename PackEntry>
+[[maybe_unused]]
+int64_t writeContainer(const std::string &fileName,
+                       Header &header,
+                       const size_t nRecords,
+                       const size_t recordsPerBatch,
+                       const size_t nChannels,
+                       const std::vector<std::string> &channelNames,
+                       EncodeBatch &&encodeBatch,
+                       PackEntry &&packEntry)
+{
+    constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    auto fd = ::open(fileName.c_str(), flags, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open " + fileName + ": "
+                               + std::strerror(errno));
+    }
+    const bool swap = (testByteOrder() == BIG_ENDIAN);
+    // The index is packed as the batches are encoded
+    std::vector<char> trailer(nRecords*EntrySize, 0);
+    std::array<std::vector<std::vector<char>>, 2> batches;
+    std::future<void> pendingWrite;
+    int64_t fileSize = 0;
+    try
+    {
+        // Reserve the header
+        std::array<char, HeaderSize> headerBytes{};
+        writeAll(fd, headerBytes.data(), headerBytes.size(), fileName);
+        auto offset = static_cast<int64_t> (HeaderSize);
+        for (size_t r0 = 0; r0 < nRecords; r0 = r0 + recordsPerBatch)
+        {
+            auto nBatch = std::min(recordsPerBatch, nRecords - r0);
+            auto &batch = batches[(r0/recordsPerBatch)%2];
+            batch.resize(nBatch);
+            encodeBatch(r0, std::span<std::vector<char>> (batch));
+            for (size_t i = 0; i < nBatch; ++i)
+            {
+                auto size = static_cast<int64_t> (batch[i].size());
+                packEntry(r0 + i, offset, size,
+                          trailer.data() + (r0 + i)*EntrySize);
+                offset = offset + size;
+            }
+            // The other buffer is free once its write finishes
+            if (pendingWrite.valid()){pendingWrite.get();}
+            pendingWrite = std::async(std::launch::async,
+                                      [fd, &batch, &fileName]()
+            {
+                for (const auto &record : batch)
+                {
+                    writeAll(fd, record.data(), record.size(), fileName);
+                }
+            });
+        }
+        if (pendingWrite.valid()){pendingWrite.get();}
+        header.indexOffset = offset;
+        header.namesOffset = offset + static_cast<int64_t> (trailer.size());
+        for (size_t i = 0; i < nChannels; ++i)
+        {
+            std::string name;
+            if (!channelNames.empty()){name = channelNames[i];}
+            std::array<char, 4> length;
+            packInt(static_cast<int32_t> (name.size()), length.data(), swap);
+            trailer.insert(trailer.end(), length.begin(), length.end());
+            trailer.insert(trailer.end(), name.begin(), name.end());
+        }
+        writeAll(fd, trailer.data(), trailer.size(), fileName);
+        header.pack(headerBytes.data());
+        pwriteAll(fd, headerBytes.data(), headerBytes.size(), 0, fileName);
+        fileSize = offset + static_cast<int64_t> (trailer.size());
+        SFF_INSTRUMENT_COUNT(BYTES_WRITTEN, static_cast<size_t> (fileSize));
+    }
+    catch (...)
+    {
+        if (pendingWrite.valid()){pendingWrite.wait();}
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0)
+    {
+        throw std::runtime_error("Failed to close " + fileName + ": "
+                               + std::strerror(errno));
+    }
+    return fileSize;
+}
+
+/// @brief Unpacks the channel names that follow the record index.
+/// @param[in] trailer    The record index and channel names.
+/// @param[in] position   The offset of the names in the trailer.
+/// @param[in] nChannels  The number of channels.
+/// @result The channel names.
+/// @throws std::invalid_argument if the names are truncated or corrupt.
+[[maybe_unused]] [[nodiscard]]
+std::vector<std::string> unpackChannelNames(const std::vector<char> &trailer,
+                                            size_t position,
+                                            const int nChannels)
+{
+    const bool swap = (testByteOrder() == BIG_ENDIAN);
+    std::vector<std::string> names(nChannels);
+    for (auto &name : names)
+    {
+        if (position + 4 > trailer.size())
+        {
+            throw std::invalid_argument("Truncated channel names");
+        }
+        auto length = unpackInt(trailer.data() + position, swap);
+        position = position + 4;
+        if (length < 0 || static_cast<size_t> (length) > trailer.size() - position)
+        {
+            throw std::invalid_argument("Corrupt channel name");
+        }
+        name.assign(trailer.data() + position, length);
+        position = position + static_cast<size_t> (length);
+    }
+    return names;
+}
+
+/// @brief Views the traces of a Silixa trace group as channels named by
+///        their trace numbers.
+/// @param[in] group           The trace group.
+/// @param[out] channels       The samples of each trace.
+/// @param[out] channelNames   The trace number of each trace.
+/// @result The sampling period of the traces in seconds.
+/// @throws std::invalid_argument if there are no traces or the traces have
+///         different sampling periods.
+[[maybe_unused]]
+double getChannels(const SFF::SEGY::Silixa::TraceGroup &group,
+                   std::vector<std::span<const float>> *channels,
+                   std::vector<std::string> *channelNames)
+{
+    auto nTraces = group.getNumberOfTraces();
+    if (nTraces < 1){throw std::invalid_argument("No traces to write");}
+    channels->clear();
+    channelNames->clear();
+    channels->reserve(nTraces);
+    channelNames->reserve(nTraces);
+    auto samplingPeriod = group[0].getSamplingPeriod();
+    for (int i = 0; i < nTraces; ++i)
+    {
+        const auto &trace = group[i];
+        if (std::abs(trace.getSamplingPeriod() - samplingPeriod) > 1.e-7)
+        {
+            throw std::invalid_argument("Trace " + std::to_string(i)
+                                      + " has a different sampling period");
+        }
+        channels->push_back(trace.getDataSpan());
+        channelNames->push_back(std::to_string(trace.getTraceNumber()));
+    }
+    return samplingPeriod;
+}
+
+}
+#endif
@@ -0,0 +1,76 @@
+#ifndef SFF_PRIVATE_COPYTO_HPP
+#define SFF_PRIVATE_COPYTO_HPP
+#include <span>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+namespace
+{
+
+/// @brief Copies x[offset], x[offset + 1], ..., x[offset + count - 1] to
+///        y[0], y[stride], y[2*stride], ... and converts the precision if
+///        necessary.
+/// @param[in] x       The samples to copy.
+/// @param[out] y      The destination.  This must have length at least
+///                    (count - 1)*stride + 1.
+/// @param[in] stride  The distance between consecutive samples in y.
+/// @param[in] offset  The index of the first sample of x to copy.  This
+///                    cannot exceed x.size().
+/// @param[in] count   The number of samples to copy.  If this is
+///                    std::dynamic_extent then the samples from offset to
+///                    the end of x are copied.
+/// @throws std::invalid_argument if stride is not positive, the samples are
+///         not in x, or y is too small.
+template<typename T, typename S>
+void copyToStrided(std::span<const T> x, std::span<S> y,
+                   const size_t stride,
+                   const size_t offset = 0,
+                   const size_t count = std::dynamic_extent)
+{
+    if (stride < 1){throw std::invalid_argument("stride must be positive");}
+    if (offset > x.size())
+    {
+        throw std::invalid_argument("offset = " + std::to_string(offset)
+                                  + " cannot exceed number of samples = "
+                                  + std::to_string(x.size()));
+    }
+    if (count != std::dynamic_extent && count > x.size() - offset)
+    {
+        throw std::invalid_argument("offset + count = "
+                                  + std::to_string(offset) + " + "
+                                  + std::to_string(count)
+                                  + " exceeds number of samples = "
+                                  + std::to_string(x.size()));
+    }
+    x = x.subspan(offset, count);
+    if (x.empty()){return;}
+    auto required = (x.size() - 1)*stride + 1;
+    if (y.size() < required)
+    {
+        throw std::invalid_argument("Destination length = "
+                                  + std::to_string(y.size())
+                                  + " must be at least "
+                                  + std::to_string(required));
+    }
+    auto n = x.size();
+    const T *__restrict__ xPtr = x.data();
+    S *__restrict__ yPtr = y.data();
+    if (stride == 1)
+    {
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i)
+        {
+            yPtr[i] = static_cast<S> (xPtr[i]);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            yPtr[i*stride] = static_cast<S> (xPtr[i]);
+        }
+    }
+}
+
+}
+#endif
@@ -0,0 +1,84 @@
+#ifndef SFF_PRIVATE_FILEIO_HPP
+#define SFF_PRIVATE_FILEIO_HPP
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+namespace
+{
+
+/// @brief Writes all the bytes at the descriptor's position, retrying on
+///        interrupts and partial writes.
+/// @throws std::runtime_error if the write fails.
+[[maybe_unused]]
+void writeAll(const int fd, const char *buffer, size_t nBytes,
+              const std::string &fileName)
+{
+    while (nBytes > 0)
+    {
+        auto nWritten = ::write(fd, buffer, nBytes);
+        if (nWritten < 0)
+        {
+            if (errno == EINTR){continue;}
+            throw std::runtime_error("Failed to write " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        buffer = buffer + nWritten;
+        nBytes = nBytes - static_cast<size_t> (nWritten);
+    }
+}
+
+/// @brief Writes all the bytes beginning at offset without moving the
+///        descriptor's position, retrying on interrupts and partial writes.
+/// @throws std::runtime_error if the write fails.
+[[maybe_unused]]
+void pwriteAll(const int fd, const char *buffer, size_t nBytes,
+               int64_t offset, const std::string &fileName)
+{
+    while (nBytes > 0)
+    {
+        auto nWritten = ::pwrite(fd, buffer, nBytes,
+                                 static_cast<off_t> (offset));
+        if (nWritten < 0)
+        {
+            if (errno == EINTR){continue;}
+            throw std::runtime_error("Failed to write " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        buffer = buffer + nWritten;
+        nBytes = nBytes - static_cast<size_t> (nWritten);
+        offset = offset + nWritten;
+    }
+}
+
+/// @brief Reads all the bytes beginning at offset, retrying on interrupts
+///        and partial reads.  This does not move the descriptor's position
+///        so it is safe to call from multiple threads.
+/// @throws std::runtime_error if the read fails or the file ends first.
+[[maybe_unused]]
+void preadAll(const int fd, char *buffer, size_t nBytes, int64_t offset,
+              const std::string &fileName)
+{
+    while (nBytes > 0)
+    {
+        auto nRead = ::pread(fd, buffer, nBytes, static_cast<off_t> (offset));
+        if (nRead < 0)
+        {
+            if (errno == EINTR){continue;}
+            throw std::runtime_error("Failed to read " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        if (nRead == 0)
+        {
+            throw std::runtime_error("Unexpected end of file " + fileName);
+        }
+        buffer = buffer + nRead;
+        nBytes = nBytes - static_cast<size_t> (nRead);
+        offset = offset + nRead;
+    }
+}
+
+}
+#endif
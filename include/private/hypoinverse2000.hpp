@@ -2,7 +2,11 @@
 #define SFF_PRIVATE_HYPOINVERSE2000_HPP
 #include <cmath>
 #include <array>
+#include <charconv>
+#include <cstdint>
 #include <locale>
+#include <string>
+#include <string_view>
 #include <algorithm>
 namespace
 {
@@ -204,35 +208,54 @@ std::string unpackString(int i1, int i2, const char *stringPtr,
 }
 
 [[maybe_unused]]
-void setString(const int i1, const int i2, const std::string &add,
-               std::string &update)
+void setString(const int i1, const int i2, const std::string_view add,
+               char *update)
 {
     if (add.empty()){return;}
 #ifdef DNDEBUG
     assert(i1 < i2);
-    assert(i2 <= update.size());
 #endif
     auto ncopy = std::min(i2 - i1, static_cast<int> (add.size()));
-    std::copy(add.begin(), add.begin()+ncopy, update.begin()+i1);
+    std::copy(add.begin(), add.begin()+ncopy, update + i1);
 }
 
 [[maybe_unused]]
-void setInteger(const int i1, const int i2, const int value,
-                std::string &update,
+void setString(const int i1, const int i2, const std::string &add,
+               std::string &update)
+{
+#ifdef DNDEBUG
+    assert(i2 <= update.size());
+#endif
+    setString(i1, i2, add, update.data());
+}
+
+/// Writes the integer value to update[i1:i2].  This behaves like sprintf
+/// with a %0Nd format but does not allocate.  When keepLeadingZero is false
+/// the leading zeros are left as whatever is in update (typically blanks).
+[[maybe_unused]]
+void setInteger(const int i1, const int i2, const int64_t value,
+                char *update,
                 const bool keepLeadingZero = true)
 {
 #ifdef DNDEBUG
     assert(i1 < i2);
-    assert(i2 <= update.size());
 #endif
     int len = i2 - i1;
-    std::string cformat = "%0" + std::to_string(i2-i1) + "d";
-    char c16[16];
-    std::fill(c16, c16+16, '\0');
-    sprintf(c16, cformat.c_str(), value);
+    // Format the absolute value then zero pad to the field width
+    char digits[24];
+    auto absValue = value < 0 ? static_cast<uint64_t> (0) - static_cast<uint64_t> (value) :
+                                static_cast<uint64_t> (value);
+    auto nDigits = static_cast<int>
+                   (std::to_chars(digits, digits + 24, absValue).ptr - digits);
+    int nSign = value < 0 ? 1 : 0;
+    char c32[32];
+    auto width = std::max(len, nSign + nDigits);
+    std::fill(c32, c32 + width, '0');
+    if (value < 0){c32[0] = '-';}
+    std::copy(digits, digits + nDigits, c32 + width - nDigits);
     if (keepLeadingZero)
     {
-        std::copy(c16, c16 + len, update.begin() + i1);
+        std::copy(c32, c32 + len, update + i1);
     }
     else
     {
@@ -240,7 +263,7 @@ void setInteger(const int i1, const int i2, const int value,
         bool lAllZero = true;
         for (int i = 0; i < len; ++i)
         {
-            if (c16[i] != '0' && c16[i] != '-')
+            if (c32[i] != '0' && c32[i] != '-')
             {
                 j = i;
                 lAllZero = false;
@@ -251,31 +274,30 @@ void setInteger(const int i1, const int i2, const int value,
         if (value < 0 && j > 0)
         {
             j = j - 1;
-            c16[j] = '-';
+            c32[j] = '-';
         }
         if (!lAllZero)
         {
-            std::copy(c16 + j, c16 + len, update.begin() + i1 + j);
+            std::copy(c32 + j, c32 + len, update + i1 + j);
         }
         else
         {
             update[i2-1] = '0';
         }
     }
-    /*
-    char cvalue[10];
-    // Copy each digit
-    auto approxValue = 0;
-    for (int i = 0; i < len; ++i)
-    {
-        auto digit = static_cast<int> (value/std::pow(10, i));
-        auto c = std::to_string(digit);
-        cvalue[len-1-i] = c[0];
-        update[i2-1-i] = c[0];
-    }
-    std::cout << cvalue << std::endl;
-     */
 }
+
+[[maybe_unused]]
+void setInteger(const int i1, const int i2, const int64_t value,
+                std::string &update,
+                const bool keepLeadingZero = true)
+{
+#ifdef DNDEBUG
+    assert(i2 <= update.size());
+#endif
+    setInteger(i1, i2, value, update.data(), keepLeadingZero);
+}
+
 [[maybe_unused]] std::pair<bool, std::string>
 unpackStringPair(int i1, int i2, const char *stringPtr, const int maxLen)
 {
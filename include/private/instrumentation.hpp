@@ -0,0 +1,53 @@
+#ifndef SFF_PRIVATE_INSTRUMENTATION_HPP
+#define SFF_PRIVATE_INSTRUMENTATION_HPP
+#include <chrono>
+#include <cstdint>
+#include "sff/utilities/instrumentation.hpp"
+/// Probes for the read and write paths.  When the library is compiled
+/// without SFF_INSTRUMENTATION the macros expand to nothing and their
+/// arguments are not evaluated.
+namespace SFF::Utilities::Instrumentation
+{
+/// @brief Adds to a counter.
+void increment(Counter counter, uint64_t value) noexcept;
+/// @brief Adds to a timer.
+void addElapsedTime(Timer timer, std::chrono::nanoseconds elapsed) noexcept;
+/// @brief Accumulates the time between construction and destruction.
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const Timer timer) noexcept :
+        mStart(std::chrono::steady_clock::now()),
+        mTimer(timer)
+    {
+    }
+    ~ScopedTimer()
+    {
+        addElapsedTime(mTimer, std::chrono::steady_clock::now() - mStart);
+    }
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer& operator=(const ScopedTimer &) = delete;
+private:
+    std::chrono::steady_clock::time_point mStart;
+    Timer mTimer;
+};
+}
+
+#define SFF_INSTRUMENT_CONCATENATE_(a, b) a##b
+#define SFF_INSTRUMENT_CONCATENATE(a, b) SFF_INSTRUMENT_CONCATENATE_(a, b)
+#ifdef SFF_INSTRUMENTATION
+/// Times the rest of the enclosing scope
+#define SFF_INSTRUMENT_SCOPE(timer) \
+    const SFF::Utilities::Instrumentation::ScopedTimer \
+        SFF_INSTRUMENT_CONCATENATE(sffScopedTimer, __LINE__) \
+        (SFF::Utilities::Instrumentation::Timer::timer)
+/// Adds value to the counter
+#define SFF_INSTRUMENT_COUNT(counter, value) \
+    SFF::Utilities::Instrumentation::increment( \
+        SFF::Utilities::Instrumentation::Counter::counter, \
+        static_cast<uint64_t> (value))
+#else
+#define SFF_INSTRUMENT_SCOPE(timer)
+#define SFF_INSTRUMENT_COUNT(counter, value) static_cast<void> (0)
+#endif
+#endif
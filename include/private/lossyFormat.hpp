@@ -0,0 +1,405 @@
+#ifndef SFF_PRIVATE_LOSSYFORMAT_HPP
+#define SFF_PRIVATE_LOSSYFORMAT_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "sff/compressed/enums.hpp"
+#include "private/byteSwap.hpp"
+namespace
+{
+
+//----------------------------------------------------------------------------//
+//                                File Layout                                 //
+//----------------------------------------------------------------------------//
+// All values are little endian.  The file is
+//   1. The 80 byte file header.
+//   2. The encoded channel blocks.
+//   3. The block index.  This is 16 bytes per block.
+//   4. The channel names.  Each name is a 4 byte length then the name.
+//
+// The file header is
+//   [0,4)   "SFFL"
+//   [4,8)   The format version
+//   [8]     The predictor
+//   [9]     The error bound type
+//   [12,16) The number of channels in a block
+//   [16,20) The number of channels
+//   [24,32) The number of samples in each channel
+//   [32,40) The sampling period in seconds
+//   [40,48) The start time as seconds since the epoch
+//   [48,56) The absolute error bound
+//   [56,64) The tolerance given to the writer
+//   [64,72) The offset of the block index
+//   [72,80) The offset of the channel names
+//
+// An index entry is
+//   [0,8)   The block's offset
+//   [8,16)  The block's size
+//
+// A block is
+//   [0,4)   The number of unpredictable samples
+//   The unpredictable samples as float32
+//   The residual codes of the block's channels, one channel after the
+//   other, packed in groups of LOSSY_GROUP_SIZE codes.  Each group is the
+//   bit width of its largest code followed by the codes packed with that
+//   width.
+
+constexpr std::array<char, 4> LOSSY_MAGIC{'S', 'F', 'F', 'L'};
+constexpr int32_t LOSSY_VERSION = 1;
+constexpr size_t LOSSY_HEADER_SIZE = 80;
+constexpr size_t LOSSY_INDEX_ENTRY_SIZE = 16;
+constexpr int LOSSY_GROUP_SIZE = 64;
+/// Residuals at least this large are stored as unpredictable samples
+constexpr int64_t LOSSY_MAX_RESIDUAL = (int64_t {1} << 30) - 1;
+/// Quantized values at least this large are not exactly representable
+constexpr double LOSSY_MAX_QUANTUM = 4503599627370496.0; // 2^52
+
+/// The file header
+struct LossyFileHeader
+{
+    /// Packs the header into 80 bytes
+    void pack(char c[]) const
+    {
+        const bool swap = (testByteOrder() == BIG_ENDIAN);
+        std::fill(c, c + LOSSY_HEADER_SIZE, 0);
+        std::copy(LOSSY_MAGIC.begin(), LOSSY_MAGIC.end(), c);
+        packInt(LOSSY_VERSION, &c[4], swap);
+        c[8] = static_cast<char> (predictor);
+        c[9] = static_cast<char> (errorBound);
+        packInt(channelBlockSize, &c[12], swap);
+        packInt(nChannels, &c[16], swap);
+        packLong(nSamples, &c[24], swap);
+        packDouble(samplingPeriod, &c[32], swap);
+        packDouble(startTime, &c[40], swap);
+        packDouble(absoluteError, &c[48], swap);
+        packDouble(tolerance, &c[56], swap);
+        packLong(indexOffset, &c[64], swap);
+        packLong(namesOffset, &c[72], swap);
+    }
+    /// Unpacks and checks the header from 80 bytes
+    void unpack(const char c[])
+    {
+        const bool swap = (testByteOrder() == BIG_ENDIAN);
+        if (!std::equal(LOSSY_MAGIC.begin(), LOSSY_MAGIC.end(), c))
+        {
+            throw std::invalid_argument("Not an sff lossy compressed file");
+        }
+        auto version = unpackInt(&c[4], swap);
+        if (version != LOSSY_VERSION)
+        {
+            throw std::invalid_argument("Unsupported lossy file version "
+                                      + std::to_string(version));
+        }
+        auto predictorValue = static_cast<uint8_t> (c[8]);
+        auto errorBoundValue = static_cast<uint8_t> (c[9]);
+        if (predictorValue > 1 || errorBoundValue > 1)
+        {
+            throw std::invalid_argument("Unknown predictor or error bound");
+        }
+        predictor = static_cast<SFF::Compressed::Predictor> (predictorValue);
+        errorBound = static_cast<SFF::Compressed::ErrorBound> (errorBoundValue);
+        channelBlockSize = unpackInt(&c[12], swap);
+        nChannels = unpackInt(&c[16], swap);
+        nSamples = unpackLong(&c[24], swap);
+        samplingPeriod = unpackDouble(&c[32], swap);
+        startTime = unpackDouble(&c[40], swap);
+        absoluteError = unpackDouble(&c[48], swap);
+        tolerance = unpackDouble(&c[56], swap);
+        indexOffset = unpackLong(&c[64], swap);
+        namesOffset = unpackLong(&c[72], swap);
+        if (channelBlockSize < 1 || nChannels < 1 || nSamples < 1 ||
+            !(samplingPeriod > 0) || !(absoluteError > 0) ||
+            !std::isfinite(absoluteError) || indexOffset < 0 ||
+            namesOffset < 0)
+        {
+            throw std::invalid_argument("Corrupt lossy file header");
+        }
+    }
+    SFF::Compressed::Predictor predictor{SFF::Compressed::Predictor::LORENZO};
+    SFF::Compressed::ErrorBound errorBound{SFF::Compressed::ErrorBound::ABSOLUTE};
+    int64_t nSamples{0};
+    int64_t indexOffset{0};
+    int64_t namesOffset{0};
+    double samplingPeriod{0};
+    double startTime{0};
+    double absoluteError{0};
+    double tolerance{0};
+    int32_t channelBlockSize{0};
+    int32_t nChannels{0};
+};
+
+//----------------------------------------------------------------------------//
+//                                Quantization                                //
+//----------------------------------------------------------------------------//
+// Each sample is first quantized to an integer multiple of twice the error
+// bound.  The integers are then predicted from their neighbors and the
+// residuals are coded.  Since the prediction is done exactly in integer
+// arithmetic the decoder reproduces the encoder's reconstruction on any
+// machine and the error does not accumulate.
+
+/// @result The quantized value of x.  Values that cannot be quantized map
+///         to 0 so that the encoder and decoder agree on the predictor.
+[[nodiscard]] inline int64_t quantize(const float x, const double step) noexcept
+{
+    auto scaled = static_cast<double> (x)/step;
+    if (!(std::abs(scaled) < LOSSY_MAX_QUANTUM)){return 0;}
+    return std::llround(scaled);
+}
+
+/// @result The sample corresponding to a quantized value.
+[[nodiscard]] inline float dequantize(const int64_t k, const double step) noexcept
+{
+    return static_cast<float> (static_cast<double> (k)*step);
+}
+
+/// @result The prediction of the quantized value at time t of a channel.
+///         previous is the preceding channel's quantized values or NULL.
+[[nodiscard]] inline int64_t predict(const SFF::Compressed::Predictor predictor,
+                                     const int64_t current[],
+                                     const int64_t previous[],
+                                     const int64_t t) noexcept
+{
+    auto left = t > 0 ? current[t - 1] : 0;
+    if (predictor == SFF::Compressed::Predictor::TIME || previous == nullptr)
+    {
+        return left;
+    }
+    auto above = previous[t];
+    auto corner = t > 0 ? previous[t - 1] : 0;
+    return left + above - corner;
+}
+
+/// Packs unsigned codes in groups
+class GroupPacker
+{
+public:
+    explicit GroupPacker(std::vector<char> &output) :
+        mOutput(output)
+    {
+    }
+    void push(const uint32_t code)
+    {
+        mCodes[mCount] = code;
+        mCount = mCount + 1;
+        if (mCount == LOSSY_GROUP_SIZE){flush();}
+    }
+    void flush()
+    {
+        if (mCount == 0){return;}
+        uint32_t largest = 0;
+        for (int i = 0; i < mCount; ++i){largest = largest | mCodes[i];}
+        auto width = static_cast<int> (std::bit_width(largest));
+        mOutput.push_back(static_cast<char> (width));
+        uint64_t accumulator = 0;
+        int nBits = 0;
+        for (int i = 0; i < mCount && width > 0; ++i)
+        {
+            accumulator = accumulator | (static_cast<uint64_t> (mCodes[i]) << nBits);
+            nBits = nBits + width;
+            while (nBits >= 8)
+            {
+                mOutput.push_back(static_cast<char> (accumulator & 0xFF));
+                accumulator = accumulator >> 8;
+                nBits = nBits - 8;
+            }
+        }
+        if (nBits > 0){mOutput.push_back(static_cast<char> (accumulator));}
+        mCount = 0;
+    }
+private:
+    std::vector<char> &mOutput;
+    std::array<uint32_t, LOSSY_GROUP_SIZE> mCodes{};
+    int mCount{0};
+};
+
+/// Unpacks the codes written by GroupPacker
+class GroupUnpacker
+{
+public:
+    GroupUnpacker(const char *input, const size_t nBytes) :
+        mInput(reinterpret_cast<const uint8_t *> (input)),
+        mBytes(nBytes)
+    {
+    }
+    /// Unpacks the next n codes
+    void unpack(const int n, uint32_t codes[])
+    {
+        if (mPosition >= mBytes)
+        {
+            throw std::runtime_error("Truncated lossy block");
+        }
+        auto width = static_cast<int> (mInput[mPosition]);
+        mPosition = mPosition + 1;
+        if (width > 32){throw std::runtime_error("Corrupt lossy block");}
+        if (width == 0)
+        {
+            std::fill(codes, codes + n, 0);
+            return;
+        }
+        auto nGroupBytes = (static_cast<size_t> (n)*width + 7)/8;
+        if (nGroupBytes > mBytes - mPosition)
+        {
+            throw std::runtime_error("Truncated lossy block");
+        }
+        const uint64_t mask = (uint64_t {1} << width) - 1;
+        const auto bytes = mInput + mPosition;
+        uint64_t accumulator = 0;
+        int nBits = 0;
+        size_t next = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            while (nBits < width)
+            {
+                accumulator = accumulator
+                            | (static_cast<uint64_t> (bytes[next]) << nBits);
+                next = next + 1;
+                nBits = nBits + 8;
+            }
+            codes[i] = static_cast<uint32_t> (accumulator & mask);
+            accumulator = accumulator >> width;
+            nBits = nBits - width;
+        }
+        mPosition = mPosition + nGroupBytes;
+    }
+    [[nodiscard]] size_t position() const noexcept{return mPosition;}
+private:
+    const uint8_t *mInput{nullptr};
+    size_t mBytes{0};
+    size_t mPosition{0};
+};
+
+/// @brief Encodes a block of channels.
+/// @param[in] channels       The channels in the block.
+/// @param[in] absoluteError  The largest allowable error.
+/// @param[out] block         The encoded block.
+/// @result The largest error of the reconstructed samples.
+[[maybe_unused]]
+double encodeBlock(const SFF::Compressed::Predictor predictor,
+                   const std::span<const std::span<const float>> channels,
+                   const double absoluteError,
+                   std::vector<char> &block)
+{
+    const bool swap = (testByteOrder() == BIG_ENDIAN);
+    const auto step = 2*absoluteError;
+    const auto nSamples = static_cast<int64_t> (channels[0].size());
+    std::vector<int64_t> previous(nSamples);
+    std::vector<int64_t> current(nSamples);
+    std::vector<char> unpredictable;
+    std::vector<char> codes;
+    codes.reserve(nSamples*channels.size()/2);
+    GroupPacker packer(codes);
+    double maxError = 0;
+    for (size_t c = 0; c < channels.size(); ++c)
+    {
+        const auto x = channels[c].data();
+        const auto above = (c > 0) ? previous.data() : nullptr;
+        for (int64_t t = 0; t < nSamples; ++t)
+        {
+            auto k = quantize(x[t], step);
+            auto residual = k - predict(predictor, current.data(), above, t);
+            auto error = std::abs(static_cast<double> (dequantize(k, step))
+                                - static_cast<double> (x[t]));
+            if (std::abs(residual) <= LOSSY_MAX_RESIDUAL &&
+                error <= absoluteError)
+            {
+                // Zig-zag so small residuals have small codes; 0 flags an
+                // unpredictable sample
+                auto zigzag = static_cast<uint32_t> ((residual << 1)
+                                                   ^ (residual >> 63));
+                packer.push(zigzag + 1);
+                maxError = std::max(maxError, error);
+            }
+            else
+            {
+                packer.push(0);
+                std::array<char, 4> bytes;
+                packFloat(x[t], bytes.data(), swap);
+                unpredictable.insert(unpredictable.end(),
+                                     bytes.begin(), bytes.end());
+            }
+            current[t] = k;
+        }
+        packer.flush();
+        std::swap(previous, current);
+    }
+    block.resize(4);
+    packInt(static_cast<int32_t> (unpredictable.size()/4), block.data(), swap);
+    block.insert(block.end(), unpredictable.begin(), unpredictable.end());
+    block.insert(block.end(), codes.begin(), codes.end());
+    return maxError;
+}
+
+/// @brief Decodes the first nDecode channels of a block.
+/// @param[out] y  The nDecode channels.  A NULL channel is decoded but not
+///                returned.
+[[maybe_unused]]
+void decodeBlock(const SFF::Compressed::Predictor predictor,
+                 const char bytes[], const size_t nBytes,
+                 const int nDecode, const int64_t nSamples,
+                 const double absoluteError,
+                 float *const y[])
+{
+    const bool swap = (testByteOrder() == BIG_ENDIAN);
+    const auto step = 2*absoluteError;
+    if (nBytes < 4){throw std::runtime_error("Truncated lossy block");}
+    auto nUnpredictable = static_cast<size_t> (unpackInt(bytes, swap));
+    if (nUnpredictable > (nBytes - 4)/4)
+    {
+        throw std::runtime_error("Corrupt lossy block");
+    }
+    const char *unpredictable = bytes + 4;
+    size_t nextUnpredictable = 0;
+    auto codesOffset = 4 + 4*nUnpredictable;
+    GroupUnpacker unpacker(bytes + codesOffset, nBytes - codesOffset);
+    std::vector<int64_t> previous(nSamples);
+    std::vector<int64_t> current(nSamples);
+    std::array<uint32_t, LOSSY_GROUP_SIZE> codes;
+    for (int c = 0; c < nDecode; ++c)
+    {
+        const auto above = (c > 0) ? previous.data() : nullptr;
+        auto yc = y[c];
+        for (int64_t t0 = 0; t0 < nSamples; t0 = t0 + LOSSY_GROUP_SIZE)
+        {
+            auto n = static_cast<int> (std::min<int64_t> (LOSSY_GROUP_SIZE,
+                                                          nSamples - t0));
+            unpacker.unpack(n, codes.data());
+            for (int i = 0; i < n; ++i)
+            {
+                auto t = t0 + i;
+                int64_t k;
+                float value;
+                if (codes[i] == 0)
+                {
+                    if (nextUnpredictable == nUnpredictable)
+                    {
+                        throw std::runtime_error("Corrupt lossy block");
+                    }
+                    value = unpackFloat(unpredictable + 4*nextUnpredictable,
+                                        swap);
+                    nextUnpredictable = nextUnpredictable + 1;
+                    k = quantize(value, step);
+                }
+                else
+                {
+                    auto zigzag = static_cast<int64_t> (codes[i] - 1);
+                    auto residual = (zigzag >> 1) ^ -(zigzag & 1);
+                    k = predict(predictor, current.data(), above, t) + residual;
+                    value = dequantize(k, step);
+                }
+                current[t] = k;
+                if (yc != nullptr){yc[t] = value;}
+            }
+        }
+        std::swap(previous, current);
+    }
+}
+
+}
+#endif
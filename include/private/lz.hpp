@@ -0,0 +1,265 @@
+#ifndef SFF_PRIVATE_LZ_HPP
+#define SFF_PRIVATE_LZ_HPP
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+namespace
+{
+
+//----------------------------------------------------------------------------//
+//                                 LZ Codec                                   //
+//----------------------------------------------------------------------------//
+// A byte oriented LZ77 codec in the style of LZ4.  A block is a sequence of
+// tokens.  Each token's high nibble is the number of literals and its low
+// nibble is the match length minus LZ_MIN_MATCH.  A nibble of 15 is
+// extended by bytes that are summed until a byte other than 255 is read.
+// The literals follow the literal length and the match is described by a
+// 2 byte little endian offset then the match length extension.  The last
+// token only has literals.
+
+/// The shortest match
+constexpr size_t LZ_MIN_MATCH = 4;
+/// The last LZ_LAST_LITERALS bytes of a block are always literals
+constexpr size_t LZ_LAST_LITERALS = 5;
+/// A match cannot begin in the last LZ_MATCH_FIND_LIMIT bytes of a block
+constexpr size_t LZ_MATCH_FIND_LIMIT = 12;
+/// The farthest a match may look back
+constexpr size_t LZ_MAX_OFFSET = 65535;
+/// log2 of the number of hash table entries
+constexpr int LZ_HASH_LOG = 12;
+
+[[nodiscard]] inline uint32_t lzRead32(const uint8_t *p) noexcept
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(uint32_t));
+    return value;
+}
+
+[[nodiscard]] inline uint32_t lzHash(const uint32_t value) noexcept
+{
+    return (value*2654435761U) >> (32 - LZ_HASH_LOG);
+}
+
+/// Writes a length extension
+[[nodiscard]] inline uint8_t *lzWriteLength(uint8_t *op, size_t length) noexcept
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length = length - 255;
+    }
+    *op++ = static_cast<uint8_t> (length);
+    return op;
+}
+
+/// @result The largest compressed size of an nBytes block.
+[[maybe_unused]] [[nodiscard]]
+size_t lzCompressBound(const size_t nBytes) noexcept
+{
+    return nBytes + nBytes/255 + 16;
+}
+
+/// @brief Compresses a block.
+/// @param[in] input      The bytes to compress.
+/// @param[in] nBytes     The number of bytes to compress.
+/// @param[out] output    The compressed block.  This must have dimension
+///                       of at least capacity.
+/// @param[in] capacity   The size of output.
+/// @result The size of the compressed block or 0 if the block would not
+///         fit in capacity bytes.
+[[maybe_unused]] [[nodiscard]]
+size_t lzCompress(const char *input, const size_t nBytes,
+                  char *output, const size_t capacity) noexcept
+{
+    const auto src = reinterpret_cast<const uint8_t *> (input);
+    auto op = reinterpret_cast<uint8_t *> (output);
+    const auto opEnd = op + capacity;
+    size_t anchor = 0;
+    // Emits the literals [anchor, end) followed by an optional match
+    auto emit = [&](const size_t end, const size_t offset,
+                    const size_t matchLength) -> bool
+    {
+        auto nLiterals = end - anchor;
+        auto nWorst = 1 + nLiterals + nLiterals/255 + 1
+                    + 2 + matchLength/255 + 1;
+        if (static_cast<size_t> (opEnd - op) < nWorst){return false;}
+        auto token = op++;
+        *token = static_cast<uint8_t> (std::min<size_t> (nLiterals, 15) << 4);
+        if (nLiterals >= 15){op = lzWriteLength(op, nLiterals - 15);}
+        std::memcpy(op, src + anchor, nLiterals);
+        op = op + nLiterals;
+        if (matchLength == 0){return true;}
+        *op++ = static_cast<uint8_t> (offset & 0xFF);
+        *op++ = static_cast<uint8_t> (offset >> 8);
+        auto length = matchLength - LZ_MIN_MATCH;
+        *token = *token | static_cast<uint8_t> (std::min<size_t> (length, 15));
+        if (length >= 15){op = lzWriteLength(op, length - 15);}
+        return true;
+    };
+    if (nBytes > LZ_MATCH_FIND_LIMIT)
+    {
+        std::array<uint32_t, (1 << LZ_HASH_LOG)> table{};
+        const auto findLimit = nBytes - LZ_MATCH_FIND_LIMIT;
+        const auto matchLimit = nBytes - LZ_LAST_LITERALS;
+        size_t ip = 0;
+        size_t nMisses = 0;
+        while (ip < findLimit)
+        {
+            auto sequence = lzRead32(src + ip);
+            auto &entry = table[lzHash(sequence)];
+            size_t reference = entry;
+            entry = static_cast<uint32_t> (ip);
+            if (reference >= ip || ip - reference > LZ_MAX_OFFSET ||
+                lzRead32(src + reference) != sequence)
+            {
+                // Skip faster through incompressible regions
+                ip = ip + 1 + (nMisses >> 6);
+                nMisses = nMisses + 1;
+                continue;
+            }
+            nMisses = 0;
+            auto length = LZ_MIN_MATCH;
+            while (ip + length < matchLimit &&
+                   src[reference + length] == src[ip + length])
+            {
+                length = length + 1;
+            }
+            while (ip > anchor && reference > 0 &&
+                   src[ip - 1] == src[reference - 1])
+            {
+                ip = ip - 1;
+                reference = reference - 1;
+                length = length + 1;
+            }
+            if (!emit(ip, ip - reference, length)){return 0;}
+            ip = ip + length;
+            anchor = ip;
+            if (ip - 2 < findLimit)
+            {
+                table[lzHash(lzRead32(src + ip - 2))]
+                    = static_cast<uint32_t> (ip - 2);
+            }
+        }
+    }
+    if (!emit(nBytes, 0, 0)){return 0;}
+    return static_cast<size_t> (op - reinterpret_cast<uint8_t *> (output));
+}
+
+/// @brief Decompresses a block.
+/// @param[in] input     The compressed block.
+/// @param[in] nBytes    The size of the compressed block.
+/// @param[out] output   The decompressed bytes.  This has dimension
+///                      [nOutput].
+/// @param[in] nOutput   The expected size of the decompressed block.
+/// @throws std::runtime_error if the block is corrupt or does not
+///         decompress to exactly nOutput bytes.
+[[maybe_unused]]
+void lzDecompress(const char *input, const size_t nBytes,
+                  char *output, const size_t nOutput)
+{
+    const auto src = reinterpret_cast<const uint8_t *> (input);
+    const auto dst = reinterpret_cast<uint8_t *> (output);
+    size_t ip = 0;
+    size_t op = 0;
+    auto readLength = [&](size_t length) -> size_t
+    {
+        uint8_t byte = 255;
+        while (byte == 255)
+        {
+            if (ip >= nBytes)
+            {
+                throw std::runtime_error("Truncated compressed block");
+            }
+            byte = src[ip++];
+            length = length + byte;
+        }
+        return length;
+    };
+    while (true)
+    {
+        if (ip >= nBytes){throw std::runtime_error("Truncated compressed block");}
+        auto token = src[ip++];
+        size_t nLiterals = token >> 4;
+        if (nLiterals == 15){nLiterals = readLength(nLiterals);}
+        if (nLiterals > nBytes - ip || nLiterals > nOutput - op)
+        {
+            throw std::runtime_error("Corrupt compressed block literals");
+        }
+        if (nLiterals <= 16 && nBytes - ip >= 16 && nOutput - op >= 16)
+        {
+            // Short literal runs dominate so copy a fixed 16 bytes
+            std::memcpy(dst + op, src + ip, 16);
+        }
+        else
+        {
+            std::memcpy(dst + op, src + ip, nLiterals);
+        }
+        ip = ip + nLiterals;
+        op = op + nLiterals;
+        if (ip == nBytes){break;}
+        if (nBytes - ip < 2)
+        {
+            throw std::runtime_error("Truncated compressed block");
+        }
+        size_t offset = src[ip] | (static_cast<size_t> (src[ip + 1]) << 8);
+        ip = ip + 2;
+        if (offset == 0 || offset > op)
+        {
+            throw std::runtime_error("Corrupt compressed block offset");
+        }
+        size_t length = token & 15;
+        if (length == 15){length = readLength(length);}
+        length = length + LZ_MIN_MATCH;
+        if (length > nOutput - op)
+        {
+            throw std::runtime_error("Corrupt compressed block match");
+        }
+        auto reference = dst + op - offset;
+        auto destination = dst + op;
+        if (offset >= 16 && length <= 16 && nOutput - op >= 16)
+        {
+            std::memcpy(destination, reference, 16);
+        }
+        else if (op + length + 8 <= nOutput)
+        {
+            // Runs, e.g., of zeros, have short offsets.  The first bytes are
+            // copied one at a time until the pattern repeats over a period
+            // of at least 8 bytes.  Then every 8 byte word is read from bytes
+            // that were already written.
+            size_t period = offset;
+            size_t i = 0;
+            if (offset < 8)
+            {
+                period = offset*((8 + offset - 1)/offset);
+                for (; i < std::min(period, length); ++i)
+                {
+                    destination[i] = reference[i];
+                }
+            }
+            for (; i < length; i = i + 8)
+            {
+                std::memcpy(destination + i, destination + i - period, 8);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                destination[i] = reference[i];
+            }
+        }
+        op = op + length;
+    }
+    if (op != nOutput)
+    {
+        throw std::runtime_error("Compressed block decompressed to "
+                               + std::to_string(op) + " bytes; expected "
+                               + std::to_string(nOutput));
+    }
+}
+
+}
+#endif
@@ -0,0 +1,62 @@
+#ifndef SFF_PRIVATE_PARALLELFOR_HPP
+#define SFF_PRIVATE_PARALLELFOR_HPP
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+namespace
+{
+
+/// @brief Evaluates task(i) for i = 0, 1, ..., n - 1 on a pool of threads.
+///        The threads pull the next index from a shared counter so that
+///        tasks of uneven cost, e.g., files of different sizes, balance.
+/// @param[in] n         The number of tasks.
+/// @param[in] nThreads  The number of threads.  If this is not positive
+///                      then the hardware concurrency is used.  The calling
+///                      thread is one of the workers.
+/// @param[in] task      The task to evaluate.
+/// @throws The exception raised by the task with the smallest index is
+///         rethrown after all tasks have finished.
+template<typename Task>
+[[maybe_unused]]
+void forEachInParallel(const int n, const int nThreads, Task &&task)
+{
+    if (n < 1){return;}
+    int nWorkers = nThreads;
+    if (nWorkers < 1)
+    {
+        nWorkers = static_cast<int> (std::thread::hardware_concurrency());
+    }
+    nWorkers = std::max(1, std::min(nWorkers, n));
+    std::vector<std::exception_ptr> errors(n, nullptr);
+    std::atomic<int> next{0};
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            auto i = next.fetch_add(1);
+            if (i >= n){break;}
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers - 1);
+    for (int i = 1; i < nWorkers; ++i){threads.emplace_back(worker);}
+    worker();
+    for (auto &thread : threads){thread.join();}
+    for (const auto &error : errors)
+    {
+        if (error){std::rethrow_exception(error);}
+    }
+}
+
+}
+#endif
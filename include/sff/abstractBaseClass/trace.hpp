@@ -2,6 +2,8 @@
 #define SFF_ABSTRACTBASECLASS_TRACE_HPP
 #include <memory>
 #include <vector>
+#include <span>
+#include <cstddef>
 #include "sff/utilities/time.hpp"
 #include "sff/formats.hpp"
 namespace SFF::AbstractBaseClass
@@ -20,6 +22,36 @@ public:
     virtual void getData(int npts, double *data[]) const = 0;
     virtual void getData(int npts, float *data[]) const = 0;
     //virtual void getData(int npts, int *data[]) const = 0;
+    /// @result A view of the time series samples whose length is
+    ///         \c getNumberOfSamples().  This is invalidated when the samples
+    ///         are modified.  Only the getter that matches \c getPrecision()
+    ///         succeeds; use \c copyTo() to convert the precision.
+    /// @throws std::runtime_error if the precision does not match.
+    virtual std::span<const double> getDataSpan64f() const = 0;
+    virtual std::span<const float>  getDataSpan32f() const = 0;
+    virtual std::span<const int>    getDataSpan32i() const = 0;
+    /// @brief Copies the samples offset, offset + 1, ..., offset + count - 1
+    ///        of the time series to destination[0], destination[stride],
+    ///        destination[2*stride], ..., e.g., into a column of a row major
+    ///        matrix.  The samples are converted to the destination precision.
+    /// @param[out] destination  The destination.  This must have length at
+    ///                          least (count - 1)*stride + 1.
+    /// @param[in] stride        The distance between consecutive samples in
+    ///                          destination.
+    /// @param[in] offset        The index of the first sample to copy.
+    /// @param[in] count         The number of samples to copy.  By default
+    ///                          the samples from offset to the end of the
+    ///                          time series are copied.
+    /// @throws std::invalid_argument if stride is not positive, offset + count
+    ///         exceeds \c getNumberOfSamples(), or destination is too small.
+    virtual void copyTo(std::span<double> destination, size_t stride = 1,
+                        size_t offset = 0,
+                        size_t count = std::dynamic_extent) const = 0;
+    virtual void copyTo(std::span<float> destination, size_t stride = 1,
+                        size_t offset = 0,
+                        size_t count = std::dynamic_extent) const = 0;
+    /// @result The precision of the underlying time series samples.
+    virtual SFF::Precision getPrecision() const = 0;
     virtual SFF::Utilities::Time getStartTime() const = 0;
     virtual SFF::Format getFormat() const noexcept = 0;
 };
@@ -0,0 +1,45 @@
+#ifndef SFF_COMPRESSED_ENUMS_HPP
+#define SFF_COMPRESSED_ENUMS_HPP
+namespace SFF::Compressed
+{
+/// @brief Defines the reversible transform applied to each chunk of samples
+///        prior to compression.  The transforms rearrange the bits of the
+///        float32 samples so that the redundant bytes, e.g., the sign and
+///        exponent, are adjacent and the LZ codec can find long matches.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+enum class Transform
+{
+    NONE = 0,          /*!< The samples are compressed as is. */
+    BYTE_SHUFFLE = 1,  /*!< The i'th byte of every sample in the chunk is
+                            stored before the (i+1)'th byte. */
+    XOR_DELTA = 2      /*!< Each sample's bits are exclusive or'd with the
+                            previous sample's bits and then byte shuffled.
+                            This works well for smooth, oversampled data. */
+};
+/// @brief Defines how the error tolerance of the lossy compressor is
+///        interpreted.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+enum class ErrorBound
+{
+    ABSOLUTE = 0,  /*!< The tolerance is the largest allowable difference
+                        between a sample and its reconstruction in the
+                        samples' units, e.g., strain rate. */
+    RELATIVE = 1   /*!< The tolerance is a fraction of the data's range, i.e.,
+                        the absolute error bound is the tolerance times the
+                        difference of the largest and smallest samples. */
+};
+/// @brief Defines how the lossy compressor predicts a sample from the
+///        samples that have already been coded.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+enum class Predictor
+{
+    LORENZO = 0,  /*!< The Lorenzo predictor over the [channel x time] grid,
+                       i.e., x[c][t-1] + x[c-1][t] - x[c-1][t-1].  This
+                       exploits the spatial coherence of adjacent DAS
+                       channels. */
+    TIME = 1      /*!< The previous sample of the channel, i.e., x[c][t-1].
+                       This is better when adjacent channels are
+                       incoherent. */
+};
+}
+#endif
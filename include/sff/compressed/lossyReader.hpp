@@ -0,0 +1,135 @@
+#ifndef SFF_COMPRESSED_LOSSYREADER_HPP
+#define SFF_COMPRESSED_LOSSYREADER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "sff/compressed/enums.hpp"
+#include "sff/utilities/time.hpp"
+namespace SFF::Compressed
+{
+/// @class LossyReader lossyReader.hpp "sff/compressed/lossyReader.hpp"
+/// @brief Reads files written by SFF::Compressed::LossyWriter.
+/// @details Opening the file reads only the file header, block index, and
+///          channel names.  Since a channel is predicted from the preceding
+///          channels of its block, reading a channel decodes its block up
+///          to and including the channel.  The reads use pread so a const
+///          reader may be shared by many threads.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class LossyReader
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    LossyReader();
+    /// @brief Copy constructor.  The copy holds its own file descriptor.
+    /// @param[in] reader  The reader from which to initialize this class.
+    LossyReader(const LossyReader &reader);
+    /// @brief Move constructor.
+    /// @param[in,out] reader  The reader from which to initialize this class.
+    ///                        On exit, reader's behavior is undefined.
+    LossyReader(LossyReader &&reader) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] reader  The reader to copy to this.
+    /// @result A copy of the reader with its own file descriptor.
+    LossyReader& operator=(const LossyReader &reader);
+    /// @brief Move assignment operator.
+    /// @param[in,out] reader  The reader whose memory will be moved to this.
+    ///                        On exit, reader's behavior is undefined.
+    /// @result The memory from reader moved to this.
+    LossyReader& operator=(LossyReader &&reader) noexcept;
+    /// @}
+
+    /// @name Opening
+    /// @{
+
+    /// @brief Opens a lossy compressed file.
+    /// @param[in] fileName  The name of the file.
+    /// @throws std::invalid_argument if the file does not exist or is not a
+    ///         valid lossy compressed file.
+    /// @throws std::runtime_error if the file cannot be read.
+    void open(const std::string &fileName);
+    /// @result True indicates a file is open.
+    [[nodiscard]] bool isOpen() const noexcept;
+    /// @}
+
+    /// @name Properties
+    /// @{
+
+    /// @result The number of channels.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int getNumberOfChannels() const;
+    /// @result The number of samples in each channel.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int64_t getNumberOfSamples() const;
+    /// @result The sampling period in seconds.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] double getSamplingPeriod() const;
+    /// @result The time of the first sample.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] SFF::Utilities::Time getStartTime() const;
+    /// @result The name of the given channel.  This is empty if the channels
+    ///         are unnamed.
+    /// @throws std::invalid_argument if channel is out of bounds.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] std::string getChannelName(int channel) const;
+    /// @result The absolute error bound.  No sample differs from the
+    ///         original by more than this.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] double getAbsoluteError() const;
+    /// @result The predictor.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] Predictor getPredictor() const;
+    /// @result The number of channels in a block.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int getChannelBlockSize() const;
+    /// @result The total size in bytes of the encoded blocks.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int64_t getCompressedSize() const;
+    /// @result The size in bytes of the samples as float32, i.e.,
+    ///         4*getNumberOfChannels()*getNumberOfSamples().
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int64_t getUncompressedSize() const;
+    /// @}
+
+    /// @name Reading
+    /// @{
+
+    /// @brief Reads all the samples of a channel.
+    /// @param[in] channel  The channel index.
+    /// @result The channel's reconstructed samples.
+    /// @throws std::invalid_argument if the channel is out of bounds.
+    /// @throws std::runtime_error if the file is not open, cannot be read,
+    ///         or is corrupt.
+    [[nodiscard]] std::vector<float> read(int channel) const;
+    /// @brief Reads every channel with the blocks decoded in parallel.
+    /// @param[in] nThreads  The number of threads.  If this is not positive
+    ///                      then the hardware concurrency is used.
+    /// @result A row major matrix with dimension
+    ///         [\c getNumberOfChannels() x \c getNumberOfSamples()].
+    /// @throws std::runtime_error if the file is not open, cannot be read,
+    ///         or is corrupt.
+    [[nodiscard]] std::vector<float> readAll(int nThreads = 0) const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Closes the file.
+    void close() noexcept;
+    /// @brief Destructor.
+    ~LossyReader();
+    /// @}
+private:
+    class LossyReaderImpl;
+    std::unique_ptr<LossyReaderImpl> pImpl;
+};
+}
+#endif
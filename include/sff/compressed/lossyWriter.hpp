@@ -0,0 +1,182 @@
+#ifndef SFF_COMPRESSED_LOSSYWRITER_HPP
+#define SFF_COMPRESSED_LOSSYWRITER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "sff/compressed/enums.hpp"
+#include "sff/utilities/time.hpp"
+namespace SFF::SEGY::Silixa
+{
+class TraceGroup;
+}
+namespace SFF::Compressed
+{
+/// @class LossyWriter lossyWriter.hpp "sff/compressed/lossyWriter.hpp"
+/// @brief Writes float32 channels with an error bounded lossy compressor.
+///        This is intended for data like DAS strain rate whose instrument
+///        noise far exceeds the precision of float32.
+/// @details Every sample is quantized to the nearest multiple of twice the
+///          absolute error bound so that no reconstructed sample differs
+///          from the original by more than the bound.  The quantized values
+///          are predicted from their already coded neighbors, see Predictor,
+///          and the residuals are zig-zag coded and bit packed in small
+///          groups.  Samples that cannot be quantized within the bound,
+///          e.g., NaNs, are stored exactly.
+///
+///          The channels are split into blocks of adjacent channels that
+///          are compressed independently by a pool of threads.  The file is
+///          read with SFF::Compressed::LossyReader.
+/// @code
+///    SFF::SEGY::Silixa::TraceGroup group;
+///    group.read("das.sgy");
+///    LossyWriter writer;
+///    writer.setErrorBound(ErrorBound::ABSOLUTE, 1.e-3);
+///    writer.write("das.sffl", group);
+///    std::cout << writer.getCompressionRatio() << " "
+///              << writer.getMaximumError() << std::endl;
+/// @endcode
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class LossyWriter
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    LossyWriter();
+    /// @brief Copy constructor.
+    /// @param[in] writer  The writer from which to initialize this class.
+    LossyWriter(const LossyWriter &writer);
+    /// @brief Move constructor.
+    /// @param[in,out] writer  The writer from which to initialize this class.
+    ///                        On exit, writer's behavior is undefined.
+    LossyWriter(LossyWriter &&writer) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] writer  The writer to copy to this.
+    /// @result A deep copy of the writer.
+    LossyWriter& operator=(const LossyWriter &writer);
+    /// @brief Move assignment operator.
+    /// @param[in,out] writer  The writer whose memory will be moved to this.
+    ///                        On exit, writer's behavior is undefined.
+    /// @result The memory from writer moved to this.
+    LossyWriter& operator=(LossyWriter &&writer) noexcept;
+    /// @}
+
+    /// @name Options
+    /// @{
+
+    /// @brief Sets the error bound.
+    /// @param[in] errorBound  Defines whether the tolerance is absolute or
+    ///                        relative to the data's range.
+    /// @param[in] tolerance   The tolerance.
+    /// @throws std::invalid_argument if the tolerance is not positive and
+    ///         finite.
+    void setErrorBound(ErrorBound errorBound, double tolerance);
+    /// @result The error bound type.
+    [[nodiscard]] ErrorBound getErrorBound() const noexcept;
+    /// @result The tolerance.
+    /// @throws std::runtime_error if the error bound was not set.
+    [[nodiscard]] double getTolerance() const;
+    /// @brief Sets the predictor.
+    /// @param[in] predictor  The predictor.  By default this is
+    ///                       Predictor::LORENZO.
+    void setPredictor(Predictor predictor) noexcept;
+    /// @result The predictor.
+    [[nodiscard]] Predictor getPredictor() const noexcept;
+    /// @brief Sets the number of adjacent channels compressed together.
+    ///        This is the unit of parallelism and of reading.
+    /// @param[in] channelBlockSize  The number of channels in a block.  By
+    ///                              default this is 32.
+    /// @throws std::invalid_argument if channelBlockSize is not positive.
+    void setChannelBlockSize(int channelBlockSize);
+    /// @result The number of channels in a block.
+    [[nodiscard]] int getChannelBlockSize() const noexcept;
+    /// @brief Sets the number of compression threads.
+    /// @param[in] nThreads  The number of threads.  If this is not positive
+    ///                      then the hardware concurrency is used.  This is
+    ///                      the default.
+    void setNumberOfThreads(int nThreads) noexcept;
+    /// @result The number of compression threads that will be used.
+    [[nodiscard]] int getNumberOfThreads() const noexcept;
+    /// @}
+
+    /// @name Writing
+    /// @{
+
+    /// @brief Compresses the channels to a file.
+    /// @param[in] fileName        The name of the file to write.
+    /// @param[in] channels        The samples of each channel.  Every
+    ///                            channel must have the same, non-zero
+    ///                            number of samples.
+    /// @param[in] samplingPeriod  The sampling period in seconds.
+    /// @param[in] startTime       The time of the first sample.
+    /// @param[in] channelNames    The name of each channel.  If this is
+    ///                            empty then the channels are unnamed.
+    ///                            Otherwise, this must have one name per
+    ///                            channel.
+    /// @throws std::invalid_argument if the channels are empty or of unequal
+    ///         length, the sampling period is not positive, the number of
+    ///         channel names is wrong, or a relative error bound is used on
+    ///         data with no finite range.
+    /// @throws std::runtime_error if the error bound was not set or the file
+    ///         cannot be written.
+    void write(const std::string &fileName,
+               const std::vector<std::span<const float>> &channels,
+               double samplingPeriod,
+               const SFF::Utilities::Time &startTime,
+               const std::vector<std::string> &channelNames = {});
+    /// @brief Compresses a Silixa trace group to a file.  The traces' sample
+    ///        buffers are compressed in place and the channels are named by
+    ///        their trace numbers.
+    /// @param[in] fileName  The name of the file to write.
+    /// @param[in] group     The trace group to compress.
+    /// @throws std::invalid_argument if the group has no traces or the traces
+    ///         have different lengths or sampling periods.
+    /// @throws std::runtime_error if the error bound was not set or the file
+    ///         cannot be written.
+    void write(const std::string &fileName,
+               const SFF::SEGY::Silixa::TraceGroup &group);
+    /// @}
+
+    /// @name Statistics of the Last Write
+    /// @{
+
+    /// @result The absolute error bound used by the last write.  For a
+    ///         relative bound this is the tolerance times the data's range.
+    /// @throws std::runtime_error if nothing was written.
+    [[nodiscard]] double getAbsoluteError() const;
+    /// @result The largest absolute difference between an original sample
+    ///         and its reconstruction in the last write.
+    /// @throws std::runtime_error if nothing was written.
+    [[nodiscard]] double getMaximumError() const;
+    /// @result The size of the file written by the last write.
+    /// @throws std::runtime_error if nothing was written.
+    [[nodiscard]] int64_t getCompressedSize() const;
+    /// @result The size of the samples of the last write as float32, i.e.,
+    ///         4 times the number of samples.
+    /// @throws std::runtime_error if nothing was written.
+    [[nodiscard]] int64_t getUncompressedSize() const;
+    /// @result The ratio of the uncompressed size to the compressed size.
+    /// @throws std::runtime_error if nothing was written.
+    [[nodiscard]] double getCompressionRatio() const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Destructor.
+    ~LossyWriter();
+    /// @}
+private:
+    class LossyWriterImpl;
+    std::unique_ptr<LossyWriterImpl> pImpl;
+};
+}
+#endif
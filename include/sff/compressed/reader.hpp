@@ -0,0 +1,151 @@
+#ifndef SFF_COMPRESSED_READER_HPP
+#define SFF_COMPRESSED_READER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "sff/compressed/enums.hpp"
+#include "sff/utilities/time.hpp"
+namespace SFF::Compressed
+{
+/// @class Reader reader.hpp "sff/compressed/reader.hpp"
+/// @brief Reads sff's lossless compressed container written by
+///        SFF::Compressed::Writer.
+/// @details Opening the file reads only the file header, chunk index, and
+///          channel names.  A sample range of a channel is then read by
+///          decompressing the chunks that overlap the range.  Since a
+///          channel's chunks are adjacent in the file this is a single
+///          read.  The reads use pread so a const reader may be shared by
+///          many threads.
+/// @code
+///    Reader reader;
+///    reader.open("das.sffc");
+///    auto x = reader.read(100, 5000, 5999); // Channel 100, 1000 samples
+///    auto all = reader.readAll();           // The whole [channel x time] matrix
+/// @endcode
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Reader
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    Reader();
+    /// @brief Copy constructor.  The copy holds its own file descriptor.
+    /// @param[in] reader  The reader from which to initialize this class.
+    Reader(const Reader &reader);
+    /// @brief Move constructor.
+    /// @param[in,out] reader  The reader from which to initialize this class.
+    ///                        On exit, reader's behavior is undefined.
+    Reader(Reader &&reader) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] reader  The reader to copy to this.
+    /// @result A copy of the reader with its own file descriptor.
+    Reader& operator=(const Reader &reader);
+    /// @brief Move assignment operator.
+    /// @param[in,out] reader  The reader whose memory will be moved to this.
+    ///                        On exit, reader's behavior is undefined.
+    /// @result The memory from reader moved to this.
+    Reader& operator=(Reader &&reader) noexcept;
+    /// @}
+
+    /// @name Opening
+    /// @{
+
+    /// @brief Opens a compressed file.
+    /// @param[in] fileName  The name of the file.
+    /// @throws std::invalid_argument if the file does not exist or is not a
+    ///         valid compressed file.
+    /// @throws std::runtime_error if the file cannot be read.
+    void open(const std::string &fileName);
+    /// @result True indicates a file is open.
+    [[nodiscard]] bool isOpen() const noexcept;
+    /// @}
+
+    /// @name Properties
+    /// @{
+
+    /// @result The number of channels.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int getNumberOfChannels() const;
+    /// @result The number of samples in each channel.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int64_t getNumberOfSamples() const;
+    /// @result The sampling period in seconds.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] double getSamplingPeriod() const;
+    /// @result The time of the first sample.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] SFF::Utilities::Time getStartTime() const;
+    /// @result The name of the given channel.  This is empty if the channels
+    ///         are unnamed.
+    /// @throws std::invalid_argument if channel is out of bounds.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] std::string getChannelName(int channel) const;
+    /// @result The transform applied to the chunks.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] Transform getTransform() const;
+    /// @result The number of samples in a chunk.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int getChunkLength() const;
+    /// @result The total size in bytes of the compressed chunks.
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int64_t getCompressedSize() const;
+    /// @result The size in bytes of the samples as float32, i.e.,
+    ///         4*getNumberOfChannels()*getNumberOfSamples().
+    /// @throws std::runtime_error if the file is not open.
+    [[nodiscard]] int64_t getUncompressedSize() const;
+    /// @}
+
+    /// @name Reading
+    /// @{
+
+    /// @brief Reads a sample range of a channel.
+    /// @param[in] channel      The channel index.
+    /// @param[in] firstSample  The first sample to read.
+    /// @param[in] lastSample   The last sample to read.  This is inclusive.
+    /// @result The samples in [firstSample, lastSample].
+    /// @throws std::invalid_argument if the channel or sample range is out
+    ///         of bounds.
+    /// @throws std::runtime_error if the file is not open, cannot be read,
+    ///         or is corrupt.
+    [[nodiscard]] std::vector<float> read(int channel,
+                                          int64_t firstSample,
+                                          int64_t lastSample) const;
+    /// @brief Reads all the samples of a channel.
+    /// @param[in] channel  The channel index.
+    /// @result The channel's samples.
+    /// @throws std::invalid_argument if the channel is out of bounds.
+    /// @throws std::runtime_error if the file is not open, cannot be read,
+    ///         or is corrupt.
+    [[nodiscard]] std::vector<float> read(int channel) const;
+    /// @brief Reads every channel with the channels decompressed in parallel.
+    /// @param[in] nThreads  The number of threads.  If this is not positive
+    ///                      then the hardware concurrency is used.
+    /// @result A row major matrix with dimension
+    ///         [\c getNumberOfChannels() x \c getNumberOfSamples()].
+    /// @throws std::runtime_error if the file is not open, cannot be read,
+    ///         or is corrupt.
+    [[nodiscard]] std::vector<float> readAll(int nThreads = 0) const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Closes the file.
+    void close() noexcept;
+    /// @brief Destructor.
+    ~Reader();
+    /// @}
+private:
+    class ReaderImpl;
+    std::unique_ptr<ReaderImpl> pImpl;
+};
+}
+#endif
@@ -0,0 +1,150 @@
+#ifndef SFF_COMPRESSED_WRITER_HPP
+#define SFF_COMPRESSED_WRITER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <span>
+#include "sff/compressed/enums.hpp"
+#include "sff/utilities/time.hpp"
+namespace SFF::SAC
+{
+class Waveform;
+}
+namespace SFF::SEGY::Silixa
+{
+class TraceGroup;
+}
+namespace SFF::Compressed
+{
+/// @class Writer writer.hpp "sff/compressed/writer.hpp"
+/// @brief Writes float32 channels to sff's lossless compressed container.
+/// @details Each channel is cut into chunks of \c getChunkLength() samples.
+///          Each chunk is transformed, see Transform, and compressed with an
+///          LZ codec.  Chunks that do not compress are stored as is.  An
+///          index of every chunk's location follows the chunks so that
+///          SFF::Compressed::Reader can decompress any sample range without
+///          touching the rest of the file.
+///
+///          The chunks are compressed in parallel while the previously
+///          compressed chunks are written.
+/// @code
+///    SFF::SEGY::Silixa::TraceGroup group;
+///    group.read("das.sgy");
+///    Writer writer;
+///    writer.setTransform(Transform::XOR_DELTA);
+///    writer.write("das.sffc", group);
+/// @endcode
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Writer
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    Writer();
+    /// @brief Copy constructor.
+    /// @param[in] writer  The writer from which to initialize this class.
+    Writer(const Writer &writer);
+    /// @brief Move constructor.
+    /// @param[in,out] writer  The writer from which to initialize this class.
+    ///                        On exit, writer's behavior is undefined.
+    Writer(Writer &&writer) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] writer  The writer to copy to this.
+    /// @result A deep copy of the writer.
+    Writer& operator=(const Writer &writer);
+    /// @brief Move assignment operator.
+    /// @param[in,out] writer  The writer whose memory will be moved to this.
+    ///                        On exit, writer's behavior is undefined.
+    /// @result The memory from writer moved to this.
+    Writer& operator=(Writer &&writer) noexcept;
+    /// @}
+
+    /// @name Options
+    /// @{
+
+    /// @brief Sets the transform applied to each chunk.
+    /// @param[in] transform  The transform.  By default this is
+    ///                       Transform::BYTE_SHUFFLE.
+    void setTransform(Transform transform) noexcept;
+    /// @result The transform applied to each chunk.
+    [[nodiscard]] Transform getTransform() const noexcept;
+    /// @brief Sets the number of samples in a chunk.  This is the unit of
+    ///        random access.  Longer chunks compress slightly better while
+    ///        shorter chunks make small reads cheaper.
+    /// @param[in] chunkLength  The number of samples in a chunk.  By default
+    ///                         this is 8192.
+    /// @throws std::invalid_argument if chunkLength is not in
+    ///         [16, 16777216].
+    void setChunkLength(int chunkLength);
+    /// @result The number of samples in a chunk.
+    [[nodiscard]] int getChunkLength() const noexcept;
+    /// @brief Sets the number of compression threads.
+    /// @param[in] nThreads  The number of threads.  If this is not positive
+    ///                      then the hardware concurrency is used.  This is
+    ///                      the default.
+    void setNumberOfThreads(int nThreads) noexcept;
+    /// @result The number of compression threads that will be used.
+    [[nodiscard]] int getNumberOfThreads() const noexcept;
+    /// @}
+
+    /// @name Writing
+    /// @{
+
+    /// @brief Compresses the channels to a file.
+    /// @param[in] fileName        The name of the file to write.
+    /// @param[in] channels        The samples of each channel.  Every
+    ///                            channel must have the same, non-zero
+    ///                            number of samples.
+    /// @param[in] samplingPeriod  The sampling period in seconds.
+    /// @param[in] startTime       The time of the first sample.
+    /// @param[in] channelNames    The name of each channel.  If this is
+    ///                            empty then the channels are unnamed.
+    ///                            Otherwise, this must have one name per
+    ///                            channel.
+    /// @throws std::invalid_argument if the channels are empty or of unequal
+    ///         length, the sampling period is not positive, or the number of
+    ///         channel names is wrong.
+    /// @throws std::runtime_error if the file cannot be written.
+    void write(const std::string &fileName,
+               const std::vector<std::span<const float>> &channels,
+               double samplingPeriod,
+               const SFF::Utilities::Time &startTime,
+               const std::vector<std::string> &channelNames = {}) const;
+    /// @brief Compresses a Silixa trace group to a file.  The channels are
+    ///        named by their trace numbers.
+    /// @param[in] fileName  The name of the file to write.
+    /// @param[in] group     The trace group to compress.
+    /// @throws std::invalid_argument if the group has no traces or the traces
+    ///         have different lengths or sampling periods.
+    /// @throws std::runtime_error if the file cannot be written.
+    void write(const std::string &fileName,
+               const SFF::SEGY::Silixa::TraceGroup &group) const;
+    /// @brief Compresses a SAC waveform to a file.  The channel is named
+    ///        NETWORK.STATION.LOCATION.CHANNEL.
+    /// @param[in] fileName  The name of the file to write.
+    /// @param[in] waveform  The waveform to compress.
+    /// @throws std::invalid_argument if the waveform has no samples.
+    /// @throws std::runtime_error if the file cannot be written.
+    void write(const std::string &fileName,
+               const SFF::SAC::Waveform &waveform) const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Destructor.
+    ~Writer();
+    /// @}
+private:
+    class WriterImpl;
+    std::unique_ptr<WriterImpl> pImpl;
+};
+}
+#endif
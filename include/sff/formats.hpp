@@ -10,7 +10,19 @@ enum class Format
 {
     SAC,         /*!< Seismic Analysis Code (SAC) format. */
     SILIXA_SEGY, /*!< Silixa's custom SEGY format. */
-    MINISEED     /*!< MiniSEED format. */
+    MINISEED,    /*!< MiniSEED format. */
+    SEGY         /*!< Standard SEG-Y format. */
+};
+/*!
+ * @brief Defines the precision of a trace's time series samples.
+ * @copyright Ben Baker (University of Utah) distributed under the MIT license.
+ */
+enum class Precision
+{
+    INT32,    /*!< 32-bit integer. */
+    FLOAT32,  /*!< 32-bit floating precision. */
+    FLOAT64,  /*!< 64-bit floating precision. */
+    UNKNOWN   /*!< An unknown precision. */
 };
 }
 #endif
@@ -0,0 +1,90 @@
+#ifndef SFF_HYPOINVERSE2000_ARCHIVEWRITER_HPP
+#define SFF_HYPOINVERSE2000_ARCHIVEWRITER_HPP
+#include <string>
+#include <memory>
+namespace SFF::HypoInverse2000
+{
+class EventSummary;
+/*!
+ * @class ArchiveWriter "archiveWriter.hpp" "sff/hypoinverse2000/archiveWriter.hpp"
+ * @brief Streams event summaries to a hypoinverse2000 archive file.  The
+ *        events are packed directly into a single reusable buffer which is
+ *        written to disk in large blocks once it fills.
+ * @copyright Ben Baker (University of Utah) distributed under the MIT license.
+ */
+class ArchiveWriter
+{
+public:
+    /*! @name Constructors
+     * @{
+     */
+    /*!
+     * @brief Constructor.
+     */
+    ArchiveWriter();
+    /*!
+     * @brief Move constructor.
+     * @param[in,out] writer  The writer from which to initialize this class.
+     *                        On exit, writer's behavior is undefined.
+     */
+    ArchiveWriter(ArchiveWriter &&writer) noexcept;
+    /*! @} */
+
+    /*! @name Operators
+     * @{
+     */
+    /*!
+     * @brief Move assignment operator.
+     * @param[in,out] writer  The writer whose memory will be moved to this.
+     *                        On exit, writer's behavior is undefined.
+     * @result The memory from writer moved to this.
+     */
+    ArchiveWriter& operator=(ArchiveWriter &&writer) noexcept;
+    /*! @} */
+
+    /*! @name Destructors
+     * @{
+     */
+    /*!
+     * @brief Destructor.  This will flush and close the file.
+     */
+    ~ArchiveWriter();
+    /*! @} */
+
+    /*!
+     * @brief Opens an archive file for writing.  An existing file will be
+     *        overwritten.
+     * @param[in] fileName    The name of the archive file.
+     * @param[in] bufferSize  The size of the write buffer in bytes.
+     * @throws std::invalid_argument if bufferSize is not positive.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    void open(const std::string &fileName, int bufferSize = 4*1024*1024);
+    /*!
+     * @result True indicates the archive file is open.
+     */
+    [[nodiscard]] bool isOpen() const noexcept;
+    /*!
+     * @brief Appends an event summary to the archive file.
+     * @param[in] event  The event summary to write.
+     * @throws std::runtime_error if the file is not open.
+     */
+    void write(const EventSummary &event);
+    /*!
+     * @brief Writes the contents of the buffer to disk.
+     * @throws std::runtime_error if the write fails.
+     */
+    void flush();
+    /*!
+     * @brief Flushes the buffer and closes the file.
+     */
+    void close();
+
+    ArchiveWriter(const ArchiveWriter &writer) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter &writer) = delete;
+private:
+    class ArchiveWriterImpl;
+    std::unique_ptr<ArchiveWriterImpl> pImpl;
+};
+}
+#endif
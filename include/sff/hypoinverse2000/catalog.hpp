@@ -0,0 +1,310 @@
+#ifndef SFF_HYPOINVERSE2000_CATALOG_HPP
+#define SFF_HYPOINVERSE2000_CATALOG_HPP
+#include <vector>
+#include <string>
+#include <memory>
+#include <limits>
+#include <cstdint>
+namespace SFF::HypoInverse2000
+{
+class EventSummary;
+/*!
+ * @class Catalog "catalog.hpp" "sff/hypoinverse2000/catalog.hpp"
+ * @brief Defines a columnar (struct-of-arrays) catalog of events and picks.
+ *        Rather than storing a vector of event summaries, each of which
+ *        holds a vector of heap-allocated station archive lines, the catalog
+ *        stores each origin and pick attribute in its own contiguous array.
+ *        Network, station, channel, and location codes are interned so that
+ *        a pick's codes are small integer indices into a dictionary.  Times
+ *        are stored as integer nanoseconds since the epoch.
+ * @note Picks are stored contiguously by event.  The picks for the i'th event
+ *       are in the range [getPickOffsets()[i], getPickOffsets()[i+1]).
+ * @note Missing floating point values are represented by NaN and missing
+ *       times are represented by Catalog::MISSING_TIME.
+ * @copyright Ben Baker (University of Utah) distributed under the MIT license.
+ */
+class Catalog
+{
+public:
+    /*!
+     * @brief The value of a time that was not set.
+     */
+    static constexpr int64_t MISSING_TIME
+        = std::numeric_limits<int64_t>::lowest();
+public:
+    /*! @name Constructors
+     * @{
+     */
+    /*!
+     * @brief Constructor.
+     */
+    Catalog();
+    /*!
+     * @brief Copy constructor.
+     * @param[in] catalog  The catalog from which to initialize this class.
+     */
+    Catalog(const Catalog &catalog);
+    /*!
+     * @brief Move constructor.
+     * @param[in,out] catalog  The catalog from which to initialize this class.
+     *                         On exit, catalog's behavior is undefined.
+     */
+    Catalog(Catalog &&catalog) noexcept;
+    /*!
+     * @brief Constructs a catalog from a collection of event summaries.
+     * @param[in] events  The events with which to populate the catalog.
+     */
+    explicit Catalog(const std::vector<EventSummary> &events);
+    /*! @} */
+
+    /*! @name Operators
+     * @{
+     */
+    /*!
+     * @brief Copy assignment operator.
+     * @param[in] catalog  The catalog to copy to this.
+     * @result A deep copy of the catalog.
+     */
+    Catalog& operator=(const Catalog &catalog);
+    /*!
+     * @brief Move assignment operator.
+     * @param[in,out] catalog  The catalog whose memory will be moved to this.
+     *                         On exit, catalog's behavior is undefined.
+     * @result The memory from catalog moved to this.
+     */
+    Catalog& operator=(Catalog &&catalog) noexcept;
+    /*! @} */
+
+    /*! @name Destructors
+     * @{
+     */
+    /*!
+     * @brief Destructor.
+     */
+    ~Catalog();
+    /*!
+     * @brief Releases the memory and resets the class.
+     */
+    void clear() noexcept;
+    /*! @} */
+
+    /*! @name Conversion
+     * @{
+     */
+    /*!
+     * @brief Reserves space for the given number of events and picks.
+     * @param[in] nEvents  The anticipated number of events.
+     * @param[in] nPicks   The anticipated total number of picks.
+     */
+    void reserve(int nEvents, int nPicks);
+    /*!
+     * @brief Appends an event and its picks to the catalog.
+     * @param[in] event  The event to add.
+     */
+    void addEvent(const EventSummary &event);
+    /*!
+     * @brief Converts the i'th event in the catalog to an event summary.
+     * @param[in] iEvent  The event index.
+     * @result The event summary corresponding to the i'th event.
+     * @throws std::invalid_argument if iEvent is not in the range
+     *         [0, getNumberOfEvents()).
+     */
+    [[nodiscard]] EventSummary getEvent(int iEvent) const;
+    /*!
+     * @brief Converts the catalog to a collection of event summaries.
+     * @result The events in the catalog.
+     */
+    [[nodiscard]] std::vector<EventSummary> getEvents() const;
+    /*!
+     * @result The number of events in the catalog.
+     */
+    [[nodiscard]] int getNumberOfEvents() const noexcept;
+    /*!
+     * @result The total number of picks in the catalog.
+     */
+    [[nodiscard]] int getNumberOfPicks() const noexcept;
+    /*! @} */
+
+    /*! @name Origin Columns
+     * @{
+     */
+    /*!
+     * @result The origin times in nanoseconds since the epoch.
+     */
+    [[nodiscard]] const std::vector<int64_t>& getOriginTimes() const noexcept;
+    /*!
+     * @result The event latitudes in degrees.
+     */
+    [[nodiscard]] const std::vector<double>& getLatitudes() const noexcept;
+    /*!
+     * @result The event longitudes in degrees.  These are in the
+     *         range [0,360).
+     */
+    [[nodiscard]] const std::vector<double>& getLongitudes() const noexcept;
+    /*!
+     * @result The event depths in kilometers.
+     */
+    [[nodiscard]] const std::vector<double>& getDepths() const noexcept;
+    /*!
+     * @result The preferred magnitudes.
+     */
+    [[nodiscard]] const std::vector<double>& getMagnitudes() const noexcept;
+    /*!
+     * @result The event identifiers.  Events without an identifier are
+     *         assigned 0.
+     */
+    [[nodiscard]] const std::vector<uint64_t>& getEventIdentifiers() const noexcept;
+    /*!
+     * @result The offsets into the pick columns.  This has dimension
+     *         [getNumberOfEvents() + 1].
+     */
+    [[nodiscard]] const std::vector<int>& getPickOffsets() const noexcept;
+    /*! @} */
+
+    /*! @name Pick Columns
+     * @{
+     */
+    /*!
+     * @result The index of the event to which each pick belongs.
+     */
+    [[nodiscard]] const std::vector<int>& getPickEventIndices() const noexcept;
+    /*!
+     * @result The index of each pick's network code in \c getNetworkCodes().
+     *         A negative value indicates the network was not set.
+     */
+    [[nodiscard]] const std::vector<int>& getPickNetworkIndices() const noexcept;
+    /*!
+     * @result The index of each pick's station code in \c getStationCodes().
+     *         A negative value indicates the station was not set.
+     */
+    [[nodiscard]] const std::vector<int>& getPickStationIndices() const noexcept;
+    /*!
+     * @result The index of each pick's channel code in \c getChannelCodes().
+     *         A negative value indicates the channel was not set.
+     */
+    [[nodiscard]] const std::vector<int>& getPickChannelIndices() const noexcept;
+    /*!
+     * @result The index of each pick's location code in
+     *         \c getLocationCodes().  A negative value indicates the
+     *         location code was not set.
+     */
+    [[nodiscard]] const std::vector<int>& getPickLocationIndices() const noexcept;
+    /*!
+     * @result The P pick times in nanoseconds since the epoch.
+     */
+    [[nodiscard]] const std::vector<int64_t>& getPPickTimes() const noexcept;
+    /*!
+     * @result The S pick times in nanoseconds since the epoch.
+     */
+    [[nodiscard]] const std::vector<int64_t>& getSPickTimes() const noexcept;
+    /*!
+     * @result The P residuals in seconds.
+     */
+    [[nodiscard]] const std::vector<double>& getPResiduals() const noexcept;
+    /*!
+     * @result The S residuals in seconds.
+     */
+    [[nodiscard]] const std::vector<double>& getSResiduals() const noexcept;
+    /*!
+     * @result The P weights used in the location.
+     */
+    [[nodiscard]] const std::vector<double>& getPWeightsUsed() const noexcept;
+    /*!
+     * @result The S weights used in the location.
+     */
+    [[nodiscard]] const std::vector<double>& getSWeightsUsed() const noexcept;
+    /*!
+     * @result The source-receiver epicentral distances in kilometers.
+     */
+    [[nodiscard]] const std::vector<double>& getEpicentralDistances() const noexcept;
+    /*!
+     * @result The source-to-receiver azimuths in degrees.
+     */
+    [[nodiscard]] const std::vector<double>& getAzimuths() const noexcept;
+    /*!
+     * @result The takeoff angles in degrees.
+     */
+    [[nodiscard]] const std::vector<double>& getTakeOffAngles() const noexcept;
+    /*! @} */
+
+    /*! @name Dictionaries
+     * @{
+     */
+    /*!
+     * @result The unique network codes in the catalog.
+     */
+    [[nodiscard]] const std::vector<std::string>& getNetworkCodes() const noexcept;
+    /*!
+     * @result The unique station codes in the catalog.
+     */
+    [[nodiscard]] const std::vector<std::string>& getStationCodes() const noexcept;
+    /*!
+     * @result The unique channel codes in the catalog.
+     */
+    [[nodiscard]] const std::vector<std::string>& getChannelCodes() const noexcept;
+    /*!
+     * @result The unique location codes in the catalog.
+     */
+    [[nodiscard]] const std::vector<std::string>& getLocationCodes() const noexcept;
+    /*! @} */
+
+    /*! @name Filtering
+     * @{
+     */
+    /*!
+     * @brief Finds the events whose origin times are in [t0, t1].
+     * @param[in] t0  The earliest origin time in nanoseconds since the epoch.
+     * @param[in] t1  The latest origin time in nanoseconds since the epoch.
+     * @result The indices of the events satisfying the criterion.
+     * @throws std::invalid_argument if t0 > t1.
+     */
+    [[nodiscard]] std::vector<int> findEventsInTimeRange(int64_t t0, int64_t t1) const;
+    /*!
+     * @brief Finds the events within a latitude/longitude box.
+     * @param[in] minLatitude   The minimum latitude in degrees.
+     * @param[in] maxLatitude   The maximum latitude in degrees.
+     * @param[in] minLongitude  The minimum longitude in degrees.
+     * @param[in] maxLongitude  The maximum longitude in degrees.
+     * @result The indices of the events satisfying the criterion.
+     * @note The longitudes are mapped to [0,360) so a box straddling the
+     *       prime meridian should have minLongitude > maxLongitude.
+     * @note A box for which maxLongitude - minLongitude >= 360, e.g.,
+     *       [-180,180] or [0,360], contains every longitude.  Events with
+     *       an unknown location are never returned.
+     * @throws std::invalid_argument if minLatitude > maxLatitude.
+     */
+    [[nodiscard]] std::vector<int> findEventsInRegion(double minLatitude,
+                                                      double maxLatitude,
+                                                      double minLongitude,
+                                                      double maxLongitude) const;
+    /*!
+     * @brief Finds the events with a preferred magnitude in [minMagnitude,
+     *        maxMagnitude].
+     * @result The indices of the events satisfying the criterion.
+     * @throws std::invalid_argument if minMagnitude > maxMagnitude.
+     */
+    [[nodiscard]] std::vector<int> findEventsInMagnitudeRange(double minMagnitude,
+                                                              double maxMagnitude) const;
+    /*!
+     * @brief Finds all picks at the given network and station.
+     * @param[in] network  The network code - e.g., UU.
+     * @param[in] station  The station code - e.g., FORK.
+     * @result The indices of the picks satisfying the criterion.
+     */
+    [[nodiscard]] std::vector<int> findPicks(const std::string &network,
+                                             const std::string &station) const;
+    /*!
+     * @brief Finds all picks with a P or S pick time in [t0, t1].
+     * @param[in] t0  The earliest pick time in nanoseconds since the epoch.
+     * @param[in] t1  The latest pick time in nanoseconds since the epoch.
+     * @result The indices of the picks satisfying the criterion.
+     * @throws std::invalid_argument if t0 > t1.
+     */
+    [[nodiscard]] std::vector<int> findPicksInTimeRange(int64_t t0, int64_t t1) const;
+    /*! @} */
+private:
+    class CatalogImpl;
+    std::unique_ptr<CatalogImpl> pImpl;
+};
+}
+#endif
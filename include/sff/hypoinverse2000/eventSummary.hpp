@@ -1,6 +1,7 @@
 #ifndef SFF_HYPOINVERSE2000_EVENTSUMMARY_HPP
 #define SFF_HYPOINVERSE2000_EVENTSUMMARY_HPP
 #include <vector>
+#include <string>
 #include <memory>
 namespace SFF::HypoInverse2000
 {
@@ -102,6 +103,23 @@ public:
      *       hypoinverse.
      */
     [[nodiscard]] std::string packString() const;
+    /*!
+     * @brief Converts the event information contained in this class to
+     *        lines of an output hypoinverse2000 archive file and writes them
+     *        to a caller-supplied buffer.  This does not allocate memory.
+     * @param[out] lines   The event and pick information.  This must have
+     *                     dimension at least [length].  The lines are newline
+     *                     separated and are not null terminated.
+     * @param[in] length   The length of lines.  This must be at least
+     *                     \c getPackedLength().
+     * @result The number of characters written to lines.
+     * @throws std::invalid_argument if lines is NULL or length is too small.
+     */
+    int packString(char *lines, int length) const;
+    /*!
+     * @result The number of characters required to pack this event summary.
+     */
+    [[nodiscard]] int getPackedLength() const noexcept;
     /*!
      * @brief Sets the event summary information (e.g., latitude, longitude,
      *        depth, origin time, etc.)
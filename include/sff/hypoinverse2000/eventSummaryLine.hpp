@@ -1,6 +1,8 @@
 #ifndef SFF_HYPOINVERSE2000_EVENTSUMMARYLINE_HPP
 #define SFF_HYPOINVERSE2000_EVENTSUMMARYLINE_HPP
 #include <memory>
+#include <string>
+#include <algorithm>
 #include "sff/utilities/time.hpp"
 namespace SFF::HypoInverse2000
 {
@@ -75,6 +77,36 @@ public:
      *        write to the archive file.
      */
     [[nodiscard]] std::string packString() const;
+    /*!
+     * @brief Packs the information contained in this class into a line to
+     *        write to the archive file.  This does not allocate memory.
+     * @param[out] line   The event summary line.  This must have dimension
+     *                    at least [length].  Only the first PACKED_LENGTH
+     *                    characters are written and the line is not null
+     *                    terminated.
+     * @param[in] length  The length of line.
+     * @result The number of characters written to line.
+     * @throws std::invalid_argument if line is NULL or length is less than
+     *         PACKED_LENGTH.
+     */
+    int packString(char *line, int length) const;
+    /*!
+     * @brief Packs the information contained in this class into a line and
+     *        writes it to an output iterator.
+     * @param[out] out  The output iterator to which the line will be written.
+     * @result The output iterator one past the last written character.
+     */
+    template<typename OutputIterator>
+    OutputIterator packString(OutputIterator out) const
+    {
+        char line[PACKED_LENGTH];
+        packString(line, PACKED_LENGTH);
+        return std::copy(line, line + PACKED_LENGTH, out);
+    }
+    /*!
+     * @brief The number of characters in a packed event summary line.
+     */
+    static constexpr int PACKED_LENGTH = 164;
 
     /*! @brief Hypocenter and Origin Time
      * @{
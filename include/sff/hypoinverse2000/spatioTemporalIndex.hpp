@@ -0,0 +1,175 @@
+#ifndef SFF_HYPOINVERSE2000_SPATIOTEMPORALINDEX_HPP
+#define SFF_HYPOINVERSE2000_SPATIOTEMPORALINDEX_HPP
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstdint>
+namespace SFF::HypoInverse2000
+{
+class Catalog;
+/*!
+ * @class SpatioTemporalIndex "spatioTemporalIndex.hpp" "sff/hypoinverse2000/spatioTemporalIndex.hpp"
+ * @brief Indexes events in space and time so that questions like "which
+ *        events are within 20 km of this point between t0 and t1 with
+ *        magnitude greater than 2" do not require a scan of the catalog.
+ * @details The events are binned into a latitude/longitude grid.  Within
+ *          each grid cell the events are sorted by origin time so the
+ *          time window is applied with a binary search.  Separately, all
+ *          events are sorted by origin time to answer purely temporal
+ *          queries.  The returned values are indices into the catalog
+ *          (or columns) from which the index was built.
+ * @note Events with an unknown latitude or longitude are excluded from the
+ *       spatial queries.
+ * @copyright Ben Baker (University of Utah) distributed under the MIT license.
+ */
+class SpatioTemporalIndex
+{
+public:
+    /*! @name Constructors
+     * @{
+     */
+    /*!
+     * @brief Constructor.
+     */
+    SpatioTemporalIndex();
+    /*!
+     * @brief Copy constructor.
+     * @param[in] index  The index from which to initialize this class.
+     */
+    SpatioTemporalIndex(const SpatioTemporalIndex &index);
+    /*!
+     * @brief Move constructor.
+     * @param[in,out] index  The index from which to initialize this class.
+     *                       On exit, index's behavior is undefined.
+     */
+    SpatioTemporalIndex(SpatioTemporalIndex &&index) noexcept;
+    /*! @} */
+
+    /*! @name Operators
+     * @{
+     */
+    /*!
+     * @brief Copy assignment operator.
+     * @param[in] index  The index to copy to this.
+     * @result A deep copy of the index.
+     */
+    SpatioTemporalIndex& operator=(const SpatioTemporalIndex &index);
+    /*!
+     * @brief Move assignment operator.
+     * @param[in,out] index  The index whose memory will be moved to this.
+     *                       On exit, index's behavior is undefined.
+     * @result The memory from index moved to this.
+     */
+    SpatioTemporalIndex& operator=(SpatioTemporalIndex &&index) noexcept;
+    /*! @} */
+
+    /*! @name Destructors
+     * @{
+     */
+    /*!
+     * @brief Destructor.
+     */
+    ~SpatioTemporalIndex();
+    /*!
+     * @brief Releases the memory and resets the class.
+     */
+    void clear() noexcept;
+    /*! @} */
+
+    /*! @name Initialization
+     * @{
+     */
+    /*!
+     * @brief Builds the index from a catalog.
+     * @param[in] catalog   The catalog to index.
+     * @param[in] cellSize  The size of a grid cell in degrees.
+     * @throws std::invalid_argument if cellSize is not in the range (0,180].
+     */
+    void initialize(const Catalog &catalog, double cellSize = 0.1);
+    /*!
+     * @brief Builds the index from event columns.
+     * @param[in] originTimes  The origin times in nanoseconds since the epoch.
+     * @param[in] latitudes    The event latitudes in degrees.
+     * @param[in] longitudes   The event longitudes in degrees.
+     * @param[in] depths       The event depths in kilometers.
+     * @param[in] magnitudes   The event magnitudes.
+     * @param[in] cellSize     The size of a grid cell in degrees.
+     * @throws std::invalid_argument if the columns are not all the same size
+     *         or cellSize is not in the range (0,180].
+     */
+    void initialize(const std::vector<int64_t> &originTimes,
+                    const std::vector<double> &latitudes,
+                    const std::vector<double> &longitudes,
+                    const std::vector<double> &depths,
+                    const std::vector<double> &magnitudes,
+                    double cellSize = 0.1);
+    /*!
+     * @result True indicates the index was initialized.
+     */
+    [[nodiscard]] bool isInitialized() const noexcept;
+    /*!
+     * @result The number of events in the index.
+     */
+    [[nodiscard]] int getNumberOfEvents() const noexcept;
+    /*! @} */
+
+    /*! @name Queries
+     * @{
+     */
+    /*!
+     * @brief Finds the events with origin times in [t0, t1].
+     * @param[in] t0  The earliest origin time in nanoseconds since the epoch.
+     * @param[in] t1  The latest origin time in nanoseconds since the epoch.
+     * @result The indices of the events sorted in increasing origin time.
+     * @throws std::invalid_argument if t0 > t1.
+     * @throws std::runtime_error if the class is not initialized.
+     */
+    [[nodiscard]] std::vector<int> findEventsInTimeRange(int64_t t0, int64_t t1) const;
+    /*!
+     * @brief Finds the events within a given epicentral distance of a point,
+     *        with an origin time in [t0, t1], and with magnitude at least
+     *        minMagnitude.
+     * @param[in] latitude      The latitude of the point in degrees.
+     * @param[in] longitude     The longitude of the point in degrees.
+     * @param[in] radius        The search radius in kilometers.
+     * @param[in] t0            The earliest origin time in nanoseconds since
+     *                          the epoch.
+     * @param[in] t1            The latest origin time in nanoseconds since
+     *                          the epoch.
+     * @param[in] minMagnitude  The minimum magnitude.  Events with an unknown
+     *                          magnitude are only returned when this is
+     *                          -infinity.
+     * @result The indices of the events in increasing order.
+     * @throws std::invalid_argument if the latitude is not in [-90,90],
+     *         the radius is negative, or t0 > t1.
+     * @throws std::runtime_error if the class is not initialized.
+     */
+    [[nodiscard]] std::vector<int> findEvents(double latitude, double longitude,
+                                              double radius,
+                                              int64_t t0 = std::numeric_limits<int64_t>::lowest(),
+                                              int64_t t1 = std::numeric_limits<int64_t>::max(),
+                                              double minMagnitude = -std::numeric_limits<double>::infinity()) const;
+    /*!
+     * @brief Finds the k events nearest to a point in the Earth.
+     * @param[in] latitude   The latitude of the point in degrees.
+     * @param[in] longitude  The longitude of the point in degrees.
+     * @param[in] depth      The depth of the point in kilometers.
+     * @param[in] k          The number of events to find.
+     * @result The indices of the (up to) k nearest events sorted in
+     *         increasing hypocentral distance.  Events with an unknown depth
+     *         are assumed to be at the query depth.
+     * @throws std::invalid_argument if the latitude is not in [-90,90] or
+     *         k is negative.
+     * @throws std::runtime_error if the class is not initialized.
+     */
+    [[nodiscard]] std::vector<int> findNearestEvents(double latitude,
+                                                     double longitude,
+                                                     double depth,
+                                                     int k) const;
+    /*! @} */
+private:
+    class SpatioTemporalIndexImpl;
+    std::unique_ptr<SpatioTemporalIndexImpl> pImpl;
+};
+}
+#endif
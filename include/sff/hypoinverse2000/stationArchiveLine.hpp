@@ -1,6 +1,9 @@
 #ifndef SFF_HYPOINVERSE2000_STATIONARCHIVELINE_HPP
 #define SFF_HYPOINVERSE2000_STATIONARCHIVELINE_HPP
 #include <memory>
+#include <string>
+#include <string_view>
+#include <algorithm>
 #include "sff/utilities/time.hpp"
 namespace SFF::HypoInverse2000
 {
@@ -54,6 +57,37 @@ public:
      * @return The line describing the pick.
      */
     [[nodiscard]] std::string packString() const noexcept;
+    /*!
+     * @brief Converts the class members to a line in a station archive file
+     *        and writes it to a caller-supplied buffer.  This does not
+     *        allocate memory.
+     * @param[out] line    The line describing the pick.  This must have
+     *                     dimension at least [length].  Only the first
+     *                     PACKED_LENGTH characters are written and the line
+     *                     is not null terminated.
+     * @param[in] length   The length of line.
+     * @result The number of characters written to line.
+     * @throws std::invalid_argument if line is NULL or length is less than
+     *         PACKED_LENGTH.
+     */
+    int packString(char *line, int length) const;
+    /*!
+     * @brief Converts the class members to a line in a station archive file
+     *        and writes it to an output iterator.
+     * @param[out] out  The output iterator to which the line will be written.
+     * @result The output iterator one past the last written character.
+     */
+    template<typename OutputIterator>
+    OutputIterator packString(OutputIterator out) const
+    {
+        char line[PACKED_LENGTH];
+        packString(line, PACKED_LENGTH);
+        return std::copy(line, line + PACKED_LENGTH, out);
+    }
+    /*!
+     * @brief The number of characters in a packed station archive line.
+     */
+    static constexpr int PACKED_LENGTH = 113;
 
     /*! @name Operators
      * @{
@@ -86,18 +120,20 @@ public:
     /*! @} */
 
     /*! @name SNCL
+     * @note The codes are stored in the line so the getters return views
+     *       that are valid until the line is modified or destroyed.
      * @{
      */
     /*!
      * @brief Sets the network code of the station on which the pick was made.
      * @param[in] network   The network name.  This should have two letters.
      */
-    void setNetworkName(const std::string &network) noexcept;
+    void setNetworkName(std::string_view network) noexcept;
     /*!
      * @return The network to which the station belongs.
      * @throws std::runtime_error if this is not set.
      */
-    [[nodiscard]] std::string getNetworkName() const;
+    [[nodiscard]] std::string_view getNetworkName() const;
     /*!
      * @return True indicates that the network name was set.
      */
@@ -108,12 +144,12 @@ public:
      * @param[in] station   The station's name.  This can have up to five
      *                      letters.
      */
-    void setStationName(const std::string &station) noexcept;
+    void setStationName(std::string_view station) noexcept;
     /*!
      * @return The name of the station name.
      * @throws std::runtime_error if this is not set.
      */
-    [[nodiscard]] std::string getStationName() const;
+    [[nodiscard]] std::string_view getStationName() const;
     /*!
      * @return True indicates that the station's name was set.
      */
@@ -124,12 +160,12 @@ public:
      * @param[in] channel   The station's channel.  This should have
      *                      three letters.
      */
-    void setChannelName(const std::string &channel) noexcept;
+    void setChannelName(std::string_view channel) noexcept;
     /*!
      * @return The station's channel name.
      * @throws std::runtime_error if this is not set.
      */
-    [[nodiscard]] std::string getChannelName() const;
+    [[nodiscard]] std::string_view getChannelName() const;
     /*!
      * @return True indicates that the channel name was set.
      */
@@ -140,12 +176,12 @@ public:
      * @param[in] location  The station's location code.  This should have
      *                      two letters.
      */
-    void setLocationCode(const std::string &location) noexcept;
+    void setLocationCode(std::string_view location) noexcept;
     /*!
      * @return The station's location code.
      * @throws std::runtime_error if this is not set.
      */
-    [[nodiscard]] std::string getLocationCode() const;
+    [[nodiscard]] std::string_view getLocationCode() const;
     /*!
      * @return True indicates that the location code was set.
      */
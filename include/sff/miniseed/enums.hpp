@@ -1,18 +1,14 @@
 #ifndef SFF_MINISEED_ENUMS_HPP
 #define SFF_MINISEED_ENUMS_HPP 1
+#include "sff/formats.hpp"
 namespace SFF::MiniSEED
 {
 /*!
- * @class Precision enums.hpp "sff/miniseed/enums.hpp"
  * @brief Defines the precision of the data in the trace.
+ * @note This is the library-wide precision so that miniSEED traces can report
+ *       their precision through SFF::AbstractBaseClass::ITrace.
  * @copyright Ben Baker (University of Utah) distributed under the MIT license.
  */
-enum class Precision 
-{
-    INT32,    /*!< 32-bit integer. */
-    FLOAT32,  /*!< 32-bit floating precision. */
-    FLOAT64,  /*!< 64-bit floating precision. */
-    UNKNOWN   /*1< An unknown precision. */
-};
+using Precision = SFF::Precision;
 }
 #endif
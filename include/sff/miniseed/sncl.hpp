@@ -1,11 +1,19 @@
 #ifndef SFF_MINISEED_SNCL_HPP
 #define SFF_MINISEED_SNCL_HPP
-#include <memory>
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <functional>
 #include <ostream>
+#include <string_view>
 namespace SFF::MiniSEED
 {
 /// @class SNCL "sncl.hpp" "sff/miniseed/sncl.hpp"
 /// @brief Defines a SEED station, network, channel, location name.
+/// @details This is a trivially copyable value type.  The codes are stored
+///          inline so copying, comparing, and hashing an SNCL never
+///          allocates.
 /// @copyright Ben Baker (University of Utah) distributed under the MIT license.
 class SNCL
 {
@@ -14,59 +22,40 @@ public:
     /// @{
 
     /// @brief Default constructor.
-    SNCL();
-    /// @brief Copy constructor.
-    /// @param[in] sncl  The SNCL class from which to initialize.
-    SNCL(const SNCL &sncl);
-    /// @brief Move constructor.
-    /// @param[in,out] sncl  The SNCL class to initialize from.  On exit
-    ///                      sncl's behavior is undefined.
-    SNCL(SNCL &&sncl) noexcept;
-    /// @}
-
-    /// @name Operators
-    /// @{
-
-    /// @brief Copy assignment operator.
-    /// @param[in] sncl  SNCL to copy.
-    /// @result A deep copy of sncl.
-    SNCL& operator=(const SNCL &sncl);
-    /// @brief Move assignment operator.
-    /// @param[in] sncl  SNCL whose memory will be moved to this.  On exit
-    ///                  sncl's behavior is undefined.
-    SNCL& operator=(SNCL &&sncl) noexcept;
-    /// @brief Equality operator.
-    /// @result True indicates that the given SNCL 
-    ///         equals the SNCL represented by this class.
-    //bool operator==(const SNCL &sncl) noexcept;
-    /// @brief Inequality operator.
-    /// @param[in] time  Class to test for inequality.
-    /// @result True indicates that the given  SNCL
-    ///         does not equal the SNCL represented by this class.
-    //bool operator!=(const SNCL &sncl) noexcept;
+    constexpr SNCL() noexcept = default;
     /// @}
 
     /// @name Destructors
     /// @{
 
-    /// @brief Default destructor.
-    ~SNCL();
     /// @brief Clears the SNCL.
-    void clear() noexcept; 
+    constexpr void clear() noexcept
+    {
+        mCodes.fill('\0');
+    }
     /// @}
 
     /// @name Network
     /// @{
 
     /// @brief Sets the network name.  If the network name exceeds
-    ///        \c getMaximumNetworkength() then this will be truncated.
+    ///        \c getMaximumNetworkLength() then this will be truncated.
     /// @param[in] name  The name of the network.
-    void setNetwork(const std::string &name) noexcept;
+    constexpr void setNetwork(const std::string_view name) noexcept
+    {
+        setCode(NETWORK, name);
+    }
     /// @result The name of the network.
-    [[nodiscard]] std::string getNetwork() const noexcept;
+    [[nodiscard]] constexpr std::string_view getNetwork() const noexcept
+    {
+        return getCode(NETWORK);
+    }
     /// @result The maximum network string length.
     /// @note A typical length is 2 but the file format can accomodate 10.
-    [[nodiscard]] static int getMaximumNetworkLength() noexcept;
+    [[nodiscard]] static constexpr int getMaximumNetworkLength() noexcept
+    {
+        return CODE_LENGTH;
+    }
     /// @} 
 
     /// @name Station
@@ -75,12 +64,21 @@ public:
     /// @brief Sets the station name.  If the station name exceeds
     ///        \c getMaximumStationLength() then this will be truncated.
     /// @param[in] name  The name of the station.
-    void setStation(const std::string &name) noexcept;
+    constexpr void setStation(const std::string_view name) noexcept
+    {
+        setCode(STATION, name);
+    }
     /// @result The name of the station.
-    [[nodiscard]] std::string getStation() const noexcept;
+    [[nodiscard]] constexpr std::string_view getStation() const noexcept
+    {
+        return getCode(STATION);
+    }
     /// @result The maximum station name string length.
     /// @note A typical length is 3-5 but the file format can accomodate 10.
-    [[nodiscard]] static int getMaximumStationLength() noexcept;
+    [[nodiscard]] static constexpr int getMaximumStationLength() noexcept
+    {
+        return CODE_LENGTH;
+    }
     /// @}
 
     /// @name Channel
@@ -88,12 +86,21 @@ public:
     /// @brief Sets the channel name.  If the channel name exceeds
     ///       \c getMaximumChannelLength then this will be truncated.
     /// @param[in] name  The name of the channel.
-    void setChannel(const std::string &name) noexcept;
+    constexpr void setChannel(const std::string_view name) noexcept
+    {
+        setCode(CHANNEL, name);
+    }
     /// @result The name of the channel.
-    [[nodiscard]] std::string getChannel() const noexcept;
+    [[nodiscard]] constexpr std::string_view getChannel() const noexcept
+    {
+        return getCode(CHANNEL);
+    }
     /// @result The maximum channel name string length.
     /// @note A typical length is 3 but the file format can accomodate 10.
-    [[nodiscard]] static int getMaximumChannelLength() noexcept;
+    [[nodiscard]] static constexpr int getMaximumChannelLength() noexcept
+    {
+        return CODE_LENGTH;
+    }
     /// @}
 
     /// @name Location Code
@@ -101,12 +108,21 @@ public:
     /// @brief Sets the location code.  If the location code exceeds
     ///        \c getMaximumLocationCodeLength() then this will be truncated.
     /// @param[in] name  The name of the location code.
-    void setLocationCode(const std::string &name) noexcept;
+    constexpr void setLocationCode(const std::string_view name) noexcept
+    {
+        setCode(LOCATION, name);
+    }
     /// @result The name of the location code.
-    [[nodiscard]] std::string getLocationCode() const noexcept;
+    [[nodiscard]] constexpr std::string_view getLocationCode() const noexcept
+    {
+        return getCode(LOCATION);
+    }
     /// @result The maximum location code string length.
     /// @note A typical length is 0 or 2 but the file format can accomodate 10.
-    [[nodiscard]] static int getMaximumLocationCodeLength() noexcept;
+    [[nodiscard]] static constexpr int getMaximumLocationCodeLength() noexcept
+    {
+        return CODE_LENGTH;
+    }
     /// @}
 
     /// @brief Convenience routine to determine if the network, station,
@@ -114,15 +130,72 @@ public:
     /// @result True indicates that there is no SNCL information.
     ///         False indicates that at least one of the SNCL elements is
     ///         defined.
-    [[nodiscard]] bool isEmpty() const noexcept;
+    [[nodiscard]] constexpr bool isEmpty() const noexcept
+    {
+        return mCodes[NETWORK] == '\0' && mCodes[STATION] == '\0' &&
+               mCodes[CHANNEL] == '\0' && mCodes[LOCATION] == '\0';
+    }
+    /// @result A 64-bit FNV-1a hash of the codes.
+    [[nodiscard]] constexpr size_t hash() const noexcept
+    {
+        uint64_t result = 14695981039346656037ULL;
+        for (const auto c : mCodes)
+        {
+            result = (result ^ static_cast<uint8_t> (c))*1099511628211ULL;
+        }
+        return static_cast<size_t> (result);
+    }
+
+    /// @brief Equality operator.
+    /// @result True indicates that the network, station, channel, and
+    ///         location codes of lhs and rhs are equal.
+    [[nodiscard]] friend constexpr bool
+        operator==(const SNCL &lhs, const SNCL &rhs) noexcept = default;
+    /// @brief Orders SNCLs by network, then station, then channel, then
+    ///        location code.
+    [[nodiscard]] friend constexpr std::strong_ordering
+        operator<=>(const SNCL &lhs, const SNCL &rhs) noexcept = default;
 private:
-    class SNCLImpl;
-    std::unique_ptr<SNCLImpl> pImpl;
+    static constexpr int CODE_LENGTH{10};
+    // Offsets of the codes in mCodes
+    static constexpr int NETWORK{0};
+    static constexpr int STATION{CODE_LENGTH};
+    static constexpr int CHANNEL{2*CODE_LENGTH};
+    static constexpr int LOCATION{3*CODE_LENGTH};
+    constexpr void setCode(const int offset, const std::string_view name) noexcept
+    {
+        auto length = std::min(name.size(), static_cast<size_t> (CODE_LENGTH));
+        for (int i = 0; i < CODE_LENGTH; ++i)
+        {
+            mCodes[offset + i] = (static_cast<size_t> (i) < length) ?
+                                 name[i] : '\0';
+        }
+    }
+    [[nodiscard]] constexpr std::string_view getCode(const int offset) const noexcept
+    {
+        // Codes are NULL padded so the first NULL ends the code
+        size_t length = 0;
+        while (length < CODE_LENGTH && mCodes[offset + length] != '\0')
+        {
+            length = length + 1;
+        }
+        return std::string_view(mCodes.data() + offset, length);
+    }
+    /// The NULL padded network, station, channel, and location codes.
+    std::array<char, 4*CODE_LENGTH> mCodes{};
 };
-[[nodiscard]] bool operator==(const SNCL &lhs, const SNCL &rhs);
-[[nodiscard]] bool operator!=(const SNCL &lhs, const SNCL &rhs);
 /// @brief Will write the contents of the SNCL in the form:
 ///        NETWORK.STATION.CHANNEL.LOCATION. 
 std::ostream& operator<<(std::ostream &os, const SNCL &sncl);
 }
+
+/// @brief Allows SNCLs to be keys in unordered containers.
+template<>
+struct std::hash<SFF::MiniSEED::SNCL>
+{
+    [[nodiscard]] constexpr size_t operator()(const SFF::MiniSEED::SNCL &sncl) const noexcept
+    {
+        return sncl.hash();
+    }
+};
 #endif
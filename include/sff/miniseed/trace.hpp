@@ -1,6 +1,7 @@
 #ifndef SFF_MINISEED_TRACE_HPP
 #define SFF_MINISEED_TRACE_HPP 1
 #include <memory>
+#include <memory_resource>
 #include "sff/abstractBaseClass/trace.hpp"
 #include "sff/utilities/time.hpp"
 #include "sff/miniseed/enums.hpp"
@@ -32,7 +33,8 @@ public:
 
     /// @brief Copy operator.
     /// @param[in] trace  The trace to copy.
-    /// @result A deep copy of trace.
+    /// @result A copy of trace.  The samples are shared until either trace
+    ///         modifies them.
     Trace& operator=(const Trace &trace);
     /// @brief Move assignment operator.
     /// @param[in,out] trace  The trace whose memory is to be moved to this.
@@ -94,7 +96,7 @@ public:
     /// @result The precision of the underlying time series data.
     /// @throws std::runtime_error if a time series was never set or read
     ///         from disk.
-    [[nodiscard]] Precision getPrecision() const;
+    [[nodiscard]] Precision getPrecision() const override;
     /// @}
 
     /// @name SNCL
@@ -164,6 +166,47 @@ public:
     /// @sa \c getNumberOfSamples()
     /// @sa \c getPrecision()
     [[nodiscard]] const int *getDataPointer32i() const;
+    /// @result A view of the time series data whose length is
+    ///         \c getNumberOfSamples().  Since copies share the samples this
+    ///         is valid only while this trace exists and its data is
+    ///         unmodified.  The same holds for the data pointers.
+    /// @throws std::runtime_error if the underlying precision does not match
+    ///         or the time series data was never set or read from disk.
+    /// @sa \c getPrecision()
+    [[nodiscard]] std::span<const double> getDataSpan64f() const override;
+    [[nodiscard]] std::span<const float>  getDataSpan32f() const override;
+    [[nodiscard]] std::span<const int>    getDataSpan32i() const override;
+    /// @brief Sets the memory resource from which the samples are allocated.
+    ///        Existing samples are moved to the new resource.  Subsequent
+    ///        reads allocate from this resource.
+    /// @param[in] resource  The memory resource.  This must outlive the
+    ///                      trace.  If this is NULL then the default resource
+    ///                      is used.
+    void setMemoryResource(std::pmr::memory_resource *resource);
+    /// @result The memory resource from which the samples are allocated.
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const noexcept;
+    /// @brief Copies the samples offset, ..., offset + count - 1 of the time
+    ///        series to x[0], x[stride], x[2*stride], ... converting the
+    ///        precision if necessary.
+    /// @param[out] x       The destination.  This must have length at least
+    ///                     (count - 1)*stride + 1.
+    /// @param[in] stride   The distance between consecutive samples in x.
+    /// @param[in] offset   The index of the first sample to copy.
+    /// @param[in] count    The number of samples to copy.  By default the
+    ///                     samples from offset to the end are copied.
+    /// @throws std::invalid_argument if stride is not positive, offset + count
+    ///         exceeds \c getNumberOfSamples(), or x is too small.
+    /// @throws std::runtime_error if the time series data was never set
+    ///         or read from disk.
+    void copyTo(std::span<double> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
+    void copyTo(std::span<float> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
+    void copyTo(std::span<int> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const;
     /// @}
 
     /// @result The seismic data format which in this instance is MINISEED.
@@ -2,7 +2,10 @@
 #define SFF_MINISEED_TRACEGROUP_HPP 1
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <future>
 #include "sff/utilities/time.hpp"
+#include "sff/utilities/asyncReader.hpp"
 #include "sff/miniseed/trace.hpp"
 #include "sff/miniseed/enums.hpp"
 
@@ -76,6 +79,47 @@ public:
      *         the file is malformed.
      */
     void read(const std::string &fileName);
+    /*!
+     * @brief Reads the miniSEED file and allocates the samples from the given
+     *        memory resource.
+     * @param[in] fileName  The name of the miniSEED file.
+     * @param[in] resource  The memory resource from which every trace's
+     *                      samples are allocated, e.g., an ArenaResource.
+     *                      This must outlive the traces.  If this is NULL
+     *                      then the default resource is used.
+     * @throws std::invalid_argument if the miniSEED file does not exist or
+     *         the file is malformed.
+     */
+    void read(const std::string &fileName,
+              std::pmr::memory_resource *resource);
+    /*!
+     * @brief Unpacks a miniSEED file that has already been read into memory.
+     *        As with \c read() only the first segment of each SNCL is kept.
+     * @param[in] nBytes    The number of bytes in the file.
+     * @param[in] bytes     The contents of the file.  This is an array whose
+     *                      dimension is [nBytes].
+     * @param[in] resource  The memory resource from which every trace's
+     *                      samples are allocated.  If this is NULL then the
+     *                      default resource is used.
+     * @throws std::invalid_argument if bytes is NULL or the records are
+     *         malformed.
+     */
+    void set(size_t nBytes, const char bytes[],
+             std::pmr::memory_resource *resource = nullptr);
+    /*!
+     * @brief Reads a miniSEED file asynchronously.
+     * @param[in] fileName  The name of the miniSEED file.
+     * @param[in] reader    The asynchronous reader that performs the I/O.
+     * @param[in] resource  The memory resource from which every trace's
+     *                      samples are allocated.  If this is NULL then the
+     *                      default resource is used.
+     * @result A future holding the trace group.  If the file does not exist or
+     *         is malformed then the future holds the exception.
+     */
+    [[nodiscard]] static std::future<TraceGroup>
+        readAsync(const std::string &fileName,
+                  SFF::Utilities::AsyncReader &reader,
+                  std::pmr::memory_resource *resource = nullptr);
     /*!
      * @brief Gets the SNCLs that exist in the archive.
      * @result The SNCLs that exist in the archive.  The result can be 
@@ -86,7 +130,8 @@ public:
     /*!
      * @brief Extracts a trace with given SNCL from the miniSEED archive.
      * @param[in] sncl  The SNCL to extract from the archive.
-     * @result The trace corresponding to the given SNCL.
+     * @result The trace corresponding to the given SNCL.  This shares the
+     *         samples with the group so no samples are copied.
      * @throws std::invalid_argument if the SNCL does not exist in the archive.
      * @sa \c haveSNCL()
      */
@@ -2,8 +2,11 @@
 #define SFF_SAC_WAVEFORM_HPP
 #include <memory>
 #include <string>
+#include <memory_resource>
 #include <vector>
+#include <future>
 #include "sff/abstractBaseClass/trace.hpp"
+#include "sff/utilities/asyncReader.hpp"
 #include "sff/utilities/time.hpp"
 #include "sff/formats.hpp"
 #include "sff/sac/enums.hpp"
@@ -37,7 +40,8 @@ public:
 
     /// @brief Copy assignment operator.
     /// @param[in] waveform  The waveform class to copy.
-    /// @result A deep copy of the input waveform.
+    /// @result A copy of the input waveform.  The samples are shared until
+    ///         either waveform modifies them.
     Waveform& operator=(const Waveform &waveform);
     /// @brief Move assignment operator.
     /// @param[in,out] waveform  The waveform to move.  On exit waveform's
@@ -168,8 +172,52 @@ public:
     void setData(int npts, const float data[]);
     /// @brief Returns a pointer to the data.
     /// @result A pointer to the data.  This can be NULL.  The length of
-    ///         the pointer is given by \c getNumberOfSamples().
+    ///         the pointer is given by \c getNumberOfSamples().  Like
+    ///         \c getDataSpan() this is valid only while this waveform
+    ///         exists and its data is unmodified.
     [[nodiscard]] const float *getDataPointer() const noexcept;
+    /// @brief Returns a view of the data.
+    /// @result A view of the data whose length is \c getNumberOfSamples().
+    ///         Copies of a waveform share its data, so this is valid only
+    ///         while this waveform exists and its data is unmodified; it
+    ///         does not keep the samples alive.
+    [[nodiscard]] std::span<const float> getDataSpan() const noexcept;
+    /// @result The same view as \c getDataSpan().
+    [[nodiscard]] std::span<const float> getDataSpan32f() const override;
+    /// @throws std::runtime_error since the data is FLOAT32.
+    [[nodiscard]] std::span<const double> getDataSpan64f() const override;
+    /// @throws std::runtime_error since the data is FLOAT32.
+    [[nodiscard]] std::span<const int> getDataSpan32i() const override;
+    /// @brief Sets the memory resource from which the samples are allocated.
+    ///        Existing samples are moved to the new resource.  Subsequent
+    ///        reads allocate from this resource.
+    /// @param[in] resource  The memory resource.  This must outlive the
+    ///                      waveform.  If this is NULL then the default
+    ///                      resource is used.
+    void setMemoryResource(std::pmr::memory_resource *resource);
+    /// @result The memory resource from which the samples are allocated.
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const noexcept;
+    /// @result The precision of the data which in this instance is FLOAT32.
+    [[nodiscard]] SFF::Precision getPrecision() const noexcept override;
+    /// @brief Copies the samples offset, ..., offset + count - 1 of the data
+    ///        to destination[0], destination[stride], ...
+    /// @param[out] destination  The destination.  This must have length at
+    ///                          least (count - 1)*stride + 1.
+    /// @param[in] stride        The distance between consecutive samples in
+    ///                          the destination.
+    /// @param[in] offset        The index of the first sample to copy.
+    /// @param[in] count         The number of samples to copy.  By default
+    ///                          the samples from offset to the end are
+    ///                          copied.
+    /// @throws std::invalid_argument if stride is not positive, offset + count
+    ///         exceeds \c getNumberOfSamples(), or destination is too small.
+    void copyTo(std::span<double> destination, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
+    /// @copydoc copyTo
+    void copyTo(std::span<float> destination, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
 
     void getData(int npts, double *data[]) const override;
     void getData(int npts, float *data[]) const override;
@@ -198,6 +246,21 @@ public:
     void read(const std::string &fileName,
               const SFF::Utilities::Time &t0,
               const SFF::Utilities::Time &t1);
+    /// @brief Unpacks a SAC file that has already been read into memory.
+    /// @param[in] nBytes  The number of bytes in the file.
+    /// @param[in] bytes   The contents of the file.  This is an array whose
+    ///                    dimension is [nBytes].
+    /// @throws std::invalid_argument if bytes is NULL or is not a SAC file.
+    void set(size_t nBytes, const char bytes[]);
+    /// @brief Loads a SAC data file asynchronously.
+    /// @param[in] fileName  The name of file to read.
+    /// @param[in] reader    The asynchronous reader that performs the I/O.
+    ///                      This must outlive the returned future's readiness.
+    /// @result A future holding the waveform.  If the file does not exist or
+    ///         is unreadable then the future holds the exception.
+    [[nodiscard]] static std::future<Waveform>
+        readAsync(const std::string &fileName,
+                  SFF::Utilities::AsyncReader &reader);
     /// @brief Writes the SAC file.
     /// @param[out] fileName  The SAC file to write.
     /// @throws std::invalid_argument if the path to fileName is invalid.
@@ -0,0 +1,19 @@
+#ifndef SFF_SEGY_ENUMS_HPP
+#define SFF_SEGY_ENUMS_HPP 1
+namespace SFF::SEGY
+{
+/*!
+ * @brief Defines the data sample format codes in bytes 3225-3226 of the
+ *        binary file header.
+ * @copyright Ben Baker (University of Utah) distributed under the MIT license.
+ */
+enum class SampleFormat
+{
+    IBM_FLOAT32  = 1, /*!< 4-byte IBM floating-point. */
+    INT32        = 2, /*!< 4-byte, two's complement integer. */
+    INT16        = 3, /*!< 2-byte, two's complement integer. */
+    IEEE_FLOAT32 = 5, /*!< 4-byte IEEE floating-point. */
+    INT8         = 8  /*!< 1-byte, two's complement integer. */
+};
+}
+#endif
@@ -2,11 +2,17 @@
 #define SFF_SEGY_SILIXA_BINARYFILEHEADER_HPP
 #include <memory>
 #include <string>
+#include <cstdint>
 namespace SFF::SEGY::Silixa
 {
 /*!
  * @class BinaryFileHeader silixa.hpp "sff/segy/silixa.hpp"
  * @brief Defines the custom Silixa 400 byte binary file header.
+ * @note Silixa stores a 32-bit number of samples per trace at bytes 3263-3266
+ *       which collides with the SEG-Y rev2 extended number of traces per
+ *       ensemble.  Hence, when the counts overflow the 16-bit fields this
+ *       class writes a rev2 header whose 64-bit number of traces is at bytes
+ *       3513-3520 and whose extended number of samples is at bytes 3269-3272.
  * @copyright Ben Baker (University of Utah) distributed under the MIT license.
  */
 class BinaryFileHeader
@@ -82,15 +88,16 @@ public:
 
     /*!
      * @brief Sets the number of traces in the file.
-     * @param[in] nTraces  The number of traces in the file.  
+     * @param[in] nTraces  The number of traces in the file.  If this exceeds
+     *                     32767 then the rev2 64-bit trace count is used.
      * @throws std::invalid_argument if this is negative.
      */
-    void setNumberOfTraces(int16_t nTraces);
+    void setNumberOfTraces(int64_t nTraces);
     /*!
      * @brief Gets the number of traces in the file.
      * @result The number of traces in the file.
      */
-    int getNumberOfTraces() const;
+    int64_t getNumberOfTraces() const;
 
     /*!
      * @brief Sets the temporal sample interval.
@@ -110,12 +117,32 @@ public:
      * @param[in] nSamples  The number of samples per trace.
      * @throws std::invalid_argument if this is not positive.
      */
-    void setNumberOfSamplesPerTrace(int16_t nSamples);
+    void setNumberOfSamplesPerTrace(int nSamples);
     /*!
      * @brief Gets the number of samples in each trace.
      * @result The number of samples per trace.
      */
     int getNumberOfSamplesPerTrace() const;
+
+    /*!
+     * @brief Sets the number of 3200 byte extended textual file headers
+     *        that follow the binary file header.
+     * @param[in] nHeaders  The number of extended textual headers.
+     * @throws std::invalid_argument if this is negative or exceeds 32767.
+     */
+    void setNumberOfExtendedTextualHeaders(int nHeaders);
+    /*!
+     * @brief Gets the number of extended textual file headers.
+     * @result The number of 3200 byte extended textual headers between the
+     *         binary file header and the first trace.
+     */
+    int getNumberOfExtendedTextualHeaders() const;
+    /*!
+     * @brief Gets the byte offset of the first trace in the file.
+     * @result The byte offset of the first trace header.  This accounts for
+     *         the extended textual headers.
+     */
+    int64_t getFirstTraceOffset() const;
     /*!
      * @brief Determines whether or not a valid binary file header.
      */
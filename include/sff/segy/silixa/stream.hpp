@@ -0,0 +1,162 @@
+#ifndef SFF_SEGY_SILIXA_STREAM_HPP
+#define SFF_SEGY_SILIXA_STREAM_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "sff/utilities/time.hpp"
+namespace SFF::SEGY::Silixa
+{
+/// @class Stream stream.hpp "sff/segy/silixa/stream.hpp"
+/// @brief Treats a sequence of Silixa SEGY files that were written back to
+///        back, e.g., the 30 to 60 second files written by an iDAS, as one
+///        continuous [channel x time] matrix and slides a window over it.
+/// @details Opening the stream reads only the file headers and first trace
+///          header of each file.  The files are ordered by their start time
+///          and each file must begin one sampling period after the last
+///          sample of the previous file.  The number of channels and the
+///          sampling period must not change.
+///
+///          At most two files are held in memory: the file being consumed
+///          and the next file which is read in the background.  Hence,
+///          the memory is independent of the number of files and detectors
+///          can be run over days of data.
+/// @code
+///    Stream stream;
+///    stream.open(fileNames);
+///    stream.setWindow(2000, 1000);
+///    while (stream.nextWindow())
+///    {
+///        auto window = stream.getWindow();
+///        // Channel i's samples begin at window[i*stream.getWindowLength()]
+///    }
+/// @endcode
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Stream
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    Stream();
+    /// @brief Move constructor.
+    /// @param[in,out] stream  The stream from which to initialize this class.
+    ///                        On exit, stream's behavior is undefined.
+    Stream(Stream &&stream) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Move assignment operator.
+    /// @param[in,out] stream  The stream whose memory will be moved to this.
+    ///                        On exit, stream's behavior is undefined.
+    /// @result The memory from stream moved to this.
+    Stream& operator=(Stream &&stream) noexcept;
+    /// @}
+
+    /// @name Opening
+    /// @{
+
+    /// @brief Sets the tolerance used when checking that consecutive files
+    ///        are continuous.
+    /// @param[in] tolerance  The largest acceptable difference in seconds
+    ///                       between a file's start time and the time
+    ///                       following the last sample of the previous file.
+    ///                       By default this is half a sampling period.
+    /// @throws std::invalid_argument if tolerance is negative.
+    /// @note This must be set prior to calling \c open().
+    void setContinuityTolerance(double tolerance);
+    /// @brief Anti-alias filters and decimates each file as it is loaded.
+    ///        The filter state is carried across file boundaries so the
+    ///        stream is filtered as one continuous signal.
+    /// @param[in] factor  The decimation factor.  If this is 1 then the
+    ///                    stream is not decimated.  This is the default.
+    /// @throws std::invalid_argument if factor is not positive.
+    /// @note This must be set prior to calling \c open().  The filter is
+    ///       that of SFF::Utilities::Decimator::initialize() and the start
+    ///       time of the stream is shifted by the filter's group delay.
+    void setDecimationFactor(int factor);
+    /// @result The decimation factor.
+    [[nodiscard]] int getDecimationFactor() const noexcept;
+    /// @brief Opens the stream.
+    /// @param[in] fileNames  The Silixa SEGY files comprising the stream.
+    ///                       These may be given in any order.
+    /// @throws std::invalid_argument if fileNames is empty, a file cannot be
+    ///         read, the files have a different number of channels or
+    ///         sampling period, or there is a gap or overlap between
+    ///         consecutive files.
+    void open(const std::vector<std::string> &fileNames);
+    /// @result True indicates the stream is open.
+    [[nodiscard]] bool isOpen() const noexcept;
+    /// @result The files in the stream ordered by start time.
+    [[nodiscard]] std::vector<std::string> getFileNames() const;
+    /// @result The number of channels.
+    /// @throws std::runtime_error if the stream is not open.
+    [[nodiscard]] int getNumberOfChannels() const;
+    /// @result The sampling period in seconds after decimation.
+    /// @throws std::runtime_error if the stream is not open.
+    [[nodiscard]] double getSamplingPeriod() const;
+    /// @result The number of samples in each channel of the stream after
+    ///         decimation.
+    /// @throws std::runtime_error if the stream is not open.
+    [[nodiscard]] int64_t getNumberOfSamples() const;
+    /// @result The time of the first sample in the stream.
+    /// @throws std::runtime_error if the stream is not open.
+    [[nodiscard]] SFF::Utilities::Time getStartTime() const;
+    /// @}
+
+    /// @name Sliding Window
+    /// @{
+
+    /// @brief Sets the window dimensions and rewinds the window to the
+    ///        start of the stream.
+    /// @param[in] windowLength  The number of samples in each channel of the
+    ///                          window.
+    /// @param[in] windowStep    The number of samples the window advances
+    ///                          on each call to \c nextWindow().
+    /// @throws std::invalid_argument if windowLength or windowStep is not
+    ///         positive.
+    /// @throws std::runtime_error if the stream is not open.
+    void setWindow(int windowLength, int windowStep);
+    /// @brief Advances the window.  The first call loads the first window.
+    /// @result True indicates the window was advanced.  False indicates the
+    ///         stream does not have enough samples left to fill the window.
+    /// @throws std::runtime_error if the stream or window is not set or a
+    ///         file cannot be read.
+    [[nodiscard]] bool nextWindow();
+    /// @result The window.  This is a row major matrix whose dimension is
+    ///         [\c getNumberOfChannels() x \c getWindowLength()] so that
+    ///         the i'th channel begins at i*getWindowLength().  This is
+    ///         invalidated by the next call to \c nextWindow().
+    /// @throws std::runtime_error if \c nextWindow() has not returned true.
+    [[nodiscard]] std::span<const float> getWindow() const;
+    /// @result The number of samples in each channel of the window.
+    [[nodiscard]] int getWindowLength() const noexcept;
+    /// @result The index of the window's first sample in the stream.
+    /// @throws std::runtime_error if \c nextWindow() has not returned true.
+    [[nodiscard]] int64_t getWindowStartSample() const;
+    /// @result The time of the window's first sample.
+    /// @throws std::runtime_error if \c nextWindow() has not returned true.
+    [[nodiscard]] SFF::Utilities::Time getWindowStartTime() const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Closes the stream and waits for any background reads.
+    void close() noexcept;
+    /// @brief Destructor.
+    ~Stream();
+    /// @}
+
+    Stream(const Stream &) = delete;
+    Stream& operator=(const Stream &) = delete;
+private:
+    class StreamImpl;
+    std::unique_ptr<StreamImpl> pImpl;
+};
+}
+#endif
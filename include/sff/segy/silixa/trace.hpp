@@ -2,6 +2,7 @@
 #define SFF_SEGY_SILIXA_TRACE_HPP
 #include <memory>
 #include <string>
+#include <memory_resource>
 #include "sff/abstractBaseClass/trace.hpp"
 #include "sff/segy/silixa/traceHeader.hpp"
 #include "sff/utilities/time.hpp"
@@ -32,7 +33,8 @@ public:
 
     /// @brief Copy assignment operator.
     /// @param[in] trace  The trace class to copy to this.
-    /// @result A deep copy of the trace class.
+    /// @result A copy of the trace class.  The samples are shared until
+    ///         either trace modifies them.
     Trace& operator=(const Trace &trace);
     /// @brief Move assignment operator.
     /// @param[in,out] trace  The trace class whose memory will be moved to this.
@@ -53,6 +55,14 @@ public:
     /// @throws std::invalid_argument if x is NULL or the header and len yield
     ///         an inconsistency.
     void set(int len, const char x[]);
+    /// @brief Packs the header and time series data into a character array.
+    ///        This is the inverse of \c set().
+    /// @param[in] len    The length of x.  This must be
+    ///                   240 + 4*\c getNumberOfSamples().
+    /// @param[out] x     The trace header followed by the big-endian time
+    ///                   series.  This is an array whose dimension is [len].
+    /// @throws std::invalid_argument if x is NULL or len is incorrect.
+    void get(int len, char *x[]) const;
     /// @brief Sets the time series.
     /// @param[in] nSamples  The number of points in the time series.
     /// @param[in] x         The time series to set.  This is an array whose
@@ -70,6 +80,50 @@ public:
     void getData(int nSamples, double *x[]) const override;
     /// @copydoc getData 
     void getData(int nSamples, float *x[]) const override;
+    /// @brief Returns a pointer to the time series data.
+    /// @result A pointer to the data.  This can be NULL.  The length of the
+    ///         pointer is given by \c getNumberOfSamples().  The lifetime
+    ///         is the same as that of \c getDataSpan().
+    [[nodiscard]] const float *getDataPointer() const noexcept;
+    /// @brief Returns a view of the time series data.
+    /// @result A view of the data whose length is \c getNumberOfSamples().
+    ///         The samples may be shared with copies of this trace.  The
+    ///         view is valid only while this trace exists and its data is
+    ///         unmodified.
+    [[nodiscard]] std::span<const float> getDataSpan() const noexcept;
+    /// @result The same view as \c getDataSpan().
+    [[nodiscard]] std::span<const float> getDataSpan32f() const override;
+    /// @throws std::runtime_error since the data is FLOAT32.
+    [[nodiscard]] std::span<const double> getDataSpan64f() const override;
+    /// @throws std::runtime_error since the data is FLOAT32.
+    [[nodiscard]] std::span<const int> getDataSpan32i() const override;
+    /// @brief Sets the memory resource from which the samples are allocated.
+    ///        Existing samples are moved to the new resource.
+    /// @param[in] resource  The memory resource.  This must outlive the
+    ///                      trace.  If this is NULL then the default resource
+    ///                      is used.
+    void setMemoryResource(std::pmr::memory_resource *resource);
+    /// @result The memory resource from which the samples are allocated.
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const noexcept;
+    /// @result The precision of the data which in this instance is FLOAT32.
+    [[nodiscard]] SFF::Precision getPrecision() const noexcept override;
+    /// @brief Copies the samples offset, ..., offset + count - 1 of the time
+    ///        series to x[0], x[stride], x[2*stride], ...
+    /// @param[out] x       The destination.  This must have length at least
+    ///                     (count - 1)*stride + 1.
+    /// @param[in] stride   The distance between consecutive samples in x.
+    /// @param[in] offset   The index of the first sample to copy.
+    /// @param[in] count    The number of samples to copy.  By default the
+    ///                     samples from offset to the end are copied.
+    /// @throws std::invalid_argument if stride is not positive, offset + count
+    ///         exceeds \c getNumberOfSamples(), or x is too small.
+    void copyTo(std::span<double> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
+    /// @copydoc copyTo
+    void copyTo(std::span<float> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
     /// @result The number of samples in the trace.
     [[nodiscard]] int getNumberOfSamples() const override;
     /// @}
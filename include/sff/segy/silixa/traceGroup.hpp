@@ -2,6 +2,9 @@
 #define SFF_SEGY_SILIXA_TRACEGROUP_HPP
 #include <memory>
 #include <vector>
+#include <future>
+#include <memory_resource>
+#include "sff/utilities/asyncReader.hpp"
 #include "sff/segy/silixa/binaryFileHeader.hpp"
 #include "sff/segy/silixa/trace.hpp"
 
@@ -9,6 +12,10 @@ namespace SFF::SEGY
 {
 class TextualFileHeader;
 }
+namespace SFF::Utilities
+{
+class Decimator;
+}
 
 /*
 namespace SFF::SEGY::Silixa
@@ -76,7 +83,8 @@ public:
     /*!
      * @brief Returns a the trace at the indicated position.
      * @param[in] index   The index of the desired trace in the trace group.
-     * @result The index'th trace.
+     * @result The index'th trace.  This shares the samples with the group
+     *         so no samples are copied.
      */
     Trace operator[](size_t index);
     /*!
@@ -111,6 +119,131 @@ public:
      *         is improperly formated.
      */
     void read(const std::string &fileName);
+    /*!
+     * @brief Reads a Silixa SEGY file from disk and allocates the samples from
+     *        the given memory resource.
+     * @param[in] fileName  The name of the SEGY file.
+     * @param[in] resource  The memory resource from which every trace's
+     *                      samples are allocated, e.g., an ArenaResource.
+     *                      This must outlive the traces.  If this is NULL
+     *                      then the default resource is used.
+     * @throws std::invalid_argument if the fileName does not exist or the file
+     *         is improperly formated.
+     */
+    void read(const std::string &fileName,
+              std::pmr::memory_resource *resource);
+    /*!
+     * @brief Reads a subset of the channels and samples of a Silixa SEGY
+     *        file from disk.
+     * @details Since every trace has the same length the byte offsets of
+     *          the requested trace headers and sample windows are computed
+     *          from the binary file header.  Only those byte ranges are read
+     *          with scatter reads so the I/O is proportional to the subset
+     *          rather than the file size.  The binary file header and the
+     *          trace headers are updated to reflect the subset.
+     * @param[in] fileName      The name of the SEGY file.
+     * @param[in] firstChannel  The index of the first trace to read.  This
+     *                          must be in the range
+     *                          [0, number of traces in file - 1].
+     * @param[in] lastChannel   The index of the last trace to read.  This
+     *                          must be in the range
+     *                          [firstChannel, number of traces in file - 1].
+     * @param[in] firstSample   The index of the first sample to read in each
+     *                          trace.  This must be in the range
+     *                          [0, samples per trace - 1].
+     * @param[in] lastSample    The index of the last sample to read in each
+     *                          trace.  This must be in the range
+     *                          [firstSample, samples per trace - 1].
+     * @param[in] resource      The memory resource from which every trace's
+     *                          samples are allocated.  If this is NULL then
+     *                          the default resource is used.
+     * @throws std::invalid_argument if the fileName does not exist, the file
+     *         is improperly formatted, or the ranges are invalid.
+     * @throws std::runtime_error if the read fails.
+     */
+    void read(const std::string &fileName,
+              int firstChannel, int lastChannel,
+              int firstSample, int lastSample,
+              std::pmr::memory_resource *resource = nullptr);
+    /*!
+     * @brief Reads a subset of the channels of a Silixa SEGY file from disk
+     *        in the given time window.
+     * @details This is like the sample range variant where the sample range
+     *          is computed from the start time and sampling period of the
+     *          first requested trace.  The window is clipped to the traces.
+     * @param[in] fileName      The name of the SEGY file.
+     * @param[in] firstChannel  The index of the first trace to read.
+     * @param[in] lastChannel   The index of the last trace to read.
+     * @param[in] startTime     The time of the first sample to read.  The
+     *                          first sample is at or after this time.
+     * @param[in] endTime       The time of the last sample to read.  The
+     *                          last sample is at or before this time.
+     * @param[in] resource      The memory resource from which every trace's
+     *                          samples are allocated.  If this is NULL then
+     *                          the default resource is used.
+     * @throws std::invalid_argument if the fileName does not exist, the file
+     *         is improperly formatted, the channel range is invalid, or the
+     *         time window does not contain any samples.
+     * @throws std::runtime_error if the read fails.
+     */
+    void read(const std::string &fileName,
+              int firstChannel, int lastChannel,
+              const SFF::Utilities::Time &startTime,
+              const SFF::Utilities::Time &endTime,
+              std::pmr::memory_resource *resource = nullptr);
+    /*!
+     * @brief Reads a Silixa SEGY file from disk and filters and decimates
+     *        every trace as it is unpacked.
+     * @details The traces are read and unpacked in blocks of channels so
+     *          only a block of full-rate samples is in memory at any time.
+     *          The decimator retains its filter state so passing the same
+     *          decimator to consecutive files filters them as one continuous
+     *          signal.  The start times are shifted by the decimator's
+     *          group delay.
+     * @param[in] fileName       The name of the SEGY file.
+     * @param[in,out] decimator  The decimator.  This must be initialized with
+     *                           the number of traces in the file.  On exit,
+     *                           the filter state is updated.
+     * @param[in] resource       The memory resource from which every trace's
+     *                           samples are allocated.  If this is NULL then
+     *                           the default resource is used.
+     * @throws std::invalid_argument if the fileName does not exist, the file
+     *         is improperly formatted, the decimator is not initialized or
+     *         has a different number of channels, or the decimated sampling
+     *         period cannot be represented in the trace header.
+     * @throws std::runtime_error if the read fails.
+     */
+    void read(const std::string &fileName,
+              SFF::Utilities::Decimator &decimator,
+              std::pmr::memory_resource *resource = nullptr);
+    /*!
+     * @brief Unpacks a Silixa SEGY file that has already been read into
+     *        memory.
+     * @param[in] nBytes    The number of bytes in the file.
+     * @param[in] bytes     The contents of the file.  This is an array whose
+     *                      dimension is [nBytes].
+     * @param[in] resource  The memory resource from which every trace's
+     *                      samples are allocated.  If this is NULL then the
+     *                      default resource is used.
+     * @throws std::invalid_argument if bytes is NULL or the file is
+     *         improperly formatted.
+     */
+    void set(size_t nBytes, const char bytes[],
+             std::pmr::memory_resource *resource = nullptr);
+    /*!
+     * @brief Reads a Silixa SEGY file asynchronously.
+     * @param[in] fileName  The name of the SEGY file.
+     * @param[in] reader    The asynchronous reader that performs the I/O.
+     * @param[in] resource  The memory resource from which every trace's
+     *                      samples are allocated.  If this is NULL then the
+     *                      default resource is used.
+     * @result A future holding the trace group.  If the file does not exist or
+     *         is improperly formatted then the future holds the exception.
+     */
+    [[nodiscard]] static std::future<TraceGroup>
+        readAsync(const std::string &fileName,
+                  SFF::Utilities::AsyncReader &reader,
+                  std::pmr::memory_resource *resource = nullptr);
 
     /*!
      * @brief Gets the number of samples in each trace.
@@ -122,6 +255,55 @@ public:
      * @result The number of traces in the group.
      */
     int getNumberOfTraces() const; 
+    /*!
+     * @brief Gets the data in all traces as a matrix.
+     * @param[in] nTraces           The number of traces.  This must equal
+     *                              \c getNumberOfTraces().
+     * @param[in] nSamplesPerTrace  The number of samples in each trace.  This
+     *                              must equal \c getNumberOfSamplesPerTrace().
+     * @param[out] data             The trace data.  This is a row major
+     *                              matrix whose dimension is
+     *                              [nTraces x nSamplesPerTrace] so that the
+     *                              i'th trace begins at i*nSamplesPerTrace.
+     * @throws std::invalid_argument if nTraces or nSamplesPerTrace are
+     *         inconsistent with the group or data is NULL and the matrix is
+     *         not empty.
+     */
+    void getData(int nTraces, int nSamplesPerTrace, float *data[]) const;
+    /*!
+     * @brief Sets the traces.  The file headers are retained so that, e.g.,
+     *        a group can be read, decimated, and written.
+     * @param[in] traces  The traces.  Each trace must have the same number
+     *                    of samples and sampling period.
+     * @throws std::invalid_argument if the traces are inconsistent.
+     */
+    void setTraces(const std::vector<Trace> &traces);
+    /*! @copydoc setTraces */
+    void setTraces(std::vector<Trace> &&traces);
+
+    /*!
+     * @brief Writes the traces as a Silixa SEGY file.
+     * @details The textual and binary file headers, trace headers, and
+     *          big-endian samples are packed into large aligned buffers by a
+     *          pool of threads while a single thread writes the previously
+     *          packed buffer.  The number of traces, samples per trace, and
+     *          sample interval in the binary file header are taken from the
+     *          traces.
+     * @param[in] fileName     The name of the file to write.
+     * @param[in] useDirectIO  If true then the file is opened with O_DIRECT
+     *                         to bypass the page cache.  This is useful for
+     *                         multi-GB files.  If the filesystem does not
+     *                         support O_DIRECT then buffered I/O is used.
+     * @param[in] nThreads     The number of packing threads.  If this is not
+     *                         positive then the hardware concurrency is used.
+     * @throws std::invalid_argument if there are no traces, the traces are
+     *         inconsistent, or the dimensions cannot be represented in the
+     *         binary file header.
+     * @throws std::runtime_error if the file cannot be opened or written.
+     */
+    void write(const std::string &fileName,
+               bool useDirectIO = false,
+               int nThreads = 0) const;
 
     /*! @name Iterators
      * @{
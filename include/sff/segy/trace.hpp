@@ -0,0 +1,160 @@
+#ifndef SFF_SEGY_TRACE_HPP
+#define SFF_SEGY_TRACE_HPP
+#include <memory>
+#include <string>
+#include <span>
+#include "sff/abstractBaseClass/trace.hpp"
+#include "sff/segy/enums.hpp"
+#include "sff/utilities/time.hpp"
+namespace SFF::SEGY
+{
+/// @class Trace "trace.hpp" "sff/segy/trace.hpp"
+/// @brief A trace from a standard SEG-Y file.  Integer samples are stored as
+///        32-bit integers and floating-point samples, including those
+///        converted from IBM floats, are stored as 32-bit IEEE floats.
+/// @sa SFF::SEGY::TraceGroup
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Trace : public SFF::AbstractBaseClass::ITrace
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    Trace();
+    /// @brief Copy constructor.
+    /// @param[in] trace  The trace class from which to initialize this class.
+    Trace(const Trace &trace);
+    /// @brief Move constructor.
+    /// @param[in,out] trace  The trace class from which to initialize this
+    ///                       class.  On exit, trace's behavior is undefined.
+    Trace(Trace &&trace) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] trace  The trace class to copy to this.
+    /// @result A deep copy of the trace class.
+    Trace& operator=(const Trace &trace);
+    /// @brief Move assignment operator.
+    /// @param[in,out] trace  The trace class whose memory will be moved to this.
+    ///                       On exit, trace's behavior is undefined.
+    /// @result The memory from trace moved to this.
+    Trace& operator=(Trace &&trace) noexcept;
+    /// @}
+
+    /// @name Trace Header
+    /// @{
+
+    /// @brief Sets the 240 byte trace header.
+    /// @param[in] header  The trace header as it was stored in the file.
+    /// @throws std::invalid_argument if header is NULL.
+    void setTraceHeader(const char header[240]);
+    /// @result The 240 byte trace header as it was stored in the file.
+    [[nodiscard]] std::string getTraceHeader() const noexcept;
+    /// @brief Sets the trace sequence number within the line.
+    void setTraceNumber(int traceNumber) noexcept;
+    /// @result The trace sequence number within the line.
+    [[nodiscard]] int getTraceNumber() const noexcept;
+    /// @brief Sets the format in which the samples were stored on disk.
+    void setSampleFormat(SampleFormat format) noexcept;
+    /// @result The format in which the samples were stored on disk.
+    [[nodiscard]] SampleFormat getSampleFormat() const noexcept;
+    /// @}
+
+    /// @name Time Series Data
+    /// @{
+
+    /// @brief Sets the time series.
+    /// @param[in] nSamples  The number of points in the time series.
+    /// @param[in] x         The time series to set.  This is an array whose
+    ///                      dimension is [nSamples].
+    /// @throws std::invalid_argument if nSamples is negative or x is NULL
+    ///         and nSamples is positive.
+    void setData(int nSamples, const float x[]);
+    /// @copydoc setData
+    void setData(int nSamples, const int x[]);
+    /// @brief Gets the time series data.
+    /// @param[in] nSamples  The number of points in x.  This must match
+    ///                      the result of \c getNumberOfSamples().
+    /// @param[out] x        The time series.  This is an array whose
+    ///                      dimension is [nSamples].
+    /// @throws std::invalid_argument if nSamples is incorrect or x is NULL.
+    void getData(int nSamples, double *x[]) const override;
+    /// @copydoc getData
+    void getData(int nSamples, float *x[]) const override;
+    /// @result A view of the time series data whose length is
+    ///         \c getNumberOfSamples().
+    /// @throws std::runtime_error if \c getPrecision() is not FLOAT32.
+    [[nodiscard]] std::span<const float> getDataSpan32f() const override;
+    /// @result A view of the time series data whose length is
+    ///         \c getNumberOfSamples().
+    /// @throws std::runtime_error if \c getPrecision() is not INT32.
+    [[nodiscard]] std::span<const int> getDataSpan32i() const override;
+    /// @throws std::runtime_error since the samples are never FLOAT64.
+    [[nodiscard]] std::span<const double> getDataSpan64f() const override;
+    /// @brief Copies the samples offset, ..., offset + count - 1 of the time
+    ///        series to x[0], x[stride], x[2*stride], ... converting the
+    ///        precision if necessary.
+    /// @param[out] x       The destination.  This must have length at least
+    ///                     (count - 1)*stride + 1.
+    /// @param[in] stride   The distance between consecutive samples in x.
+    /// @param[in] offset   The index of the first sample to copy.
+    /// @param[in] count    The number of samples to copy.  By default the
+    ///                     samples from offset to the end are copied.
+    /// @throws std::invalid_argument if stride is not positive, offset + count
+    ///         exceeds \c getNumberOfSamples(), or x is too small.
+    void copyTo(std::span<double> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
+    /// @copydoc copyTo
+    void copyTo(std::span<float> x, size_t stride = 1,
+                size_t offset = 0,
+                size_t count = std::dynamic_extent) const override;
+    /// @result The precision of the stored samples.  This is INT32 for
+    ///         integer data and FLOAT32 otherwise.
+    [[nodiscard]] SFF::Precision getPrecision() const noexcept override;
+    /// @result The number of samples in the trace.
+    [[nodiscard]] int getNumberOfSamples() const noexcept override;
+    /// @}
+
+    /// @name Sampling Rate
+    /// @{
+
+    /// @brief Sets the sampling period in seconds.
+    /// @param[in] dt  The sampling period in seconds.
+    /// @throws std::invalid_argument if dt is not positive.
+    void setSamplingPeriod(double dt);
+    /// @result The sampling period in seconds.
+    /// @throws std::runtime_error if this was not set.
+    [[nodiscard]] double getSamplingPeriod() const override;
+    /// @result The sampling rate in Hz.
+    /// @throws std::runtime_error if this was not set.
+    [[nodiscard]] double getSamplingRate() const override;
+    /// @}
+
+    /// @brief Sets the time of the first sample.
+    void setStartTime(const SFF::Utilities::Time &time);
+    /// @result The time of the first sample.  If the trace header does not
+    ///         have a valid year, day, and time then this is the epoch.
+    [[nodiscard]] SFF::Utilities::Time getStartTime() const override;
+
+    /// @result The data format which in this instance is SEGY.
+    [[nodiscard]] SFF::Format getFormat() const noexcept override;
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Releases the memory on the class and resets the variables.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~Trace() override;
+    /// @}
+private:
+    class TraceImpl;
+    std::unique_ptr<TraceImpl> pImpl;
+};
+}
+#endif
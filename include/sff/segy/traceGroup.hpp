@@ -0,0 +1,132 @@
+#ifndef SFF_SEGY_TRACEGROUP_HPP
+#define SFF_SEGY_TRACEGROUP_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "sff/segy/enums.hpp"
+namespace SFF::SEGY
+{
+class TextualFileHeader;
+class Trace;
+/// @class TraceGroup traceGroup.hpp "sff/segy/traceGroup.hpp"
+/// @brief Reads standard rev0, rev1, and rev2 SEG-Y files, e.g., from active
+///        source experiments.  Unlike SFF::SEGY::Silixa::TraceGroup the
+///        samples may be IBM floats, IEEE floats, or 8, 16, or 32-bit
+///        integers and the traces may have different lengths.
+/// @details Opening a file reads the file headers and makes one pass over
+///          the trace headers to index each trace's byte offset and number
+///          of samples.  When the binary file header indicates fixed length
+///          traces the offsets are computed without touching the trace
+///          headers.  Any trace can then be read by random access.
+///
+///          Big-endian files and rev2 little-endian files, as indicated by
+///          the integer constant at bytes 3297-3300, are supported.  Files
+///          with a variable number of extended textual headers or with
+///          additional trace headers are not supported.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class TraceGroup
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    TraceGroup();
+    /// @brief Copy constructor.
+    /// @param[in] group  The trace group from which to initialize this class.
+    TraceGroup(const TraceGroup &group);
+    /// @brief Move constructor.
+    /// @param[in,out] group  The trace group from which to initialize this
+    ///                       class.  On exit, group's behavior is undefined.
+    TraceGroup(TraceGroup &&group) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] group  The trace group to copy.
+    /// @result A copy of the group.  The copy refers to the same file.
+    TraceGroup& operator=(const TraceGroup &group);
+    /// @brief Move assignment operator.
+    /// @param[in,out] group  The trace group whose memory will be moved to
+    ///                       this.  On exit, group's behavior is undefined.
+    /// @result The memory from group moved to this.
+    TraceGroup& operator=(TraceGroup &&group) noexcept;
+    /// @}
+
+    /// @name Reading
+    /// @{
+
+    /// @brief Opens a SEG-Y file, reads its file headers, and indexes its
+    ///        traces.
+    /// @param[in] fileName  The name of the SEG-Y file.
+    /// @throws std::invalid_argument if the file does not exist, the sample
+    ///         format is not supported, or the file is malformed or
+    ///         truncated.
+    void open(const std::string &fileName);
+    /// @brief Indexes the traces of a SEG-Y file that was read into memory.
+    ///        The contents are copied so bytes may be released after this
+    ///        returns.
+    /// @param[in] nBytes  The number of bytes in the file.
+    /// @param[in] bytes   The contents of the file.  This is an array whose
+    ///                    dimension is [nBytes].
+    /// @throws std::invalid_argument if bytes is NULL, the sample format is
+    ///         not supported, or the file is malformed or truncated.
+    void set(size_t nBytes, const char bytes[]);
+    /// @result True indicates a file is open or its contents were set.
+    [[nodiscard]] bool isOpen() const noexcept;
+    /// @brief Reads a trace.  This is thread safe.
+    /// @param[in] index  The index of the trace in the file.  This must be in
+    ///                   the range [0, \c getNumberOfTraces() - 1].
+    /// @result The trace.
+    /// @throws std::invalid_argument if the index is out of bounds.
+    /// @throws std::runtime_error if a file is not open or the read fails.
+    [[nodiscard]] Trace getTrace(int64_t index) const;
+    /// @brief Reads all the traces with a single sequential read.
+    /// @result The traces in the order they appear in the file.
+    /// @throws std::runtime_error if a file is not open or the read fails.
+    [[nodiscard]] std::vector<Trace> getTraces() const;
+    /// @}
+
+    /// @name File Properties
+    /// @{
+
+    /// @result The textual file header.
+    /// @throws std::runtime_error if a file is not open.
+    [[nodiscard]] TextualFileHeader getTextualFileHeader() const;
+    /// @result The number of traces in the file.
+    [[nodiscard]] int64_t getNumberOfTraces() const noexcept;
+    /// @param[in] index  The index of the trace.
+    /// @result The number of samples in the trace.
+    /// @throws std::invalid_argument if the index is out of bounds.
+    [[nodiscard]] int getNumberOfSamples(int64_t index) const;
+    /// @param[in] index  The index of the trace.
+    /// @result The byte offset of the trace's header in the file.
+    /// @throws std::invalid_argument if the index is out of bounds.
+    [[nodiscard]] int64_t getTraceOffset(int64_t index) const;
+    /// @result The format of the samples on disk.
+    /// @throws std::runtime_error if a file is not open.
+    [[nodiscard]] SampleFormat getSampleFormat() const;
+    /// @result The major revision of the file, e.g., 0, 1, or 2.
+    [[nodiscard]] int getRevision() const noexcept;
+    /// @result True indicates the traces are stored in big-endian byte
+    ///         order.
+    [[nodiscard]] bool isBigEndian() const noexcept;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Closes the file and releases memory.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~TraceGroup();
+    /// @}
+private:
+    class TraceGroupImpl;
+    std::unique_ptr<TraceGroupImpl> pImpl;
+};
+}
+#endif
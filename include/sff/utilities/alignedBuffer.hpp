@@ -0,0 +1,207 @@
+#ifndef SFF_UTILITIES_ALIGNEDBUFFER_HPP
+#define SFF_UTILITIES_ALIGNEDBUFFER_HPP
+#include <span>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <memory_resource>
+namespace SFF::Utilities
+{
+/// @class AlignedBuffer alignedBuffer.hpp "sff/utilities/alignedBuffer.hpp"
+/// @brief A contiguous buffer of samples aligned to a 64 byte boundary.  The
+///        memory is obtained from a std::pmr::memory_resource so that, for
+///        example, every trace in a file can be carved from a single
+///        \c ArenaResource and released at once.
+/// @note The memory resource must outlive every buffer that uses it.  Copies
+///       allocate from the same resource as the source.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+template<typename T>
+class AlignedBuffer
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Samples must be trivially copyable");
+public:
+    /// @brief The alignment of the samples in bytes.
+    static constexpr size_t ALIGNMENT = 64;
+
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    /// @param[in] resource  The memory resource.  If this is NULL then the
+    ///                      default resource is used.
+    explicit AlignedBuffer(std::pmr::memory_resource *resource = nullptr) noexcept :
+        mResource(resource ? resource : std::pmr::get_default_resource())
+    {
+    }
+    /// @brief Constructs a zero-initialized buffer.
+    /// @param[in] n         The number of samples.
+    /// @param[in] resource  The memory resource.  If this is NULL then the
+    ///                      default resource is used.
+    explicit AlignedBuffer(const size_t n,
+                           std::pmr::memory_resource *resource = nullptr) :
+        AlignedBuffer(resource)
+    {
+        resize(n);
+    }
+    /// @brief Copy constructor.
+    /// @param[in] buffer  The buffer from which to initialize this class.
+    AlignedBuffer(const AlignedBuffer &buffer) :
+        AlignedBuffer(buffer.mResource)
+    {
+        *this = buffer;
+    }
+    /// @brief Move constructor.
+    /// @param[in,out] buffer  The buffer from which to initialize this class.
+    ///                        On exit, buffer is empty.
+    AlignedBuffer(AlignedBuffer &&buffer) noexcept :
+        mResource(buffer.mResource)
+    {
+        std::swap(mData, buffer.mData);
+        std::swap(mSize, buffer.mSize);
+    }
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] buffer  The buffer to copy to this.
+    /// @result A deep copy of the buffer.
+    AlignedBuffer& operator=(const AlignedBuffer &buffer)
+    {
+        if (&buffer == this){return *this;}
+        clear();
+        mResource = buffer.mResource;
+        if (buffer.mSize > 0)
+        {
+            mData = allocate(buffer.mSize);
+            mSize = buffer.mSize;
+            std::copy(buffer.mData, buffer.mData + mSize, mData);
+        }
+        return *this;
+    }
+    /// @brief Move assignment operator.
+    /// @param[in,out] buffer  The buffer whose memory will be moved to this.
+    ///                        On exit, buffer is empty.
+    /// @result The memory from buffer moved to this.
+    AlignedBuffer& operator=(AlignedBuffer &&buffer) noexcept
+    {
+        if (&buffer == this){return *this;}
+        clear();
+        mResource = buffer.mResource;
+        std::swap(mData, buffer.mData);
+        std::swap(mSize, buffer.mSize);
+        return *this;
+    }
+    /// @result A reference to the i'th sample.
+    [[nodiscard]] T& operator[](const size_t i) noexcept
+    {
+        return mData[i];
+    }
+    /// @result A reference to the i'th sample.
+    [[nodiscard]] const T& operator[](const size_t i) const noexcept
+    {
+        return mData[i];
+    }
+    /// @}
+
+    /// @name Memory
+    /// @{
+
+    /// @brief Resizes the buffer.  The first min(n, size()) samples are kept
+    ///        and new samples are zero-initialized.
+    /// @param[in] n  The number of samples.
+    void resize(const size_t n)
+    {
+        if (n == mSize){return;}
+        if (n == 0)
+        {
+            clear();
+            return;
+        }
+        auto data = allocate(n);
+        auto nKeep = std::min(n, mSize);
+        if (nKeep > 0){std::copy(mData, mData + nKeep, data);}
+        std::fill(data + nKeep, data + n, T{0});
+        clear();
+        mData = data;
+        mSize = n;
+    }
+    /// @brief Moves the samples to a new memory resource.
+    /// @param[in] resource  The memory resource.  If this is NULL then the
+    ///                      default resource is used.
+    void setMemoryResource(std::pmr::memory_resource *resource)
+    {
+        if (resource == nullptr){resource = std::pmr::get_default_resource();}
+        if (resource == mResource || *resource == *mResource)
+        {
+            mResource = resource;
+            return;
+        }
+        AlignedBuffer buffer(resource);
+        if (mSize > 0)
+        {
+            buffer.mData = buffer.allocate(mSize);
+            buffer.mSize = mSize;
+            std::copy(mData, mData + mSize, buffer.mData);
+        }
+        *this = std::move(buffer);
+    }
+    /// @result The memory resource from which the samples are allocated.
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const noexcept
+    {
+        return mResource;
+    }
+    /// @brief Releases the samples.  The memory resource is retained.
+    void clear() noexcept
+    {
+        if (mData)
+        {
+            mResource->deallocate(mData, mSize*sizeof(T), ALIGNMENT);
+        }
+        mData = nullptr;
+        mSize = 0;
+    }
+    /// @brief Destructor.
+    ~AlignedBuffer()
+    {
+        clear();
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// @result The number of samples.
+    [[nodiscard]] size_t size() const noexcept{return mSize;}
+    /// @result True indicates there are no samples.
+    [[nodiscard]] bool empty() const noexcept{return mSize == 0;}
+    /// @result A pointer to the samples.  This is NULL when the buffer is
+    ///         empty.
+    [[nodiscard]] T *data() noexcept{return mData;}
+    /// @result A pointer to the samples.  This is NULL when the buffer is
+    ///         empty.
+    [[nodiscard]] const T *data() const noexcept{return mData;}
+    [[nodiscard]] T *begin() noexcept{return mData;}
+    [[nodiscard]] T *end() noexcept{return mData + mSize;}
+    [[nodiscard]] const T *begin() const noexcept{return mData;}
+    [[nodiscard]] const T *end() const noexcept{return mData + mSize;}
+    /// @result A view of the samples.
+    [[nodiscard]] std::span<const T> getSpan() const noexcept
+    {
+        return std::span<const T> (mData, mSize);
+    }
+    /// @}
+private:
+    [[nodiscard]] T *allocate(const size_t n)
+    {
+        return static_cast<T *> (mResource->allocate(n*sizeof(T), ALIGNMENT));
+    }
+    std::pmr::memory_resource *mResource{nullptr};
+    T *mData{nullptr};
+    size_t mSize{0};
+};
+}
+#endif
@@ -0,0 +1,104 @@
+#ifndef SFF_UTILITIES_ASYNCREADER_HPP
+#define SFF_UTILITIES_ASYNCREADER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <future>
+#include <exception>
+#include <functional>
+namespace SFF::Utilities
+{
+/// @class AsyncReader asyncReader.hpp "sff/utilities/asyncReader.hpp"
+/// @brief Reads entire files asynchronously so that many reads can be
+///        outstanding at once.  This is intended for latency bound workloads,
+///        e.g., extracting events from thousands of files on a network
+///        filesystem.
+/// @details On Linux the reads are submitted to an io_uring when the kernel
+///          supports it.  Otherwise, or when requested, a pool of threads
+///          issues blocking pread calls.  In both cases at most
+///          \c getQueueDepth() reads are in flight.  Completion callbacks, which
+///          typically unpack the file, run on a separate pool of worker
+///          threads so that they do not stall the I/O.
+///
+///          The format readers use this class through, e.g.,
+///          SFF::SAC::Waveform::readAsync().
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class AsyncReader
+{
+public:
+    /// @brief The I/O mechanism.
+    enum class Backend
+    {
+        AUTOMATIC,   /*!< Use io_uring if available; otherwise a thread pool. */
+        IO_URING,    /*!< Use io_uring.  This is Linux only. */
+        THREAD_POOL  /*!< Use a pool of threads calling pread. */
+    };
+    /// @brief The callback invoked when a read completes.  On success error
+    ///        is NULL and bytes holds the file's contents.  On failure error
+    ///        holds the exception.
+    using Callback = std::function<void (std::vector<char> &&bytes,
+                                         std::exception_ptr error)>;
+
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    /// @param[in] queueDepth  The maximum number of outstanding reads.  For
+    ///                        the thread pool this is the number of I/O
+    ///                        threads.
+    /// @param[in] nWorkers    The number of threads that run the completion
+    ///                        callbacks.  If this is not positive then the
+    ///                        hardware concurrency is used.
+    /// @param[in] backend     The I/O mechanism.
+    /// @throws std::invalid_argument if queueDepth is not positive.
+    /// @throws std::runtime_error if io_uring is requested but unavailable.
+    explicit AsyncReader(int queueDepth = 64,
+                         int nWorkers = 0,
+                         Backend backend = Backend::AUTOMATIC);
+    /// @}
+
+    /// @name Reading
+    /// @{
+
+    /// @brief Reads a file asynchronously.
+    /// @param[in] fileName  The name of the file to read.
+    /// @param[in] callback  The function to invoke with the file's contents.
+    ///                      This is called exactly once from a worker thread.
+    ///                      If the file cannot be opened or read then the
+    ///                      error is a std::invalid_argument or
+    ///                      std::runtime_error respectively.
+    void readFile(const std::string &fileName, Callback callback);
+    /// @brief Reads a file asynchronously.
+    /// @param[in] fileName  The name of the file to read.
+    /// @result A future holding the file's contents.
+    [[nodiscard]] std::future<std::vector<char>> readFile(const std::string &fileName);
+    /// @brief Blocks until all submitted reads and their callbacks finish.
+    void wait();
+    /// @}
+
+    /// @name Properties
+    /// @{
+
+    /// @result The I/O mechanism in use.  This is never AUTOMATIC.
+    [[nodiscard]] Backend getBackend() const noexcept;
+    /// @result The maximum number of outstanding reads.
+    [[nodiscard]] int getQueueDepth() const noexcept;
+    /// @result True indicates the running kernel supports io_uring.
+    [[nodiscard]] static bool isIOUringAvailable() noexcept;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Destructor.  This waits for outstanding reads to finish.
+    ~AsyncReader();
+    /// @}
+
+    AsyncReader(const AsyncReader &) = delete;
+    AsyncReader& operator=(const AsyncReader &) = delete;
+private:
+    class AsyncReaderImpl;
+    std::unique_ptr<AsyncReaderImpl> pImpl;
+};
+}
+#endif
@@ -0,0 +1,145 @@
+#ifndef SFF_UTILITIES_DECIMATOR_HPP
+#define SFF_UTILITIES_DECIMATOR_HPP
+#include <memory>
+#include <vector>
+namespace SFF::Utilities
+{
+/// @class Decimator decimator.hpp "sff/utilities/decimator.hpp"
+/// @brief Applies an FIR anti-alias filter and downsamples many channels
+///        that are sampled in lockstep, e.g., the channels of a DAS fiber.
+/// @details The input is processed in blocks and the last (nTaps - 1)
+///          samples of each channel are retained between calls.  Therefore,
+///          consecutive blocks, e.g., consecutive files, are filtered as if
+///          they were one continuous signal.  Only the retained output
+///          samples are computed, which is the cost of the polyphase form,
+///          and the filter is applied to all channels of a block at once so
+///          that the inner loop vectorizes across channels.
+///
+///          The k'th output sample is the filtered input sample k*factor
+///          counting from the first sample given to the decimator since it
+///          was initialized or reset.  The filter is causal so the outputs
+///          lag the input by \c getGroupDelay() input samples.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Decimator
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Default constructor.
+    Decimator();
+    /// @brief Constructs a decimator with the default anti-alias filter.
+    /// @param[in] nChannels  The number of channels.
+    /// @param[in] factor     The decimation factor.
+    /// @throws std::invalid_argument if nChannels or factor is not positive.
+    Decimator(int nChannels, int factor);
+    /// @brief Copy constructor.
+    /// @param[in] decimator  The decimator from which to initialize this
+    ///                       class.
+    Decimator(const Decimator &decimator);
+    /// @brief Move constructor.
+    /// @param[in,out] decimator  The decimator from which to initialize this
+    ///                           class.  On exit, decimator's behavior is
+    ///                           undefined.
+    Decimator(Decimator &&decimator) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] decimator  The decimator to copy to this.
+    /// @result A deep copy of the decimator including its filter state.
+    Decimator& operator=(const Decimator &decimator);
+    /// @brief Move assignment operator.
+    /// @param[in,out] decimator  The decimator whose memory will be moved to
+    ///                           this.  On exit, decimator's behavior is
+    ///                           undefined.
+    /// @result The memory from decimator moved to this.
+    Decimator& operator=(Decimator &&decimator) noexcept;
+    /// @}
+
+    /// @name Initialization
+    /// @{
+
+    /// @brief Initializes the decimator with a Hamming windowed sinc
+    ///        low-pass filter whose length is 20*factor + 1 and whose cutoff
+    ///        is 80 percent of the output Nyquist frequency.
+    /// @param[in] nChannels  The number of channels.
+    /// @param[in] factor     The decimation factor.  If this is 1 then the
+    ///                       filter is the identity.
+    /// @throws std::invalid_argument if nChannels or factor is not positive.
+    void initialize(int nChannels, int factor);
+    /// @brief Initializes the decimator with the given filter.
+    /// @param[in] nChannels  The number of channels.
+    /// @param[in] factor     The decimation factor.
+    /// @param[in] taps       The FIR filter coefficients.  For the group delay
+    ///                       to be meaningful this should be linear phase.
+    /// @throws std::invalid_argument if nChannels or factor is not positive
+    ///         or taps is empty.
+    void initialize(int nChannels, int factor,
+                    const std::vector<double> &taps);
+    /// @result True indicates the decimator is initialized.
+    [[nodiscard]] bool isInitialized() const noexcept;
+    /// @result The number of channels.
+    [[nodiscard]] int getNumberOfChannels() const noexcept;
+    /// @result The decimation factor.
+    [[nodiscard]] int getDecimationFactor() const noexcept;
+    /// @result The FIR filter coefficients.
+    [[nodiscard]] std::vector<double> getFilterTaps() const;
+    /// @result The delay of the output relative to the input in input
+    ///         samples, i.e., (nTaps - 1)/2.
+    [[nodiscard]] double getGroupDelay() const noexcept;
+    /// @brief Zeros the filter state so the next sample given to each
+    ///        channel begins a new signal.
+    void reset() noexcept;
+    /// @}
+
+    /// @name Filtering
+    /// @{
+
+    /// @param[in] channel   The channel index.
+    /// @result The number of input samples that precede the channel's next
+    ///         output sample.  This is in the range [0, factor - 1].
+    /// @throws std::invalid_argument if the channel is out of bounds.
+    [[nodiscard]] int getPhase(int channel) const;
+    /// @param[in] channel   The channel index.
+    /// @param[in] nSamples  The number of input samples in the next block.
+    /// @result The number of output samples \c process() will produce for
+    ///         the channel.
+    /// @throws std::invalid_argument if the channel is out of bounds or
+    ///         nSamples is negative.
+    [[nodiscard]] int getNumberOfOutputSamples(int channel,
+                                               int nSamples) const;
+    /// @brief Filters and downsamples the next block of samples of the
+    ///        channels [firstChannel, firstChannel + nChannels - 1].
+    /// @param[in] firstChannel  The index of the first channel in the block.
+    /// @param[in] nChannels     The number of channels in the block.
+    /// @param[in] nSamples      The number of input samples in each channel.
+    /// @param[in] x             The input.  x[i] is the i'th channel of the
+    ///                          block and is an array whose dimension is
+    ///                          [nSamples].
+    /// @param[out] y            The output.  y[i] is the i'th channel of the
+    ///                          block and is an array whose dimension is at
+    ///                          least \c getNumberOfOutputSamples().
+    /// @throws std::invalid_argument if the decimator is not initialized,
+    ///         the channels are out of bounds, the channels in the block
+    ///         are not in phase, or x or y are NULL.
+    void process(int firstChannel, int nChannels, int nSamples,
+                 const float *const x[], float *const y[]);
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Releases the memory and resets the class.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~Decimator();
+    /// @}
+private:
+    class DecimatorImpl;
+    std::unique_ptr<DecimatorImpl> pImpl;
+};
+}
+#endif
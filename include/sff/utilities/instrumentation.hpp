@@ -0,0 +1,107 @@
+#ifndef SFF_UTILITIES_INSTRUMENTATION_HPP
+#define SFF_UTILITIES_INSTRUMENTATION_HPP
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdint>
+/// @namespace SFF::Utilities::Instrumentation
+/// @brief Counters and timers for the read and write paths of the SAC,
+///        miniSEED, SEGY, and RG16 readers.  Instrumentation is opt-in: it is
+///        compiled into the library only when sff is configured with
+///        -DSFF_ENABLE_INSTRUMENTATION=ON.  Otherwise, the probes are removed
+///        by the preprocessor and all counters read zero.
+namespace SFF::Utilities::Instrumentation
+{
+/// @brief The quantities that are counted.
+enum class Counter
+{
+    BYTES_READ = 0,      /*!< Bytes read from files. */
+    BYTES_WRITTEN,       /*!< Bytes written to files. */
+    RECORDS_DECODED,     /*!< Traces or data records unpacked. */
+    RECORDS_ENCODED,     /*!< Traces or data records packed. */
+    ALLOCATIONS,         /*!< Sample buffer allocations. */
+    BYTE_SWAPS           /*!< Samples whose byte order was swapped. */
+};
+/// @brief The stages of the read and write paths that are timed.
+enum class Timer
+{
+    READ = 0,            /*!< Total time reading a file. */
+    WRITE,               /*!< Total time writing a file. */
+    HEADER,              /*!< Time unpacking file and trace headers. */
+    DECODE,              /*!< Time decoding compressed data records. */
+    SWAP                 /*!< Time swapping the byte order of samples. */
+};
+/// @class Snapshot instrumentation.hpp "sff/utilities/instrumentation.hpp"
+/// @brief The counters and timers at an instant.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Snapshot
+{
+public:
+    /// @brief Constructor.  All counters and timers are zero.
+    Snapshot();
+    /// @brief Copy constructor.
+    /// @param[in] snapshot  The snapshot from which to initialize this class.
+    Snapshot(const Snapshot &snapshot);
+    /// @brief Move constructor.
+    /// @param[in,out] snapshot  The snapshot from which to initialize this
+    ///                          class.  On exit, snapshot's behavior is
+    ///                          undefined.
+    Snapshot(Snapshot &&snapshot) noexcept;
+    /// @brief Copy assignment operator.
+    /// @param[in] snapshot  The snapshot to copy to this.
+    /// @result A deep copy of the snapshot.
+    Snapshot& operator=(const Snapshot &snapshot);
+    /// @brief Move assignment operator.
+    /// @param[in,out] snapshot  The snapshot whose memory will be moved to
+    ///                          this.  On exit, snapshot's behavior is
+    ///                          undefined.
+    /// @result The memory from snapshot moved to this.
+    Snapshot& operator=(Snapshot &&snapshot) noexcept;
+    /// @brief Destructor.
+    ~Snapshot();
+
+    /// @brief Sets a counter.
+    /// @param[in] counter  The counter.
+    /// @param[in] value    The counter's value.
+    void setCount(Counter counter, uint64_t value) noexcept;
+    /// @result The value of the given counter.
+    [[nodiscard]] uint64_t getCount(Counter counter) const noexcept;
+    /// @brief Sets a timer.
+    /// @param[in] timer    The timer.
+    /// @param[in] elapsed  The accumulated time.
+    /// @param[in] nCalls   The number of times the timed scope was entered.
+    void setElapsedTime(Timer timer, std::chrono::nanoseconds elapsed,
+                        uint64_t nCalls) noexcept;
+    /// @result The accumulated time spent in the given stage.
+    [[nodiscard]] std::chrono::nanoseconds getElapsedTime(Timer timer) const noexcept;
+    /// @result The number of times the given stage was entered.
+    [[nodiscard]] uint64_t getNumberOfCalls(Timer timer) const noexcept;
+    /// @result The snapshot as a JSON object of the form
+    ///         {"enabled": true,
+    ///          "counters": {"bytes_read": 0, ...},
+    ///          "timers": {"read": {"calls": 0, "nanoseconds": 0}, ...}}.
+    [[nodiscard]] std::string toJSON() const;
+private:
+    class SnapshotImpl;
+    std::unique_ptr<SnapshotImpl> pImpl;
+};
+
+/// @result True indicates the library was compiled with instrumentation.
+[[nodiscard]] bool isEnabled() noexcept;
+/// @result The current counters and timers.  This is safe to call while
+///         other threads read and write files.  Each counter is read
+///         atomically, however, the snapshot is not a consistent cut across
+///         counters.
+[[nodiscard]] Snapshot getSnapshot() noexcept;
+/// @brief Sets all counters and timers to zero.
+void reset() noexcept;
+/// @brief Writes the current snapshot as JSON.
+/// @param[in] fileName  The name of the JSON file.
+/// @throws std::runtime_error if the file cannot be written.
+void dumpJSON(const std::string &fileName);
+/// @result The name of a counter, e.g., "bytes_read".
+[[nodiscard]] std::string toString(Counter counter);
+/// @result The name of a timer, e.g., "read".
+[[nodiscard]] std::string toString(Timer timer);
+}
+#endif
@@ -0,0 +1,79 @@
+#ifndef SFF_UTILITIES_MEMORYRESOURCE_HPP
+#define SFF_UTILITIES_MEMORYRESOURCE_HPP
+#include <memory>
+#include <cstddef>
+#include <memory_resource>
+namespace SFF::Utilities
+{
+/// @class ArenaResource memoryResource.hpp "sff/utilities/memoryResource.hpp"
+/// @brief A thread-safe monotonic arena.  Allocations are carved sequentially
+///        from large blocks and deallocation is a no-op.  All memory is
+///        returned at once by \c release() or when the arena is destroyed.
+///        This is well suited to reading a batch of short-lived traces.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class ArenaResource : public std::pmr::memory_resource
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] initialBlockSize  The size in bytes of the first block
+    ///                              requested from upstream.  Subsequent
+    ///                              blocks grow geometrically.
+    /// @param[in] upstream          The resource from which blocks are
+    ///                              obtained.  If this is NULL then
+    ///                              std::pmr::new_delete_resource() is used.
+    explicit ArenaResource(size_t initialBlockSize = 1024*1024,
+                           std::pmr::memory_resource *upstream = nullptr);
+    /// @brief Returns all memory to the upstream resource.  Buffers allocated
+    ///        from this arena are invalid after this call.
+    void release();
+    /// @result The number of bytes handed out since construction or the last
+    ///         call to \c release().
+    [[nodiscard]] size_t getBytesAllocated() const noexcept;
+    /// @brief Destructor.
+    ~ArenaResource() override;
+
+    ArenaResource(const ArenaResource &) = delete;
+    ArenaResource& operator=(const ArenaResource &) = delete;
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    class ArenaResourceImpl;
+    std::unique_ptr<ArenaResourceImpl> pImpl;
+};
+
+/// @class PoolResource memoryResource.hpp "sff/utilities/memoryResource.hpp"
+/// @brief A thread-safe pool of size classes.  Freed blocks are kept and
+///        reused for subsequent allocations of the same size class.  This is
+///        well suited to streaming jobs where traces of similar length are
+///        repeatedly created and destroyed.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] largestPooledBlock  Allocations larger than this many bytes
+    ///                                bypass the pools and go directly to
+    ///                                upstream.
+    /// @param[in] upstream            The resource from which pools are
+    ///                                obtained.  If this is NULL then
+    ///                                std::pmr::new_delete_resource() is used.
+    explicit PoolResource(size_t largestPooledBlock = 4*1024*1024,
+                          std::pmr::memory_resource *upstream = nullptr);
+    /// @brief Returns all memory to the upstream resource.  Buffers allocated
+    ///        from this pool are invalid after this call.
+    void release();
+    /// @brief Destructor.
+    ~PoolResource() override;
+
+    PoolResource(const PoolResource &) = delete;
+    PoolResource& operator=(const PoolResource &) = delete;
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    class PoolResourceImpl;
+    std::unique_ptr<PoolResourceImpl> pImpl;
+};
+}
+#endif
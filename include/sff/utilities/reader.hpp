@@ -0,0 +1,67 @@
+#ifndef SFF_UTILITIES_READER_HPP
+#define SFF_UTILITIES_READER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include "sff/formats.hpp"
+namespace SFF::AbstractBaseClass
+{
+class ITrace;
+}
+namespace SFF::Utilities
+{
+/// @name Format Detection
+/// @{
+
+/// @brief Determines the format of a file by inspecting its header.
+/// @param[in] fileName  The name of the file.
+/// @result The file's format.  The checks are:
+///         - SAC: the file size is 632 + 4*npts where npts is read from the
+///           header in either byte order.
+///         - Silixa SEGY: the binary file header has IEEE float samples and
+///           the file size is 3600 + nTraces*(240 + 4*nSamplesPerTrace).
+///         - MiniSEED: the first record begins with a 6 character sequence
+///           number followed by a data quality indicator (miniSEED 2) or
+///           begins with "MS" and format version 3 (miniSEED 3).
+///         - SEG-Y: the textual header begins with a C and the binary file
+///           header has a supported sample format code.
+/// @throws std::invalid_argument if the file does not exist or the format
+///         cannot be determined.
+[[nodiscard]] SFF::Format detectFormat(const std::string &fileName);
+/// @}
+
+/// @name Readers
+/// @{
+
+/// @brief Reads all traces in a file whose format is determined with
+///        \c detectFormat().
+/// @param[in] fileName  The name of the file.
+/// @result The traces in the file.  A SAC file has one trace.  A Silixa SEGY
+///         file has one trace per channel.  A miniSEED file has one trace
+///         per SNCL.  A SEG-Y file has one trace per trace header.
+/// @throws std::invalid_argument if the format cannot be determined or the
+///         file is malformed.
+/// @throws std::runtime_error if the library was compiled without support
+///         for the file's format.
+[[nodiscard]] std::vector<std::unique_ptr<SFF::AbstractBaseClass::ITrace>>
+    readTraces(const std::string &fileName);
+/// @brief Reads the traces in many files in parallel.
+/// @param[in] fileNames  The names of the files to read.
+/// @param[in] nThreads   The number of threads.  If this is not positive
+///                       then the hardware concurrency is used.
+/// @result The traces in the files.  The traces are ordered by file and
+///         then by their order in the file.
+/// @throws The exceptions of \c readTraces().  If multiple files fail then
+///         the error for the earliest file is thrown.
+[[nodiscard]] std::vector<std::unique_ptr<SFF::AbstractBaseClass::ITrace>>
+    readTraces(const std::vector<std::string> &fileNames, int nThreads = 0);
+/// @brief Reads a file that contains a single trace.
+/// @param[in] fileName  The name of the file.
+/// @result The trace in the file.
+/// @throws std::invalid_argument if the file does not contain exactly one
+///         trace or the exceptions of \c readTraces().
+[[nodiscard]] std::unique_ptr<SFF::AbstractBaseClass::ITrace>
+    readTrace(const std::string &fileName);
+/// @}
+}
+#endif
@@ -0,0 +1,212 @@
+#ifndef SFF_UTILITIES_SHAREDBUFFER_HPP
+#define SFF_UTILITIES_SHAREDBUFFER_HPP
+#include <span>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include "sff/utilities/alignedBuffer.hpp"
+namespace SFF::Utilities
+{
+/// @class SharedBuffer sharedBuffer.hpp "sff/utilities/sharedBuffer.hpp"
+/// @brief A reference counted, copy-on-write AlignedBuffer.  Copying a
+///        buffer shares the samples so that traces can be passed by value
+///        without duplicating them.  The samples are copied the first time
+///        a shared buffer is modified.
+/// @details Read access is only provided by the const accessors so that
+///          reading never triggers a copy.  Write access is obtained with
+///          \c mutableData() which first gives this buffer its own samples
+///          if they are shared.  The reference count is atomic so copies
+///          may be read and modified on different threads; as with any
+///          other class, a single buffer may not be modified concurrently.
+/// @note The memory resource must outlive every buffer that uses it.  A
+///       detached copy allocates from this buffer's resource.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+template<typename T>
+class SharedBuffer
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    /// @param[in] resource  The memory resource.  If this is NULL then the
+    ///                      default resource is used.
+    explicit SharedBuffer(std::pmr::memory_resource *resource = nullptr) noexcept :
+        mResource(resource ? resource : std::pmr::get_default_resource())
+    {
+    }
+    /// @brief Constructs a zero-initialized buffer.
+    /// @param[in] n         The number of samples.
+    /// @param[in] resource  The memory resource.  If this is NULL then the
+    ///                      default resource is used.
+    explicit SharedBuffer(const size_t n,
+                          std::pmr::memory_resource *resource = nullptr) :
+        SharedBuffer(resource)
+    {
+        resize(n);
+    }
+    /// @brief Copy constructor.  This shares the samples of buffer.
+    /// @param[in] buffer  The buffer from which to initialize this class.
+    SharedBuffer(const SharedBuffer &buffer) noexcept = default;
+    /// @brief Move constructor.
+    /// @param[in,out] buffer  The buffer from which to initialize this class.
+    ///                        On exit, buffer is empty.
+    SharedBuffer(SharedBuffer &&buffer) noexcept :
+        mResource(buffer.mResource),
+        mBuffer(std::move(buffer.mBuffer))
+    {
+    }
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] buffer  The buffer to copy to this.
+    /// @result This buffer sharing the samples of buffer.
+    SharedBuffer& operator=(const SharedBuffer &buffer) noexcept = default;
+    /// @brief Move assignment operator.
+    /// @param[in,out] buffer  The buffer whose memory will be moved to this.
+    ///                        On exit, buffer is empty.
+    /// @result The memory from buffer moved to this.
+    SharedBuffer& operator=(SharedBuffer &&buffer) noexcept
+    {
+        if (&buffer == this){return *this;}
+        mResource = buffer.mResource;
+        mBuffer = std::move(buffer.mBuffer);
+        return *this;
+    }
+    /// @result A reference to the i'th sample.
+    [[nodiscard]] const T& operator[](const size_t i) const noexcept
+    {
+        return (*mBuffer)[i];
+    }
+    /// @}
+
+    /// @name Memory
+    /// @{
+
+    /// @brief Resizes the buffer.  The first min(n, size()) samples are kept
+    ///        and new samples are zero-initialized.  Other buffers sharing
+    ///        the samples are unaffected.
+    /// @param[in] n  The number of samples.
+    void resize(const size_t n)
+    {
+        if (n == size()){return;}
+        if (n == 0)
+        {
+            clear();
+            return;
+        }
+        if (!isUnique())
+        {
+            auto buffer = allocate();
+            buffer->resize(n);
+            auto nKeep = std::min(n, size());
+            if (nKeep > 0){std::copy(data(), data() + nKeep, buffer->data());}
+            mBuffer = std::move(buffer);
+            return;
+        }
+        mBuffer->resize(n);
+    }
+    /// @brief Moves the samples to a new memory resource.
+    /// @param[in] resource  The memory resource.  If this is NULL then the
+    ///                      default resource is used.
+    void setMemoryResource(std::pmr::memory_resource *resource)
+    {
+        if (resource == nullptr){resource = std::pmr::get_default_resource();}
+        if (resource == mResource || *resource == *mResource)
+        {
+            mResource = resource;
+            return;
+        }
+        mResource = resource;
+        if (mBuffer){mBuffer = copy();}
+    }
+    /// @result The memory resource from which the samples are allocated.
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const noexcept
+    {
+        return mResource;
+    }
+    /// @brief Releases this buffer's reference to the samples.  The memory
+    ///        resource is retained.
+    void clear() noexcept
+    {
+        mBuffer.reset();
+    }
+    /// @result True indicates the samples are shared with another buffer so
+    ///         that modifying them will first copy them.
+    [[nodiscard]] bool isShared() const noexcept
+    {
+        return mBuffer && mBuffer.use_count() > 1;
+    }
+    /// @}
+
+    /// @name Access
+    /// @{
+
+    /// @result The number of samples.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mBuffer ? mBuffer->size() : 0;
+    }
+    /// @result True indicates there are no samples.
+    [[nodiscard]] bool empty() const noexcept{return size() == 0;}
+    /// @result A pointer to the samples.  This is NULL when the buffer is
+    ///         empty.
+    [[nodiscard]] const T *data() const noexcept
+    {
+        return mBuffer ? mBuffer->data() : nullptr;
+    }
+    /// @result A pointer to the samples that may be modified.  If the
+    ///         samples are shared then they are first copied.  This is NULL
+    ///         when the buffer is empty.
+    [[nodiscard]] T *mutableData()
+    {
+        if (!mBuffer){return nullptr;}
+        if (!isUnique()){mBuffer = copy();}
+        return mBuffer->data();
+    }
+    [[nodiscard]] const T *begin() const noexcept{return data();}
+    [[nodiscard]] const T *end() const noexcept{return data() + size();}
+    /// @result A view of the samples.  This is valid until this buffer is
+    ///         modified or destroyed; modifying a buffer that shares the
+    ///         samples does not invalidate it.
+    [[nodiscard]] std::span<const T> getSpan() const noexcept
+    {
+        return std::span<const T> (data(), size());
+    }
+    /// @}
+private:
+    /// True if this is the only owner of the samples and they may be
+    /// modified in place.  use_count() is a relaxed load so the fence is
+    /// needed to order the writes that follow after the other owners' reads,
+    /// which happened before they released their references.
+    [[nodiscard]] bool isUnique() const noexcept
+    {
+        if (!mBuffer || mBuffer.use_count() != 1){return false;}
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+    /// Makes an empty buffer whose samples will come from the resource.
+    /// The small reference count is kept off the resource so that, e.g.,
+    /// an arena holds only samples.
+    [[nodiscard]] std::shared_ptr<AlignedBuffer<T>> allocate() const
+    {
+        return std::make_shared<AlignedBuffer<T>> (mResource);
+    }
+    /// Copies the samples into a buffer allocated from the resource
+    [[nodiscard]] std::shared_ptr<AlignedBuffer<T>> copy() const
+    {
+        auto buffer = allocate();
+        buffer->resize(size());
+        std::copy(data(), data() + size(), buffer->data());
+        return buffer;
+    }
+    std::pmr::memory_resource *mResource{nullptr};
+    std::shared_ptr<AlignedBuffer<T>> mBuffer;
+};
+}
+#endif
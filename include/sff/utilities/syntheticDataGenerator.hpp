@@ -0,0 +1,163 @@
+#ifndef SFF_UTILITIES_SYNTHETICDATAGENERATOR_HPP
+#define SFF_UTILITIES_SYNTHETICDATAGENERATOR_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+namespace SFF::Utilities
+{
+class Time;
+/// @class SyntheticDataGenerator syntheticDataGenerator.hpp "sff/utilities/syntheticDataGenerator.hpp"
+/// @brief Writes valid SAC, miniSEED, Silixa SEGY, and HypoInverse2000
+///        archive files of arbitrary size for testing and benchmarking.
+/// @details The time series are integer random walks so that they resemble
+///          seismic data and compress realistically with Steim2.  The random
+///          number generator is implemented here rather than taken from
+///          <random> so that the same seed produces byte-identical files on
+///          every platform.
+///
+///          Channel i is named XX.S{i+1:04d}.HHZ.00.  Gaps are specified as
+///          a pattern: after every segment of recorded samples the clock
+///          advances by a gap of missing samples.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class SyntheticDataGenerator
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    SyntheticDataGenerator();
+    /// @brief Copy constructor.
+    /// @param[in] generator  The generator from which to initialize this class.
+    SyntheticDataGenerator(const SyntheticDataGenerator &generator);
+    /// @brief Move constructor.
+    /// @param[in,out] generator  The generator from which to initialize this
+    ///                           class.  On exit, generator's behavior is
+    ///                           undefined.
+    SyntheticDataGenerator(SyntheticDataGenerator &&generator) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] generator  The generator to copy to this.
+    /// @result A deep copy of the generator.
+    SyntheticDataGenerator& operator=(const SyntheticDataGenerator &generator);
+    /// @brief Move assignment operator.
+    /// @param[in,out] generator  The generator whose memory will be moved to
+    ///                           this.  On exit, generator's behavior is
+    ///                           undefined.
+    /// @result The memory from generator moved to this.
+    SyntheticDataGenerator& operator=(SyntheticDataGenerator &&generator) noexcept;
+    /// @}
+
+    /// @name Parameters
+    /// @{
+
+    /// @brief Sets the seed of the random number generator.
+    /// @param[in] seed  The seed.
+    void setSeed(uint64_t seed) noexcept;
+    /// @result The seed.  By default this is 0.
+    [[nodiscard]] uint64_t getSeed() const noexcept;
+    /// @brief Sets the number of channels.
+    /// @param[in] nChannels  The number of channels.
+    /// @throws std::invalid_argument if this is not positive.
+    void setNumberOfChannels(int nChannels);
+    /// @result The number of channels.  By default this is 1.
+    [[nodiscard]] int getNumberOfChannels() const noexcept;
+    /// @brief Sets the number of recorded samples in each channel.
+    /// @param[in] nSamples  The number of samples.
+    /// @throws std::invalid_argument if this is not positive.
+    void setNumberOfSamples(int64_t nSamples);
+    /// @result The number of samples in each channel.  By default this is 1000.
+    [[nodiscard]] int64_t getNumberOfSamples() const noexcept;
+    /// @brief Sets the sampling rate.
+    /// @param[in] samplingRate  The sampling rate in Hz.
+    /// @throws std::invalid_argument if this is not positive.
+    void setSamplingRate(double samplingRate);
+    /// @result The sampling rate in Hz.  By default this is 100.
+    [[nodiscard]] double getSamplingRate() const noexcept;
+    /// @brief Sets the time of the first sample.
+    /// @param[in] startTime  The UTC start time.
+    void setStartTime(const Time &startTime);
+    /// @result The time of the first sample.  By default this is
+    ///         2020-01-01T00:00:00.
+    [[nodiscard]] Time getStartTime() const;
+    /// @brief Sets the gap pattern.
+    /// @param[in] segmentLength  The number of contiguous samples between gaps.
+    ///                           If this is not positive then the data are
+    ///                           contiguous.
+    /// @param[in] gapLength      The number of samples missing in each gap.
+    /// @throws std::invalid_argument if gapLength is negative.
+    void setGapPattern(int64_t segmentLength, int64_t gapLength);
+    /// @result The number of contiguous samples between gaps.  This is 0 when
+    ///         the data are contiguous.
+    [[nodiscard]] int64_t getSegmentLength() const noexcept;
+    /// @result The number of samples missing in each gap.
+    [[nodiscard]] int64_t getGapLength() const noexcept;
+    /// @}
+
+    /// @name Generation
+    /// @{
+
+    /// @brief Generates the time series of a channel.
+    /// @param[in] channel  The channel index.  This must be in the range
+    ///                     [0, \c getNumberOfChannels()).
+    /// @result The \c getNumberOfSamples() samples recorded on this channel.
+    ///         Samples on either side of a gap are adjacent in the result.
+    /// @throws std::invalid_argument if channel is out of range.
+    [[nodiscard]] std::vector<int> generate(int channel) const;
+    /// @brief Writes each contiguous segment of each channel to a SAC file.
+    /// @param[in] directory  The output directory.  This is created if it does
+    ///                       not exist.
+    /// @result The names of the files that were written.  The file names are
+    ///         XX.S0001.HHZ.00.{segment}.sac.
+    /// @throws std::runtime_error if a file cannot be written.
+    std::vector<std::string> writeSAC(const std::string &directory) const;
+    /// @brief Writes all channels to a miniSEED file with Steim2 compression.
+    /// @param[in] fileName      The name of the miniSEED file.
+    /// @param[in] recordLength  The record length in bytes.  This must be a
+    ///                          power of 2 in the range [256, 65536].
+    /// @throws std::invalid_argument if the record length is invalid.
+    /// @throws std::runtime_error if the file cannot be written.
+    void writeMiniSEED(const std::string &fileName,
+                       int recordLength = 4096) const;
+    /// @brief Writes all channels to a Silixa SEGY file.  Each channel is a
+    ///        trace.  Since a SEGY shot gather has no notion of gaps the gap
+    ///        pattern is ignored.
+    /// @param[in] fileName  The name of the SEGY file.
+    /// @throws std::invalid_argument if the number of channels or samples
+    ///         exceeds what the Silixa binary file header can represent.
+    /// @throws std::runtime_error if the file cannot be written.
+    void writeSilixaSEGY(const std::string &fileName) const;
+    /// @brief Writes a HypoInverse2000 archive of events recorded on the
+    ///        channels' stations.  Events are evenly spaced over the time
+    ///        span of the data.
+    /// @param[in] fileName        The name of the archive file.
+    /// @param[in] nEvents         The number of events.
+    /// @param[in] nPicksPerEvent  The number of picks for each event.  This
+    ///                            cannot exceed \c getNumberOfChannels().
+    /// @throws std::invalid_argument if nEvents is negative or nPicksPerEvent
+    ///         is not in the range [0, \c getNumberOfChannels()].
+    /// @throws std::runtime_error if the file cannot be written.
+    void writeHypoInverse2000Archive(const std::string &fileName,
+                                     int nEvents,
+                                     int nPicksPerEvent = 10) const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Resets the class to its default parameters.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~SyntheticDataGenerator();
+    /// @}
+private:
+    class SyntheticDataGeneratorImpl;
+    std::unique_ptr<SyntheticDataGeneratorImpl> pImpl;
+};
+}
+#endif
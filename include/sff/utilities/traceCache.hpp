@@ -0,0 +1,146 @@
+#ifndef SFF_UTILITIES_TRACECACHE_HPP
+#define SFF_UTILITIES_TRACECACHE_HPP
+#include <memory>
+#include <string>
+#include <cstdint>
+#include "sff/utilities/time.hpp"
+namespace SFF::SAC
+{
+class Waveform;
+}
+namespace SFF::MiniSEED
+{
+class SNCL;
+class Trace;
+}
+namespace SFF::SEGY::Silixa
+{
+class TraceGroup;
+}
+namespace SFF::Utilities
+{
+/// @class TraceCache traceCache.hpp "sff/utilities/traceCache.hpp"
+/// @brief A thread-safe, memory-bounded, least recently used cache of decoded
+///        traces.  This sits in front of SFF::SAC::Waveform::read(),
+///        SFF::MiniSEED::Trace::read(), and
+///        SFF::SEGY::Silixa::TraceGroup::read() so that tools which
+///        repeatedly request overlapping windows from the same files do not
+///        re-open and re-decode them.
+/// @details Entries are keyed on the file's path and modification time, the
+///          SNCL, and the requested time window.  Rewriting a file therefore
+///          invalidates its entries.  A request whose window lies within the
+///          window of a cached entry is a hit and is cut from that entry.
+///          When the cached bytes exceed the capacity the least recently used
+///          entries are evicted.
+///
+///          The returned objects are shared and immutable; they remain valid
+///          after eviction for as long as the caller holds them.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class TraceCache
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    /// @param[in] capacity  The maximum number of bytes of decoded samples
+    ///                      and headers to retain.
+    /// @throws std::invalid_argument if capacity is 0.
+    explicit TraceCache(size_t capacity = 256*1024*1024);
+    /// @}
+
+    /// @name SAC
+    /// @{
+
+    /// @brief Gets a SAC waveform.
+    /// @param[in] fileName  The name of the SAC file.
+    /// @result The waveform.
+    /// @throws The exceptions of SFF::SAC::Waveform::read().
+    [[nodiscard]] std::shared_ptr<const SFF::SAC::Waveform>
+        getWaveform(const std::string &fileName);
+    /// @brief Gets the samples of a SAC waveform between t0 and t1.
+    /// @param[in] fileName  The name of the SAC file.
+    /// @param[in] t0        The start time of the window.
+    /// @param[in] t1        The end time of the window.
+    /// @result The waveform cut to the window with the same conventions as
+    ///         SFF::SAC::Waveform::read().
+    /// @throws The exceptions of SFF::SAC::Waveform::read().
+    [[nodiscard]] std::shared_ptr<const SFF::SAC::Waveform>
+        getWaveform(const std::string &fileName,
+                    const Time &t0, const Time &t1);
+    /// @}
+
+    /// @name MiniSEED
+    /// @{
+
+    /// @brief Gets a miniSEED trace.
+    /// @param[in] fileName  The name of the miniSEED file.
+    /// @param[in] sncl      The SNCL of the trace.
+    /// @result The trace.
+    /// @throws The exceptions of SFF::MiniSEED::Trace::read().
+    /// @throws std::runtime_error if the library was compiled without
+    ///         miniSEED support.
+    [[nodiscard]] std::shared_ptr<const SFF::MiniSEED::Trace>
+        getTrace(const std::string &fileName,
+                 const SFF::MiniSEED::SNCL &sncl);
+    /// @brief Gets the samples of a miniSEED trace between t0 and t1.
+    /// @param[in] fileName  The name of the miniSEED file.
+    /// @param[in] sncl      The SNCL of the trace.
+    /// @param[in] t0        The start time of the window.
+    /// @param[in] t1        The end time of the window.
+    /// @result The trace cut to the window.
+    /// @throws std::invalid_argument if t0 >= t1 or the window does not
+    ///         overlap the trace.
+    [[nodiscard]] std::shared_ptr<const SFF::MiniSEED::Trace>
+        getTrace(const std::string &fileName,
+                 const SFF::MiniSEED::SNCL &sncl,
+                 const Time &t0, const Time &t1);
+    /// @}
+
+    /// @name Silixa SEGY
+    /// @{
+
+    /// @brief Gets a Silixa SEGY trace group.
+    /// @param[in] fileName  The name of the SEGY file.
+    /// @result The trace group.
+    /// @throws The exceptions of SFF::SEGY::Silixa::TraceGroup::read().
+    [[nodiscard]] std::shared_ptr<const SFF::SEGY::Silixa::TraceGroup>
+        getTraceGroup(const std::string &fileName);
+    /// @}
+
+    /// @name Statistics
+    /// @{
+
+    /// @result The maximum number of bytes retained.
+    [[nodiscard]] size_t getCapacity() const noexcept;
+    /// @result The number of bytes currently retained.
+    [[nodiscard]] size_t getSize() const noexcept;
+    /// @result The number of entries currently retained.
+    [[nodiscard]] size_t getNumberOfEntries() const noexcept;
+    /// @result The number of requests satisfied from the cache.
+    [[nodiscard]] int64_t getNumberOfHits() const noexcept;
+    /// @result The number of requests that required a read.
+    [[nodiscard]] int64_t getNumberOfMisses() const noexcept;
+    /// @result The number of entries evicted to respect the capacity.
+    [[nodiscard]] int64_t getNumberOfEvictions() const noexcept;
+    /// @brief Zeros the hit, miss, and eviction counts.
+    void resetStatistics() noexcept;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Removes all entries.  The statistics are retained.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~TraceCache();
+    /// @}
+
+    TraceCache(const TraceCache &) = delete;
+    TraceCache& operator=(const TraceCache &) = delete;
+private:
+    class TraceCacheImpl;
+    std::unique_ptr<TraceCacheImpl> pImpl;
+};
+}
+#endif
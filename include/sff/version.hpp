@@ -0,0 +1,35 @@
+#ifndef SFF_VERSION_HPP
+#define SFF_VERSION_HPP
+#include <string>
+#define SFF_MAJOR 0
+#define SFF_MINOR 1
+#define SFF_PATCH 0
+#define SFF_VERSION "0.1.0"
+
+namespace SFF
+{
+/// @class Version version.hpp "sff/version.hpp"
+/// @brief Defines the SFF's version information.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Version
+{
+public:
+    /// @result The API's major version number.
+    [[nodiscard]] static int getMajor() noexcept;
+    /// @result The API's minor version number.
+    [[nodiscard]] static int getMinor() noexcept;
+    /// @result The API's patch version number.
+    [[nodiscard]] static int getPatch() noexcept;
+    /// @result The API's full version number, e.g., "1.2.3".
+    [[nodiscard]] static std::string getVersion() noexcept;
+    /// @brief Determines if the version is greater than or equal to
+    ///        the current (major, minor, patch).
+    /// @param[in] major  The major version number.
+    /// @param[in] minor  The minor version number.
+    /// @param[in] patch  The patch number.
+    /// @result True indicates that the version is at least equal to the
+    ///         given major, minor, patch.
+    [[nodiscard]] static bool isAtLeast(int major, int minor, int patch) noexcept;
+};
+}
+#endif
@@ -0,0 +1,74 @@
+#ifndef PYSFF_ARRAYVIEW_HPP
+#define PYSFF_ARRAYVIEW_HPP
+#include <algorithm>
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+namespace PBSFF
+{
+/// @brief Creates a read-only NumPy array that borrows a C++ buffer rather
+///        than copying it.
+/// @param[in] owner   The object that owns data.  A reference to the owner
+///                    is stored in the array's base so that the buffer
+///                    remains valid for the lifetime of the array, even if
+///                    the Python wrapper is destroyed or replaces its data.
+/// @param[in] data    The data to view.  This is an array whose dimension
+///                    is [n].
+/// @param[in] n       The number of elements in data.
+/// @result A NumPy array of dimension [n] that shares memory with data.
+template<typename T, typename U>
+pybind11::array_t<T> makeArrayView(const std::shared_ptr<U> &owner,
+                                   const T *data, const pybind11::ssize_t n)
+{
+    if (n < 1 || data == nullptr){return pybind11::array_t<T> (0);}
+    auto ownerCopy = new std::shared_ptr<U> (owner);
+    pybind11::capsule base(ownerCopy, [](void *p)
+                           {
+                               delete reinterpret_cast<std::shared_ptr<U> *> (p);
+                           });
+    pybind11::array_t<T> result({n}, {static_cast<pybind11::ssize_t> (sizeof(T))},
+                                data, base);
+    // The buffer belongs to the C++ object so do not let Python modify it
+    result.attr("setflags")(pybind11::arg("write") = false);
+    return result;
+}
+
+/// @brief Creates a read-only [nRows x nColumns] NumPy matrix that borrows
+///        a C++ buffer whose rows are leadingDimension elements apart.
+/// @param[in] owner             The object that owns data.  As with
+///                              \c makeArrayView() this is referenced by
+///                              the array's base.
+/// @param[in] data              The data to view.  This is an array whose
+///                              dimension is [nRows x leadingDimension].
+/// @param[in] nRows             The number of rows.
+/// @param[in] nColumns          The number of columns.
+/// @param[in] leadingDimension  The number of elements between rows.  This
+///                              must be at least nColumns.
+/// @result A NumPy matrix that shares memory with data.
+template<typename T, typename U>
+pybind11::array_t<T> makeMatrixView(const std::shared_ptr<U> &owner,
+                                    const T *data,
+                                    const pybind11::ssize_t nRows,
+                                    const pybind11::ssize_t nColumns,
+                                    const pybind11::ssize_t leadingDimension)
+{
+    if (nRows < 1 || nColumns < 1 || data == nullptr)
+    {
+        return pybind11::array_t<T> ({std::max<pybind11::ssize_t> (nRows, 0),
+                                      std::max<pybind11::ssize_t> (nColumns, 0)});
+    }
+    auto ownerCopy = new std::shared_ptr<U> (owner);
+    pybind11::capsule base(ownerCopy, [](void *p)
+                           {
+                               delete reinterpret_cast<std::shared_ptr<U> *> (p);
+                           });
+    constexpr auto size = static_cast<pybind11::ssize_t> (sizeof(T));
+    pybind11::array_t<T> result({nRows, nColumns},
+                                {leadingDimension*size, size},
+                                data, base);
+    result.attr("setflags")(pybind11::arg("write") = false);
+    return result;
+}
+}
+#endif
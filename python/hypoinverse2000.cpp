@@ -78,7 +78,7 @@ void StationArchiveLine::setNetworkName(const std::string &network) noexcept
 }
 std::string StationArchiveLine::getNetworkName() const
 {
-    return mStation->getNetworkName();
+    return std::string {mStation->getNetworkName()};
 }
 bool StationArchiveLine::haveNetworkName() const noexcept
 {
@@ -91,7 +91,7 @@ void StationArchiveLine::setStationName(const std::string &station) noexcept
 }
 std::string StationArchiveLine::getStationName() const
 {
-    return mStation->getStationName();
+    return std::string {mStation->getStationName()};
 }
 bool StationArchiveLine::haveStationName() const noexcept
 {
@@ -104,7 +104,7 @@ void StationArchiveLine::setChannelName(const std::string &channel) noexcept
 }
 std::string StationArchiveLine::getChannelName() const
 {
-    return mStation->getChannelName();
+    return std::string {mStation->getChannelName()};
 }
 bool StationArchiveLine::haveChannelName() const noexcept
 {
@@ -117,7 +117,7 @@ void StationArchiveLine::setLocationCode(const std::string &location) noexcept
 }
 std::string StationArchiveLine::getLocationCode() const
 {
-    return mStation->getLocationCode();
+    return std::string {mStation->getLocationCode()};
 }
 bool StationArchiveLine::haveLocationCode() const noexcept
 {
@@ -1,8 +1,13 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <pybind11/stl.h>
 #include "sff/miniseed/trace.hpp"
 #include "sff/miniseed/sncl.hpp"
+#include "sff/miniseed/enums.hpp"
 #include "miniseed.hpp"
+#include "arrayView.hpp"
+#include "parallel.hpp"
 #include "time.hpp"
 
 using namespace PBSFF::MiniSEED;
@@ -71,7 +76,7 @@ void SNCL::setNetwork(const std::string &s)
 
 std::string SNCL::getNetwork() const
 {
-    return mSNCL->getNetwork();
+    return std::string {mSNCL->getNetwork()};
 }
 
 /// Station
@@ -82,7 +87,7 @@ void SNCL::setStation(const std::string &s)
 
 std::string SNCL::getStation() const
 {
-    return mSNCL->getStation();
+    return std::string {mSNCL->getStation()};
 }
 
 /// Channel
@@ -93,7 +98,7 @@ void SNCL::setChannel(const std::string &s)
 
 std::string SNCL::getChannel() const
 {
-    return mSNCL->getChannel();
+    return std::string {mSNCL->getChannel()};
 }
 
 /// Location code
@@ -104,7 +109,7 @@ void SNCL::setLocationCode(const std::string &s)
 
 std::string SNCL::getLocationCode() const
 {
-    return mSNCL->getLocationCode();
+    return std::string {mSNCL->getLocationCode()};
 }
 
 /// Resets class
@@ -129,7 +134,7 @@ SNCL::~SNCL() = default;
 ///--------------------------------------------------------------------------///
 /// Constructors
 Trace::Trace() :
-    mTrace(std::make_unique<SFF::MiniSEED::Trace> ())
+    mTrace(std::make_shared<SFF::MiniSEED::Trace> ())
 {
 }
 
@@ -152,7 +157,7 @@ Trace::Trace(Trace &&trace) noexcept
 Trace& Trace::operator=(const Trace &trace)
 {
     if (&trace == this){return *this;}
-    mTrace = std::make_unique<SFF::MiniSEED::Trace> (*trace.mTrace);
+    mTrace = std::make_shared<SFF::MiniSEED::Trace> (*trace.mTrace);
     return *this;
 }
 
@@ -165,14 +170,70 @@ Trace& Trace::operator=(Trace &&trace) noexcept
 
 Trace& Trace::operator=(const SFF::MiniSEED::Trace &trace)
 {
-    mTrace = std::make_unique<SFF::MiniSEED::Trace> (trace);
+    mTrace = std::make_shared<SFF::MiniSEED::Trace> (trace);
     return *this;
 }
 
+/// Detach from any array views
+void Trace::detach()
+{
+    if (mTrace.use_count() > 1)
+    {
+        mTrace = std::make_shared<SFF::MiniSEED::Trace> (*mTrace);
+    }
+}
+
 void Trace::read(const std::string &fileName, const SNCL &sncl)
 {
+    // Views of the old trace keep referring to the old trace
     auto snclNative = sncl.getNativeClassReference();
-    mTrace->read(fileName, snclNative);
+    auto trace = std::make_shared<SFF::MiniSEED::Trace> ();
+    trace->read(fileName, snclNative);
+    mTrace = std::move(trace);
+}
+
+std::vector<Trace> Trace::readMany(const std::vector<std::string> &fileNames,
+                                   const std::vector<SNCL> &sncls,
+                                   const int nThreads)
+{
+    auto nFiles = static_cast<int> (fileNames.size());
+    if (sncls.size() != 1 && static_cast<int> (sncls.size()) != nFiles)
+    {
+        throw std::invalid_argument(
+            "Number of SNCLs must be 1 or equal the number of files");
+    }
+    std::vector<Trace> traces(nFiles);
+    parallelFor(nFiles, nThreads, [&](const int i)
+    {
+        const auto &sncl = sncls.size() == 1 ? sncls[0] : sncls[i];
+        traces[i].read(fileNames[i], sncl);
+    });
+    return traces;
+}
+
+pybind11::array_t<double> Trace::stack(const std::vector<Trace> &traces)
+{
+    auto nTraces = static_cast<pybind11::ssize_t> (traces.size());
+    pybind11::ssize_t nSamples = 0;
+    if (nTraces > 0){nSamples = traces[0].getNumberOfSamples();}
+    for (const auto &trace : traces)
+    {
+        if (trace.getNumberOfSamples() != nSamples)
+        {
+            throw std::invalid_argument(
+                "All traces must have the same number of samples to stack");
+        }
+    }
+    pybind11::array_t<double, pybind11::array::c_style>
+        result({nTraces, nSamples});
+    auto resultPtr = result.mutable_data();
+    for (pybind11::ssize_t i = 0; i < nTraces; ++i)
+    {
+        if (nSamples < 1){break;}
+        auto rowPtr = resultPtr + i*nSamples;
+        traces[i].mTrace->getData(static_cast<int> (nSamples), &rowPtr);
+    }
+    return result;
 }
 
 void Trace::setWaveform(
@@ -186,6 +247,7 @@ void Trace::setWaveform(
     {
         throw std::runtime_error("x is null");
     }
+    detach();
     mTrace->setData(length, xPtr);
 }
 
@@ -197,7 +259,22 @@ pybind11::array_t<double> Trace::getWaveform() const
     auto yPtr = static_cast<double *> (yBuffer.ptr);
     mTrace->getData(nSamples, &yPtr);
     return y;
+}
 
+pybind11::array Trace::getWaveformView() const
+{
+    auto nSamples = getNumberOfSamples();
+    if (nSamples < 1){return pybind11::array_t<double> (0);}
+    auto precision = mTrace->getPrecision();
+    if (precision == SFF::MiniSEED::Precision::INT32)
+    {
+        return makeArrayView(mTrace, mTrace->getDataPointer32i(), nSamples);
+    }
+    else if (precision == SFF::MiniSEED::Precision::FLOAT32)
+    {
+        return makeArrayView(mTrace, mTrace->getDataPointer32f(), nSamples);
+    }
+    return makeArrayView(mTrace, mTrace->getDataPointer64f(), nSamples);
 }
 
 /// Start time
@@ -250,6 +327,12 @@ int Trace::getNumberOfSamples() const noexcept
 /// Destructor
 void Trace::clear() noexcept
 {
+    // Array views may still be referencing the data
+    if (mTrace.use_count() > 1)
+    {
+        mTrace = std::make_shared<SFF::MiniSEED::Trace> ();
+        return;
+    }
     mTrace->clear();
 }
 
@@ -317,7 +400,10 @@ Properties :
     start_time : Time
         The start time of the trace.
     waveform : np.array
-        The waveform data for this SNCL.
+        The waveform data for this SNCL.  Reading this returns a read-only
+        array in the trace's native precision (int32, float32, or float64)
+        that shares memory with the trace.  Use get_waveform(as_double=True)
+        for a float64 copy.
 
 Read-only Properties
     number_of_samples : int
@@ -336,8 +422,16 @@ Read-only Properties
                        &Trace::getStartTime,
                        &Trace::setStartTime);
     trace.def_property("waveform",
-                       &Trace::getWaveform,
+                       &Trace::getWaveformView,
                        &Trace::setWaveform);
+    trace.def("get_waveform",
+              [](const Trace &self, const bool asDouble) -> pybind11::array
+              {
+                  if (asDouble){return self.getWaveform();}
+                  return self.getWaveformView();
+              },
+              pybind11::arg("as_double") = false,
+              "Gets the waveform.  By default this is a read-only view in the trace's native precision.  If as_double is True then a float64 copy is returned.");
     trace.def_property("sncl",
                        &Trace::getSNCL,
                        &Trace::setSNCL);
@@ -347,8 +441,24 @@ Read-only Properties
                                 &Trace::getSamplingPeriod);
     trace.def("read",
               &Trace::read,
+              pybind11::call_guard<pybind11::gil_scoped_release> (),
               "Loads the waveform in the MiniSEED file corresponding to the SNCL");
     trace.def("clear",
               &Trace::clear,
               "Releases memory and resets the class.");
+    //--------------------------------Batch Reads-----------------------------//
+    mseed.def("read_many",
+              [](const std::vector<std::string> &fileNames,
+                 const std::vector<SNCL> &sncls,
+                 const int nThreads, const bool stack) -> pybind11::object
+              {
+                  auto traces = Trace::readMany(fileNames, sncls, nThreads);
+                  if (stack){return Trace::stack(traces);}
+                  return pybind11::cast(std::move(traces));
+              },
+              pybind11::arg("file_names"),
+              pybind11::arg("sncls"),
+              pybind11::arg("threads") = 0,
+              pybind11::arg("stack") = false,
+              "Loads the waveforms in the given MiniSEED files using the given number of threads.  sncls is either a list with one SNCL that is used for all files or a list with one SNCL per file.  If threads is not positive then all available cores are used.  The GIL is released while reading.  By default a list of Traces is returned.  If stack is True then a float64 NumPy array of dimension [len(file_names) x number_of_samples] is returned instead; in this case all traces must have the same number of samples.");
 }
@@ -3,6 +3,7 @@
 #ifdef USE_MSEED
 #include <memory>
 #include <string>
+#include <vector>
 #include <pybind11/numpy.h>
 #include "time.hpp"
 #include "sff/sac/enums.hpp"
@@ -77,9 +78,20 @@ public:
     void read(const std::string &fileName, const SNCL &sncl);
     /// Writes a miniseed waveform to file
     void write(const std::string &fileName);
+    /// Reads many miniseed waveforms from file in parallel.  Either one SNCL
+    /// is given for all files or one SNCL is given for each file.
+    static std::vector<Trace> readMany(const std::vector<std::string> &fileNames,
+                                       const std::vector<SNCL> &sncls,
+                                       int nThreads = 0);
+    /// Stacks the traces into a [nTraces x nSamples] row major matrix.
+    /// All traces must have the same number of samples.
+    static pybind11::array_t<double> stack(const std::vector<Trace> &traces);
     /// Sets the data
     void setWaveform(const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &x);
     pybind11::array_t<double> getWaveform() const;
+    /// Gets a read-only view of the data in its native precision that
+    /// shares memory with the trace
+    pybind11::array getWaveformView() const;
 
     /// Sets/gets the start time
     void setStartTime(const PBSFF::Time &time);
@@ -106,7 +118,9 @@ public:
     /// @brief Destructor.
     ~Trace();
 private:
-    std::unique_ptr<SFF::MiniSEED::Trace> mTrace;
+    /// Ensures no array views share the trace before modifying its data
+    void detach();
+    std::shared_ptr<SFF::MiniSEED::Trace> mTrace;
 };
 void initialize(pybind11::module &m);
 }
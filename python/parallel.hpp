@@ -0,0 +1,25 @@
+#ifndef PYSFF_PARALLEL_HPP
+#define PYSFF_PARALLEL_HPP
+#include <utility>
+#include <pybind11/pybind11.h>
+#include "private/parallelFor.hpp"
+
+namespace PBSFF
+{
+/// @brief Evaluates function(i) for i = 0, 1, ..., n - 1 on a pool of
+///        threads with the GIL released.
+/// @param[in] n         The number of tasks.
+/// @param[in] nThreads  The number of threads.  If this is not positive
+///                      then the hardware concurrency is used.
+/// @param[in] function  The task to evaluate.  This must not touch any
+///                      Python objects.
+/// @throws The exceptions of forEachInParallel() which is shared with the
+///         C++ readers in sff/utilities/reader.hpp.
+template<typename Function>
+void parallelFor(const int n, const int nThreads, Function &&function)
+{
+    pybind11::gil_scoped_release release;
+    forEachInParallel(n, nThreads, std::forward<Function> (function));
+}
+}
+#endif
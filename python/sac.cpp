@@ -1,17 +1,22 @@
 #include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <pybind11/stl.h>
 #include "sff/sac/waveform.hpp"
 #include "sff/sac/header.hpp"
 #include "sff/utilities/time.hpp"
 #include "time.hpp"
 #include "sac.hpp"
+#include "arrayView.hpp"
+#include "parallel.hpp"
 
 using namespace PBSFF;
 
 /// Constructor
 SAC::SAC() :
-    mWaveform(std::make_unique<SFF::SAC::Waveform> ())
+    mWaveform(std::make_shared<SFF::SAC::Waveform> ())
 {
 }
 
@@ -26,28 +31,54 @@ SAC::SAC(const SFF::SAC::Waveform &sac)
     *this = sac;
 }
 
+/// Move c'tor
+SAC::SAC(SAC &&sac) noexcept
+{
+    *this = std::move(sac);
+}
+
 /// Copy assignment operator
 SAC& SAC::operator=(const SAC &sac)
 {
     if (&sac == this){return *this;}
     mWaveform
-        = std::make_unique<SFF::SAC::Waveform> (*sac.mWaveform);
+        = std::make_shared<SFF::SAC::Waveform> (*sac.mWaveform);
+    return *this;
+}
+
+/// Move assignment operator
+SAC& SAC::operator=(SAC &&sac) noexcept
+{
+    if (&sac == this){return *this;}
+    mWaveform = std::move(sac.mWaveform);
     return *this;
 }
 
 SAC& SAC::operator=(const SFF::SAC::Waveform &sac)
 {
-    mWaveform = std::make_unique<SFF::SAC::Waveform> (sac);
+    mWaveform = std::make_shared<SFF::SAC::Waveform> (sac);
     return *this;
 }
 
 /// Destructor
 SAC::~SAC() = default;
 
+/// Detach from any array views
+void SAC::detach()
+{
+    if (mWaveform.use_count() > 1)
+    {
+        mWaveform = std::make_shared<SFF::SAC::Waveform> (*mWaveform);
+    }
+}
+
 /// Loads a time series from disk
 void SAC::read(const std::string &fileName)
 {
-    mWaveform->read(fileName);
+    // Views of the old waveform keep referring to the old waveform
+    auto waveform = std::make_shared<SFF::SAC::Waveform> ();
+    waveform->read(fileName);
+    mWaveform = std::move(waveform);
 }
 
 /// Writes a time series to disk
@@ -56,6 +87,46 @@ void SAC::write(const std::string &fileName)
     mWaveform->write(fileName);
 }
 
+/// Reads many time series from disk
+std::vector<SAC> SAC::readMany(const std::vector<std::string> &fileNames,
+                               const int nThreads)
+{
+    auto nFiles = static_cast<int> (fileNames.size());
+    std::vector<SAC> sacs(nFiles);
+    parallelFor(nFiles, nThreads, [&](const int i)
+    {
+        sacs[i].read(fileNames[i]);
+    });
+    return sacs;
+}
+
+/// Stacks the time series
+pybind11::array_t<float> SAC::stack(const std::vector<SAC> &sacs)
+{
+    auto nWaveforms = static_cast<pybind11::ssize_t> (sacs.size());
+    pybind11::ssize_t nSamples = 0;
+    if (nWaveforms > 0){nSamples = sacs[0].getNumberOfSamples();}
+    for (const auto &sac : sacs)
+    {
+        if (sac.getNumberOfSamples() != nSamples)
+        {
+            throw std::invalid_argument(
+                "All waveforms must have the same number of samples to stack");
+        }
+    }
+    pybind11::array_t<float, pybind11::array::c_style>
+        result({nWaveforms, nSamples});
+    auto resultPtr = result.mutable_data();
+    for (pybind11::ssize_t i = 0; i < nWaveforms; ++i)
+    {
+        if (nSamples < 1){break;}
+        std::copy(sacs[i].mWaveform->getDataPointer(),
+                  sacs[i].mWaveform->getDataPointer() + nSamples,
+                  resultPtr + i*nSamples);
+    }
+    return result;
+}
+
 /// Sampling period
 void SAC::setSamplingPeriod(const double dt)
 {
@@ -83,6 +154,7 @@ void SAC::setWaveform(
     {   
         throw std::runtime_error("x is null");
     }   
+    detach();
     mWaveform->setData(len, xptr);
 }
 
@@ -97,12 +169,25 @@ pybind11::array_t<double> SAC::getWaveform() const
     return y;
 }
 
+/// Gets a view of the waveform
+pybind11::array_t<float> SAC::getWaveformView() const
+{
+    return makeArrayView(mWaveform, mWaveform->getDataPointer(),
+                         mWaveform->getNumberOfSamples());
+}
+
 /// Gets the number of samples
 int SAC::getNumberOfSamples() const
 {
     return mWaveform->getNumberOfSamples();
 }
 
+/// Native class
+const SFF::SAC::Waveform& SAC::getNativeClassReference() const noexcept
+{
+    return *mWaveform;
+}
+
 /// Sampling rate
 void SAC::setSamplingRate(const double rate)
 {
@@ -212,13 +297,32 @@ void PBSFF::initializeSAC(pybind11::module &m)
     sac.doc() = "This is used for reading and writing SAC files.";
     sac.def("read",
             &PBSFF::SAC::read,
+            pybind11::call_guard<pybind11::gil_scoped_release> (),
             "Loads a waveform from disk corresponding to the given file name.");
     sac.def("write",
             &PBSFF::SAC::write,
+            pybind11::call_guard<pybind11::gil_scoped_release> (),
             "Writes a waveform to disk corresponding to the given file name.");
+    sac.def_static("read_many",
+                   [](const std::vector<std::string> &fileNames,
+                      const int nThreads, const bool stack) -> pybind11::object
+                   {
+                       auto sacs = PBSFF::SAC::readMany(fileNames, nThreads);
+                       if (stack){return PBSFF::SAC::stack(sacs);}
+                       return pybind11::cast(std::move(sacs));
+                   },
+                   pybind11::arg("file_names"),
+                   pybind11::arg("threads") = 0,
+                   pybind11::arg("stack") = false,
+                   "Loads the waveforms in the given files using the given number of threads.  If threads is not positive then all available cores are used.  The GIL is released while reading.  By default a list of SAC objects is returned.  If stack is True then a float32 NumPy array of dimension [len(file_names) x npts] is returned instead; in this case all waveforms must have the same number of samples.");
     sac.def("get_data",
-            &PBSFF::SAC::getWaveform,
-            "Gets the waveform data as a NumPy array.");
+            [](const PBSFF::SAC &self, const bool asDouble) -> pybind11::array
+            {
+                if (asDouble){return self.getWaveform();}
+                return self.getWaveformView();
+            },
+            pybind11::arg("as_double") = false,
+            "Gets the waveform data as a NumPy array.  By default this is a read-only float32 array that shares memory with the waveform.  If as_double is True then a float64 copy of the data is returned.");
     sac.def("set_data",
             &PBSFF::SAC::setWaveform,
             "Sets the waveform data from a NumPy array.");
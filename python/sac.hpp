@@ -2,6 +2,7 @@
 #define SFF_SAC_HPP
 #include <memory>
 #include <string>
+#include <vector>
 #include <pybind11/numpy.h>
 #include "time.hpp"
 #include "sff/sac/enums.hpp"
@@ -20,16 +21,28 @@ public:
     /// Copy c'tor
     SAC(const SAC &sac);
     SAC(const SFF::SAC::Waveform &sac);
+    /// Move c'tor
+    SAC(SAC &&sac) noexcept;
     /// Copy assignment operator
     SAC& operator=(const SAC &sac);
+    /// Move assignment operator
+    SAC& operator=(SAC &&sac) noexcept;
     SAC& operator=(const SFF::SAC::Waveform &sac);
     /// Reads a SAC waveform from file
     void read(const std::string &fileName);
     /// Writes a SAC waveform to file
     void write(const std::string &fileName);
+    /// Reads many SAC waveforms from file in parallel
+    static std::vector<SAC> readMany(const std::vector<std::string> &fileNames,
+                                     int nThreads = 0);
+    /// Stacks the waveforms into a [nWaveforms x nSamples] row major matrix.
+    /// All waveforms must have the same number of samples.
+    static pybind11::array_t<float> stack(const std::vector<SAC> &sacs);
     /// Sets the data
     void setWaveform(const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &x);
     pybind11::array_t<double> getWaveform() const;    
+    /// Gets a read-only view of the data that shares memory with the waveform
+    pybind11::array_t<float> getWaveformView() const;
     /// Sets the sampling period
     void setSamplingPeriod(double samplingPeriod);
     double getSamplingPeriod() const;
@@ -40,6 +53,8 @@ public:
     PBSFF::Time getStartTime() const;
     /// Gets the number of samples
     int getNumberOfSamples() const;
+    /// Native class
+    const SFF::SAC::Waveform& getNativeClassReference() const noexcept;
     /// The header variables
     void setDoubleHeaderVariable(const SFF::SAC::Double name, double value);
     double getDoubleHeaderVariable(const SFF::SAC::Double name) const;
@@ -54,7 +69,9 @@ public:
     /// Destrutcor
     ~SAC();
 private:
-    std::unique_ptr<SFF::SAC::Waveform> mWaveform;
+    /// Ensures no array views share the waveform before modifying its data
+    void detach();
+    std::shared_ptr<SFF::SAC::Waveform> mWaveform;
 };
 void initializeSAC(pybind11::module &m);
 }
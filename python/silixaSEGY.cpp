@@ -1,21 +1,85 @@
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include "sff/segy/silixa/traceGroup.hpp"
 #include "sff/segy/silixa/trace.hpp"
+#include "sff/segy/silixa/binaryFileHeader.hpp"
+#include "sff/utilities/alignedBuffer.hpp"
 #include "sff/utilities/time.hpp"
 #include "time.hpp"
 #include "silixaSEGY.hpp"
+#include "arrayView.hpp"
 
 using namespace PBSFF::SEGY::Silixa;
 
+namespace
+{
+/// Hands out consecutive rows of one contiguous matrix.  When the traces of
+/// a group are unpacked in order from this resource the samples of trace i
+/// are row i so the group's samples may be viewed as a single matrix.  The
+/// rows are padded to the alignment of the trace's samples.
+class RowResource : public std::pmr::memory_resource
+{
+public:
+    RowResource(const size_t nRows, const size_t nColumns) :
+        mLeadingDimension(padLength(nColumns)),
+        mRows(nRows),
+        mBuffer(nRows*mLeadingDimension)
+    {
+    }
+    [[nodiscard]] const float *data() const noexcept{return mBuffer.data();}
+    [[nodiscard]] size_t getLeadingDimension() const noexcept
+    {
+        return mLeadingDimension;
+    }
+private:
+    [[nodiscard]] static size_t padLength(const size_t n) noexcept
+    {
+        constexpr auto nAlign = SFF::Utilities::AlignedBuffer<float>::ALIGNMENT
+                               /sizeof(float);
+        return ((n + nAlign - 1)/nAlign)*nAlign;
+    }
+    void *do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        if (mNextRow >= mRows ||
+            bytes > mLeadingDimension*sizeof(float) ||
+            alignment > SFF::Utilities::AlignedBuffer<float>::ALIGNMENT)
+        {
+            throw std::bad_alloc();
+        }
+        auto row = mBuffer.data() + mNextRow*mLeadingDimension;
+        mNextRow = mNextRow + 1;
+        return row;
+    }
+    /// The rows are released with the matrix
+    void do_deallocate(void *, size_t, size_t) override
+    {
+    }
+    [[nodiscard]] bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+    size_t mLeadingDimension{0};
+    size_t mRows{0};
+    size_t mNextRow{0};
+    SFF::Utilities::AlignedBuffer<float> mBuffer;
+};
+}
+
 //----------------------------------------------------------------------------//
 //                                    Trace                                   //
 //----------------------------------------------------------------------------//
 
 /// Constructor
 Trace::Trace() :
-    mWaveform(std::make_unique<SFF::SEGY::Silixa::Trace> ())
+    mWaveform(std::make_shared<SFF::SEGY::Silixa::Trace> ())
 {
 }
 
@@ -36,7 +100,7 @@ Trace::Trace(const SFF::SEGY::Silixa::Trace &trace)
 Trace& Trace::operator=(const Trace &trace)
 {
     if (&trace == this){return *this;}
-    mWaveform = std::make_unique<SFF::SEGY::Silixa::Trace> (*trace.mWaveform); 
+    mWaveform = std::make_shared<SFF::SEGY::Silixa::Trace> (*trace.mWaveform);
     return *this;
 }
 
@@ -44,13 +108,22 @@ Trace& Trace::operator=(const Trace &trace)
 /// Copy assignment operator
 Trace& Trace::operator=(const SFF::SEGY::Silixa::Trace &trace)
 {
-    mWaveform = std::make_unique<SFF::SEGY::Silixa::Trace> (trace); 
+    mWaveform = std::make_shared<SFF::SEGY::Silixa::Trace> (trace);
     return *this;
 }
 
 /// Destructor
 Trace::~Trace() = default;
 
+/// Detach from any array views
+void Trace::detach()
+{
+    if (mWaveform.use_count() > 1)
+    {
+        mWaveform = std::make_shared<SFF::SEGY::Silixa::Trace> (*mWaveform);
+    }
+}
+
 /// Sets the waveform
 void Trace::setWaveform(pybind11::array_t<double, pybind11::array::c_style |
                                           pybind11::array::forcecast> &x)
@@ -62,6 +135,7 @@ void Trace::setWaveform(pybind11::array_t<double, pybind11::array::c_style |
     {
         throw std::runtime_error("x is null");
     }
+    detach();
     mWaveform->setData(len, xptr);
 }
 
@@ -76,6 +150,13 @@ pybind11::array_t<double> Trace::getWaveform() const
     return y;
 }
 
+/// Gets a view of the waveform
+pybind11::array_t<float> Trace::getWaveformView() const
+{
+    return makeArrayView(mWaveform, mWaveform->getDataPointer(),
+                         mWaveform->getNumberOfSamples());
+}
+
 /// Gets the sampling period 
 double Trace::getSamplingPeriod() const
 {
@@ -128,13 +209,17 @@ TraceGroup::TraceGroup(const SFF::SEGY::Silixa::TraceGroup &group)
 TraceGroup& TraceGroup::operator=(const TraceGroup &group)
 {
     if (&group == this){return *this;}
+    // The copy shares the samples so it must also own them.  The old
+    // group is released before the samples it may point into.
     mGroup = std::make_unique<SFF::SEGY::Silixa::TraceGroup> (*group.mGroup);
+    mSamples = group.mSamples;
     return *this;
 }
 
 TraceGroup& TraceGroup::operator=(const SFF::SEGY::Silixa::TraceGroup &group)
 {
     mGroup = std::make_unique<SFF::SEGY::Silixa::TraceGroup> (group);
+    mSamples.reset();
     return *this;
 }
 
@@ -145,14 +230,140 @@ TraceGroup::~TraceGroup() = default;
 void TraceGroup::read(const std::string &fileName)
 {
     mGroup->read(fileName);
+    mSamples.reset();
 }
  
+/// Reads the data into a matrix
+pybind11::array_t<float> TraceGroup::readData(const std::string &fileName)
+{
+    std::shared_ptr<RowResource> samples;
+    {
+    pybind11::gil_scoped_release release;
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        throw std::invalid_argument("Could not open " + fileName);
+    }
+    file.seekg(0, file.end);
+    auto nBytes = static_cast<size_t> (file.tellg());
+    file.seekg(0, file.beg);
+    std::vector<char> bytes(nBytes);
+    file.read(bytes.data(), static_cast<std::streamsize> (nBytes));
+    if (static_cast<size_t> (file.gcount()) != nBytes)
+    {
+        throw std::runtime_error("Failed to read " + fileName);
+    }
+    if (nBytes < 3600)
+    {
+        throw std::invalid_argument("File must be at least 3600 bytes");
+    }
+    // Size the matrix from the binary file header.  The group verifies
+    // the header against the file size so only the rows that fit in the
+    // file are allocated here.
+    SFF::SEGY::Silixa::BinaryFileHeader header;
+    header.set(bytes.data() + 3200);
+    auto nSamples = static_cast<size_t>
+                    (std::max(0, header.getNumberOfSamplesPerTrace()));
+    auto nTraces = static_cast<size_t>
+                   (std::max(int64_t {0}, header.getNumberOfTraces()));
+    nTraces = std::min(nTraces, nBytes/(240 + 4*nSamples));
+    samples = std::make_shared<RowResource> (nTraces, nSamples);
+    // The traces are unpacked in order so trace i's samples are row i.
+    // Release the old group before the samples it may point into.
+    auto group = std::make_unique<SFF::SEGY::Silixa::TraceGroup> ();
+    group->set(nBytes, bytes.data(), samples.get());
+    mGroup = std::move(group);
+    mSamples = samples;
+    }
+    return makeMatrixView(samples, samples->data(),
+                          static_cast<pybind11::ssize_t> (getNumberOfTraces()),
+                          static_cast<pybind11::ssize_t>
+                          (getNumberOfSamplesPerTrace()),
+                          static_cast<pybind11::ssize_t>
+                          (samples->getLeadingDimension()));
+}
+
 /// Gets the number of traces
 int TraceGroup::getNumberOfTraces() const
 {
     return mGroup->getNumberOfTraces();
 }
 
+/// Gets the number of samples per trace
+int TraceGroup::getNumberOfSamplesPerTrace() const
+{
+    if (getNumberOfTraces() == 0){return 0;}
+    return mGroup->getNumberOfSamplesPerTrace();
+}
+
+/// Gets the data as a matrix
+pybind11::array_t<float> TraceGroup::getData() const
+{
+    auto nTraces = getNumberOfTraces();
+    auto nSamples = getNumberOfSamplesPerTrace();
+    pybind11::array_t<float, pybind11::array::c_style>
+        result({static_cast<pybind11::ssize_t> (nTraces),
+                static_cast<pybind11::ssize_t> (nSamples)});
+    auto resultPtr = result.mutable_data();
+    {
+    pybind11::gil_scoped_release release;
+    mGroup->getData(nTraces, nSamples, &resultPtr);
+    }
+    return result;
+}
+
+/// Gets the start times
+pybind11::array_t<double> TraceGroup::getStartTimes() const
+{
+    pybind11::array_t<double> result(getNumberOfTraces());
+    auto resultPtr = result.mutable_data();
+    for (const auto &trace : *mGroup)
+    {
+        *resultPtr = trace.getStartTime().getEpoch();
+        resultPtr = resultPtr + 1;
+    }
+    return result;
+}
+
+/// Gets the sampling rates
+pybind11::array_t<double> TraceGroup::getSamplingRates() const
+{
+    pybind11::array_t<double> result(getNumberOfTraces());
+    auto resultPtr = result.mutable_data();
+    for (const auto &trace : *mGroup)
+    {
+        *resultPtr = trace.getSamplingRate();
+        resultPtr = resultPtr + 1;
+    }
+    return result;
+}
+
+/// Gets the trace numbers
+pybind11::array_t<int> TraceGroup::getTraceNumbers() const
+{
+    pybind11::array_t<int> result(getNumberOfTraces());
+    auto resultPtr = result.mutable_data();
+    for (const auto &trace : *mGroup)
+    {
+        *resultPtr = trace.getTraceNumber();
+        resultPtr = resultPtr + 1;
+    }
+    return result;
+}
+
+/// Gets the correlation flags
+pybind11::array_t<bool> TraceGroup::getIsCorrelated() const
+{
+    pybind11::array_t<bool> result(getNumberOfTraces());
+    auto resultPtr = result.mutable_data();
+    for (const auto &trace : *mGroup)
+    {
+        *resultPtr = trace.getIsCorrelated();
+        resultPtr = resultPtr + 1;
+    }
+    return result;
+}
+
 /// Gets the it'th trace
 Trace TraceGroup::getTrace(const int it) const
 {
@@ -163,7 +374,10 @@ Trace TraceGroup::getTrace(const int it) const
                                   + std::to_string(getNumberOfTraces())
                                   + ")\n");
     }
-    Trace trace(mGroup->at(it));
+    SFF::SEGY::Silixa::Trace copy(mGroup->at(it));
+    // A trace may outlive the matrix holding the group's samples
+    if (mSamples){copy.setMemoryResource(nullptr);}
+    Trace trace(copy);
     return trace;
 }
 
@@ -182,8 +396,14 @@ void PBSFF::SEGY::Silixa::initializeTrace(pybind11::module &m)
               "Returns the trace's sampling rate in Hz.");
 
     trace.def("get_data",
-              &PBSFF::SEGY::Silixa::Trace::getWaveform,
-              "Gets the waveform data as a NumPy array.");
+              [](const PBSFF::SEGY::Silixa::Trace &self,
+                 const bool asDouble) -> pybind11::array
+              {
+                  if (asDouble){return self.getWaveform();}
+                  return self.getWaveformView();
+              },
+              pybind11::arg("as_double") = false,
+              "Gets the waveform data as a NumPy array.  By default this is a read-only float32 array that shares memory with the trace.  If as_double is True then a float64 copy of the data is returned.");
     trace.def("set_data",
               &PBSFF::SEGY::Silixa::Trace::setWaveform,
               "Sets the waveform data from a NumPy array.");
@@ -205,6 +425,7 @@ void PBSFF::SEGY::Silixa::initializeTrace(pybind11::module &m)
 
     group.def("read",
               &PBSFF::SEGY::Silixa::TraceGroup::read,
+              pybind11::call_guard<pybind11::gil_scoped_release> (),
               "Reads the Silixa SEGY file.");
     group.def("get_number_of_traces",
               &PBSFF::SEGY::Silixa::TraceGroup::getNumberOfTraces,
@@ -212,5 +433,26 @@ void PBSFF::SEGY::Silixa::initializeTrace(pybind11::module &m)
     group.def("get_trace",
               &PBSFF::SEGY::Silixa::TraceGroup::getTrace,
               "Gets the trace corresponding to the it'th index");
+    group.def("read_data",
+              &PBSFF::SEGY::Silixa::TraceGroup::readData,
+              "Reads the Silixa SEGY file and returns the traces as a read-only float32 NumPy array of dimension [number_of_traces x number_of_samples_per_trace].  The array shares memory with the trace group, whose samples are unpacked directly into its rows, so the samples are held once.  The rows may be padded for alignment.");
+    group.def("get_data",
+              &PBSFF::SEGY::Silixa::TraceGroup::getData,
+              "Gets the traces as a contiguous float32 NumPy array of dimension [number_of_traces x number_of_samples_per_trace].");
+    group.def("get_number_of_samples_per_trace",
+              &PBSFF::SEGY::Silixa::TraceGroup::getNumberOfSamplesPerTrace,
+              "Gets the number of samples in each trace.");
+    group.def("get_start_times",
+              &PBSFF::SEGY::Silixa::TraceGroup::getStartTimes,
+              "Gets the start time of each trace in UTC seconds since the epoch.");
+    group.def("get_sampling_rates",
+              &PBSFF::SEGY::Silixa::TraceGroup::getSamplingRates,
+              "Gets the sampling rate of each trace in Hz.");
+    group.def("get_trace_numbers",
+              &PBSFF::SEGY::Silixa::TraceGroup::getTraceNumbers,
+              "Gets the trace number of each trace.");
+    group.def("get_is_correlated",
+              &PBSFF::SEGY::Silixa::TraceGroup::getIsCorrelated,
+              "Determines whether or not each trace is correlated.");
 }
 
@@ -30,6 +30,8 @@ public:
     /// Sets/gets the waveform
     void setWaveform(pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &x);
     pybind11::array_t<double> getWaveform() const;
+    /// Gets a read-only view of the data that shares memory with the trace
+    pybind11::array_t<float> getWaveformView() const;
     /// Sets/gets the sampling period
     void setSamplingPeriod(double samplingPeriod);
     double getSamplingPeriod() const;
@@ -45,7 +47,9 @@ public:
     /// Determines if this correlated
     bool getIsCorrelated() const;
 private:
-    std::unique_ptr<SFF::SEGY::Silixa::Trace> mWaveform;
+    /// Ensures no array views share the trace before modifying its data
+    void detach();
+    std::shared_ptr<SFF::SEGY::Silixa::Trace> mWaveform;
 };
 
 class TraceGroup
@@ -66,7 +70,22 @@ public:
     void read(const std::string &fileName);
     /// Gets the number of traces in the group
     int getNumberOfTraces() const;
+    /// Gets the number of samples in each trace
+    int getNumberOfSamplesPerTrace() const;
+    /// Reads the data and returns it as a read-only [nTraces x nSamples]
+    /// matrix whose rows are the samples of the group's traces.
+    pybind11::array_t<float> readData(const std::string &fileName);
+    /// Gets the data as a [nTraces x nSamples] row major matrix
+    pybind11::array_t<float> getData() const;
+    /// Gets the trace header fields for all traces
+    pybind11::array_t<double> getStartTimes() const;
+    pybind11::array_t<double> getSamplingRates() const;
+    pybind11::array_t<int> getTraceNumbers() const;
+    pybind11::array_t<bool> getIsCorrelated() const;
 private:
+    // The contiguous samples of the traces after readData().  This is
+    // declared first so that it outlives the group.
+    std::shared_ptr<const void> mSamples;
     std::unique_ptr<SFF::SEGY::Silixa::TraceGroup> mGroup;
 };
 
@@ -93,6 +93,24 @@ def test_sac():
     ref = np.arange(1, 101, 1) 
     data = sac.get_data()
     assert np.max(ref - data) < 1.e-7, 'couldnt recover data'
+    assert data.dtype == np.float32, 'view should be float32'
+    assert not data.flags.writeable, 'view should be read-only'
+    data64 = sac.get_data(as_double = True)
+    assert data64.dtype == np.float64, 'copy should be float64'
+    assert np.max(ref - data64) < 1.e-7, 'couldnt recover double data'
+    # The view outlives changes to the waveform
+    sac.set_data(np.zeros(10))
+    assert np.max(ref - data) < 1.e-7, 'view changed after set_data'
+    assert sac.get_number_of_samples() == 10, 'set_data failed'
+    # Batch reads
+    sacs = pysff.SAC.read_many(['data/debug.sac']*3, threads = 2)
+    assert len(sacs) == 3, 'read_many failed'
+    for s in sacs:
+        assert np.max(ref - s.get_data()) < 1.e-7, 'read_many data failed'
+    stacked = pysff.SAC.read_many(['data/debug.sac']*3, stack = True)
+    assert stacked.shape == (3, 100), 'read_many stack shape failed'
+    assert stacked.dtype == np.float32, 'read_many stack dtype failed'
+    assert np.max(np.abs(stacked - ref)) < 1.e-7, 'read_many stack failed'
 
 def test_silixa_segy():
     tg = pysff.SilixaSEGY.TraceGroup()
@@ -102,6 +120,19 @@ def test_silixa_segy():
     ts = trace.get_data()
     assert trace.get_sampling_rate() == 2000, 'sampling rate is wrong'
     assert len(ts) == 30000, 'number of samples is wrong'
+    data = tg.read_data("data/FORGE_78-32_iDASv3-P11_UTC190427000008.sgy")
+    assert data.shape == (1280, 30000), 'matrix shape is wrong'
+    assert data.dtype == np.float32, 'matrix should be float32'
+    assert data.flags.c_contiguous, 'matrix should be contiguous'
+    assert np.max(np.abs(data[0,:] - ts)) == 0, 'first row is wrong'
+    assert not data.flags.writeable, 'matrix should share the group memory'
+    assert np.all(tg.get_sampling_rates() == 2000), 'sampling rates are wrong'
+    assert len(tg.get_start_times()) == 1280, 'start times are wrong'
+    assert len(tg.get_trace_numbers()) == 1280, 'trace numbers are wrong'
+    # The matrix and the traces outlive the group
+    last = tg.get_trace(1279).get_data()
+    del tg
+    assert np.max(np.abs(data[1279,:] - last)) == 0, 'last row is wrong'
 
 def test_hypoinverse2000():
     sta = pysff.HypoInverse2000.StationArchiveLine()
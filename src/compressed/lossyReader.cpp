@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "sff/compressed/lossyReader.hpp"
+#include "private/lossyFormat.hpp"
+#include "private/container.hpp"
+#include "private/fileIO.hpp"
+#include "private/instrumentation.hpp"
+
+using namespace SFF::Compressed;
+
+class LossyReader::LossyReaderImpl
+{
+public:
+    LossyReaderImpl() = default;
+    /// The copy gets its own descriptor so that closing one does not
+    /// close the other
+    LossyReaderImpl(const LossyReaderImpl &impl) :
+        mFileName(impl.mFileName),
+        mHeader(impl.mHeader),
+        mIndex(impl.mIndex),
+        mNames(impl.mNames),
+        mCompressedSize(impl.mCompressedSize)
+    {
+        if (impl.mDescriptor >= 0)
+        {
+            mDescriptor = ::fcntl(impl.mDescriptor, F_DUPFD_CLOEXEC, 0);
+            if (mDescriptor < 0)
+            {
+                throw std::runtime_error("Failed to duplicate descriptor for "
+                                       + mFileName + ": "
+                                       + std::strerror(errno));
+            }
+        }
+    }
+    LossyReaderImpl& operator=(const LossyReaderImpl &) = delete;
+    ~LossyReaderImpl()
+    {
+        close();
+    }
+    void close() noexcept
+    {
+        if (mDescriptor >= 0){::close(mDescriptor);}
+        mDescriptor = -1;
+        mFileName.clear();
+        mHeader = LossyFileHeader {};
+        mIndex.clear();
+        mNames.clear();
+        mCompressedSize = 0;
+    }
+    void checkOpen() const
+    {
+        if (mDescriptor < 0){throw std::runtime_error("File not open\n");}
+    }
+    void checkChannel(const int channel) const
+    {
+        if (channel < 0 || channel >= mHeader.nChannels)
+        {
+            throw std::invalid_argument("channel = " + std::to_string(channel)
+                                      + " must be in [0,"
+                                      + std::to_string(mHeader.nChannels - 1)
+                                      + "]");
+        }
+    }
+    /// Unpacks the index and channel names
+    void unpackTrailer(const std::vector<char> &trailer, const int64_t nBlocks)
+    {
+        const bool swap = (testByteOrder() == BIG_ENDIAN);
+        mIndex.resize(nBlocks);
+        auto blocksEnd = static_cast<int64_t> (LOSSY_HEADER_SIZE);
+        for (int64_t b = 0; b < nBlocks; ++b)
+        {
+            auto c = trailer.data() + b*LOSSY_INDEX_ENTRY_SIZE;
+            auto offset = unpackLong(&c[0], swap);
+            auto size = unpackLong(&c[8], swap);
+            if (offset != blocksEnd || size < 4)
+            {
+                throw std::invalid_argument("Corrupt block index entry "
+                                          + std::to_string(b));
+            }
+            mIndex[b] = std::pair(offset, size);
+            blocksEnd = offset + size;
+        }
+        if (blocksEnd != mHeader.indexOffset)
+        {
+            throw std::invalid_argument("Block index does not span the blocks");
+        }
+        mCompressedSize = blocksEnd - static_cast<int64_t> (LOSSY_HEADER_SIZE);
+        auto namesPosition = static_cast<size_t> (nBlocks)*LOSSY_INDEX_ENTRY_SIZE;
+        mNames = unpackChannelNames(trailer, namesPosition,
+                                    mHeader.nChannels);
+    }
+    /// Decodes the first nDecode channels of a block
+    void decode(const int block, const int nDecode, float *const y[],
+                std::vector<char> &bytes) const
+    {
+        const auto &[offset, size] = mIndex[block];
+        bytes.resize(static_cast<size_t> (size));
+        preadAll(mDescriptor, bytes.data(), bytes.size(), offset, mFileName);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, bytes.size());
+        decodeBlock(mHeader.predictor, bytes.data(), bytes.size(), nDecode,
+                    mHeader.nSamples, mHeader.absoluteError, y);
+    }
+    std::string mFileName;
+    LossyFileHeader mHeader;
+    std::vector<std::pair<int64_t, int64_t>> mIndex;
+    std::vector<std::string> mNames;
+    int64_t mCompressedSize{0};
+    int mDescriptor{-1};
+};
+
+/// Constructor
+LossyReader::LossyReader() :
+    pImpl(std::make_unique<LossyReaderImpl> ())
+{
+}
+
+/// Copy c'tor
+LossyReader::LossyReader(const LossyReader &reader)
+{
+    *this = reader;
+}
+
+/// Move c'tor
+LossyReader::LossyReader(LossyReader &&reader) noexcept
+{
+    *this = std::move(reader);
+}
+
+/// Copy assignment
+LossyReader& LossyReader::operator=(const LossyReader &reader)
+{
+    if (&reader == this){return *this;}
+    pImpl = std::make_unique<LossyReaderImpl> (*reader.pImpl);
+    return *this;
+}
+
+/// Move assignment
+LossyReader& LossyReader::operator=(LossyReader &&reader) noexcept
+{
+    if (&reader == this){return *this;}
+    pImpl = std::move(reader.pImpl);
+    return *this;
+}
+
+/// Destructor
+LossyReader::~LossyReader() = default;
+
+/// Close
+void LossyReader::close() noexcept
+{
+    pImpl->close();
+}
+
+/// Open
+void LossyReader::open(const std::string &fileName)
+{
+    close();
+    SFF_INSTRUMENT_SCOPE(HEADER);
+    auto fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::invalid_argument("Could not open " + fileName + ": "
+                                  + std::strerror(errno));
+    }
+    pImpl->mDescriptor = fd;
+    pImpl->mFileName = fileName;
+    try
+    {
+        struct stat status{};
+        if (::fstat(fd, &status) != 0)
+        {
+            throw std::runtime_error("Could not stat " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        auto fileSize = static_cast<int64_t> (status.st_size);
+        if (fileSize < static_cast<int64_t> (LOSSY_HEADER_SIZE))
+        {
+            throw std::invalid_argument(fileName
+                                      + " is too small to be compressed");
+        }
+        std::array<char, LOSSY_HEADER_SIZE> headerBytes;
+        preadAll(fd, headerBytes.data(), headerBytes.size(), 0, fileName);
+        auto &header = pImpl->mHeader;
+        header.unpack(headerBytes.data());
+        auto nBlocks = (static_cast<int64_t> (header.nChannels)
+                      + header.channelBlockSize - 1)/header.channelBlockSize;
+        if (header.indexOffset > fileSize ||
+            header.namesOffset != header.indexOffset
+                + nBlocks*static_cast<int64_t> (LOSSY_INDEX_ENTRY_SIZE) ||
+            header.namesOffset > fileSize)
+        {
+            throw std::invalid_argument("Corrupt block index offset in "
+                                      + fileName);
+        }
+        std::vector<char> trailer(fileSize - header.indexOffset);
+        preadAll(fd, trailer.data(), trailer.size(), header.indexOffset,
+                 fileName);
+        pImpl->unpackTrailer(trailer, nBlocks);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, headerBytes.size() + trailer.size());
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+}
+
+/// Is open?
+bool LossyReader::isOpen() const noexcept
+{
+    return pImpl->mDescriptor >= 0;
+}
+
+/// Properties
+int LossyReader::getNumberOfChannels() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.nChannels;
+}
+
+int64_t LossyReader::getNumberOfSamples() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.nSamples;
+}
+
+double LossyReader::getSamplingPeriod() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.samplingPeriod;
+}
+
+SFF::Utilities::Time LossyReader::getStartTime() const
+{
+    pImpl->checkOpen();
+    return SFF::Utilities::Time(pImpl->mHeader.startTime);
+}
+
+std::string LossyReader::getChannelName(const int channel) const
+{
+    pImpl->checkOpen();
+    pImpl->checkChannel(channel);
+    return pImpl->mNames[channel];
+}
+
+double LossyReader::getAbsoluteError() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.absoluteError;
+}
+
+Predictor LossyReader::getPredictor() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.predictor;
+}
+
+int LossyReader::getChannelBlockSize() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.channelBlockSize;
+}
+
+int64_t LossyReader::getCompressedSize() const
+{
+    pImpl->checkOpen();
+    return pImpl->mCompressedSize;
+}
+
+int64_t LossyReader::getUncompressedSize() const
+{
+    pImpl->checkOpen();
+    return 4*static_cast<int64_t> (pImpl->mHeader.nChannels)
+            *pImpl->mHeader.nSamples;
+}
+
+/// Read a channel
+std::vector<float> LossyReader::read(const int channel) const
+{
+    pImpl->checkOpen();
+    pImpl->checkChannel(channel);
+    SFF_INSTRUMENT_SCOPE(READ);
+    const auto blockSize = pImpl->mHeader.channelBlockSize;
+    auto block = channel/blockSize;
+    auto nDecode = channel - block*blockSize + 1;
+    std::vector<float> y(pImpl->mHeader.nSamples);
+    // Only the requested channel is kept
+    std::vector<float *> pointers(nDecode, nullptr);
+    pointers.back() = y.data();
+    std::vector<char> bytes;
+    pImpl->decode(block, nDecode, pointers.data(), bytes);
+    return y;
+}
+
+/// Read all channels
+std::vector<float> LossyReader::readAll(const int nThreadsIn) const
+{
+    pImpl->checkOpen();
+    SFF_INSTRUMENT_SCOPE(READ);
+    const auto nChannels = pImpl->mHeader.nChannels;
+    const auto nSamples = pImpl->mHeader.nSamples;
+    const auto blockSize = pImpl->mHeader.channelBlockSize;
+    const auto nBlocks = static_cast<int> (pImpl->mIndex.size());
+    auto nThreads = nThreadsIn;
+    if (nThreads < 1)
+    {
+        nThreads = std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+    }
+    nThreads = std::min(nThreads, nBlocks);
+    std::vector<float> y(static_cast<size_t> (nChannels)*nSamples);
+    // Threads take the next block until none remain
+    std::atomic<int> nextBlock{0};
+    auto decode = [&]()
+    {
+        std::vector<char> bytes;
+        std::vector<float *> pointers;
+        for (int block = nextBlock++; block < nBlocks; block = nextBlock++)
+        {
+            auto c0 = block*blockSize;
+            auto nDecode = std::min(blockSize, nChannels - c0);
+            pointers.resize(nDecode);
+            for (int i = 0; i < nDecode; ++i)
+            {
+                pointers[i] = y.data() + static_cast<size_t> (c0 + i)*nSamples;
+            }
+            pImpl->decode(block, nDecode, pointers.data(), bytes);
+        }
+    };
+    std::vector<std::future<void>> decoders;
+    for (int thread = 1; thread < nThreads; ++thread)
+    {
+        decoders.push_back(std::async(std::launch::async, decode));
+    }
+    try
+    {
+        decode();
+    }
+    catch (...)
+    {
+        nextBlock = nBlocks;
+        for (auto &decoder : decoders){decoder.wait();}
+        throw;
+    }
+    for (auto &decoder : decoders){decoder.get();}
+    return y;
+}
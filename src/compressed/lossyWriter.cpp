@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include "sff/compressed/lossyWriter.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "private/lossyFormat.hpp"
+#include "private/container.hpp"
+#include "private/instrumentation.hpp"
+
+using namespace SFF::Compressed;
+
+namespace
+{
+
+/// The number of uncompressed bytes compressed before a write is issued
+constexpr size_t BATCH_SIZE = 64*1024*1024;
+
+/// Runs f(i0, i1) over [0, n) split among nThreads threads
+template<typename F>
+void parallelFor(const size_t n, const size_t nThreads, F &&f)
+{
+    auto nWorkers = std::max(size_t {1}, std::min(nThreads, n));
+    std::vector<std::future<void>> workers;
+    for (size_t worker = 1; worker < nWorkers; ++worker)
+    {
+        workers.push_back(std::async(std::launch::async, f,
+                                     worker*n/nWorkers,
+                                     (worker + 1)*n/nWorkers));
+    }
+    f(size_t {0}, n/nWorkers);
+    for (auto &worker : workers){worker.get();}
+}
+
+}
+
+class LossyWriter::LossyWriterImpl
+{
+public:
+    void checkWritten() const
+    {
+        if (mCompressedSize < 1)
+        {
+            throw std::runtime_error("Nothing written\n");
+        }
+    }
+    ErrorBound mErrorBound{ErrorBound::ABSOLUTE};
+    Predictor mPredictor{Predictor::LORENZO};
+    double mTolerance{0};
+    double mAbsoluteError{0};
+    double mMaximumError{0};
+    int64_t mCompressedSize{0};
+    int64_t mUncompressedSize{0};
+    int mChannelBlockSize{32};
+    int mThreads{0};
+};
+
+/// Constructor
+LossyWriter::LossyWriter() :
+    pImpl(std::make_unique<LossyWriterImpl> ())
+{
+}
+
+/// Copy c'tor
+LossyWriter::LossyWriter(const LossyWriter &writer)
+{
+    *this = writer;
+}
+
+/// Move c'tor
+LossyWriter::LossyWriter(LossyWriter &&writer) noexcept
+{
+    *this = std::move(writer);
+}
+
+/// Copy assignment
+LossyWriter& LossyWriter::operator=(const LossyWriter &writer)
+{
+    if (&writer == this){return *this;}
+    pImpl = std::make_unique<LossyWriterImpl> (*writer.pImpl);
+    return *this;
+}
+
+/// Move assignment
+LossyWriter& LossyWriter::operator=(LossyWriter &&writer) noexcept
+{
+    if (&writer == this){return *this;}
+    pImpl = std::move(writer.pImpl);
+    return *this;
+}
+
+/// Destructor
+LossyWriter::~LossyWriter() = default;
+
+/// Error bound
+void LossyWriter::setErrorBound(const ErrorBound errorBound,
+                                const double tolerance)
+{
+    if (!(tolerance > 0) || !std::isfinite(tolerance))
+    {
+        throw std::invalid_argument("tolerance = " + std::to_string(tolerance)
+                                  + " must be positive");
+    }
+    pImpl->mErrorBound = errorBound;
+    pImpl->mTolerance = tolerance;
+}
+
+ErrorBound LossyWriter::getErrorBound() const noexcept
+{
+    return pImpl->mErrorBound;
+}
+
+double LossyWriter::getTolerance() const
+{
+    if (pImpl->mTolerance <= 0){throw std::runtime_error("Tolerance not set\n");}
+    return pImpl->mTolerance;
+}
+
+/// Predictor
+void LossyWriter::setPredictor(const Predictor predictor) noexcept
+{
+    pImpl->mPredictor = predictor;
+}
+
+Predictor LossyWriter::getPredictor() const noexcept
+{
+    return pImpl->mPredictor;
+}
+
+/// Channel block size
+void LossyWriter::setChannelBlockSize(const int channelBlockSize)
+{
+    if (channelBlockSize < 1)
+    {
+        throw std::invalid_argument("channelBlockSize = "
+                                  + std::to_string(channelBlockSize)
+                                  + " must be positive");
+    }
+    pImpl->mChannelBlockSize = channelBlockSize;
+}
+
+int LossyWriter::getChannelBlockSize() const noexcept
+{
+    return pImpl->mChannelBlockSize;
+}
+
+/// Number of threads
+void LossyWriter::setNumberOfThreads(const int nThreads) noexcept
+{
+    pImpl->mThreads = nThreads;
+}
+
+int LossyWriter::getNumberOfThreads() const noexcept
+{
+    if (pImpl->mThreads < 1)
+    {
+        return std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+    }
+    return pImpl->mThreads;
+}
+
+/// Write the channels
+void LossyWriter::write(const std::string &fileName,
+                        const std::vector<std::span<const float>> &channels,
+                        const double samplingPeriod,
+                        const SFF::Utilities::Time &startTime,
+                        const std::vector<std::string> &channelNames)
+{
+    auto tolerance = getTolerance();
+    if (channels.empty()){throw std::invalid_argument("No channels to write");}
+    if (channels.size() > static_cast<size_t> (std::numeric_limits<int>::max()))
+    {
+        throw std::invalid_argument("Too many channels");
+    }
+    auto nSamples = channels[0].size();
+    if (nSamples == 0){throw std::invalid_argument("Channels are empty");}
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+        if (channels[i].size() != nSamples)
+        {
+            throw std::invalid_argument("Channel " + std::to_string(i)
+                                      + " has "
+                                      + std::to_string(channels[i].size())
+                                      + " samples; expecting "
+                                      + std::to_string(nSamples));
+        }
+        if (channels[i].data() == nullptr)
+        {
+            throw std::invalid_argument("Channel " + std::to_string(i)
+                                      + " is NULL");
+        }
+    }
+    if (!(samplingPeriod > 0))
+    {
+        throw std::invalid_argument("Sampling period must be positive");
+    }
+    if (!channelNames.empty() && channelNames.size() != channels.size())
+    {
+        throw std::invalid_argument("Expecting "
+                                  + std::to_string(channels.size())
+                                  + " channel names");
+    }
+    SFF_INSTRUMENT_SCOPE(WRITE);
+    const auto nThreads = static_cast<size_t> (getNumberOfThreads());
+    const auto predictor = pImpl->mPredictor;
+    // Resolve the absolute error bound
+    auto absoluteError = tolerance;
+    if (pImpl->mErrorBound == ErrorBound::RELATIVE)
+    {
+        std::vector<std::pair<float, float>> ranges(channels.size());
+        parallelFor(channels.size(), nThreads,
+                    [&](const size_t i0, const size_t i1)
+        {
+            for (auto i = i0; i < i1; ++i)
+            {
+                auto lower = std::numeric_limits<float>::max();
+                auto upper = std::numeric_limits<float>::lowest();
+                for (const auto x : channels[i])
+                {
+                    if (!std::isfinite(x)){continue;}
+                    lower = std::min(lower, x);
+                    upper = std::max(upper, x);
+                }
+                ranges[i] = std::pair(lower, upper);
+            }
+        });
+        auto lower = std::numeric_limits<double>::max();
+        auto upper = std::numeric_limits<double>::lowest();
+        for (const auto &range : ranges)
+        {
+            lower = std::min(lower, static_cast<double> (range.first));
+            upper = std::max(upper, static_cast<double> (range.second));
+        }
+        absoluteError = tolerance*(upper - lower);
+        if (!(absoluteError > 0) || !std::isfinite(absoluteError))
+        {
+            throw std::invalid_argument(
+                "Relative error bound requires data with a finite range");
+        }
+    }
+    const auto blockSize = static_cast<size_t> (pImpl->mChannelBlockSize);
+    const auto nBlocks = (channels.size() + blockSize - 1)/blockSize;
+    const auto blocksPerBatch
+        = std::max(nThreads, BATCH_SIZE/(4*blockSize*nSamples));
+    LossyFileHeader header;
+    header.predictor = predictor;
+    header.errorBound = pImpl->mErrorBound;
+    header.channelBlockSize = static_cast<int32_t> (blockSize);
+    header.nChannels = static_cast<int32_t> (channels.size());
+    header.nSamples = static_cast<int64_t> (nSamples);
+    header.samplingPeriod = samplingPeriod;
+    header.startTime = startTime.getEpoch();
+    header.absoluteError = absoluteError;
+    header.tolerance = tolerance;
+    std::vector<double> maxErrors(nBlocks, 0);
+    // Each thread encodes a contiguous run of blocks
+    auto encodeBatch = [&](const size_t b0,
+                           const std::span<std::vector<char>> batch)
+    {
+        parallelFor(batch.size(), nThreads,
+                    [&](const size_t i0, const size_t i1)
+        {
+            for (auto i = i0; i < i1; ++i)
+            {
+                auto c0 = (b0 + i)*blockSize;
+                auto c1 = std::min(c0 + blockSize, channels.size());
+                std::span<const std::span<const float>>
+                    block(channels.data() + c0, c1 - c0);
+                maxErrors[b0 + i] = encodeBlock(predictor, block,
+                                                absoluteError, batch[i]);
+            }
+        });
+    };
+    const bool swap = (testByteOrder() == BIG_ENDIAN);
+    auto packEntry = [swap](const size_t, const int64_t offset,
+                            const int64_t size, char c[])
+    {
+        packLong(offset, &c[0], swap);
+        packLong(size, &c[8], swap);
+    };
+    auto fileSize
+        = writeContainer<LOSSY_HEADER_SIZE, LOSSY_INDEX_ENTRY_SIZE>
+          (fileName, header, nBlocks, blocksPerBatch, channels.size(),
+           channelNames, encodeBatch, packEntry);
+    pImpl->mAbsoluteError = absoluteError;
+    pImpl->mMaximumError = *std::max_element(maxErrors.begin(),
+                                             maxErrors.end());
+    pImpl->mCompressedSize = fileSize;
+    pImpl->mUncompressedSize = 4*static_cast<int64_t> (channels.size())
+                              *static_cast<int64_t> (nSamples);
+}
+
+/// Write a Silixa trace group
+void LossyWriter::write(const std::string &fileName,
+                        const SFF::SEGY::Silixa::TraceGroup &group)
+{
+    std::vector<std::span<const float>> channels;
+    std::vector<std::string> channelNames;
+    auto samplingPeriod = getChannels(group, &channels, &channelNames);
+    write(fileName, channels, samplingPeriod, group[0].getStartTime(),
+          channelNames);
+}
+
+/// Statistics
+double LossyWriter::getAbsoluteError() const
+{
+    pImpl->checkWritten();
+    return pImpl->mAbsoluteError;
+}
+
+double LossyWriter::getMaximumError() const
+{
+    pImpl->checkWritten();
+    return pImpl->mMaximumError;
+}
+
+int64_t LossyWriter::getCompressedSize() const
+{
+    pImpl->checkWritten();
+    return pImpl->mCompressedSize;
+}
+
+int64_t LossyWriter::getUncompressedSize() const
+{
+    pImpl->checkWritten();
+    return pImpl->mUncompressedSize;
+}
+
+double LossyWriter::getCompressionRatio() const
+{
+    pImpl->checkWritten();
+    return static_cast<double> (pImpl->mUncompressedSize)
+          /static_cast<double> (pImpl->mCompressedSize);
+}
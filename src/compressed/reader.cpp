@@ -0,0 +1,427 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "sff/compressed/reader.hpp"
+#include "private/compressedFormat.hpp"
+#include "private/container.hpp"
+#include "private/fileIO.hpp"
+#include "private/lz.hpp"
+#include "private/instrumentation.hpp"
+
+using namespace SFF::Compressed;
+
+namespace
+{
+
+/// Scratch space for decompressing a channel
+struct Workspace
+{
+    std::vector<char> compressed;
+    std::vector<char> bytes;
+    std::vector<float> samples;
+};
+
+}
+
+class Reader::ReaderImpl
+{
+public:
+    ReaderImpl() = default;
+    /// The copy gets its own descriptor so that closing one does not
+    /// close the other
+    ReaderImpl(const ReaderImpl &impl) :
+        mFileName(impl.mFileName),
+        mHeader(impl.mHeader),
+        mIndex(impl.mIndex),
+        mNames(impl.mNames),
+        mChunksPerChannel(impl.mChunksPerChannel),
+        mCompressedSize(impl.mCompressedSize)
+    {
+        if (impl.mDescriptor >= 0)
+        {
+            mDescriptor = ::fcntl(impl.mDescriptor, F_DUPFD_CLOEXEC, 0);
+            if (mDescriptor < 0)
+            {
+                throw std::runtime_error("Failed to duplicate descriptor for "
+                                       + mFileName + ": "
+                                       + std::strerror(errno));
+            }
+        }
+    }
+    ReaderImpl& operator=(const ReaderImpl &) = delete;
+    ~ReaderImpl()
+    {
+        close();
+    }
+    void close() noexcept
+    {
+        if (mDescriptor >= 0){::close(mDescriptor);}
+        mDescriptor = -1;
+        mFileName.clear();
+        mHeader = CompressedFileHeader {};
+        mIndex.clear();
+        mNames.clear();
+        mChunksPerChannel = 0;
+        mCompressedSize = 0;
+    }
+    void checkOpen() const
+    {
+        if (mDescriptor < 0){throw std::runtime_error("File not open\n");}
+    }
+    void checkChannel(const int channel) const
+    {
+        if (channel < 0 || channel >= mHeader.nChannels)
+        {
+            throw std::invalid_argument("channel = " + std::to_string(channel)
+                                      + " must be in [0,"
+                                      + std::to_string(mHeader.nChannels - 1)
+                                      + "]");
+        }
+    }
+    /// Unpacks the index and channel names
+    void unpackTrailer(const std::vector<char> &trailer, const int64_t nChunks)
+    {
+        const bool swap = (testByteOrder() == BIG_ENDIAN);
+        mIndex.resize(nChunks);
+        auto chunksEnd = static_cast<int64_t> (COMPRESSED_HEADER_SIZE);
+        for (int64_t k = 0; k < nChunks; ++k)
+        {
+            auto c = trailer.data() + k*COMPRESSED_INDEX_ENTRY_SIZE;
+            auto &entry = mIndex[k];
+            entry.offset = unpackLong(&c[0], swap);
+            entry.size = unpackInt(&c[8], swap);
+            auto codec = static_cast<uint8_t> (c[12]);
+            // The chunks must be contiguous so that a channel is one read
+            if (entry.offset != chunksEnd || entry.size < 0 || codec > 1)
+            {
+                throw std::invalid_argument("Corrupt chunk index entry "
+                                          + std::to_string(k));
+            }
+            entry.codec = static_cast<Codec> (codec);
+            chunksEnd = entry.offset + entry.size;
+        }
+        if (chunksEnd != mHeader.indexOffset)
+        {
+            throw std::invalid_argument("Chunk index does not span the chunks");
+        }
+        mCompressedSize = chunksEnd - static_cast<int64_t> (COMPRESSED_HEADER_SIZE);
+        auto namesPosition = static_cast<size_t> (nChunks)*COMPRESSED_INDEX_ENTRY_SIZE;
+        mNames = unpackChannelNames(trailer, namesPosition,
+                                    mHeader.nChannels);
+    }
+    /// Decompresses [firstSample, lastSample] of a channel into y
+    void decode(const int channel,
+                const int64_t firstSample, const int64_t lastSample,
+                float y[], Workspace &workspace) const
+    {
+        const auto chunkLength = static_cast<int64_t> (mHeader.chunkLength);
+        const auto k0 = channel*mChunksPerChannel + firstSample/chunkLength;
+        const auto k1 = channel*mChunksPerChannel + lastSample/chunkLength;
+        // The channel's chunks are adjacent so read them at once
+        auto begin = mIndex[k0].offset;
+        auto nBytes = static_cast<size_t> (mIndex[k1].offset + mIndex[k1].size
+                                         - begin);
+        workspace.compressed.resize(nBytes);
+        preadAll(mDescriptor, workspace.compressed.data(), nBytes, begin,
+                 mFileName);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, nBytes);
+        for (auto k = k0; k <= k1; ++k)
+        {
+            const auto &entry = mIndex[k];
+            auto s0 = (k - channel*mChunksPerChannel)*chunkLength;
+            auto n = static_cast<int> (std::min(chunkLength,
+                                                mHeader.nSamples - s0));
+            auto nChunkBytes = 4*static_cast<size_t> (n);
+            const char *bytes = workspace.compressed.data()
+                              + (entry.offset - begin);
+            if (entry.codec == Codec::LZ)
+            {
+                workspace.bytes.resize(nChunkBytes);
+                lzDecompress(bytes, static_cast<size_t> (entry.size),
+                             workspace.bytes.data(), nChunkBytes);
+                bytes = workspace.bytes.data();
+            }
+            else if (static_cast<size_t> (entry.size) != nChunkBytes)
+            {
+                throw std::runtime_error("Corrupt stored chunk "
+                                       + std::to_string(k));
+            }
+            auto lo = std::max(firstSample, s0);
+            auto hi = std::min(lastSample, s0 + n - 1);
+            if (lo == s0 && hi == s0 + n - 1)
+            {
+                inverseTransform(mHeader.transform, bytes, n,
+                                 y + (s0 - firstSample));
+            }
+            else
+            {
+                workspace.samples.resize(n);
+                inverseTransform(mHeader.transform, bytes, n,
+                                 workspace.samples.data());
+                std::copy(workspace.samples.data() + (lo - s0),
+                          workspace.samples.data() + (hi - s0) + 1,
+                          y + (lo - firstSample));
+            }
+        }
+    }
+    std::string mFileName;
+    CompressedFileHeader mHeader;
+    std::vector<ChunkIndexEntry> mIndex;
+    std::vector<std::string> mNames;
+    int64_t mChunksPerChannel{0};
+    int64_t mCompressedSize{0};
+    int mDescriptor{-1};
+};
+
+/// Constructor
+Reader::Reader() :
+    pImpl(std::make_unique<ReaderImpl> ())
+{
+}
+
+/// Copy c'tor
+Reader::Reader(const Reader &reader)
+{
+    *this = reader;
+}
+
+/// Move c'tor
+Reader::Reader(Reader &&reader) noexcept
+{
+    *this = std::move(reader);
+}
+
+/// Copy assignment
+Reader& Reader::operator=(const Reader &reader)
+{
+    if (&reader == this){return *this;}
+    pImpl = std::make_unique<ReaderImpl> (*reader.pImpl);
+    return *this;
+}
+
+/// Move assignment
+Reader& Reader::operator=(Reader &&reader) noexcept
+{
+    if (&reader == this){return *this;}
+    pImpl = std::move(reader.pImpl);
+    return *this;
+}
+
+/// Destructor
+Reader::~Reader() = default;
+
+/// Close
+void Reader::close() noexcept
+{
+    pImpl->close();
+}
+
+/// Open
+void Reader::open(const std::string &fileName)
+{
+    close();
+    SFF_INSTRUMENT_SCOPE(HEADER);
+    auto fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::invalid_argument("Could not open " + fileName + ": "
+                                  + std::strerror(errno));
+    }
+    pImpl->mDescriptor = fd;
+    pImpl->mFileName = fileName;
+    try
+    {
+        struct stat status{};
+        if (::fstat(fd, &status) != 0)
+        {
+            throw std::runtime_error("Could not stat " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        auto fileSize = static_cast<int64_t> (status.st_size);
+        if (fileSize < static_cast<int64_t> (COMPRESSED_HEADER_SIZE))
+        {
+            throw std::invalid_argument(fileName
+                                      + " is too small to be compressed");
+        }
+        std::array<char, COMPRESSED_HEADER_SIZE> headerBytes;
+        preadAll(fd, headerBytes.data(), headerBytes.size(), 0, fileName);
+        auto &header = pImpl->mHeader;
+        header.unpack(headerBytes.data());
+        // Check the index fits in the file before allocating it
+        auto chunksPerChannel = (header.nSamples + header.chunkLength - 1)
+                              /header.chunkLength;
+        auto maxChunks = (fileSize - header.indexOffset)
+                        /static_cast<int64_t> (COMPRESSED_INDEX_ENTRY_SIZE);
+        if (header.indexOffset > fileSize ||
+            chunksPerChannel > maxChunks/header.nChannels)
+        {
+            throw std::invalid_argument("Chunk index exceeds " + fileName);
+        }
+        auto nChunks = chunksPerChannel*header.nChannels;
+        if (header.namesOffset != header.indexOffset
+            + nChunks*static_cast<int64_t> (COMPRESSED_INDEX_ENTRY_SIZE))
+        {
+            throw std::invalid_argument("Corrupt channel name offset in "
+                                      + fileName);
+        }
+        std::vector<char> trailer(fileSize - header.indexOffset);
+        preadAll(fd, trailer.data(), trailer.size(), header.indexOffset,
+                 fileName);
+        pImpl->mChunksPerChannel = chunksPerChannel;
+        pImpl->unpackTrailer(trailer, nChunks);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, headerBytes.size() + trailer.size());
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+}
+
+/// Is open?
+bool Reader::isOpen() const noexcept
+{
+    return pImpl->mDescriptor >= 0;
+}
+
+/// Properties
+int Reader::getNumberOfChannels() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.nChannels;
+}
+
+int64_t Reader::getNumberOfSamples() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.nSamples;
+}
+
+double Reader::getSamplingPeriod() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.samplingPeriod;
+}
+
+SFF::Utilities::Time Reader::getStartTime() const
+{
+    pImpl->checkOpen();
+    return SFF::Utilities::Time(pImpl->mHeader.startTime);
+}
+
+std::string Reader::getChannelName(const int channel) const
+{
+    pImpl->checkOpen();
+    pImpl->checkChannel(channel);
+    return pImpl->mNames[channel];
+}
+
+Transform Reader::getTransform() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.transform;
+}
+
+int Reader::getChunkLength() const
+{
+    pImpl->checkOpen();
+    return pImpl->mHeader.chunkLength;
+}
+
+int64_t Reader::getCompressedSize() const
+{
+    pImpl->checkOpen();
+    return pImpl->mCompressedSize;
+}
+
+int64_t Reader::getUncompressedSize() const
+{
+    pImpl->checkOpen();
+    return 4*static_cast<int64_t> (pImpl->mHeader.nChannels)
+            *pImpl->mHeader.nSamples;
+}
+
+/// Read a sample range of a channel
+std::vector<float> Reader::read(const int channel,
+                                const int64_t firstSample,
+                                const int64_t lastSample) const
+{
+    pImpl->checkOpen();
+    pImpl->checkChannel(channel);
+    auto nSamples = pImpl->mHeader.nSamples;
+    if (firstSample < 0 || lastSample >= nSamples || firstSample > lastSample)
+    {
+        throw std::invalid_argument("Sample range ["
+                                  + std::to_string(firstSample) + ","
+                                  + std::to_string(lastSample)
+                                  + "] must be in [0,"
+                                  + std::to_string(nSamples - 1) + "]");
+    }
+    SFF_INSTRUMENT_SCOPE(READ);
+    std::vector<float> y(lastSample - firstSample + 1);
+    Workspace workspace;
+    pImpl->decode(channel, firstSample, lastSample, y.data(), workspace);
+    return y;
+}
+
+/// Read a channel
+std::vector<float> Reader::read(const int channel) const
+{
+    return read(channel, 0, getNumberOfSamples() - 1);
+}
+
+/// Read all channels
+std::vector<float> Reader::readAll(const int nThreadsIn) const
+{
+    pImpl->checkOpen();
+    SFF_INSTRUMENT_SCOPE(READ);
+    const auto nChannels = pImpl->mHeader.nChannels;
+    const auto nSamples = pImpl->mHeader.nSamples;
+    auto nThreads = nThreadsIn;
+    if (nThreads < 1)
+    {
+        nThreads = std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+    }
+    nThreads = std::min(nThreads, nChannels);
+    std::vector<float> y(static_cast<size_t> (nChannels)*nSamples);
+    // Threads take the next channel until none remain
+    std::atomic<int> nextChannel{0};
+    auto decode = [&]()
+    {
+        Workspace workspace;
+        for (int channel = nextChannel++; channel < nChannels;
+             channel = nextChannel++)
+        {
+            pImpl->decode(channel, 0, nSamples - 1,
+                          y.data() + static_cast<size_t> (channel)*nSamples,
+                          workspace);
+        }
+    };
+    std::vector<std::future<void>> decoders;
+    for (int thread = 1; thread < nThreads; ++thread)
+    {
+        decoders.push_back(std::async(std::launch::async, decode));
+    }
+    try
+    {
+        decode();
+    }
+    catch (...)
+    {
+        nextChannel = nChannels;
+        for (auto &decoder : decoders){decoder.wait();}
+        throw;
+    }
+    for (auto &decoder : decoders){decoder.get();}
+    return y;
+}
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include "sff/compressed/writer.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/sac/enums.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "private/compressedFormat.hpp"
+#include "private/container.hpp"
+#include "private/lz.hpp"
+#include "private/instrumentation.hpp"
+
+using namespace SFF::Compressed;
+
+namespace
+{
+
+/// The number of uncompressed bytes compressed before a write is issued
+constexpr size_t BATCH_SIZE = 32*1024*1024;
+constexpr int MIN_CHUNK_LENGTH = 16;
+constexpr int MAX_CHUNK_LENGTH = 16*1024*1024;
+
+/// Transforms then compresses a chunk.  If the chunk does not compress
+/// then the transformed bytes are stored.
+/// @result The codec with which the chunk's bytes were stored.
+Codec compressChunk(const Transform transform,
+                    const float x[], const int n,
+                    std::vector<char> &work, std::vector<char> &bytes)
+{
+    auto nBytes = 4*static_cast<size_t> (n);
+    work.resize(nBytes);
+    forwardTransform(transform, x, n, work.data());
+    bytes.resize(lzCompressBound(nBytes));
+    auto size = lzCompress(work.data(), nBytes, bytes.data(), bytes.size());
+    if (size == 0 || size >= nBytes)
+    {
+        std::swap(bytes, work);
+        bytes.resize(nBytes);
+        return Codec::STORED;
+    }
+    bytes.resize(size);
+    return Codec::LZ;
+}
+
+/// Joins the SAC station identifiers into NET.STA.LOC.CHA
+std::string makeChannelName(const SFF::SAC::Waveform &waveform)
+{
+    std::string name;
+    for (const auto variable : {SFF::SAC::Character::KNETWK,
+                                SFF::SAC::Character::KSTNM,
+                                SFF::SAC::Character::KHOLE,
+                                SFF::SAC::Character::KCMPNM})
+    {
+        if (variable != SFF::SAC::Character::KNETWK){name.append(".");}
+        auto value = waveform.getHeader(variable);
+        if (value != "-12345"){name.append(value);}
+    }
+    return name;
+}
+
+}
+
+class Writer::WriterImpl
+{
+public:
+    Transform mTransform{Transform::BYTE_SHUFFLE};
+    int mChunkLength{8192};
+    int mThreads{0};
+};
+
+/// Constructor
+Writer::Writer() :
+    pImpl(std::make_unique<WriterImpl> ())
+{
+}
+
+/// Copy c'tor
+Writer::Writer(const Writer &writer)
+{
+    *this = writer;
+}
+
+/// Move c'tor
+Writer::Writer(Writer &&writer) noexcept
+{
+    *this = std::move(writer);
+}
+
+/// Copy assignment
+Writer& Writer::operator=(const Writer &writer)
+{
+    if (&writer == this){return *this;}
+    pImpl = std::make_unique<WriterImpl> (*writer.pImpl);
+    return *this;
+}
+
+/// Move assignment
+Writer& Writer::operator=(Writer &&writer) noexcept
+{
+    if (&writer == this){return *this;}
+    pImpl = std::move(writer.pImpl);
+    return *this;
+}
+
+/// Destructor
+Writer::~Writer() = default;
+
+/// Transform
+void Writer::setTransform(const Transform transform) noexcept
+{
+    pImpl->mTransform = transform;
+}
+
+Transform Writer::getTransform() const noexcept
+{
+    return pImpl->mTransform;
+}
+
+/// Chunk length
+void Writer::setChunkLength(const int chunkLength)
+{
+    if (chunkLength < MIN_CHUNK_LENGTH || chunkLength > MAX_CHUNK_LENGTH)
+    {
+        throw std::invalid_argument("chunkLength = "
+                                  + std::to_string(chunkLength)
+                                  + " must be in ["
+                                  + std::to_string(MIN_CHUNK_LENGTH) + ","
+                                  + std::to_string(MAX_CHUNK_LENGTH) + "]");
+    }
+    pImpl->mChunkLength = chunkLength;
+}
+
+int Writer::getChunkLength() const noexcept
+{
+    return pImpl->mChunkLength;
+}
+
+/// Number of threads
+void Writer::setNumberOfThreads(const int nThreads) noexcept
+{
+    pImpl->mThreads = nThreads;
+}
+
+int Writer::getNumberOfThreads() const noexcept
+{
+    if (pImpl->mThreads < 1)
+    {
+        return std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+    }
+    return pImpl->mThreads;
+}
+
+/// Write the channels
+void Writer::write(const std::string &fileName,
+                   const std::vector<std::span<const float>> &channels,
+                   const double samplingPeriod,
+                   const SFF::Utilities::Time &startTime,
+                   const std::vector<std::string> &channelNames) const
+{
+    if (channels.empty()){throw std::invalid_argument("No channels to write");}
+    if (channels.size() > static_cast<size_t> (std::numeric_limits<int>::max()))
+    {
+        throw std::invalid_argument("Too many channels");
+    }
+    auto nSamples = channels[0].size();
+    if (nSamples == 0){throw std::invalid_argument("Channels are empty");}
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+        if (channels[i].size() != nSamples)
+        {
+            throw std::invalid_argument("Channel " + std::to_string(i)
+                                      + " has "
+                                      + std::to_string(channels[i].size())
+                                      + " samples; expecting "
+                                      + std::to_string(nSamples));
+        }
+        if (channels[i].data() == nullptr)
+        {
+            throw std::invalid_argument("Channel " + std::to_string(i)
+                                      + " is NULL");
+        }
+    }
+    if (!(samplingPeriod > 0))
+    {
+        throw std::invalid_argument("Sampling period must be positive");
+    }
+    if (!channelNames.empty() && channelNames.size() != channels.size())
+    {
+        throw std::invalid_argument("Expecting "
+                                  + std::to_string(channels.size())
+                                  + " channel names");
+    }
+    SFF_INSTRUMENT_SCOPE(WRITE);
+    const auto transform = pImpl->mTransform;
+    const auto chunkLength = static_cast<size_t> (pImpl->mChunkLength);
+    const auto nThreads = static_cast<size_t> (getNumberOfThreads());
+    const auto chunksPerChannel = (nSamples + chunkLength - 1)/chunkLength;
+    const auto nChunks = channels.size()*chunksPerChannel;
+    const auto chunksPerBatch
+        = std::max(nThreads, BATCH_SIZE/(4*chunkLength));
+    CompressedFileHeader header;
+    header.transform = transform;
+    header.chunkLength = static_cast<int32_t> (chunkLength);
+    header.nChannels = static_cast<int32_t> (channels.size());
+    header.nSamples = static_cast<int64_t> (nSamples);
+    header.samplingPeriod = samplingPeriod;
+    header.startTime = startTime.getEpoch();
+    // The codecs are recorded in the index
+    std::vector<Codec> codecs(nChunks);
+    auto compressBatch = [&](const size_t k0,
+                             const std::span<std::vector<char>> batch)
+    {
+        auto nBatch = batch.size();
+        auto compress = [&](const size_t i0, const size_t i1)
+        {
+            std::vector<char> work;
+            for (auto i = i0; i < i1; ++i)
+            {
+                auto k = k0 + i;
+                auto channel = k/chunksPerChannel;
+                auto sample = (k%chunksPerChannel)*chunkLength;
+                auto n = std::min(chunkLength, nSamples - sample);
+                codecs[k] = compressChunk(transform,
+                                          channels[channel].data() + sample,
+                                          static_cast<int> (n), work,
+                                          batch[i]);
+            }
+        };
+        auto nWorkers = std::min(nThreads, nBatch);
+        std::vector<std::future<void>> compressors;
+        for (size_t worker = 1; worker < nWorkers; ++worker)
+        {
+            compressors.push_back(std::async(std::launch::async, compress,
+                                             worker*nBatch/nWorkers,
+                                             (worker + 1)*nBatch/nWorkers));
+        }
+        compress(0, nBatch/nWorkers);
+        for (auto &compressor : compressors){compressor.get();}
+    };
+    const bool swap = (testByteOrder() == BIG_ENDIAN);
+    auto packEntry = [&](const size_t k, const int64_t offset,
+                         const int64_t size, char c[])
+    {
+        packLong(offset, &c[0], swap);
+        packInt(static_cast<int32_t> (size), &c[8], swap);
+        c[12] = static_cast<char> (codecs[k]);
+    };
+    writeContainer<COMPRESSED_HEADER_SIZE, COMPRESSED_INDEX_ENTRY_SIZE>
+        (fileName, header, nChunks, chunksPerBatch, channels.size(),
+         channelNames, compressBatch, packEntry);
+}
+
+/// Write a Silixa trace group
+void Writer::write(const std::string &fileName,
+                   const SFF::SEGY::Silixa::TraceGroup &group) const
+{
+    std::vector<std::span<const float>> channels;
+    std::vector<std::string> channelNames;
+    auto samplingPeriod = getChannels(group, &channels, &channelNames);
+    write(fileName, channels, samplingPeriod, group[0].getStartTime(),
+          channelNames);
+}
+
+/// Write a SAC waveform
+void Writer::write(const std::string &fileName,
+                   const SFF::SAC::Waveform &waveform) const
+{
+    if (waveform.getNumberOfSamples() < 1)
+    {
+        throw std::invalid_argument("Waveform has no samples");
+    }
+    std::vector<std::span<const float>> channels{waveform.getDataSpan()};
+    write(fileName, channels, waveform.getSamplingPeriod(),
+          waveform.getStartTime(), {makeChannelName(waveform)});
+}
@@ -0,0 +1,123 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "sff/hypoinverse2000/archiveWriter.hpp"
+#include "sff/hypoinverse2000/eventSummary.hpp"
+
+using namespace SFF::HypoInverse2000;
+
+class ArchiveWriter::ArchiveWriterImpl
+{
+public:
+    /// Writes the buffer to disk
+    void flush()
+    {
+        if (mUsed > 0)
+        {
+            mFile.write(mBuffer.data(), mUsed);
+            mUsed = 0;
+            if (!mFile.good())
+            {
+                throw std::runtime_error("Failed to write to archive file");
+            }
+        }
+    }
+    std::ofstream mFile;
+    std::vector<char> mBuffer;
+    int mUsed = 0;
+};
+
+/// C'tor
+ArchiveWriter::ArchiveWriter() :
+    pImpl(std::make_unique<ArchiveWriterImpl> ())
+{
+}
+
+/// Move c'tor
+ArchiveWriter::ArchiveWriter(ArchiveWriter &&writer) noexcept
+{
+    *this = std::move(writer);
+}
+
+/// Move assignment
+ArchiveWriter& ArchiveWriter::operator=(ArchiveWriter &&writer) noexcept
+{
+    if (&writer == this){return *this;}
+    pImpl = std::move(writer.pImpl);
+    return *this;
+}
+
+/// Destructor
+ArchiveWriter::~ArchiveWriter()
+{
+    if (pImpl == nullptr){return;}
+    try
+    {
+        close();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Failed to close archive: " << e.what() << std::endl;
+    }
+}
+
+/// Open file
+void ArchiveWriter::open(const std::string &fileName, const int bufferSize)
+{
+    if (bufferSize < 1)
+    {
+        throw std::invalid_argument("bufferSize must be positive");
+    }
+    close();
+    pImpl->mFile.open(fileName, std::ofstream::binary | std::ofstream::trunc);
+    if (!pImpl->mFile.is_open())
+    {
+        throw std::runtime_error("Failed to open: " + fileName);
+    }
+    pImpl->mBuffer.resize(bufferSize);
+    pImpl->mUsed = 0;
+}
+
+/// Is the file open?
+bool ArchiveWriter::isOpen() const noexcept
+{
+    return pImpl->mFile.is_open();
+}
+
+/// Write an event
+void ArchiveWriter::write(const EventSummary &event)
+{
+    if (!isOpen()){throw std::runtime_error("Archive file not open");}
+    auto length = event.getPackedLength();
+    auto nAvailable = static_cast<int> (pImpl->mBuffer.size()) - pImpl->mUsed;
+    if (length > nAvailable)
+    {
+        pImpl->flush();
+        // Very large events get a larger buffer
+        if (length > static_cast<int> (pImpl->mBuffer.size()))
+        {
+            pImpl->mBuffer.resize(length);
+        }
+    }
+    auto nWritten = event.packString(pImpl->mBuffer.data() + pImpl->mUsed,
+                                     length);
+    pImpl->mUsed = pImpl->mUsed + nWritten;
+}
+
+/// Flush
+void ArchiveWriter::flush()
+{
+    if (!isOpen()){return;}
+    pImpl->flush();
+    pImpl->mFile.flush();
+}
+
+/// Close
+void ArchiveWriter::close()
+{
+    if (!isOpen()){return;}
+    flush();
+    pImpl->mFile.close();
+}
@@ -0,0 +1,877 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <limits>
+#include <unordered_map>
+#include "sff/hypoinverse2000/catalog.hpp"
+#include "sff/hypoinverse2000/eventSummary.hpp"
+#include "sff/hypoinverse2000/eventSummaryLine.hpp"
+#include "sff/hypoinverse2000/stationArchiveLine.hpp"
+#include "sff/utilities/time.hpp"
+
+using namespace SFF::HypoInverse2000;
+
+namespace
+{
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Converts a time to integer nanoseconds.  The underlying time has
+/// microsecond resolution.
+int64_t toNanoseconds(const SFF::Utilities::Time &time)
+{
+    auto microSeconds = static_cast<int64_t> (std::llround(time.getEpoch()*1.e6));
+    return microSeconds*1000;
+}
+
+/// Converts integer nanoseconds to a time.
+SFF::Utilities::Time fromNanoseconds(const int64_t ns)
+{
+    auto seconds = ns/1000000000;
+    auto remainder = ns%1000000000;
+    if (remainder < 0)
+    {
+        seconds = seconds - 1;
+        remainder = remainder + 1000000000;
+    }
+    SFF::Utilities::Time time;
+    time.setEpoch(static_cast<double> (seconds));
+    time.setMicroSecond(static_cast<int> (remainder/1000));
+    return time;
+}
+
+/// Hashes strings and string views alike so lookups need not allocate.
+struct StringHash
+{
+    using is_transparent = void;
+    [[nodiscard]] size_t operator()(const std::string_view s) const noexcept
+    {
+        return std::hash<std::string_view> {}(s);
+    }
+};
+
+/// Interns a string and returns its index in the dictionary.
+class Dictionary
+{
+public:
+    int intern(const std::string_view s)
+    {
+        auto it = mIndex.find(s);
+        if (it != mIndex.end()){return it->second;}
+        auto index = static_cast<int> (mValues.size());
+        mIndex.insert(std::pair(std::string {s}, index));
+        mValues.emplace_back(s);
+        return index;
+    }
+    [[nodiscard]] int find(const std::string_view s) const
+    {
+        auto it = mIndex.find(s);
+        if (it == mIndex.end()){return -1;}
+        return it->second;
+    }
+    void clear() noexcept
+    {
+        mIndex.clear();
+        mValues.clear();
+    }
+    std::unordered_map<std::string, int, StringHash, std::equal_to<>> mIndex;
+    std::vector<std::string> mValues;
+};
+
+/// Converts a mask to indices.
+std::vector<int> maskToIndices(const std::vector<uint8_t> &mask)
+{
+    std::vector<int> indices;
+    auto n = static_cast<int> (mask.size());
+    int nKeep = 0;
+    for (int i = 0; i < n; ++i){nKeep = nKeep + mask[i];}
+    indices.reserve(nKeep);
+    for (int i = 0; i < n; ++i)
+    {
+        if (mask[i] == 1){indices.push_back(i);}
+    }
+    return indices;
+}
+
+}
+
+class Catalog::CatalogImpl
+{
+public:
+    void clear() noexcept
+    {
+        mNetworks.clear();
+        mStations.clear();
+        mChannels.clear();
+        mLocations.clear();
+        mRemarks.clear();
+        mOriginTime.clear();
+        mLatitude.clear();
+        mLongitude.clear();
+        mDepth.clear();
+        mMagnitude.clear();
+        mEventIdentifier.clear();
+        mDistanceToClosestStation.clear();
+        mAzimuthalGap.clear();
+        mTravelTimeRMS.clear();
+        mNumberOfWeightedResiduals.clear();
+        mNumberOfSWeightedResiduals.clear();
+        mMagnitudeLabel.clear();
+        mPickOffset.clear();
+        mPickOffset.push_back(0);
+        mPickEvent.clear();
+        mPickNetwork.clear();
+        mPickStation.clear();
+        mPickChannel.clear();
+        mPickLocation.clear();
+        mPPickTime.clear();
+        mSPickTime.clear();
+        mPResidual.clear();
+        mSResidual.clear();
+        mPWeightUsed.clear();
+        mSWeightUsed.clear();
+        mDistance.clear();
+        mAzimuth.clear();
+        mTakeOffAngle.clear();
+        mPDelay.clear();
+        mSDelay.clear();
+        mPImportance.clear();
+        mSImportance.clear();
+        mAmplitude.clear();
+        mPeriod.clear();
+        mAmplitudeMagnitude.clear();
+        mDurationMagnitude.clear();
+        mCodaDuration.clear();
+        mPRemark.clear();
+        mSRemark.clear();
+        mPWeightCode.clear();
+        mSWeightCode.clear();
+        mAmplitudeUnits.clear();
+        mAmplitudeMagnitudeWeightCode.clear();
+        mDurationMagnitudeWeightCode.clear();
+        mFirstMotion.clear();
+        mAmplitudeMagnitudeLabel.clear();
+        mDurationMagnitudeLabel.clear();
+        mDataSourceCode.clear();
+    }
+    /// Appends an event line
+    void addOrigin(const EventSummaryLine &origin)
+    {
+        mOriginTime.push_back(origin.haveOriginTime() ?
+                              toNanoseconds(origin.getOriginTime()) :
+                              MISSING_TIME);
+        mLatitude.push_back(origin.haveLatitude() ?
+                            origin.getLatitude() : NaN);
+        mLongitude.push_back(origin.haveLongitude() ?
+                             origin.getLongitude() : NaN);
+        mDepth.push_back(origin.haveDepth() ? origin.getDepth() : NaN);
+        mMagnitude.push_back(origin.havePreferredMagnitude() ?
+                             origin.getPreferredMagnitude() : NaN);
+        mEventIdentifier.push_back(origin.haveEventIdentifier() ?
+                                   origin.getEventIdentifier() : 0);
+        mDistanceToClosestStation.push_back(
+            origin.haveDistanceToClosestStation() ?
+            origin.getDistanceToClosestStation() : NaN);
+        mAzimuthalGap.push_back(origin.haveAzimuthalGap() ?
+                                origin.getAzimuthalGap() : NaN);
+        mTravelTimeRMS.push_back(origin.haveResidualTravelTimeRMS() ?
+                                 origin.getResidualTravelTimeRMS() : NaN);
+        mNumberOfWeightedResiduals.push_back(
+            origin.haveNumberOfWeightedResiduals() ?
+            origin.getNumberOfWeightedResiduals() : -1);
+        mNumberOfSWeightedResiduals.push_back(
+            origin.haveNumberOfSWeightedResiduals() ?
+            origin.getNumberOfSWeightedResiduals() : -1);
+        mMagnitudeLabel.push_back(origin.havePreferredMagnitudeLabel() ?
+                                  origin.getPreferredMagnitudeLabel() : '\0');
+    }
+    /// Appends a pick
+    void addPick(const int eventIndex, const StationArchiveLine &pick)
+    {
+        mPickEvent.push_back(eventIndex);
+        mPickNetwork.push_back(pick.haveNetworkName() ?
+                               mNetworks.intern(pick.getNetworkName()) : -1);
+        mPickStation.push_back(pick.haveStationName() ?
+                               mStations.intern(pick.getStationName()) : -1);
+        mPickChannel.push_back(pick.haveChannelName() ?
+                               mChannels.intern(pick.getChannelName()) : -1);
+        mPickLocation.push_back(pick.haveLocationCode() ?
+                                mLocations.intern(pick.getLocationCode()) : -1);
+        mPRemark.push_back(pick.havePRemark() ?
+                           mRemarks.intern(pick.getPRemark()) : -1);
+        mSRemark.push_back(pick.haveSRemark() ?
+                           mRemarks.intern(pick.getSRemark()) : -1);
+        mPPickTime.push_back(pick.havePPickTime() ?
+                             toNanoseconds(pick.getPPickTime()) :
+                             MISSING_TIME);
+        mSPickTime.push_back(pick.haveSPickTime() ?
+                             toNanoseconds(pick.getSPickTime()) :
+                             MISSING_TIME);
+        mPResidual.push_back(pick.havePResidual() ?
+                             pick.getPResidual() : NaN);
+        mSResidual.push_back(pick.haveSResidual() ?
+                             pick.getSResidual() : NaN);
+        mPWeightUsed.push_back(pick.havePWeightUsed() ?
+                               pick.getPWeightUsed() : NaN);
+        mSWeightUsed.push_back(pick.haveSWeightUsed() ?
+                               pick.getSWeightUsed() : NaN);
+        mDistance.push_back(pick.haveEpicentralDistance() ?
+                            pick.getEpicentralDistance() : NaN);
+        mAzimuth.push_back(pick.haveAzimuth() ? pick.getAzimuth() : NaN);
+        mTakeOffAngle.push_back(pick.haveTakeOffAngle() ?
+                                pick.getTakeOffAngle() : NaN);
+        mPDelay.push_back(pick.havePDelayTime() ? pick.getPDelayTime() : NaN);
+        mSDelay.push_back(pick.haveSDelayTime() ? pick.getSDelayTime() : NaN);
+        mPImportance.push_back(pick.havePImportance() ?
+                               pick.getPImportance() : NaN);
+        mSImportance.push_back(pick.haveSImportance() ?
+                               pick.getSImportance() : NaN);
+        mAmplitude.push_back(pick.haveAmplitude() ? pick.getAmplitude() : NaN);
+        mPeriod.push_back(pick.havePeriodOfAmplitudeMeasurement() ?
+                          pick.getPeriodOfAmplitudeMeasurement() : NaN);
+        mAmplitudeMagnitude.push_back(pick.haveAmplitudeMagnitude() ?
+                                      pick.getAmplitudeMagnitude() : NaN);
+        mDurationMagnitude.push_back(pick.haveDurationMagnitude() ?
+                                     pick.getDurationMagnitude() : NaN);
+        mCodaDuration.push_back(pick.haveCodaDuration() ?
+                                pick.getCodaDuration() : NaN);
+        mPWeightCode.push_back(pick.havePWeightCode() ?
+                               static_cast<int8_t> (pick.getPWeightCode()) : -1);
+        mSWeightCode.push_back(pick.haveSWeightCode() ?
+                               static_cast<int8_t> (pick.getSWeightCode()) : -1);
+        mAmplitudeUnits.push_back(pick.haveAmplitudeUnits() ?
+            static_cast<int8_t> (pick.getAmplitudeUnits()) : -1);
+        mAmplitudeMagnitudeWeightCode.push_back(
+            pick.haveAmplitudeMagnitudeWeightCode() ?
+            static_cast<int8_t> (pick.getAmplitudeMagnitudeWeightCode()) : -1);
+        mDurationMagnitudeWeightCode.push_back(
+            pick.haveDurationMagnitudeWeightCode() ?
+            static_cast<int8_t> (pick.getDurationMagnitudeWeightCode()) : -1);
+        mFirstMotion.push_back(pick.haveFirstMotion() ?
+                               pick.getFirstMotion() : '\0');
+        mAmplitudeMagnitudeLabel.push_back(
+            pick.haveAmplitudeMagnitudeLabel() ?
+            pick.getAmplitudeMagnitudeLabel() : '\0');
+        mDurationMagnitudeLabel.push_back(
+            pick.haveDurationMagnitudeLabel() ?
+            pick.getDurationMagnitudeLabel() : '\0');
+        mDataSourceCode.push_back(pick.haveDataSourceCode() ?
+                                  pick.getDataSourceCode() : '\0');
+    }
+    /// Gets an event line
+    [[nodiscard]] EventSummaryLine getOrigin(const int i) const
+    {
+        EventSummaryLine origin;
+        if (mOriginTime[i] != MISSING_TIME)
+        {
+            origin.setOriginTime(fromNanoseconds(mOriginTime[i]));
+        }
+        if (!std::isnan(mLatitude[i])){origin.setLatitude(mLatitude[i]);}
+        if (!std::isnan(mLongitude[i])){origin.setLongitude(mLongitude[i]);}
+        if (!std::isnan(mDepth[i])){origin.setDepth(mDepth[i]);}
+        if (!std::isnan(mMagnitude[i]))
+        {
+            origin.setPreferredMagnitude(mMagnitude[i]);
+        }
+        if (mMagnitudeLabel[i] != '\0')
+        {
+            origin.setPreferredMagnitudeLabel(mMagnitudeLabel[i]);
+        }
+        if (mEventIdentifier[i] > 0)
+        {
+            origin.setEventIdentifier(mEventIdentifier[i]);
+        }
+        if (!std::isnan(mDistanceToClosestStation[i]))
+        {
+            origin.setDistanceToClosestStation(mDistanceToClosestStation[i]);
+        }
+        if (!std::isnan(mAzimuthalGap[i]))
+        {
+            origin.setAzimuthalGap(mAzimuthalGap[i]);
+        }
+        if (!std::isnan(mTravelTimeRMS[i]))
+        {
+            origin.setResidualTravelTimeRMS(mTravelTimeRMS[i]);
+        }
+        if (mNumberOfWeightedResiduals[i] >= 0)
+        {
+            origin.setNumberOfWeightedResiduals(mNumberOfWeightedResiduals[i]);
+        }
+        if (mNumberOfSWeightedResiduals[i] >= 0)
+        {
+            origin.setNumberOfSWeightedResiduals(
+                mNumberOfSWeightedResiduals[i]);
+        }
+        return origin;
+    }
+    /// Gets a pick
+    [[nodiscard]] StationArchiveLine getPick(const int i) const
+    {
+        StationArchiveLine pick;
+        if (mPickNetwork[i] >= 0)
+        {
+            pick.setNetworkName(mNetworks.mValues[mPickNetwork[i]]);
+        }
+        if (mPickStation[i] >= 0)
+        {
+            pick.setStationName(mStations.mValues[mPickStation[i]]);
+        }
+        if (mPickChannel[i] >= 0)
+        {
+            pick.setChannelName(mChannels.mValues[mPickChannel[i]]);
+        }
+        if (mPickLocation[i] >= 0)
+        {
+            pick.setLocationCode(mLocations.mValues[mPickLocation[i]]);
+        }
+        if (mPRemark[i] >= 0){pick.setPRemark(mRemarks.mValues[mPRemark[i]]);}
+        if (mSRemark[i] >= 0){pick.setSRemark(mRemarks.mValues[mSRemark[i]]);}
+        if (mPPickTime[i] != MISSING_TIME)
+        {
+            pick.setPPickTime(fromNanoseconds(mPPickTime[i]));
+        }
+        if (mSPickTime[i] != MISSING_TIME)
+        {
+            pick.setSPickTime(fromNanoseconds(mSPickTime[i]));
+        }
+        if (!std::isnan(mPResidual[i])){pick.setPResidual(mPResidual[i]);}
+        if (!std::isnan(mSResidual[i])){pick.setSResidual(mSResidual[i]);}
+        if (!std::isnan(mPWeightUsed[i])){pick.setPWeightUsed(mPWeightUsed[i]);}
+        if (!std::isnan(mSWeightUsed[i])){pick.setSWeightUsed(mSWeightUsed[i]);}
+        if (!std::isnan(mDistance[i])){pick.setEpicentralDistance(mDistance[i]);}
+        if (!std::isnan(mAzimuth[i])){pick.setAzimuth(mAzimuth[i]);}
+        if (!std::isnan(mTakeOffAngle[i]))
+        {
+            pick.setTakeOffAngle(mTakeOffAngle[i]);
+        }
+        if (!std::isnan(mPDelay[i])){pick.setPDelayTime(mPDelay[i]);}
+        if (!std::isnan(mSDelay[i])){pick.setSDelayTime(mSDelay[i]);}
+        if (!std::isnan(mPImportance[i])){pick.setPImportance(mPImportance[i]);}
+        if (!std::isnan(mSImportance[i])){pick.setSImportance(mSImportance[i]);}
+        if (!std::isnan(mAmplitude[i])){pick.setAmplitude(mAmplitude[i]);}
+        if (!std::isnan(mPeriod[i]))
+        {
+            pick.setPeriodOfAmplitudeMeasurement(mPeriod[i]);
+        }
+        if (!std::isnan(mAmplitudeMagnitude[i]))
+        {
+            pick.setAmplitudeMagnitude(mAmplitudeMagnitude[i]);
+        }
+        if (!std::isnan(mDurationMagnitude[i]))
+        {
+            pick.setDurationMagnitude(mDurationMagnitude[i]);
+        }
+        if (!std::isnan(mCodaDuration[i]))
+        {
+            pick.setCodaDuration(mCodaDuration[i]);
+        }
+        if (mPWeightCode[i] >= 0){pick.setPWeightCode(mPWeightCode[i]);}
+        if (mSWeightCode[i] >= 0){pick.setSWeightCode(mSWeightCode[i]);}
+        if (mAmplitudeUnits[i] >= 0)
+        {
+            pick.setAmplitudeUnits(
+                static_cast<AmplitudeUnits> (mAmplitudeUnits[i]));
+        }
+        if (mAmplitudeMagnitudeWeightCode[i] >= 0)
+        {
+            pick.setAmplitudeMagnitudeWeightCode(
+                mAmplitudeMagnitudeWeightCode[i]);
+        }
+        if (mDurationMagnitudeWeightCode[i] >= 0)
+        {
+            pick.setDurationMagnitudeWeightCode(
+                mDurationMagnitudeWeightCode[i]);
+        }
+        if (mFirstMotion[i] != '\0'){pick.setFirstMotion(mFirstMotion[i]);}
+        if (mAmplitudeMagnitudeLabel[i] != '\0')
+        {
+            pick.setAmplitudeMagnitudeLabel(mAmplitudeMagnitudeLabel[i]);
+        }
+        if (mDurationMagnitudeLabel[i] != '\0')
+        {
+            pick.setDurationMagnitudeLabel(mDurationMagnitudeLabel[i]);
+        }
+        if (mDataSourceCode[i] != '\0')
+        {
+            pick.setDataSourceCode(mDataSourceCode[i]);
+        }
+        return pick;
+    }
+    /// Finds the values of x in the range [x0, x1]
+    template<typename T>
+    [[nodiscard]] static std::vector<int> findInRange(const std::vector<T> &x,
+                                                      const T x0, const T x1)
+    {
+        auto n = static_cast<int> (x.size());
+        std::vector<uint8_t> mask(n);
+        const T *__restrict__ xPtr = x.data();
+        uint8_t *__restrict__ maskPtr = mask.data();
+        #pragma omp simd
+        for (int i = 0; i < n; ++i)
+        {
+            maskPtr[i] = (xPtr[i] >= x0 && xPtr[i] <= x1) ? 1 : 0;
+        }
+        return maskToIndices(mask);
+    }
+    // Dictionaries
+    Dictionary mNetworks;
+    Dictionary mStations;
+    Dictionary mChannels;
+    Dictionary mLocations;
+    Dictionary mRemarks;
+    // Origin columns
+    std::vector<int64_t> mOriginTime;
+    std::vector<double> mLatitude;
+    std::vector<double> mLongitude;
+    std::vector<double> mDepth;
+    std::vector<double> mMagnitude;
+    std::vector<uint64_t> mEventIdentifier;
+    std::vector<double> mDistanceToClosestStation;
+    std::vector<double> mAzimuthalGap;
+    std::vector<double> mTravelTimeRMS;
+    std::vector<int> mNumberOfWeightedResiduals;
+    std::vector<int> mNumberOfSWeightedResiduals;
+    std::vector<char> mMagnitudeLabel;
+    std::vector<int> mPickOffset{0};
+    // Pick columns
+    std::vector<int> mPickEvent;
+    std::vector<int> mPickNetwork;
+    std::vector<int> mPickStation;
+    std::vector<int> mPickChannel;
+    std::vector<int> mPickLocation;
+    std::vector<int64_t> mPPickTime;
+    std::vector<int64_t> mSPickTime;
+    std::vector<double> mPResidual;
+    std::vector<double> mSResidual;
+    std::vector<double> mPWeightUsed;
+    std::vector<double> mSWeightUsed;
+    std::vector<double> mDistance;
+    std::vector<double> mAzimuth;
+    std::vector<double> mTakeOffAngle;
+    std::vector<double> mPDelay;
+    std::vector<double> mSDelay;
+    std::vector<double> mPImportance;
+    std::vector<double> mSImportance;
+    std::vector<double> mAmplitude;
+    std::vector<double> mPeriod;
+    std::vector<double> mAmplitudeMagnitude;
+    std::vector<double> mDurationMagnitude;
+    std::vector<double> mCodaDuration;
+    std::vector<int> mPRemark;
+    std::vector<int> mSRemark;
+    std::vector<int8_t> mPWeightCode;
+    std::vector<int8_t> mSWeightCode;
+    std::vector<int8_t> mAmplitudeUnits;
+    std::vector<int8_t> mAmplitudeMagnitudeWeightCode;
+    std::vector<int8_t> mDurationMagnitudeWeightCode;
+    std::vector<char> mFirstMotion;
+    std::vector<char> mAmplitudeMagnitudeLabel;
+    std::vector<char> mDurationMagnitudeLabel;
+    std::vector<char> mDataSourceCode;
+};
+
+/// C'tor
+Catalog::Catalog() :
+    pImpl(std::make_unique<CatalogImpl> ())
+{
+}
+
+/// Copy c'tor
+Catalog::Catalog(const Catalog &catalog)
+{
+    *this = catalog;
+}
+
+/// Move c'tor
+Catalog::Catalog(Catalog &&catalog) noexcept
+{
+    *this = std::move(catalog);
+}
+
+/// Construct from events
+Catalog::Catalog(const std::vector<EventSummary> &events) :
+    pImpl(std::make_unique<CatalogImpl> ())
+{
+    int nPicks = 0;
+    for (const auto &event : events){nPicks = nPicks + event.getNumberOfPicks();}
+    reserve(static_cast<int> (events.size()), nPicks);
+    for (const auto &event : events){addEvent(event);}
+}
+
+/// Copy assignment
+Catalog& Catalog::operator=(const Catalog &catalog)
+{
+    if (&catalog == this){return *this;}
+    pImpl = std::make_unique<CatalogImpl> (*catalog.pImpl);
+    return *this;
+}
+
+/// Move assignment
+Catalog& Catalog::operator=(Catalog &&catalog) noexcept
+{
+    if (&catalog == this){return *this;}
+    pImpl = std::move(catalog.pImpl);
+    return *this;
+}
+
+/// Destructor
+Catalog::~Catalog() = default;
+
+/// Reset the class
+void Catalog::clear() noexcept
+{
+    pImpl->clear();
+}
+
+/// Reserve space
+void Catalog::reserve(const int nEvents, const int nPicks)
+{
+    if (nEvents < 0){throw std::invalid_argument("nEvents must be positive");}
+    if (nPicks < 0){throw std::invalid_argument("nPicks must be positive");}
+    pImpl->mOriginTime.reserve(nEvents);
+    pImpl->mLatitude.reserve(nEvents);
+    pImpl->mLongitude.reserve(nEvents);
+    pImpl->mDepth.reserve(nEvents);
+    pImpl->mMagnitude.reserve(nEvents);
+    pImpl->mEventIdentifier.reserve(nEvents);
+    pImpl->mDistanceToClosestStation.reserve(nEvents);
+    pImpl->mAzimuthalGap.reserve(nEvents);
+    pImpl->mTravelTimeRMS.reserve(nEvents);
+    pImpl->mNumberOfWeightedResiduals.reserve(nEvents);
+    pImpl->mNumberOfSWeightedResiduals.reserve(nEvents);
+    pImpl->mMagnitudeLabel.reserve(nEvents);
+    pImpl->mPickOffset.reserve(nEvents + 1);
+    pImpl->mPickEvent.reserve(nPicks);
+    pImpl->mPickNetwork.reserve(nPicks);
+    pImpl->mPickStation.reserve(nPicks);
+    pImpl->mPickChannel.reserve(nPicks);
+    pImpl->mPickLocation.reserve(nPicks);
+    pImpl->mPPickTime.reserve(nPicks);
+    pImpl->mSPickTime.reserve(nPicks);
+    pImpl->mPResidual.reserve(nPicks);
+    pImpl->mSResidual.reserve(nPicks);
+    pImpl->mPWeightUsed.reserve(nPicks);
+    pImpl->mSWeightUsed.reserve(nPicks);
+    pImpl->mDistance.reserve(nPicks);
+    pImpl->mAzimuth.reserve(nPicks);
+    pImpl->mTakeOffAngle.reserve(nPicks);
+    pImpl->mPDelay.reserve(nPicks);
+    pImpl->mSDelay.reserve(nPicks);
+    pImpl->mPImportance.reserve(nPicks);
+    pImpl->mSImportance.reserve(nPicks);
+    pImpl->mAmplitude.reserve(nPicks);
+    pImpl->mPeriod.reserve(nPicks);
+    pImpl->mAmplitudeMagnitude.reserve(nPicks);
+    pImpl->mDurationMagnitude.reserve(nPicks);
+    pImpl->mCodaDuration.reserve(nPicks);
+    pImpl->mPRemark.reserve(nPicks);
+    pImpl->mSRemark.reserve(nPicks);
+    pImpl->mPWeightCode.reserve(nPicks);
+    pImpl->mSWeightCode.reserve(nPicks);
+    pImpl->mAmplitudeUnits.reserve(nPicks);
+    pImpl->mAmplitudeMagnitudeWeightCode.reserve(nPicks);
+    pImpl->mDurationMagnitudeWeightCode.reserve(nPicks);
+    pImpl->mFirstMotion.reserve(nPicks);
+    pImpl->mAmplitudeMagnitudeLabel.reserve(nPicks);
+    pImpl->mDurationMagnitudeLabel.reserve(nPicks);
+    pImpl->mDataSourceCode.reserve(nPicks);
+}
+
+/// Add an event
+void Catalog::addEvent(const EventSummary &event)
+{
+    auto eventIndex = getNumberOfEvents();
+    pImpl->addOrigin(event.getEventInformation());
+    auto nPicks = event.getNumberOfPicks();
+    for (int i = 0; i < nPicks; ++i)
+    {
+        pImpl->addPick(eventIndex, event[i]);
+    }
+    pImpl->mPickOffset.push_back(getNumberOfPicks());
+}
+
+/// Get an event
+EventSummary Catalog::getEvent(const int iEvent) const
+{
+    if (iEvent < 0 || iEvent >= getNumberOfEvents())
+    {
+        throw std::invalid_argument("iEvent = " + std::to_string(iEvent)
+                                  + " must be in range [0,"
+                                  + std::to_string(getNumberOfEvents())
+                                  + ")");
+    }
+    EventSummary event;
+    event.setEventInformation(pImpl->getOrigin(iEvent));
+    auto i0 = pImpl->mPickOffset[iEvent];
+    auto i1 = pImpl->mPickOffset[iEvent + 1];
+    for (int i = i0; i < i1; ++i)
+    {
+        auto pick = pImpl->getPick(i);
+        if (pick.havePPickTime())
+        {
+            event.addPPick(pick);
+        }
+        else
+        {
+            event.addSPick(pick);
+        }
+    }
+    return event;
+}
+
+/// Get all events
+std::vector<EventSummary> Catalog::getEvents() const
+{
+    std::vector<EventSummary> events;
+    events.reserve(getNumberOfEvents());
+    for (int i = 0; i < getNumberOfEvents(); ++i)
+    {
+        events.push_back(getEvent(i));
+    }
+    return events;
+}
+
+/// Number of events
+int Catalog::getNumberOfEvents() const noexcept
+{
+    return static_cast<int> (pImpl->mOriginTime.size());
+}
+
+/// Number of picks
+int Catalog::getNumberOfPicks() const noexcept
+{
+    return static_cast<int> (pImpl->mPickEvent.size());
+}
+
+/// Origin columns
+const std::vector<int64_t>& Catalog::getOriginTimes() const noexcept
+{
+    return pImpl->mOriginTime;
+}
+
+const std::vector<double>& Catalog::getLatitudes() const noexcept
+{
+    return pImpl->mLatitude;
+}
+
+const std::vector<double>& Catalog::getLongitudes() const noexcept
+{
+    return pImpl->mLongitude;
+}
+
+const std::vector<double>& Catalog::getDepths() const noexcept
+{
+    return pImpl->mDepth;
+}
+
+const std::vector<double>& Catalog::getMagnitudes() const noexcept
+{
+    return pImpl->mMagnitude;
+}
+
+const std::vector<uint64_t>& Catalog::getEventIdentifiers() const noexcept
+{
+    return pImpl->mEventIdentifier;
+}
+
+const std::vector<int>& Catalog::getPickOffsets() const noexcept
+{
+    return pImpl->mPickOffset;
+}
+
+/// Pick columns
+const std::vector<int>& Catalog::getPickEventIndices() const noexcept
+{
+    return pImpl->mPickEvent;
+}
+
+const std::vector<int>& Catalog::getPickNetworkIndices() const noexcept
+{
+    return pImpl->mPickNetwork;
+}
+
+const std::vector<int>& Catalog::getPickStationIndices() const noexcept
+{
+    return pImpl->mPickStation;
+}
+
+const std::vector<int>& Catalog::getPickChannelIndices() const noexcept
+{
+    return pImpl->mPickChannel;
+}
+
+const std::vector<int>& Catalog::getPickLocationIndices() const noexcept
+{
+    return pImpl->mPickLocation;
+}
+
+const std::vector<int64_t>& Catalog::getPPickTimes() const noexcept
+{
+    return pImpl->mPPickTime;
+}
+
+const std::vector<int64_t>& Catalog::getSPickTimes() const noexcept
+{
+    return pImpl->mSPickTime;
+}
+
+const std::vector<double>& Catalog::getPResiduals() const noexcept
+{
+    return pImpl->mPResidual;
+}
+
+const std::vector<double>& Catalog::getSResiduals() const noexcept
+{
+    return pImpl->mSResidual;
+}
+
+const std::vector<double>& Catalog::getPWeightsUsed() const noexcept
+{
+    return pImpl->mPWeightUsed;
+}
+
+const std::vector<double>& Catalog::getSWeightsUsed() const noexcept
+{
+    return pImpl->mSWeightUsed;
+}
+
+const std::vector<double>& Catalog::getEpicentralDistances() const noexcept
+{
+    return pImpl->mDistance;
+}
+
+const std::vector<double>& Catalog::getAzimuths() const noexcept
+{
+    return pImpl->mAzimuth;
+}
+
+const std::vector<double>& Catalog::getTakeOffAngles() const noexcept
+{
+    return pImpl->mTakeOffAngle;
+}
+
+/// Dictionaries
+const std::vector<std::string>& Catalog::getNetworkCodes() const noexcept
+{
+    return pImpl->mNetworks.mValues;
+}
+
+const std::vector<std::string>& Catalog::getStationCodes() const noexcept
+{
+    return pImpl->mStations.mValues;
+}
+
+const std::vector<std::string>& Catalog::getChannelCodes() const noexcept
+{
+    return pImpl->mChannels.mValues;
+}
+
+const std::vector<std::string>& Catalog::getLocationCodes() const noexcept
+{
+    return pImpl->mLocations.mValues;
+}
+
+/// Filter events on time
+std::vector<int> Catalog::findEventsInTimeRange(const int64_t t0,
+                                                const int64_t t1) const
+{
+    if (t0 > t1){throw std::invalid_argument("t0 cannot exceed t1");}
+    // Missing times are the lowest int64 so a valid t0 excludes them
+    auto t0Use = std::max(t0, MISSING_TIME + 1);
+    return CatalogImpl::findInRange(pImpl->mOriginTime, t0Use, t1);
+}
+
+/// Filter events on region
+std::vector<int> Catalog::findEventsInRegion(const double minLatitude,
+                                             const double maxLatitude,
+                                             const double minLongitude,
+                                             const double maxLongitude) const
+{
+    if (minLatitude > maxLatitude)
+    {
+        throw std::invalid_argument("minLatitude cannot exceed maxLatitude");
+    }
+    // A box at least 360 degrees wide spans every longitude.  This is
+    // checked first since, e.g., -180 and 180 map to the same longitude.
+    auto allLongitudes = (maxLongitude - minLongitude >= 360);
+    // Put longitudes in the same [0,360) convention as the catalog
+    double lon0 = std::fmod(minLongitude, 360.0);
+    if (lon0 < 0){lon0 = lon0 + 360;}
+    double lon1 = std::fmod(maxLongitude, 360.0);
+    if (lon1 < 0){lon1 = lon1 + 360;}
+    auto wrap = (lon0 > lon1);
+    auto n = getNumberOfEvents();
+    std::vector<uint8_t> mask(n);
+    const double *__restrict__ latPtr = pImpl->mLatitude.data();
+    const double *__restrict__ lonPtr = pImpl->mLongitude.data();
+    uint8_t *__restrict__ maskPtr = mask.data();
+    #pragma omp simd
+    for (int i = 0; i < n; ++i)
+    {
+        bool inLat = (latPtr[i] >= minLatitude && latPtr[i] <= maxLatitude);
+        // Unknown (NaN) longitudes are never in the box
+        bool inLon = allLongitudes ? (lonPtr[i] == lonPtr[i]) :
+                     wrap ? (lonPtr[i] >= lon0 || lonPtr[i] <= lon1) :
+                            (lonPtr[i] >= lon0 && lonPtr[i] <= lon1);
+        maskPtr[i] = (inLat && inLon) ? 1 : 0;
+    }
+    return maskToIndices(mask);
+}
+
+/// Filter events on magnitude
+std::vector<int> Catalog::findEventsInMagnitudeRange(
+    const double minMagnitude, const double maxMagnitude) const
+{
+    if (minMagnitude > maxMagnitude)
+    {
+        throw std::invalid_argument("minMagnitude cannot exceed maxMagnitude");
+    }
+    return CatalogImpl::findInRange(pImpl->mMagnitude,
+                                    minMagnitude, maxMagnitude);
+}
+
+/// Filter picks on station
+std::vector<int> Catalog::findPicks(const std::string &network,
+                                    const std::string &station) const
+{
+    auto networkIndex = pImpl->mNetworks.find(network);
+    auto stationIndex = pImpl->mStations.find(station);
+    if (networkIndex < 0 || stationIndex < 0){return std::vector<int> {};}
+    auto n = getNumberOfPicks();
+    std::vector<uint8_t> mask(n);
+    const int *__restrict__ networkPtr = pImpl->mPickNetwork.data();
+    const int *__restrict__ stationPtr = pImpl->mPickStation.data();
+    uint8_t *__restrict__ maskPtr = mask.data();
+    #pragma omp simd
+    for (int i = 0; i < n; ++i)
+    {
+        maskPtr[i] = (networkPtr[i] == networkIndex &&
+                      stationPtr[i] == stationIndex) ? 1 : 0;
+    }
+    return maskToIndices(mask);
+}
+
+/// Filter picks on time
+std::vector<int> Catalog::findPicksInTimeRange(const int64_t t0,
+                                               const int64_t t1) const
+{
+    if (t0 > t1){throw std::invalid_argument("t0 cannot exceed t1");}
+    auto t0Use = std::max(t0, MISSING_TIME + 1);
+    auto n = getNumberOfPicks();
+    std::vector<uint8_t> mask(n);
+    const int64_t *__restrict__ pPtr = pImpl->mPPickTime.data();
+    const int64_t *__restrict__ sPtr = pImpl->mSPickTime.data();
+    uint8_t *__restrict__ maskPtr = mask.data();
+    #pragma omp simd
+    for (int i = 0; i < n; ++i)
+    {
+        bool inP = (pPtr[i] >= t0Use && pPtr[i] <= t1);
+        bool inS = (sPtr[i] >= t0Use && sPtr[i] <= t1);
+        maskPtr[i] = (inP || inS) ? 1 : 0;
+    }
+    return maskToIndices(mask);
+}
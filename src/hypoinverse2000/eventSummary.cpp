@@ -260,11 +260,38 @@ EventSummaryLine EventSummary::getEventInformation() const
 /// Packs a string
 std::string EventSummary::packString() const
 {
-    std::string result;
-    result = pImpl->mHeader.packString() + "\n";
+    std::string result(getPackedLength(), ' ');
+    packString(result.data(), static_cast<int> (result.size()));
+    return result;
+}
+
+/// Packs a string into a buffer
+int EventSummary::packString(char *result, const int length) const
+{
+    if (result == nullptr){throw std::invalid_argument("result is NULL");}
+    auto packedLength = getPackedLength();
+    if (length < packedLength)
+    {
+        throw std::invalid_argument("length = " + std::to_string(length)
+                                  + " must be at least "
+                                  + std::to_string(packedLength));
+    }
+    auto nWritten = pImpl->mHeader.packString(result, length);
+    result[nWritten] = '\n';
+    nWritten = nWritten + 1;
     for (const auto &pick : pImpl->mPicks)
     {
-        result.append(pick.packString() + "\n");
+        nWritten = nWritten + pick.packString(result + nWritten,
+                                              length - nWritten);
+        result[nWritten] = '\n';
+        nWritten = nWritten + 1;
     }
-    return result;
+    return nWritten;
+}
+
+/// Length of packed string
+int EventSummary::getPackedLength() const noexcept
+{
+    return (EventSummaryLine::PACKED_LENGTH + 1)
+         + getNumberOfPicks()*(StationArchiveLine::PACKED_LENGTH + 1);
 }
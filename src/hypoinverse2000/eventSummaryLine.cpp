@@ -261,10 +261,24 @@ void EventSummaryLine::unpackString(const std::string &line)
 /// Packs the class into a string
 std::string EventSummaryLine::packString() const
 {
-    std::string result(164, ' ');
+    std::string result(PACKED_LENGTH, ' ');
+    packString(result.data(), PACKED_LENGTH);
+    return result;
+}
+
+int EventSummaryLine::packString(char *result, const int length) const
+{
+    if (result == nullptr){throw std::invalid_argument("result is NULL");}
+    if (length < PACKED_LENGTH)
+    {
+        throw std::invalid_argument("length = " + std::to_string(length)
+                                  + " must be at least "
+                                  + std::to_string(PACKED_LENGTH));
+    }
+    std::fill(result, result + PACKED_LENGTH, ' ');
     if (haveOriginTime())
     {
-        auto originTime = getOriginTime();
+        const auto &originTime = pImpl->mOriginTime;
         setInteger(0, 4, originTime.getYear(), result);
         setInteger(4, 6, originTime.getMonth(), result);
         setInteger(6, 8, originTime.getDayOfMonth(), result);
@@ -342,7 +356,7 @@ std::string EventSummaryLine::packString() const
              static_cast<int> (std::round(getPreferredMagnitude()*100)),
                 result, false);
     }
-    return result;
+    return PACKED_LENGTH;
 }
 /// Origin time
 void EventSummaryLine::setOriginTime(const SFF::Utilities::Time &originTime) noexcept
@@ -0,0 +1,503 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "sff/hypoinverse2000/spatioTemporalIndex.hpp"
+#include "sff/hypoinverse2000/catalog.hpp"
+
+using namespace SFF::HypoInverse2000;
+
+namespace
+{
+
+constexpr double EARTH_RADIUS = 6371.0;
+constexpr double DEG_TO_RAD = M_PI/180.0;
+constexpr double RAD_TO_DEG = 180.0/M_PI;
+
+/// Great circle distance in km between two points given in radians.
+double haversine(const double lat1, const double lon1,
+                 const double lat2, const double lon2)
+{
+    auto sinDLat = std::sin(0.5*(lat2 - lat1));
+    auto sinDLon = std::sin(0.5*(lon2 - lon1));
+    auto a = sinDLat*sinDLat
+           + std::cos(lat1)*std::cos(lat2)*sinDLon*sinDLon;
+    return 2*EARTH_RADIUS*std::asin(std::sqrt(std::min(1.0, a)));
+}
+
+/// Maps a longitude to [0,360)
+double toLongitude360(const double lon)
+{
+    auto result = std::fmod(lon, 360.0);
+    if (result < 0){result = result + 360;}
+    if (result >= 360){result = 0;}
+    return result;
+}
+
+}
+
+class SpatioTemporalIndex::SpatioTemporalIndexImpl
+{
+public:
+    void clear() noexcept
+    {
+        mTime.clear();
+        mLatitude.clear();
+        mLongitude.clear();
+        mDepth.clear();
+        mMagnitude.clear();
+        mTimeOrder.clear();
+        mSortedTimes.clear();
+        mCellIdentifiers.clear();
+        mCellOffsets.clear();
+        mCellEvents.clear();
+        mCellTimes.clear();
+        mCellSize = 0.1;
+        mLatitudeCells = 0;
+        mLongitudeCells = 0;
+        mInitialized = false;
+    }
+    /// Grid row
+    [[nodiscard]] int getLatitudeCell(const double latitude) const
+    {
+        auto i = static_cast<int> (std::floor((latitude + 90)/mCellSize));
+        return std::max(0, std::min(mLatitudeCells - 1, i));
+    }
+    /// Grid column
+    [[nodiscard]] int getLongitudeCell(const double longitude) const
+    {
+        auto i = static_cast<int> (std::floor(toLongitude360(longitude)
+                                              /mCellSize));
+        return std::max(0, std::min(mLongitudeCells - 1, i));
+    }
+    /// Scans the events in a cell
+    void scanCell(const int cell,
+                  const double latitude, const double longitude,
+                  const double radius,
+                  const int64_t t0, const int64_t t1,
+                  const double minMagnitude,
+                  std::vector<int> &result) const
+    {
+        auto i0 = mCellOffsets[cell];
+        auto i1 = mCellOffsets[cell + 1];
+        auto timeBegin = mCellTimes.begin();
+        auto j0 = static_cast<int>
+                  (std::lower_bound(timeBegin + i0, timeBegin + i1, t0)
+                 - timeBegin);
+        auto j1 = static_cast<int>
+                  (std::upper_bound(timeBegin + j0, timeBegin + i1, t1)
+                 - timeBegin);
+        auto checkMagnitude = !std::isinf(minMagnitude);
+        for (int j = j0; j < j1; ++j)
+        {
+            auto event = mCellEvents[j];
+            if (checkMagnitude && !(mMagnitude[event] >= minMagnitude))
+            {
+                continue;
+            }
+            auto distance = haversine(latitude, longitude,
+                                      mLatitude[event], mLongitude[event]);
+            if (distance <= radius){result.push_back(event);}
+        }
+    }
+    /// Range query
+    [[nodiscard]] std::vector<int> findEvents(const double latitude,
+                                              const double longitude,
+                                              const double radius,
+                                              const int64_t t0,
+                                              const int64_t t1,
+                                              const double minMagnitude) const
+    {
+        std::vector<int> result;
+        if (mCellIdentifiers.empty()){return result;}
+        auto latitudeRadians = latitude*DEG_TO_RAD;
+        auto longitudeRadians = toLongitude360(longitude)*DEG_TO_RAD;
+        // Bounding box of the search circle
+        auto angularRadius = radius/EARTH_RADIUS;
+        auto latitudeMin = latitude - angularRadius*RAD_TO_DEG;
+        auto latitudeMax = latitude + angularRadius*RAD_TO_DEG;
+        bool allLongitudes = (latitudeMin <= -90 || latitudeMax >= 90);
+        double dLongitude = 360;
+        if (!allLongitudes)
+        {
+            auto sinRatio = std::sin(angularRadius)/std::cos(latitudeRadians);
+            if (sinRatio >= 1)
+            {
+                allLongitudes = true;
+            }
+            else
+            {
+                dLongitude = std::asin(sinRatio)*RAD_TO_DEG;
+            }
+        }
+        auto iLat0 = getLatitudeCell(std::max(-90.0, latitudeMin));
+        auto iLat1 = getLatitudeCell(std::min(90.0, latitudeMax));
+        // Longitude cells as up to two inclusive ranges.  The edges of the
+        // box are wrapped into [0,360) in degrees before binning since the
+        // last column is narrower than the others when the cell size does
+        // not divide 360.
+        std::array<std::pair<int, int>, 2> longitudeRanges{
+            std::pair{0, mLongitudeCells - 1}, std::pair{0, -1}};
+        if (!allLongitudes && dLongitude < 180)
+        {
+            auto lon = toLongitude360(longitude);
+            auto lonMin = lon - dLongitude;
+            auto lonMax = lon + dLongitude;
+            if (lonMin < 0)
+            {
+                longitudeRanges[0] = {getLongitudeCell(lonMin + 360),
+                                      mLongitudeCells - 1};
+                longitudeRanges[1] = {0, getLongitudeCell(lonMax)};
+            }
+            else if (lonMax >= 360)
+            {
+                longitudeRanges[0] = {getLongitudeCell(lonMin),
+                                      mLongitudeCells - 1};
+                longitudeRanges[1] = {0, getLongitudeCell(lonMax - 360)};
+            }
+            else
+            {
+                longitudeRanges[0] = {getLongitudeCell(lonMin),
+                                      getLongitudeCell(lonMax)};
+            }
+        }
+        // A box that nearly spans the globe can meet itself in one cell
+        if (longitudeRanges[1].second >= longitudeRanges[0].first)
+        {
+            longitudeRanges = {std::pair{0, mLongitudeCells - 1},
+                               std::pair{0, -1}};
+        }
+        int nLongitudeCells = 0;
+        for (const auto &range : longitudeRanges)
+        {
+            nLongitudeCells = nLongitudeCells
+                            + std::max(0, range.second - range.first + 1);
+        }
+        // Either visit the candidate cells or, if there are fewer occupied
+        // cells than candidates, the occupied cells.
+        auto nCandidates = static_cast<int64_t> (iLat1 - iLat0 + 1)
+                          *nLongitudeCells;
+        auto nOccupied = static_cast<int> (mCellIdentifiers.size());
+        if (nCandidates < nOccupied)
+        {
+            for (int iLat = iLat0; iLat <= iLat1; ++iLat)
+            {
+                for (const auto &range : longitudeRanges)
+                {
+                    for (int iLon = range.first; iLon <= range.second; ++iLon)
+                    {
+                        auto id = static_cast<int64_t> (iLat)*mLongitudeCells
+                                + iLon;
+                        auto it = std::lower_bound(mCellIdentifiers.begin(),
+                                                   mCellIdentifiers.end(),
+                                                   id);
+                        if (it == mCellIdentifiers.end() || *it != id)
+                        {
+                            continue;
+                        }
+                        auto cell = static_cast<int>
+                                    (it - mCellIdentifiers.begin());
+                        scanCell(cell, latitudeRadians, longitudeRadians,
+                                 radius, t0, t1, minMagnitude, result);
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (int cell = 0; cell < nOccupied; ++cell)
+            {
+                auto id = mCellIdentifiers[cell];
+                auto iLat = static_cast<int> (id/mLongitudeCells);
+                if (iLat < iLat0 || iLat > iLat1){continue;}
+                if (nLongitudeCells < mLongitudeCells)
+                {
+                    auto iLon = static_cast<int> (id%mLongitudeCells);
+                    bool inside = false;
+                    for (const auto &range : longitudeRanges)
+                    {
+                        if (iLon >= range.first && iLon <= range.second)
+                        {
+                            inside = true;
+                        }
+                    }
+                    if (!inside){continue;}
+                }
+                scanCell(cell, latitudeRadians, longitudeRadians,
+                         radius, t0, t1, minMagnitude, result);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+    // Event columns (latitude and longitude are in radians)
+    std::vector<int64_t> mTime;
+    std::vector<double> mLatitude;
+    std::vector<double> mLongitude;
+    std::vector<double> mDepth;
+    std::vector<double> mMagnitude;
+    // Events sorted by time
+    std::vector<int> mTimeOrder;
+    std::vector<int64_t> mSortedTimes;
+    // Occupied grid cells in compressed sparse row format.  Within a cell
+    // the events are sorted by time.
+    std::vector<int64_t> mCellIdentifiers;
+    std::vector<int> mCellOffsets;
+    std::vector<int> mCellEvents;
+    std::vector<int64_t> mCellTimes;
+    double mCellSize{0.1};
+    int mLatitudeCells{0};
+    int mLongitudeCells{0};
+    bool mInitialized{false};
+};
+
+/// C'tor
+SpatioTemporalIndex::SpatioTemporalIndex() :
+    pImpl(std::make_unique<SpatioTemporalIndexImpl> ())
+{
+}
+
+/// Copy c'tor
+SpatioTemporalIndex::SpatioTemporalIndex(const SpatioTemporalIndex &index)
+{
+    *this = index;
+}
+
+/// Move c'tor
+SpatioTemporalIndex::SpatioTemporalIndex(SpatioTemporalIndex &&index) noexcept
+{
+    *this = std::move(index);
+}
+
+/// Copy assignment
+SpatioTemporalIndex&
+SpatioTemporalIndex::operator=(const SpatioTemporalIndex &index)
+{
+    if (&index == this){return *this;}
+    pImpl = std::make_unique<SpatioTemporalIndexImpl> (*index.pImpl);
+    return *this;
+}
+
+/// Move assignment
+SpatioTemporalIndex&
+SpatioTemporalIndex::operator=(SpatioTemporalIndex &&index) noexcept
+{
+    if (&index == this){return *this;}
+    pImpl = std::move(index.pImpl);
+    return *this;
+}
+
+/// Destructor
+SpatioTemporalIndex::~SpatioTemporalIndex() = default;
+
+/// Reset the class
+void SpatioTemporalIndex::clear() noexcept
+{
+    pImpl->clear();
+}
+
+/// Initialize from catalog
+void SpatioTemporalIndex::initialize(const Catalog &catalog,
+                                     const double cellSize)
+{
+    initialize(catalog.getOriginTimes(),
+               catalog.getLatitudes(),
+               catalog.getLongitudes(),
+               catalog.getDepths(),
+               catalog.getMagnitudes(),
+               cellSize);
+}
+
+/// Initialize from columns
+void SpatioTemporalIndex::initialize(const std::vector<int64_t> &originTimes,
+                                     const std::vector<double> &latitudes,
+                                     const std::vector<double> &longitudes,
+                                     const std::vector<double> &depths,
+                                     const std::vector<double> &magnitudes,
+                                     const double cellSize)
+{
+    clear();
+    auto nEvents = static_cast<int> (originTimes.size());
+    if (static_cast<int> (latitudes.size()) != nEvents ||
+        static_cast<int> (longitudes.size()) != nEvents ||
+        static_cast<int> (depths.size()) != nEvents ||
+        static_cast<int> (magnitudes.size()) != nEvents)
+    {
+        throw std::invalid_argument("All columns must be the same size");
+    }
+    if (cellSize <= 0 || cellSize > 180)
+    {
+        throw std::invalid_argument("cellSize must be in range (0,180]");
+    }
+    pImpl->mCellSize = cellSize;
+    pImpl->mLatitudeCells = static_cast<int> (std::ceil(180/cellSize));
+    pImpl->mLongitudeCells = static_cast<int> (std::ceil(360/cellSize));
+    // Copy the columns
+    pImpl->mTime = originTimes;
+    pImpl->mDepth = depths;
+    pImpl->mMagnitude = magnitudes;
+    pImpl->mLatitude.resize(nEvents);
+    pImpl->mLongitude.resize(nEvents);
+    for (int i = 0; i < nEvents; ++i)
+    {
+        pImpl->mLatitude[i] = latitudes[i]*DEG_TO_RAD;
+        pImpl->mLongitude[i] = toLongitude360(longitudes[i])*DEG_TO_RAD;
+    }
+    // Time ordering
+    pImpl->mTimeOrder.resize(nEvents);
+    std::iota(pImpl->mTimeOrder.begin(), pImpl->mTimeOrder.end(), 0);
+    std::stable_sort(pImpl->mTimeOrder.begin(), pImpl->mTimeOrder.end(),
+                     [&](const int lhs, const int rhs)
+                     {
+                         return originTimes[lhs] < originTimes[rhs];
+                     });
+    pImpl->mSortedTimes.resize(nEvents);
+    for (int i = 0; i < nEvents; ++i)
+    {
+        pImpl->mSortedTimes[i] = originTimes[pImpl->mTimeOrder[i]];
+    }
+    // Bin the located events into cells.  Walking the events in time order
+    // and stable sorting on the cell keeps each cell time sorted.
+    std::vector<int64_t> cellOfEvent(nEvents, -1);
+    std::vector<int> located;
+    located.reserve(nEvents);
+    for (const auto event : pImpl->mTimeOrder)
+    {
+        if (std::isnan(latitudes[event]) || std::isnan(longitudes[event]))
+        {
+            continue;
+        }
+        auto iLat = pImpl->getLatitudeCell(latitudes[event]);
+        auto iLon = pImpl->getLongitudeCell(longitudes[event]);
+        cellOfEvent[event] = static_cast<int64_t> (iLat)*pImpl->mLongitudeCells
+                           + iLon;
+        located.push_back(event);
+    }
+    std::stable_sort(located.begin(), located.end(),
+                     [&](const int lhs, const int rhs)
+                     {
+                         return cellOfEvent[lhs] < cellOfEvent[rhs];
+                     });
+    pImpl->mCellEvents = located;
+    pImpl->mCellTimes.resize(located.size());
+    pImpl->mCellOffsets.push_back(0);
+    for (int i = 0; i < static_cast<int> (located.size()); ++i)
+    {
+        auto event = located[i];
+        pImpl->mCellTimes[i] = originTimes[event];
+        if (i > 0 && cellOfEvent[event] != cellOfEvent[located[i - 1]])
+        {
+            pImpl->mCellOffsets.push_back(i);
+        }
+        if (i == 0 || cellOfEvent[event] != cellOfEvent[located[i - 1]])
+        {
+            pImpl->mCellIdentifiers.push_back(cellOfEvent[event]);
+        }
+    }
+    pImpl->mCellOffsets.push_back(static_cast<int> (located.size()));
+    pImpl->mInitialized = true;
+}
+
+/// Initialized?
+bool SpatioTemporalIndex::isInitialized() const noexcept
+{
+    return pImpl->mInitialized;
+}
+
+/// Number of events
+int SpatioTemporalIndex::getNumberOfEvents() const noexcept
+{
+    return static_cast<int> (pImpl->mTime.size());
+}
+
+/// Time query
+std::vector<int> SpatioTemporalIndex::findEventsInTimeRange(
+    const int64_t t0, const int64_t t1) const
+{
+    if (!isInitialized()){throw std::runtime_error("Index not initialized");}
+    if (t0 > t1){throw std::invalid_argument("t0 cannot exceed t1");}
+    auto i0 = std::lower_bound(pImpl->mSortedTimes.begin(),
+                               pImpl->mSortedTimes.end(), t0)
+            - pImpl->mSortedTimes.begin();
+    auto i1 = std::upper_bound(pImpl->mSortedTimes.begin() + i0,
+                               pImpl->mSortedTimes.end(), t1)
+            - pImpl->mSortedTimes.begin();
+    return std::vector<int> (pImpl->mTimeOrder.begin() + i0,
+                             pImpl->mTimeOrder.begin() + i1);
+}
+
+/// Range query
+std::vector<int> SpatioTemporalIndex::findEvents(const double latitude,
+                                                 const double longitude,
+                                                 const double radius,
+                                                 const int64_t t0,
+                                                 const int64_t t1,
+                                                 const double minMagnitude) const
+{
+    if (!isInitialized()){throw std::runtime_error("Index not initialized");}
+    if (latitude < -90 || latitude > 90)
+    {
+        throw std::invalid_argument("latitude must be in range [-90,90]");
+    }
+    if (radius < 0){throw std::invalid_argument("radius must be positive");}
+    if (t0 > t1){throw std::invalid_argument("t0 cannot exceed t1");}
+    return pImpl->findEvents(latitude, longitude, radius,
+                             t0, t1, minMagnitude);
+}
+
+/// k-nearest neighbors
+std::vector<int> SpatioTemporalIndex::findNearestEvents(const double latitude,
+                                                        const double longitude,
+                                                        const double depth,
+                                                        const int k) const
+{
+    if (!isInitialized()){throw std::runtime_error("Index not initialized");}
+    if (latitude < -90 || latitude > 90)
+    {
+        throw std::invalid_argument("latitude must be in range [-90,90]");
+    }
+    if (k < 0){throw std::invalid_argument("k must be positive");}
+    std::vector<int> result;
+    if (k == 0 || pImpl->mCellEvents.empty()){return result;}
+    // Grow the search radius until it holds k events.  Since the hypocentral
+    // distance is at least the epicentral distance, any event within the
+    // final radius in hypocentral distance is among the candidates.
+    auto latitudeRadians = latitude*DEG_TO_RAD;
+    auto longitudeRadians = toLongitude360(longitude)*DEG_TO_RAD;
+    auto radius = std::max(1.0, pImpl->mCellSize*DEG_TO_RAD*EARTH_RADIUS);
+    const double maxRadius = M_PI*EARTH_RADIUS;
+    std::vector<std::pair<double, int>> candidates;
+    while (true)
+    {
+        auto events = pImpl->findEvents(latitude, longitude, radius,
+                                        std::numeric_limits<int64_t>::lowest(),
+                                        std::numeric_limits<int64_t>::max(),
+                                        -std::numeric_limits<double>::infinity());
+        candidates.clear();
+        candidates.reserve(events.size());
+        int nInside = 0;
+        for (const auto event : events)
+        {
+            auto epicentralDistance
+                = haversine(latitudeRadians, longitudeRadians,
+                            pImpl->mLatitude[event], pImpl->mLongitude[event]);
+            auto dz = std::isnan(pImpl->mDepth[event]) ?
+                      0 : pImpl->mDepth[event] - depth;
+            auto distance = std::sqrt(epicentralDistance*epicentralDistance
+                                    + dz*dz);
+            if (distance <= radius){nInside = nInside + 1;}
+            candidates.push_back(std::pair(distance, event));
+        }
+        if (nInside >= k || radius >= maxRadius){break;}
+        radius = std::min(maxRadius, 2*radius);
+    }
+    auto nKeep = std::min(k, static_cast<int> (candidates.size()));
+    std::partial_sort(candidates.begin(), candidates.begin() + nKeep,
+                      candidates.end());
+    result.resize(nKeep);
+    for (int i = 0; i < nKeep; ++i){result[i] = candidates[i].second;}
+    return result;
+}
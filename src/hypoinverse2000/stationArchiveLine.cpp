@@ -2,6 +2,7 @@
 #include <limits>
 #include <array>
 #include <cstdint>
+#include <string_view>
 #ifndef DNDEBUG
 #include <cassert>
 #endif
@@ -11,6 +12,47 @@
 
 using namespace SFF::HypoInverse2000;
 
+namespace
+{
+
+/// A station, network, channel, or location code.  These are a few
+/// characters so they are stored inline rather than in a std::string.
+template<size_t N>
+class Code
+{
+public:
+    void set(const std::string_view code) noexcept
+    {
+        mLength = static_cast<uint8_t> (std::min(code.size(), N));
+        std::copy(code.begin(), code.begin() + mLength, mCharacters.begin());
+    }
+    [[nodiscard]] std::string_view get() const noexcept
+    {
+        return std::string_view(mCharacters.data(), mLength);
+    }
+    void clear() noexcept
+    {
+        mLength = 0;
+    }
+private:
+    std::array<char, N> mCharacters{};
+    uint8_t mLength{0};
+};
+
+/// Truncates the code to its field width and removes trailing blanks
+std::string_view trimCode(const std::string_view code, const size_t width)
+{
+    auto result = code.substr(0, std::min(code.size(), width));
+    while (!result.empty() &&
+           std::isspace<char>(result.back(), std::locale::classic()))
+    {
+        result.remove_suffix(1);
+    }
+    return result;
+}
+
+}
+
 class StationArchiveLine::StationArchiveLineImpl
 {
 public:
@@ -77,10 +119,10 @@ public:
     }
     SFF::Utilities::Time mPPick;
     SFF::Utilities::Time mSPick;
-    std::string mNetwork;
-    std::string mStation;
-    std::string mChannel;
-    std::string mLocationCode;
+    Code<2> mNetwork;
+    Code<5> mStation;
+    Code<3> mChannel;
+    Code<2> mLocationCode;
     std::string mPRemark;
     std::string mSRemark;
     double mPResidual = 0;
@@ -426,26 +468,32 @@ void StationArchiveLine::unpackString(const std::string &line)
 /// Packs a hypo string
 std::string StationArchiveLine::packString() const noexcept
 {
-    std::string result(113, ' ');
-    // SNCL
-    if (haveStationName()){setString(0, 5, getStationName(), result);}
-    if (haveNetworkName()){setString(5, 7, getNetworkName(), result);}
-    if (haveChannelName()){setString(9, 12, getChannelName(), result);}
-    if (haveLocationCode()){setString(111, 113, getLocationCode(), result);}
-    if (havePRemark())
+    std::string result(PACKED_LENGTH, ' ');
+    packString(result.data(), PACKED_LENGTH);
+    return result;
+}
+
+int StationArchiveLine::packString(char *result, const int length) const
+{
+    if (result == nullptr){throw std::invalid_argument("result is NULL");}
+    if (length < PACKED_LENGTH)
     {
-        auto remark = getPRemark();
-        if (remark.size() == 1)
-        { remark.push_back(' '); }
-        setString(13, 15, remark, result);
+        throw std::invalid_argument("length = " + std::to_string(length)
+                                  + " must be at least "
+                                  + std::to_string(PACKED_LENGTH));
     }
-    if (haveSRemark())
+    std::fill(result, result + PACKED_LENGTH, ' ');
+    // SNCL.  Work off the implementation to avoid copies.
+    if (haveStationName()){setString(0, 5, pImpl->mStation.get(), result);}
+    if (haveNetworkName()){setString(5, 7, pImpl->mNetwork.get(), result);}
+    if (haveChannelName()){setString(9, 12, pImpl->mChannel.get(), result);}
+    if (haveLocationCode())
     {
-        auto remark = getSRemark();
-        if (remark.size() == 1)
-        { remark.push_back(' '); }
-        setString(46, 48, remark, result);
+        setString(111, 113, pImpl->mLocationCode.get(), result);
     }
+    // Single character remarks are padded by the blank result
+    if (havePRemark()){setString(13, 15, pImpl->mPRemark, result);}
+    if (haveSRemark()){setString(46, 48, pImpl->mSRemark, result);}
     if (haveFirstMotion()){result[15] = getFirstMotion();}
     // A little strange - but a 4 seems to be assigned to the P weight
     // when we have an S pick.  HypoInverse seems to hunt for this number
@@ -462,8 +510,8 @@ std::string StationArchiveLine::packString() const noexcept
         // is filled with zeros.
         if (havePPickTime() && haveSPickTime())
         {
-            auto p = getPPickTime();
-            auto s = getSPickTime();
+            const auto &p = pImpl->mPPick;
+            const auto &s = pImpl->mSPick;
             if (p.getYear() != s.getYear() ||
                 p.getDayOfYear() != s.getDayOfYear() ||
                 p.getHour() != s.getHour() ||
@@ -477,31 +525,23 @@ std::string StationArchiveLine::packString() const noexcept
                 }
             }
         }
-        SFF::Utilities::Time pickTime;
+        const SFF::Utilities::Time *pickTime = &pImpl->mSPick;
+        if (havePPickTime()){pickTime = &pImpl->mPPick;}
+        setInteger(17, 21, pickTime->getYear(), result);
+        setInteger(21, 23, pickTime->getMonth(), result);
+        setInteger(23, 25, pickTime->getDayOfMonth(), result);
+        setInteger(25, 27, pickTime->getHour(), result);
+        setInteger(27, 29, pickTime->getMinute(), result);
         if (havePPickTime())
         {
-            pickTime = getPPickTime();
-        }
-        else
-        {
-            pickTime = getSPickTime();
-        }
-        setInteger(17, 21, pickTime.getYear(), result);
-        setInteger(21, 23, pickTime.getMonth(), result);
-        setInteger(23, 25, pickTime.getDayOfMonth(), result);
-        setInteger(25, 27, pickTime.getHour(), result);
-        setInteger(27, 29, pickTime.getMinute(), result);
-        if (havePPickTime())
-        {
-//if (getStationName() == "YMR"){std::cout << pickTime << " " << pickTime.getMicroSecond() << " " << pickTime.getMicroSecond()/10000; getchar();}
-            setInteger(30, 32, pickTime.getSecond(), result, false);
-            setInteger(32, 34, pickTime.getMicroSecond() / 10000, result);
+            setInteger(30, 32, pickTime->getSecond(), result, false);
+            setInteger(32, 34, pickTime->getMicroSecond() / 10000, result);
         }
         if (haveSPickTime())
         {
-            if (havePPickTime()){pickTime = getSPickTime();}
-            setInteger(42, 44, pickTime.getSecond(), result, false);
-            setInteger(44, 46, pickTime.getMicroSecond() / 10000, result);
+            pickTime = &pImpl->mSPick;
+            setInteger(42, 44, pickTime->getSecond(), result, false);
+            setInteger(44, 46, pickTime->getMicroSecond() / 10000, result);
         }
     }
     if (havePResidual())
@@ -610,24 +650,23 @@ std::string StationArchiveLine::packString() const noexcept
     {
         result[110] = getAmplitudeMagnitudeLabel();
     }
-    return result;
+    return PACKED_LENGTH;
 }
 
 /// Network name
-void StationArchiveLine::setNetworkName(const std::string &network) noexcept
+void StationArchiveLine::setNetworkName(
+    const std::string_view network) noexcept
 {
-    std::string scopy(network,
-                      0,std::min(static_cast<int> (network.size()), 2));
-    rtrim(scopy);
-    if (scopy.empty()){return;}
-    pImpl->mNetwork = network;
+    auto code = trimCode(network, 2);
+    if (code.empty()){return;}
+    pImpl->mNetwork.set(code);
     pImpl->mHaveNetwork = true;
 }
 
-std::string StationArchiveLine::getNetworkName() const
+std::string_view StationArchiveLine::getNetworkName() const
 {
     if (!haveNetworkName()){throw std::runtime_error("Network name not set");}
-    return pImpl->mNetwork;
+    return pImpl->mNetwork.get();
 }
 
 bool StationArchiveLine::haveNetworkName() const noexcept
@@ -636,20 +675,19 @@ bool StationArchiveLine::haveNetworkName() const noexcept
 }
 
 /// Station name
-void StationArchiveLine::setStationName(const std::string &station) noexcept
+void StationArchiveLine::setStationName(
+    const std::string_view station) noexcept
 {
-    std::string scopy(station,
-                 0, std::min(static_cast<int> (station.size()), 5));
-    rtrim(scopy);
-    if (scopy.empty()){return;}
-    pImpl->mStation = scopy;
+    auto code = trimCode(station, 5);
+    if (code.empty()){return;}
+    pImpl->mStation.set(code);
     pImpl->mHaveStation = true;
 }
 
-std::string StationArchiveLine::getStationName() const
+std::string_view StationArchiveLine::getStationName() const
 {
     if (!haveStationName()){throw std::runtime_error("Station name not set");}
-    return pImpl->mStation;
+    return pImpl->mStation.get();
 }
 
 bool StationArchiveLine::haveStationName() const noexcept
@@ -658,20 +696,19 @@ bool StationArchiveLine::haveStationName() const noexcept
 }
 
 /// Channel name
-void StationArchiveLine::setChannelName(const std::string &channel) noexcept
+void StationArchiveLine::setChannelName(
+    const std::string_view channel) noexcept
 {
-    std::string scopy(channel,
-                 0, std::min(static_cast<int> (channel.size()), 3));
-    rtrim(scopy);
-    if (scopy.empty()){return;}
-    pImpl->mChannel = scopy;
+    auto code = trimCode(channel, 3);
+    if (code.empty()){return;}
+    pImpl->mChannel.set(code);
     pImpl->mHaveChannel = true;
 }
 
-std::string StationArchiveLine::getChannelName() const
+std::string_view StationArchiveLine::getChannelName() const
 {
     if (!haveChannelName()){throw std::runtime_error("Channel name not set");}
-    return pImpl->mChannel;
+    return pImpl->mChannel.get();
 }
 
 bool StationArchiveLine::haveChannelName() const noexcept
@@ -680,23 +717,22 @@ bool StationArchiveLine::haveChannelName() const noexcept
 }
 
 /// Location code
-void StationArchiveLine::setLocationCode(const std::string &location) noexcept
+void StationArchiveLine::setLocationCode(
+    const std::string_view location) noexcept
 {
-    std::string scopy(location,
-                 0, std::min(static_cast<int> (location.size()), 2));
-    rtrim(scopy);
-    if (scopy.empty()){return;}
-    pImpl->mLocationCode = scopy;
+    auto code = trimCode(location, 2);
+    if (code.empty()){return;}
+    pImpl->mLocationCode.set(code);
     pImpl->mHaveLocationCode = true;
 }
 
-std::string StationArchiveLine::getLocationCode() const
+std::string_view StationArchiveLine::getLocationCode() const
 {
     if (!haveLocationCode())
     {
         throw std::runtime_error("Location code not set");
     }
-    return pImpl->mLocationCode;
+    return pImpl->mLocationCode.get();
 }
 
 bool StationArchiveLine::haveLocationCode() const noexcept
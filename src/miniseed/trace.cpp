@@ -18,6 +18,9 @@
 #include "sff/miniseed/sncl.hpp"
 #include "sff/miniseed/trace.hpp"
 #include "sff/utilities/time.hpp"
+#include "sff/utilities/sharedBuffer.hpp"
+#include "private/copyTo.hpp"
+#include "private/instrumentation.hpp"
 
 //using namespace SFF;
 using namespace SFF::MiniSEED;
@@ -56,9 +59,10 @@ public:
     }
     Utilities::Time mStartTime;
     SNCL mSNCL;
-    std::vector<double> mData64f;
-    std::vector<float> mData32f;
-    std::vector<int> mData32i;
+    // Copies of the trace share the samples until one is modified
+    SFF::Utilities::SharedBuffer<double> mData64f;
+    SFF::Utilities::SharedBuffer<float> mData32f;
+    SFF::Utilities::SharedBuffer<int> mData32i;
     double mSamplingRate = 0;
     int64_t mNumberOfSamples = 0;
     Precision mPrecision = Precision::UNKNOWN;
@@ -125,13 +129,14 @@ void Trace::read(const std::string &fileName, const SNCL &sncl)
     {
         throw std::invalid_argument("SNCL cannot be empty\n");
     }
+    SFF_INSTRUMENT_SCOPE(READ);
     pImpl->mSNCL = sncl;
     // Create a SNCL selection
     int retcode = 0;
-    std::string network  = sncl.getNetwork();
-    std::string station  = sncl.getStation();
-    std::string channel  = sncl.getChannel();
-    std::string location = sncl.getLocationCode();
+    std::string network{sncl.getNetwork()};
+    std::string station{sncl.getStation()};
+    std::string channel{sncl.getChannel()};
+    std::string location{sncl.getLocationCode()};
     char *networkQuery = NULL;
     if (network.length() > 0){networkQuery = network.data();}
     char *stationQuery = NULL;
@@ -165,6 +170,25 @@ void Trace::read(const std::string &fileName, const SNCL &sncl)
         mstl3_free(&traceList, 0);
         throw std::runtime_error("Failed to read trace list\n");
     }
+#ifdef SFF_INSTRUMENTATION
+    for (auto traceID = traceList->traces;
+         traceID != NULL;
+         traceID = traceID->next)
+    {
+        for (auto segment = traceID->first;
+             segment != NULL;
+             segment = segment->next)
+        {
+            if (!segment->recordlist){continue;}
+            for (auto record = segment->recordlist->first;
+                 record != NULL;
+                 record = record->next)
+            {
+                SFF_INSTRUMENT_COUNT(BYTES_READ, record->msr->reclen);
+            }
+        }
+    }
+#endif
     bool lfound = false;
     bool lfail = false;
     for (auto traceID=traceList->traces;
@@ -204,19 +228,19 @@ void Trace::read(const std::string &fileName, const SNCL &sncl)
             {
                 pImpl->mPrecision = Precision::INT32;
                 pImpl->mData32i.resize(segment->samplecnt);
-                dPtr = pImpl->mData32i.data();
+                dPtr = pImpl->mData32i.mutableData();
             }
             else if (sampleType == 'f')
             {
                 pImpl->mPrecision = Precision::FLOAT32;
                 pImpl->mData32f.resize(segment->samplecnt);
-                dPtr = pImpl->mData32f.data(); 
+                dPtr = pImpl->mData32f.mutableData(); 
             }
             else if (sampleType == 'd')
             {
                 pImpl->mPrecision = Precision::FLOAT64;
                 pImpl->mData64f.resize(segment->samplecnt);
-                dPtr = pImpl->mData64f.data();
+                dPtr = pImpl->mData64f.mutableData();
             }
             else
             {
@@ -225,6 +249,7 @@ void Trace::read(const std::string &fileName, const SNCL &sncl)
                 lfail = true;
                 goto EXIT;
             }
+            SFF_INSTRUMENT_COUNT(ALLOCATIONS, 1);
             // Does the sampling rate make sense?
             pImpl->mSamplingRate = segment->samprate;
             if (segment->samprate <= 0)
@@ -238,8 +263,14 @@ void Trace::read(const std::string &fileName, const SNCL &sncl)
             pImpl->mStartTime.setEpoch(startTime);
             // Unpack the data
             size_t outputSize = segment->samplecnt*sampleSize;
-            auto unpacked = mstl3_unpack_recordlist(traceID, segment,
-                                                    dPtr, outputSize, 0);
+            int64_t unpacked = 0;
+            {
+                SFF_INSTRUMENT_SCOPE(DECODE);
+                unpacked = mstl3_unpack_recordlist(traceID, segment,
+                                                   dPtr, outputSize, 0);
+            }
+            SFF_INSTRUMENT_COUNT(RECORDS_DECODED,
+                                 segment->recordlist->recordcnt);
             if (unpacked != segment->samplecnt)
             {
                 fprintf(stderr, "%s: Cannot unpack data for %s\n",
@@ -362,7 +393,8 @@ void Trace::setData(const size_t nSamples, const double x[])
     pImpl->mNumberOfSamples = static_cast<int> (nSamples);
     pImpl->mPrecision = Precision::FLOAT64; 
     pImpl->mData64f.resize(nSamples);
-    copySeismogram(pImpl->mNumberOfSamples, x, pImpl->mData64f.data());
+    copySeismogram(pImpl->mNumberOfSamples, x,
+                   pImpl->mData64f.mutableData());
 }
 
 void Trace::setData(const size_t nSamples, const float x[])
@@ -384,7 +416,8 @@ void Trace::setData(const size_t nSamples, const float x[])
     pImpl->mNumberOfSamples = static_cast<int> (nSamples);
     pImpl->mPrecision = Precision::FLOAT32;
     pImpl->mData32f.resize(nSamples);
-    copySeismogram(pImpl->mNumberOfSamples, x, pImpl->mData32f.data());
+    copySeismogram(pImpl->mNumberOfSamples, x,
+                   pImpl->mData32f.mutableData());
 }
 
 void Trace::setData(const size_t nSamples, const int x[])
@@ -406,7 +439,8 @@ void Trace::setData(const size_t nSamples, const int x[])
     pImpl->mNumberOfSamples = static_cast<int> (nSamples);
     pImpl->mPrecision = Precision::INT32;
     pImpl->mData32i.resize(nSamples);
-    copySeismogram(pImpl->mNumberOfSamples, x, pImpl->mData32i.data());
+    copySeismogram(pImpl->mNumberOfSamples, x,
+                   pImpl->mData32i.mutableData());
 }
 
 /// Data getters - vectors
@@ -575,3 +609,79 @@ const double *Trace::getDataPointer64f() const
     }
     return pImpl->mData64f.data();
 }
+
+/// Views of the data
+std::span<const double> Trace::getDataSpan64f() const
+{
+    auto data = getDataPointer64f();
+    return std::span<const double> (data,
+                                    static_cast<size_t> (getNumberOfSamples()));
+}
+
+std::span<const float> Trace::getDataSpan32f() const
+{
+    auto data = getDataPointer32f();
+    return std::span<const float> (data,
+                                   static_cast<size_t> (getNumberOfSamples()));
+}
+
+std::span<const int> Trace::getDataSpan32i() const
+{
+    auto data = getDataPointer32i();
+    return std::span<const int> (data,
+                                 static_cast<size_t> (getNumberOfSamples()));
+}
+
+/// Memory resource
+void Trace::setMemoryResource(std::pmr::memory_resource *resource)
+{
+    pImpl->mData64f.setMemoryResource(resource);
+    pImpl->mData32f.setMemoryResource(resource);
+    pImpl->mData32i.setMemoryResource(resource);
+}
+
+std::pmr::memory_resource *Trace::getMemoryResource() const noexcept
+{
+    return pImpl->mData64f.getMemoryResource();
+}
+
+/// Strided copies
+namespace
+{
+template<typename T>
+void copyTraceTo(const Trace &trace, std::span<T> x, const size_t stride,
+                 const size_t offset, const size_t count)
+{
+    auto precision = trace.getPrecision();
+    if (precision == Precision::INT32)
+    {
+        copyToStrided(trace.getDataSpan32i(), x, stride, offset, count);
+    }
+    else if (precision == Precision::FLOAT32)
+    {
+        copyToStrided(trace.getDataSpan32f(), x, stride, offset, count);
+    }
+    else
+    {
+        copyToStrided(trace.getDataSpan64f(), x, stride, offset, count);
+    }
+}
+}
+
+void Trace::copyTo(std::span<double> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyTraceTo(*this, x, stride, offset, count);
+}
+
+void Trace::copyTo(std::span<float> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyTraceTo(*this, x, stride, offset, count);
+}
+
+void Trace::copyTo(std::span<int> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyTraceTo(*this, x, stride, offset, count);
+}
@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstring>
+#include <future>
 #if __has_include(<filesystem>)
  #include <filesystem>
  namespace fs = std::filesystem;
@@ -18,6 +20,7 @@
 #include "sff/miniseed/traceGroup.hpp"
 #include "sff/miniseed/sncl.hpp"
 #include "sff/miniseed/trace.hpp"
+#include "private/instrumentation.hpp"
 
 using namespace SFF::MiniSEED;
 
@@ -26,10 +29,10 @@ namespace
 std::string sncl2str(const SNCL &sncl)
 {
     std::string str;
-    str = sncl.getNetwork() + "."
-        + sncl.getStation() + "."
-        + sncl.getChannel() + "."
-        + sncl.getLocationCode();
+    str.append(sncl.getNetwork()).append(".")
+       .append(sncl.getStation()).append(".")
+       .append(sncl.getChannel()).append(".")
+       .append(sncl.getLocationCode());
     return str;
 }
 }
@@ -87,6 +90,13 @@ void TraceGroup::clear() noexcept
 
 /// Read the traces
 void TraceGroup::read(const std::string &fileName)
+{
+    read(fileName, nullptr);
+}
+
+/// Read the traces into the given memory resource
+void TraceGroup::read(const std::string &fileName,
+                      std::pmr::memory_resource *resource)
 {
     clear();
 #if USE_FILESYSTEM == 1
@@ -103,14 +113,20 @@ void TraceGroup::read(const std::string &fileName)
     constexpr int8_t verbose = 0;
     constexpr int splitversion = 0;
     int retcode = MS_NOERROR;
-    retcode = ms3_readtracelist(&mstl, fileName.c_str(), NULL,
-                                splitversion, flags, verbose);
+    {
+        SFF_INSTRUMENT_SCOPE(HEADER);
+        retcode = ms3_readtracelist(&mstl, fileName.c_str(), NULL,
+                                    splitversion, flags, verbose);
+    }
     if (retcode != MS_NOERROR)
     {
         auto error = std::string(ms_errorstr(retcode));
         throw std::invalid_argument("Encountered error: " + error
                                   + " when reading: " + fileName);
     }
+#if USE_FILESYSTEM == 1
+    SFF_INSTRUMENT_COUNT(BYTES_READ, fs::file_size(fileName));
+#endif
     // Unpack the SNCLs
     auto id = mstl->traces;
     while (id)
@@ -153,6 +169,7 @@ void TraceGroup::read(const std::string &fileName)
     {
         try
         {
+            pImpl->mTraces[i].setMemoryResource(resource);
             pImpl->mTraces[i].read(fileName, sncl);
         }
         catch (const std::exception &e)
@@ -164,6 +181,135 @@ void TraceGroup::read(const std::string &fileName)
     }
 }
 
+/// Unpack the traces from memory
+void TraceGroup::set(const size_t nBytes, const char bytes[],
+                     std::pmr::memory_resource *resource)
+{
+    clear();
+    if (nBytes == 0){throw std::invalid_argument("No bytes to unpack");}
+    if (bytes == nullptr){throw std::invalid_argument("bytes is NULL");}
+    // Parse and unpack everything in one pass
+    MS3TraceList *mstl = nullptr;
+    constexpr uint32_t flags = MSF_VALIDATECRC | MSF_UNPACKDATA;
+    constexpr int8_t verbose = 0;
+    constexpr int8_t splitversion = 0;
+    int64_t nRecords = 0;
+    {
+        SFF_INSTRUMENT_SCOPE(DECODE);
+        nRecords = mstl3_readbuffer(&mstl, const_cast<char *> (bytes), nBytes,
+                                    splitversion, flags, NULL, verbose);
+    }
+    if (nRecords < 0)
+    {
+        if (mstl){mstl3_free(&mstl, 0);}
+        auto error = std::string(ms_errorstr(static_cast<int> (nRecords)));
+        throw std::invalid_argument("Encountered error: " + error
+                                  + " when unpacking buffer");
+    }
+    SFF_INSTRUMENT_COUNT(RECORDS_DECODED, nRecords);
+    try
+    {
+        for (auto id = mstl->traces; id != NULL; id = id->next)
+        {
+            std::string network(11, 0);
+            std::string station(11, 0);
+            std::string channel(11, 0);
+            std::string location(11, 0);
+            auto retcode = ms_sid2nslc(id->sid,
+                                       network.data(), station.data(),
+                                       location.data(), channel.data());
+            if (retcode != MS_NOERROR)
+            {
+                std::string error = std::string(ms_errorstr(retcode));
+                throw std::invalid_argument("Encountered error: " + error
+                                          + " when unpacking buffer");
+            }
+            SNCL sncl;
+            sncl.setNetwork(network);
+            sncl.setStation(station);
+            sncl.setChannel(channel);
+            if (strnlen(location.c_str(), location.size()) > 0)
+            {
+                sncl.setLocationCode(location);
+            }
+            auto idx = std::find(pImpl->mSNCLs.begin(), pImpl->mSNCLs.end(),
+                                 sncl);
+            if (idx != pImpl->mSNCLs.end()){continue;}
+            // Like Trace::read() only the first segment is retained
+            auto segment = id->first;
+            if (segment == NULL){continue;}
+            Trace trace;
+            trace.setMemoryResource(resource);
+            trace.setSNCL(sncl);
+            trace.setSamplingRate(segment->samprate);
+            SFF::Utilities::Time startTime;
+            startTime.setEpoch(segment->starttime*1.e-9);
+            trace.setStartTime(startTime);
+            auto nSamples = static_cast<size_t> (segment->numsamples);
+            if (segment->sampletype == 'i')
+            {
+                trace.setData(nSamples,
+                              static_cast<const int *> (segment->datasamples));
+            }
+            else if (segment->sampletype == 'f')
+            {
+                trace.setData(nSamples,
+                              static_cast<const float *> (segment->datasamples));
+            }
+            else if (segment->sampletype == 'd')
+            {
+                trace.setData(nSamples,
+                              static_cast<const double *> (segment->datasamples));
+            }
+            else
+            {
+                throw std::invalid_argument("Unsupported sample type for "
+                                          + sncl2str(sncl));
+            }
+            pImpl->mSNCLs.push_back(sncl);
+            pImpl->mTraces.push_back(std::move(trace));
+        }
+    }
+    catch (...)
+    {
+        mstl3_free(&mstl, 0);
+        clear();
+        throw;
+    }
+    mstl3_free(&mstl, 0);
+}
+
+/// Read the traces asynchronously
+std::future<TraceGroup>
+TraceGroup::readAsync(const std::string &fileName,
+                      SFF::Utilities::AsyncReader &reader,
+                      std::pmr::memory_resource *resource)
+{
+    auto promise = std::make_shared<std::promise<TraceGroup>> ();
+    auto future = promise->get_future();
+    reader.readFile(fileName,
+                    [promise, resource](std::vector<char> &&bytes,
+                                        std::exception_ptr error)
+                    {
+                        if (error)
+                        {
+                            promise->set_exception(error);
+                            return;
+                        }
+                        try
+                        {
+                            TraceGroup group;
+                            group.set(bytes.size(), bytes.data(), resource);
+                            promise->set_value(std::move(group));
+                        }
+                        catch (...)
+                        {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+    return future;
+}
+
 /// Check if the SNCL exists
 bool TraceGroup::haveSNCL(const SNCL &sncl) const noexcept
 {
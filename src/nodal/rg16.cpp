@@ -15,6 +15,7 @@
 #endif
 #include "sff/nodal/fairfield/rg16.hpp"
 #include "sff/nodal/fairfield/generalHeader1.hpp"
+#include "private/instrumentation.hpp"
 
 using namespace SFF::Nodal::Fairfield;
 
@@ -98,6 +99,7 @@ void RG16::read(const std::string &fileName)
         throw std::invalid_argument(errmsg);
     }
 #endif
+    SFF_INSTRUMENT_SCOPE(READ);
     // Open the file
     std::ifstream nodalFile(fileName, std::ios::in | std::ios::binary);
     // Begin unpacking
@@ -159,7 +161,11 @@ void RG16::read(const std::string &fileName)
     nodalFile.seekg(0, nodalFile.beg);
     std::array<char, 32> cGeneralHeader1{};
     nodalFile.read(cGeneralHeader1.data(), cGeneralHeader1.size()*sizeof(char));
-    pImpl->mGeneralHeader1.unpack(cGeneralHeader1.data());
+    SFF_INSTRUMENT_COUNT(BYTES_READ, cGeneralHeader1.size());
+    {
+        SFF_INSTRUMENT_SCOPE(HEADER);
+        pImpl->mGeneralHeader1.unpack(cGeneralHeader1.data());
+    }
     std::stringstream sstream;
     sstream << pImpl->mGeneralHeader1;
     std::cout << sstream.str() << std::endl;
@@ -7,14 +7,13 @@
 #include <algorithm>
 #include <vector>
 #include <fstream>
+#include <future>
 #ifndef NDEBUG
 #include <cassert>
 #endif
-#if __has_include(<boost/align/aligned_allocator.hpp>)
- #define USE_BOOST_ALIGN
- #include <boost/align/aligned_allocator.hpp>
-#endif
 #include "sff/utilities/time.hpp"
+#include "sff/utilities/sharedBuffer.hpp"
+#include "sff/utilities/asyncReader.hpp"
 #include "sff/sac/waveform.hpp"
 #include "sff/sac/header.hpp"
 #if __has_include(<filesystem>)
@@ -27,6 +26,8 @@
  #define USE_FILESYSTEM 1
 #endif
 #include "private/byteSwap.hpp"
+#include "private/copyTo.hpp"
+#include "private/instrumentation.hpp"
 
 using namespace SFF::SAC;
 
@@ -78,6 +79,37 @@ SFF::Utilities::Time headerToStartTime(const SFF::SAC::Header &header)
     return startTime;
 }
 
+/// Infers the byte order of a SAC file from the number of points in the
+/// header and the file size.  Returns true if the bytes must be swapped.
+[[nodiscard]]
+bool getByteOrder(const char *cdat, const size_t nBytes, int *nptsOut)
+{
+    union
+    {
+        char c4[4];
+        int npts = 0;
+    };
+    c4[0] = cdat[316];
+    c4[1] = cdat[317];
+    c4[2] = cdat[318];
+    c4[3] = cdat[319];
+    size_t nBytesEst = static_cast<size_t> (npts)*sizeof(float) + 632;
+    bool lswap = false;
+    if (nBytesEst != nBytes)
+    {
+        std::reverse(c4, c4 + 4);
+        nBytesEst = static_cast<size_t> (npts)*sizeof(float) + 632;
+        if (nBytesEst != nBytes)
+        {
+            std::string errmsg = "Cannot determine endianness of file";
+            throw std::invalid_argument(errmsg);
+        }
+        lswap = true;
+    }
+    *nptsOut = npts;
+    return lswap;
+}
+
 }
 
 //static double *alignedAllocDouble(const int npts);
@@ -152,11 +184,8 @@ public:
 
 //private:
     class Header mHeader;
-#ifdef USE_BOOST_ALIGN
-    std::vector<float, boost::alignment::aligned_allocator<float, 64>> mData;
-#else
-    std::vector<float> mData;
-#endif
+    // Copies of the waveform share the samples until one is modified
+    SFF::Utilities::SharedBuffer<float> mData;
     //float *__attribute__((aligned(64))) mData = nullptr;
 };
 
@@ -229,6 +258,7 @@ void Waveform::read(const std::string &fileName,
         throw std::invalid_argument(errmsg);
     }
 #endif
+    SFF_INSTRUMENT_SCOPE(READ);
     // Read the binary file
     std::ifstream sacfl(fileName, std::ios::in | std::ios::binary);
     sacfl.seekg(0, sacfl.end);
@@ -245,33 +275,12 @@ void Waveform::read(const std::string &fileName,
     auto nBytesRemaining = nBytes - cheader.size()*sizeof(char);
     // Figure out the byte order
     const char *cdat = cheader.data(); //buffer.data();
-    union
-    {
-        char c4[4];
-        int npts = 0;
-    };
-    c4[0] = cdat[316];
-    c4[1] = cdat[317];
-    c4[2] = cdat[318];
-    c4[3] = cdat[319];
-    //std::copy(cdat + 316*sizeof(char), cdat + 320*sizeof(char), c4);
-    //std::memcpy(c4, &cdat[316], 4*sizeof(char));
-    size_t nBytesEst = static_cast<size_t> (npts)*sizeof(float) + 632;
-    bool lswap = false;
-    if (nBytesEst != nBytes)
-    {
-        std::reverse(c4, c4 + 4);
-        nBytesEst = static_cast<size_t> (npts)*sizeof(float) + 632;
-        if (nBytesEst != nBytes)
-        {
-            std::string errmsg = "Cannot determine endianness of file";
-            throw std::invalid_argument(errmsg);
-        }
-        lswap = true;
-    }
+    int npts = 0;
+    bool lswap = getByteOrder(cdat, nBytes, &npts);
     // Unpack the header (this will check npts and delta are valid)
     try
     {
+        SFF_INSTRUMENT_SCOPE(HEADER);
         pImpl->mHeader.setFromBinaryHeader(cdat, lswap);
     }
     catch (const std::invalid_argument &ia)
@@ -339,19 +348,94 @@ void Waveform::read(const std::string &fileName,
     t0File.setEpoch(t0File.getEpoch() + i0*dt);
     setStartTime(t0File);
     pImpl->mData.resize(nPtsToRead);// = alignedAllocFloat(nPtsToRead);
+    SFF_INSTRUMENT_COUNT(ALLOCATIONS, 1);
     // Now read it
-    char *cdata = reinterpret_cast<char *> (pImpl->mData.data());
+    auto data = pImpl->mData.mutableData();
+    char *cdata = reinterpret_cast<char *> (data);
     sacfl.read(cdata, nBytesRemaining);
     sacfl.close();
+    SFF_INSTRUMENT_COUNT(BYTES_READ, cheader.size() + nBytesRemaining);
+    SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
     if (lswap)
     {
+        SFF_INSTRUMENT_SCOPE(SWAP);
+        SFF_INSTRUMENT_COUNT(BYTE_SWAPS, nPtsToRead);
         for (int i = 0; i < nPtsToRead; i++)
         {
-            pImpl->mData[i] = swapFloat(pImpl->mData[i]);
+            data[i] = swapFloat(data[i]);
         }
     }
 }
 
+/// Unpacks a waveform from memory
+void Waveform::set(const size_t nBytes, const char bytes[])
+{
+    clear();
+    if (nBytes < 632)
+    {
+        std::string errmsg = "SAC file has less than 632 bytes; nBytes = "
+                           + std::to_string(nBytes);
+        throw std::invalid_argument(errmsg);
+    }
+    if (bytes == nullptr){throw std::invalid_argument("bytes is NULL");}
+    int npts = 0;
+    bool lswap = getByteOrder(bytes, nBytes, &npts);
+    try
+    {
+        SFF_INSTRUMENT_SCOPE(HEADER);
+        pImpl->mHeader.setFromBinaryHeader(bytes, lswap);
+    }
+    catch (const std::invalid_argument &ia)
+    {
+        pImpl->mHeader.clear();
+        throw std::invalid_argument(ia);
+    }
+    pImpl->mData.resize(npts);
+    SFF_INSTRUMENT_COUNT(ALLOCATIONS, 1);
+    SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
+    auto data = pImpl->mData.mutableData();
+    std::copy(bytes + 632, bytes + nBytes, reinterpret_cast<char *> (data));
+    if (lswap)
+    {
+        SFF_INSTRUMENT_SCOPE(SWAP);
+        SFF_INSTRUMENT_COUNT(BYTE_SWAPS, npts);
+        for (int i = 0; i < npts; i++)
+        {
+            data[i] = swapFloat(data[i]);
+        }
+    }
+}
+
+/// Loads a waveform asynchronously
+std::future<Waveform>
+Waveform::readAsync(const std::string &fileName,
+                    SFF::Utilities::AsyncReader &reader)
+{
+    auto promise = std::make_shared<std::promise<Waveform>> ();
+    auto future = promise->get_future();
+    reader.readFile(fileName,
+                    [promise](std::vector<char> &&bytes,
+                              std::exception_ptr error)
+                    {
+                        if (error)
+                        {
+                            promise->set_exception(error);
+                            return;
+                        }
+                        try
+                        {
+                            Waveform waveform;
+                            waveform.set(bytes.size(), bytes.data());
+                            promise->set_value(std::move(waveform));
+                        }
+                        catch (...)
+                        {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+    return future;
+}
+
 /// Loads a waveform
 void Waveform::read(const std::string &fileName)
 {
@@ -381,6 +465,7 @@ void Waveform::write(const std::string &fileName, const bool lswap) const
         }
     }
 #endif
+    SFF_INSTRUMENT_SCOPE(WRITE);
     // Pack the header
     int npts = getNumberOfSamples();
     auto nBytes = sizeof(float)*static_cast<size_t> (npts);
@@ -390,6 +475,8 @@ void Waveform::write(const std::string &fileName, const bool lswap) const
     std::ofstream outfile(fileName,
                           std::ofstream::binary | std::ofstream::trunc);
     outfile.write(cheader.data(), cheader.size()*sizeof(char));
+    SFF_INSTRUMENT_COUNT(BYTES_WRITTEN, cheader.size() + nBytes);
+    SFF_INSTRUMENT_COUNT(RECORDS_ENCODED, 1);
     // Pack the data
     if (!lswap)
     {
@@ -404,6 +491,8 @@ void Waveform::write(const std::string &fileName, const bool lswap) const
             char c4[4];
             float f4 = 0;
         };
+        SFF_INSTRUMENT_SCOPE(SWAP);
+        SFF_INSTRUMENT_COUNT(BYTE_SWAPS, npts);
         std::vector<char> cdata(nBytes); 
         auto mData = pImpl->mData.data();
         //#pragma omp simd aligned(mData: 64)
@@ -604,6 +693,61 @@ const float *Waveform::getDataPointer() const noexcept
     return pImpl->mData.data();
 }
 
+/// Gets a view of the data
+std::span<const float> Waveform::getDataSpan() const noexcept
+{
+    auto npts = getNumberOfSamples();
+    auto data = getDataPointer();
+    if (npts < 1 || data == nullptr){return {};}
+    return std::span<const float> (data, static_cast<size_t> (npts));
+}
+
+/// Memory resource
+void Waveform::setMemoryResource(std::pmr::memory_resource *resource)
+{
+    pImpl->mData.setMemoryResource(resource);
+}
+
+std::pmr::memory_resource *Waveform::getMemoryResource() const noexcept
+{
+    return pImpl->mData.getMemoryResource();
+}
+
+/// Gets the precision
+SFF::Precision Waveform::getPrecision() const noexcept
+{
+    return SFF::Precision::FLOAT32;
+}
+
+/// Typed views
+std::span<const float> Waveform::getDataSpan32f() const
+{
+    return getDataSpan();
+}
+
+std::span<const double> Waveform::getDataSpan64f() const
+{
+    throw std::runtime_error("Precision is FLOAT32 not FLOAT64");
+}
+
+std::span<const int> Waveform::getDataSpan32i() const
+{
+    throw std::runtime_error("Precision is FLOAT32 not INT32");
+}
+
+/// Strided copies
+void Waveform::copyTo(std::span<double> destination, const size_t stride,
+                      const size_t offset, const size_t count) const
+{
+    copyToStrided(getDataSpan(), destination, stride, offset, count);
+}
+
+void Waveform::copyTo(std::span<float> destination, const size_t stride,
+                      const size_t offset, const size_t count) const
+{
+    copyToStrided(getDataSpan(), destination, stride, offset, count);
+}
+
 /// Get a copy of the data
 void Waveform::getData(const int npts, double *dataIn[]) const
 {
@@ -683,7 +827,7 @@ void Waveform::setData(const int npts, const double x[])
     pImpl->freeData();
     pImpl->mHeader.setHeader(Integer::NPTS, npts);
     pImpl->mData.resize(npts);// = alignedAllocFloat(npts);
-    auto mData = pImpl->mData.data();
+    auto mData = pImpl->mData.mutableData();
     std::copy(x, x + npts, mData); 
 }
 
@@ -702,7 +846,7 @@ void Waveform::setData(const int npts, const float x[])
     pImpl->freeData();
     pImpl->mHeader.setHeader(Integer::NPTS, npts);
     pImpl->mData.resize(npts);// = alignedAllocFloat(npts);
-    auto mData = pImpl->mData.data();
+    auto mData = pImpl->mData.mutableData();
     std::copy(x, x+npts, mData); 
 }
 
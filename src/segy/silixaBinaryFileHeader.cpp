@@ -2,6 +2,7 @@
 #include <cstdlib>
 #include <string>
 #include <array>
+#include <limits>
 #include "sff/segy/silixa/binaryFileHeader.hpp"
 #include "private/byteSwap.hpp"
 
@@ -199,6 +200,30 @@ public:
         std::fill(mHeader.begin(), mHeader.end(), 0);
         packShort(mByteFormat, mHeader.begin()+24, mSwapBytes);
     }
+    /// Computes the first trace's byte offset from the number of extended
+    /// textual headers
+    void updateFirstTraceOffset()
+    {
+        mFirstTraceOffset = 3600 + 3200*static_cast<int64_t> (mExtendedHeaders);
+    }
+    /// Fills the SEG-Y rev2 fields when the counts no longer fit in the
+    /// rev1 16-bit fields or when there are extended textual headers
+    void packRevision2()
+    {
+        constexpr auto i16max = std::numeric_limits<int16_t>::max();
+        bool isRevision2 = static_cast<uint8_t> (mHeader[300]) >= 2;
+        if (mTracesInFile > i16max || mSamplesPerTrace > i16max ||
+            mExtendedHeaders > 0 || isRevision2)
+        {
+            mHeader[300] = 2; // Major revision
+            mHeader[301] = 0; // Minor revision
+            packInt(mSamplesPerTrace, mHeader.begin()+68, mSwapBytes);
+            packShort(static_cast<int16_t> (mExtendedHeaders),
+                      mHeader.begin()+304, mSwapBytes);
+            packLong(mTracesInFile, mHeader.begin()+312, mSwapBytes);
+            packLong(mFirstTraceOffset, mHeader.begin()+320, mSwapBytes);
+        }
+    }
     void updateValid()
     {
         mIsValid = false;
@@ -211,9 +236,11 @@ public:
     
     //HeaderData mHeader;
     std::array<char, 400> mHeader;
-    int mTracesInFile = 0;
+    int64_t mTracesInFile = 0;
+    int64_t mFirstTraceOffset = 3600;
     int mSampleInterval = 0;
     int mSamplesPerTrace = 0;
+    int mExtendedHeaders = 0;
     const int16_t mByteFormat = 5;
     bool mIsValid = false;
     /// File is in big endian format
@@ -265,6 +292,8 @@ void BinaryFileHeader::clear() noexcept
     pImpl->mTracesInFile = 0;
     pImpl->mSampleInterval = 0;
     pImpl->mSamplesPerTrace = 0;
+    pImpl->mExtendedHeaders = 0;
+    pImpl->updateFirstTraceOffset();
     //pImpl->mByteFormat = 5;
     packShort(pImpl->mByteFormat, pImpl->mHeader.begin()+24, pImpl->mSwapBytes);
     pImpl->mIsValid = false;
@@ -279,7 +308,14 @@ void BinaryFileHeader::set(const char *header)
     }
     pImpl->mIsValid = false;
     std::copy(header, header+400, pImpl->mHeader.begin());
-    pImpl->mTracesInFile = unpackShort(header+12, pImpl->mSwapBytes);
+    auto swap = pImpl->mSwapBytes;
+    bool isRevision2 = static_cast<uint8_t> (header[300]) >= 2;
+    pImpl->mTracesInFile = unpackShort(header+12, swap);
+    if (isRevision2)
+    {
+        auto nTraces = unpackLong(header+312, swap);
+        if (nTraces > 0){pImpl->mTracesInFile = nTraces;}
+    }
     pImpl->mSampleInterval = unpackShort(header+16, pImpl->mSwapBytes);
     //pImpl->mByteFormat = unpackShort(header+24, pImpl->mSwapBytes);
     if (unpackShort(header+24, pImpl->mSwapBytes) != 5)
@@ -287,7 +323,31 @@ void BinaryFileHeader::set(const char *header)
         throw std::invalid_argument("Only IEEE floats supported\n");
     }
     // N.B. 20:21 is also samples per trace but this is more robust
-    pImpl->mSamplesPerTrace =  unpackInt(header+62, pImpl->mSwapBytes);
+    pImpl->mSamplesPerTrace =  unpackInt(header+62, swap);
+    if (pImpl->mSamplesPerTrace <= 0 && isRevision2)
+    {
+        pImpl->mSamplesPerTrace = unpackInt(header+68, swap);
+    }
+    if (pImpl->mSamplesPerTrace <= 0)
+    {
+        pImpl->mSamplesPerTrace = unpackShort(header+20, swap);
+    }
+    pImpl->mExtendedHeaders = 0;
+    pImpl->updateFirstTraceOffset();
+    if (isRevision2)
+    {
+        // N.B. -1 indicates a variable number terminated by an end stanza
+        // which Silixa does not write
+        pImpl->mExtendedHeaders = unpackShort(header+304, swap);
+        if (pImpl->mExtendedHeaders < 0)
+        {
+            throw std::invalid_argument(
+                "Variable number of extended textual headers not supported\n");
+        }
+        pImpl->updateFirstTraceOffset();
+        auto offset = unpackLong(header+320, swap);
+        if (offset > 0){pImpl->mFirstTraceOffset = offset;}
+    }
     pImpl->updateValid();
 }
 
@@ -310,7 +370,7 @@ void BinaryFileHeader::get(char *headerIn[]) const
 }
 
 /// Sets the number of samples
-void BinaryFileHeader::setNumberOfSamplesPerTrace(const int16_t nSamples)
+void BinaryFileHeader::setNumberOfSamplesPerTrace(const int nSamples)
 {
     if (nSamples < 0)
     {
@@ -319,9 +379,16 @@ void BinaryFileHeader::setNumberOfSamplesPerTrace(const int16_t nSamples)
     }
     pImpl->mSamplesPerTrace = nSamples;
     pImpl->updateValid();
-    packShort(nSamples, pImpl->mHeader.begin()+20, pImpl->mSwapBytes);
+    // The 16-bit field is zeroed when it cannot hold the count
+    int16_t nSamples16 = 0;
+    if (nSamples <= std::numeric_limits<int16_t>::max())
+    {
+        nSamples16 = static_cast<int16_t> (nSamples);
+    }
+    packShort(nSamples16, pImpl->mHeader.begin()+20, pImpl->mSwapBytes);
     packInt(pImpl->mSamplesPerTrace, pImpl->mHeader.begin()+62,
             pImpl->mSwapBytes);
+    pImpl->packRevision2();
 }
 
 /// Get number of samples per trace
@@ -331,7 +398,7 @@ int BinaryFileHeader::getNumberOfSamplesPerTrace() const
 }
 
 /// Set the number of traces
-void BinaryFileHeader::setNumberOfTraces(const int16_t nTraces)
+void BinaryFileHeader::setNumberOfTraces(const int64_t nTraces)
 {
     if (nTraces < 0)
     {
@@ -340,16 +407,47 @@ void BinaryFileHeader::setNumberOfTraces(const int16_t nTraces)
     }
     pImpl->mTracesInFile = nTraces;
     pImpl->updateValid();
-    packShort(nTraces, pImpl->mHeader.begin()+12, pImpl->mSwapBytes);
-
+    // The 16-bit field is zeroed when it cannot hold the count
+    int16_t nTraces16 = 0;
+    if (nTraces <= std::numeric_limits<int16_t>::max())
+    {
+        nTraces16 = static_cast<int16_t> (nTraces);
+    }
+    packShort(nTraces16, pImpl->mHeader.begin()+12, pImpl->mSwapBytes);
+    pImpl->packRevision2();
 }
 
 /// Get the number of traces
-int BinaryFileHeader::getNumberOfTraces() const
+int64_t BinaryFileHeader::getNumberOfTraces() const
 {
     return pImpl->mTracesInFile;
 }
 
+/// Sets the number of extended textual headers
+void BinaryFileHeader::setNumberOfExtendedTextualHeaders(const int nHeaders)
+{
+    if (nHeaders < 0 || nHeaders > std::numeric_limits<int16_t>::max())
+    {
+        throw std::invalid_argument("nHeaders = " + std::to_string(nHeaders)
+                                  + " must be in range [0,32767]\n");
+    }
+    pImpl->mExtendedHeaders = nHeaders;
+    pImpl->updateFirstTraceOffset();
+    pImpl->packRevision2();
+}
+
+/// Gets the number of extended textual headers
+int BinaryFileHeader::getNumberOfExtendedTextualHeaders() const
+{
+    return pImpl->mExtendedHeaders;
+}
+
+/// Gets the byte offset of the first trace
+int64_t BinaryFileHeader::getFirstTraceOffset() const
+{
+    return pImpl->mFirstTraceOffset;
+}
+
 /// Set the sampling interval
 void BinaryFileHeader::setSampleInterval(const int16_t sampleInterval)
 {
@@ -0,0 +1,537 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <cmath>
+#include "sff/segy/silixa/stream.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/silixa/traceHeader.hpp"
+#include "sff/segy/silixa/binaryFileHeader.hpp"
+#include "sff/utilities/asyncReader.hpp"
+#include "sff/utilities/decimator.hpp"
+
+using namespace SFF::SEGY::Silixa;
+
+namespace
+{
+
+/// The number of channels decimated at once.  This bounds the decimator's
+/// workspace.
+constexpr int DECIMATION_BLOCK = 64;
+
+/// The properties of a file required to order and check the stream
+struct FileSummary
+{
+    std::string fileName;
+    SFF::Utilities::Time startTime;
+    int64_t nChannels{0};
+    int nSamples{0};
+    int sampleInterval{0};
+};
+
+/// Reads the binary file header and first trace header of a file
+FileSummary summarize(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        throw std::invalid_argument("Could not open " + fileName + "\n");
+    }
+    std::array<char, 3600> fileHeaders{};
+    std::array<char, 240> traceHeaderBytes{};
+    file.read(fileHeaders.data(), fileHeaders.size());
+    if (!file)
+    {
+        throw std::invalid_argument(fileName + " is too small\n");
+    }
+    BinaryFileHeader binaryFileHeader;
+    binaryFileHeader.set(fileHeaders.data() + 3200);
+    file.seekg(binaryFileHeader.getFirstTraceOffset(), file.beg);
+    file.read(traceHeaderBytes.data(), traceHeaderBytes.size());
+    if (!file)
+    {
+        throw std::invalid_argument(fileName + " has no traces\n");
+    }
+    TraceHeader traceHeader;
+    traceHeader.set(traceHeaderBytes.data());
+    FileSummary summary;
+    summary.fileName = fileName;
+    summary.startTime = traceHeader.getStartTime();
+    summary.nChannels = binaryFileHeader.getNumberOfTraces();
+    summary.nSamples = binaryFileHeader.getNumberOfSamplesPerTrace();
+    summary.sampleInterval = traceHeader.getSampleInterval();
+    return summary;
+}
+
+}
+
+class Stream::StreamImpl
+{
+public:
+    /// Waits for the background read then releases the files
+    void close() noexcept
+    {
+        if (mNext.valid()){mNext.wait();}
+        mNext = std::future<TraceGroup> ();
+        mCurrent.clear();
+        mDecimated.clear();
+        mDecimator.clear();
+        mFiles.clear();
+        mWindow.clear();
+        mCurrentFile =-1;
+        mSampleInFile = 0;
+        mCurrentSamples = 0;
+        mConsumed = 0;
+        mWindowStart =-1;
+        mTotalSamples = 0;
+        mOpen = false;
+    }
+    /// Waits for the background read then rewinds to the start of the
+    /// stream
+    void rewind()
+    {
+        if (mNext.valid()){mNext.wait();}
+        mCurrent.clear();
+        mDecimated.clear();
+        if (mDecimator.isInitialized()){mDecimator.reset();}
+        mCurrentFile =-1;
+        mSampleInFile = 0;
+        mCurrentSamples = 0;
+        mConsumed = 0;
+        mWindowStart =-1;
+        prefetch(0);
+    }
+    /// Starts reading the index'th file in the background
+    void prefetch(const size_t index)
+    {
+        mNext = std::future<TraceGroup> ();
+        if (index < mFiles.size())
+        {
+            mNext = TraceGroup::readAsync(mFiles[index].fileName, *mReader);
+        }
+    }
+    /// Makes the prefetched file the current file and starts reading the
+    /// file after it
+    void advanceFile()
+    {
+        auto index = static_cast<size_t> (mCurrentFile + 1);
+        if (!mNext.valid() || index >= mFiles.size())
+        {
+            throw std::runtime_error("Stream is exhausted\n");
+        }
+        try
+        {
+            mCurrent = mNext.get();
+        }
+        catch (const std::exception &e)
+        {
+            mCurrent.clear();
+            throw std::runtime_error(std::string(e.what())
+                                   + "Failed to read "
+                                   + mFiles[index].fileName + "\n");
+        }
+        if (mCurrent.getNumberOfTraces() != mChannels ||
+            mCurrent.getNumberOfSamplesPerTrace() != mFiles[index].nSamples)
+        {
+            mCurrent.clear();
+            throw std::runtime_error(mFiles[index].fileName
+                                   + " changed since the stream was opened\n");
+        }
+        mCurrentFile = static_cast<int64_t> (index);
+        mSampleInFile = 0;
+        mCurrentSamples = mFiles[index].nSamples;
+        prefetch(index + 1);
+        if (mFactor > 1){decimate();}
+    }
+    /// Decimates the current file then releases its full-rate samples
+    void decimate()
+    {
+        const auto &current = mCurrent;
+        auto nOut = mDecimator.getNumberOfOutputSamples(0, mCurrentSamples);
+        mDecimated.resize(static_cast<size_t> (mChannels)*nOut);
+        std::vector<const float *> x(DECIMATION_BLOCK);
+        std::vector<float *> y(DECIMATION_BLOCK);
+        for (int c0 = 0; c0 < mChannels; c0 = c0 + DECIMATION_BLOCK)
+        {
+            auto nBlock = std::min(DECIMATION_BLOCK, mChannels - c0);
+            for (int i = 0; i < nBlock; ++i)
+            {
+                x[i] = current[c0 + i].getDataPointer();
+                y[i] = mDecimated.data()
+                     + static_cast<size_t> (c0 + i)*nOut;
+            }
+            mDecimator.process(c0, nBlock, mCurrentSamples,
+                               x.data(), y.data());
+        }
+        mCurrent.clear();
+        mCurrentSamples = nOut;
+    }
+    /// The samples of the channel in the current file
+    const float *getChannel(const int channel) const
+    {
+        if (mFactor > 1)
+        {
+            return mDecimated.data()
+                 + static_cast<size_t> (channel)*mCurrentSamples;
+        }
+        const auto &current = mCurrent;
+        return current[channel].getDataPointer();
+    }
+    /// Copies the next nSamples samples of each channel into the window
+    /// beginning at the given column.  If column is negative then the
+    /// samples are skipped.
+    void consume(const int column, const int nSamples)
+    {
+        int nCopied = 0;
+        while (nCopied < nSamples)
+        {
+            if (mCurrentFile < 0 || mSampleInFile == mCurrentSamples)
+            {
+                advanceFile();
+            }
+            auto nCopy = std::min(nSamples - nCopied,
+                                  mCurrentSamples - mSampleInFile);
+            if (column >= 0)
+            {
+                for (int channel = 0; channel < mChannels; ++channel)
+                {
+                    auto x = getChannel(channel);
+                    std::copy(x + mSampleInFile,
+                              x + mSampleInFile + nCopy,
+                              mWindow.data()
+                            + static_cast<size_t> (channel)*mWindowLength
+                            + column + nCopied);
+                }
+            }
+            mSampleInFile = mSampleInFile + nCopy;
+            nCopied = nCopied + nCopy;
+        }
+        mConsumed = mConsumed + nSamples;
+    }
+    std::unique_ptr<SFF::Utilities::AsyncReader> mReader;
+    std::vector<FileSummary> mFiles;
+    std::vector<float> mWindow;
+    /// The decimated samples of the current file.  This is a row major
+    /// [nChannels x mCurrentSamples] matrix.
+    std::vector<float> mDecimated;
+    SFF::Utilities::Decimator mDecimator;
+    TraceGroup mCurrent;
+    std::future<TraceGroup> mNext;
+    SFF::Utilities::Time mStartTime;
+    double mSamplingPeriod = 0;
+    double mTolerance =-1;
+    int64_t mTotalSamples = 0;
+    int64_t mCurrentFile =-1;
+    int64_t mConsumed = 0;
+    int64_t mWindowStart =-1;
+    int mChannels = 0;
+    int mSampleInFile = 0;
+    int mCurrentSamples = 0;
+    int mFactor = 1;
+    int mWindowLength = 0;
+    int mWindowStep = 0;
+    bool mOpen = false;
+};
+
+/// Constructor
+Stream::Stream() :
+    pImpl(std::make_unique<StreamImpl> ())
+{
+}
+
+/// Move c'tor
+Stream::Stream(Stream &&stream) noexcept
+{
+    *this = std::move(stream);
+}
+
+/// Move assignment
+Stream& Stream::operator=(Stream &&stream) noexcept
+{
+    if (&stream == this){return *this;}
+    if (pImpl){pImpl->close();}
+    pImpl = std::move(stream.pImpl);
+    return *this;
+}
+
+/// Destructor
+Stream::~Stream()
+{
+    if (pImpl){pImpl->close();}
+}
+
+/// Closes the stream
+void Stream::close() noexcept
+{
+    pImpl->close();
+}
+
+/// Continuity tolerance
+void Stream::setContinuityTolerance(const double tolerance)
+{
+    if (tolerance < 0)
+    {
+        throw std::invalid_argument("tolerance = " + std::to_string(tolerance)
+                                  + " cannot be negative\n");
+    }
+    pImpl->mTolerance = tolerance;
+}
+
+/// Decimation factor
+void Stream::setDecimationFactor(const int factor)
+{
+    if (factor < 1)
+    {
+        throw std::invalid_argument("factor = " + std::to_string(factor)
+                                  + " must be positive\n");
+    }
+    pImpl->mFactor = factor;
+}
+
+int Stream::getDecimationFactor() const noexcept
+{
+    return pImpl->mFactor;
+}
+
+/// Opens the stream
+void Stream::open(const std::vector<std::string> &fileNames)
+{
+    close();
+    if (fileNames.empty()){throw std::invalid_argument("No files\n");}
+    std::vector<FileSummary> files;
+    files.reserve(fileNames.size());
+    for (const auto &fileName : fileNames)
+    {
+        try
+        {
+            files.push_back(summarize(fileName));
+        }
+        catch (const std::exception &e)
+        {
+            throw std::invalid_argument(std::string(e.what())
+                                      + "Failed to read headers of "
+                                      + fileName + "\n");
+        }
+    }
+    std::stable_sort(files.begin(), files.end(),
+                     [](const FileSummary &a, const FileSummary &b)
+                     {
+                         return a.startTime < b.startTime;
+                     });
+    // Check the files are consistent and continuous
+    const auto &first = files[0];
+    if (first.sampleInterval <= 0)
+    {
+        throw std::invalid_argument("Sampling period not set in "
+                                  + first.fileName + "\n");
+    }
+    if (first.nChannels < 1 ||
+        first.nChannels > std::numeric_limits<int>::max())
+    {
+        throw std::invalid_argument("Invalid number of channels in "
+                                  + first.fileName + "\n");
+    }
+    auto dt = static_cast<double> (first.sampleInterval)*1.e-6;
+    auto tolerance = pImpl->mTolerance >= 0 ? pImpl->mTolerance : dt/2;
+    int64_t nTotalSamples = first.nSamples;
+    for (size_t i = 1; i < files.size(); ++i)
+    {
+        const auto &previous = files[i - 1];
+        const auto &file = files[i];
+        if (file.nChannels != first.nChannels)
+        {
+            throw std::invalid_argument(file.fileName + " has "
+                                      + std::to_string(file.nChannels)
+                                      + " channels; expecting "
+                                      + std::to_string(first.nChannels)
+                                      + "\n");
+        }
+        if (file.sampleInterval != first.sampleInterval)
+        {
+            throw std::invalid_argument(file.fileName
+                                      + " has a different sampling period\n");
+        }
+        auto expectedStart = previous.startTime.getEpoch()
+                           + previous.nSamples*dt;
+        auto difference = file.startTime.getEpoch() - expectedStart;
+        if (std::abs(difference) > tolerance)
+        {
+            throw std::invalid_argument(std::string(difference > 0 ?
+                                                    "Gap of " : "Overlap of ")
+                                      + std::to_string(std::abs(difference))
+                                      + " s between " + previous.fileName
+                                      + " and " + file.fileName + "\n");
+        }
+        nTotalSamples = nTotalSamples + file.nSamples;
+    }
+    if (!pImpl->mReader)
+    {
+        pImpl->mReader = std::make_unique<SFF::Utilities::AsyncReader> (1, 1);
+    }
+    pImpl->mFiles = std::move(files);
+    pImpl->mStartTime = pImpl->mFiles[0].startTime;
+    pImpl->mSamplingPeriod = dt;
+    pImpl->mChannels = static_cast<int> (pImpl->mFiles[0].nChannels);
+    pImpl->mTotalSamples = nTotalSamples;
+    if (pImpl->mFactor > 1)
+    {
+        // The k'th output is the filtered (k*factor)'th input delayed by
+        // the filter
+        auto factor = pImpl->mFactor;
+        pImpl->mDecimator.initialize(pImpl->mChannels, factor);
+        pImpl->mStartTime = pImpl->mStartTime
+                          - pImpl->mDecimator.getGroupDelay()*dt;
+        pImpl->mSamplingPeriod = dt*factor;
+        pImpl->mTotalSamples = 0;
+        if (nTotalSamples > 0)
+        {
+            pImpl->mTotalSamples = (nTotalSamples - 1)/factor + 1;
+        }
+    }
+    pImpl->mOpen = true;
+    if (pImpl->mWindowLength > 0){setWindow(pImpl->mWindowLength,
+                                            pImpl->mWindowStep);}
+}
+
+/// Is the stream open?
+bool Stream::isOpen() const noexcept
+{
+    return pImpl->mOpen;
+}
+
+/// File names
+std::vector<std::string> Stream::getFileNames() const
+{
+    std::vector<std::string> fileNames;
+    fileNames.reserve(pImpl->mFiles.size());
+    for (const auto &file : pImpl->mFiles){fileNames.push_back(file.fileName);}
+    return fileNames;
+}
+
+/// Number of channels
+int Stream::getNumberOfChannels() const
+{
+    if (!isOpen()){throw std::runtime_error("Stream not open\n");}
+    return pImpl->mChannels;
+}
+
+/// Sampling period
+double Stream::getSamplingPeriod() const
+{
+    if (!isOpen()){throw std::runtime_error("Stream not open\n");}
+    return pImpl->mSamplingPeriod;
+}
+
+/// Number of samples
+int64_t Stream::getNumberOfSamples() const
+{
+    if (!isOpen()){throw std::runtime_error("Stream not open\n");}
+    return pImpl->mTotalSamples;
+}
+
+/// Start time
+SFF::Utilities::Time Stream::getStartTime() const
+{
+    if (!isOpen()){throw std::runtime_error("Stream not open\n");}
+    return pImpl->mStartTime;
+}
+
+/// Sets the window
+void Stream::setWindow(const int windowLength, const int windowStep)
+{
+    if (windowLength < 1)
+    {
+        throw std::invalid_argument("windowLength = "
+                                  + std::to_string(windowLength)
+                                  + " must be positive\n");
+    }
+    if (windowStep < 1)
+    {
+        throw std::invalid_argument("windowStep = "
+                                  + std::to_string(windowStep)
+                                  + " must be positive\n");
+    }
+    if (!isOpen()){throw std::runtime_error("Stream not open\n");}
+    pImpl->rewind();
+    pImpl->mWindowLength = windowLength;
+    pImpl->mWindowStep = windowStep;
+    pImpl->mWindow.assign(static_cast<size_t> (pImpl->mChannels)
+                         *static_cast<size_t> (windowLength), 0);
+}
+
+/// Advances the window
+bool Stream::nextWindow()
+{
+    if (!isOpen()){throw std::runtime_error("Stream not open\n");}
+    if (pImpl->mWindowLength < 1){throw std::runtime_error("Window not set\n");}
+    auto length = pImpl->mWindowLength;
+    auto step = pImpl->mWindowStep;
+    auto start = pImpl->mWindowStart < 0 ? 0 : pImpl->mWindowStart + step;
+    if (start + length > pImpl->mTotalSamples){return false;}
+    if (pImpl->mWindowStart >= 0 && step < length)
+    {
+        // Slide the samples shared with the previous window to the front
+        // then append the new samples
+        auto nKeep = length - step;
+        for (int channel = 0; channel < pImpl->mChannels; ++channel)
+        {
+            auto row = pImpl->mWindow.data()
+                     + static_cast<size_t> (channel)*length;
+            std::copy(row + step, row + length, row);
+        }
+        pImpl->consume(nKeep, step);
+    }
+    else
+    {
+        // Skip any samples between the windows then fill the window
+        auto nSkip = start - pImpl->mConsumed;
+        while (nSkip > 0)
+        {
+            auto n = static_cast<int> (std::min<int64_t> (nSkip, length));
+            pImpl->consume(-1, n);
+            nSkip = nSkip - n;
+        }
+        pImpl->consume(0, length);
+    }
+    pImpl->mWindowStart = start;
+    return true;
+}
+
+/// Window
+std::span<const float> Stream::getWindow() const
+{
+    if (pImpl->mWindowStart < 0)
+    {
+        throw std::runtime_error("Window not loaded\n");
+    }
+    return std::span<const float> (pImpl->mWindow.data(),
+                                   pImpl->mWindow.size());
+}
+
+/// Window length
+int Stream::getWindowLength() const noexcept
+{
+    return pImpl->mWindowLength;
+}
+
+/// Window start sample
+int64_t Stream::getWindowStartSample() const
+{
+    if (pImpl->mWindowStart < 0)
+    {
+        throw std::runtime_error("Window not loaded\n");
+    }
+    return pImpl->mWindowStart;
+}
+
+/// Window start time
+SFF::Utilities::Time Stream::getWindowStartTime() const
+{
+    auto start = getWindowStartSample();
+    return pImpl->mStartTime
+         + static_cast<double> (start)*pImpl->mSamplingPeriod;
+}
@@ -5,28 +5,13 @@
 #include <algorithm>
 #include "sff/segy/silixa/traceHeader.hpp"
 #include "sff/segy/silixa/trace.hpp"
+#include "sff/utilities/sharedBuffer.hpp"
 #include "private/byteSwap.hpp"
+#include "private/copyTo.hpp"
+#include "private/instrumentation.hpp"
 
 using namespace SFF::SEGY::Silixa;
 
-namespace
-{
-
-static float *alignedAllocFloat(const int npts)
-{
-    size_t nbytes = static_cast<size_t> (npts)*sizeof(float);
-#ifdef HAVE_ALIGNED_ALLOC
-    float *data = static_cast<float *> (aligned_alloc(64, nbytes));
-#else
-    void *dataTemp = malloc(nbytes);
-    posix_memalign(&dataTemp, 64, nbytes);
-    auto data = static_cast<float *> (dataTemp);
-#endif
-    return data;
-}
-
-}
-
 class Trace::TraceImpl
 {
 public:
@@ -34,41 +19,16 @@ public:
     {
         mHeader.setSampleInterval(500); 
     }
-    /// Copy c'tor
-    TraceImpl(const TraceImpl &trace)
-    {
-        *this = trace;
-    }
-    /// Copy assignment operator.
-    TraceImpl& operator=(const TraceImpl &trace)
-    {
-        if (&trace == this){return *this;}
-        mHeader = trace.mHeader;
-        mSamples = trace.mSamples;
-        if (mSamples > 0 && trace.mData)
-        {
-            mData = alignedAllocFloat(mSamples);
-            std::copy(trace.mData, trace.mData+mSamples, mData);
-        }
-        return *this;
-    }
-    /// Destructor
-    ~TraceImpl()
-    {
-        clear();
-    }
     /// Clears the class and resets the header
     void clear() noexcept
     {
-        if (mData){free(mData);}
-        mData = nullptr;
+        mData.clear();
         mHeader.clear();
-        mSamples = 0;
     }
 /// private:
-    float *__attribute__((aligned(64))) mData = nullptr;
+    // Copies of the trace share the samples until one is modified
+    SFF::Utilities::SharedBuffer<float> mData;
     TraceHeader mHeader;
-    int mSamples = 0;
     const bool mSwapBytes = testByteOrder() == LITTLE_ENDIAN;
 };
 
@@ -109,10 +69,7 @@ Trace& Trace::operator=(Trace &&trace) noexcept
 }
 
 /// Destructor
-Trace::~Trace()
-{
-    clear();
-}
+Trace::~Trace() = default;
 
 /// Clears the class
 void Trace::clear() noexcept
@@ -134,14 +91,12 @@ void Trace::setData(const int nSamples, const double x[])
         throw std::invalid_argument("x is NULL\n");
     }
     // Update and release memory
-    pImpl->mSamples = nSamples;
     pImpl->mHeader.setNumberOfSamples(nSamples);
-    if (pImpl->mData){free(pImpl->mData);}
-    pImpl->mData = nullptr;
+    pImpl->mData.clear();
     if (nSamples == 0){return;} // Done early
     // Now resize and copy
-    pImpl->mData = alignedAllocFloat(nSamples);
-    auto data = pImpl->mData;
+    pImpl->mData.resize(nSamples);
+    auto data = pImpl->mData.mutableData();
     #pragma omp simd 
     for (int i=0; i<nSamples; ++i)
     {
@@ -162,14 +117,12 @@ void Trace::setData(const int nSamples, const float x[])
         throw std::invalid_argument("x is NULL\n");
     }
     // Update and release memory
-    pImpl->mSamples = nSamples;
     pImpl->mHeader.setNumberOfSamples(nSamples);
-    if (pImpl->mData){free(pImpl->mData);}
-    pImpl->mData = nullptr;
+    pImpl->mData.clear();
     if (nSamples == 0){return;} // Done early
     // Now resize and copy
-    pImpl->mData = alignedAllocFloat(nSamples);
-    auto data = pImpl->mData;
+    pImpl->mData.resize(nSamples);
+    auto data = pImpl->mData.mutableData();
     std::copy(x, x+nSamples, data);
 }
 
@@ -186,7 +139,7 @@ void Trace::getData(const int nSamples, float *xIn[]) const
     if (nSamples == 0){return;}
     auto x = *xIn;
     if (x == nullptr){throw std::invalid_argument("x is NULL\n");}
-    auto data = pImpl->mData;
+    auto data = pImpl->mData.data();
     std::copy(data, data+nSamplesRef, x);
 }
 
@@ -203,7 +156,7 @@ void Trace::getData(const int nSamples, int *xIn[]) const
     if (nSamples == 0){return;}
     auto x = *xIn;
     if (x == nullptr){throw std::invalid_argument("x is NULL\n");}
-    auto data = pImpl->mData;
+    auto data = pImpl->mData.data();
     std::copy(data, data+nSamplesRef, x);
 }
 */
@@ -221,16 +174,112 @@ void Trace::getData(const int nSamples, double *xIn[]) const
     if (nSamples == 0){return;}
     auto x = *xIn;
     if (x == nullptr){throw std::invalid_argument("x is NULL\n");}
-    auto data = pImpl->mData;
+    auto data = pImpl->mData.data();
     #pragma omp simd aligned(data: 64)
     for (int i=0; i<nSamples; ++i){x[i] = data[i];}
 }
 
 
+/// Gets a pointer to the data
+const float *Trace::getDataPointer() const noexcept
+{
+    return pImpl->mData.data();
+}
+
+/// Gets a view of the data
+std::span<const float> Trace::getDataSpan() const noexcept
+{
+    return pImpl->mData.getSpan();
+}
+
+/// Memory resource
+void Trace::setMemoryResource(std::pmr::memory_resource *resource)
+{
+    pImpl->mData.setMemoryResource(resource);
+}
+
+std::pmr::memory_resource *Trace::getMemoryResource() const noexcept
+{
+    return pImpl->mData.getMemoryResource();
+}
+
+/// Gets the precision
+SFF::Precision Trace::getPrecision() const noexcept
+{
+    return SFF::Precision::FLOAT32;
+}
+
+/// Typed views
+std::span<const float> Trace::getDataSpan32f() const
+{
+    return getDataSpan();
+}
+
+std::span<const double> Trace::getDataSpan64f() const
+{
+    throw std::runtime_error("Precision is FLOAT32 not FLOAT64");
+}
+
+std::span<const int> Trace::getDataSpan32i() const
+{
+    throw std::runtime_error("Precision is FLOAT32 not INT32");
+}
+
+/// Strided copies
+void Trace::copyTo(std::span<double> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyToStrided(getDataSpan(), x, stride, offset, count);
+}
+
+void Trace::copyTo(std::span<float> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyToStrided(getDataSpan(), x, stride, offset, count);
+}
+
 /// Gets the number of samples
 int Trace::getNumberOfSamples() const
 {
-    return pImpl->mSamples;
+    return static_cast<int> (pImpl->mData.size());
+}
+
+/// Packs the trace header and data
+void Trace::get(const int len, char *xIn[]) const
+{
+    auto nSamples = getNumberOfSamples();
+    auto lenEst = 240 + 4*nSamples;
+    if (lenEst != len)
+    {
+        throw std::invalid_argument("len = " + std::to_string(len)
+                                  + " should equal "
+                                  + std::to_string(lenEst) + "\n");
+    }
+    char *x = *xIn;
+    if (x == nullptr){throw std::invalid_argument("x is NULL\n");}
+    pImpl->mHeader.get(&x);
+    char *xOff = x + 240;
+    const char *__attribute__((aligned(64))) cdata
+        = reinterpret_cast<const char *> (pImpl->mData.data());
+    if (pImpl->mSwapBytes)
+    {
+        SFF_INSTRUMENT_SCOPE(SWAP);
+        SFF_INSTRUMENT_COUNT(BYTE_SWAPS, nSamples);
+        #pragma omp simd aligned(cdata: 64)
+        for (int i=0; i<nSamples; ++i)
+        {
+            auto index = 4*i;
+            xOff[index]   = cdata[index+3];
+            xOff[index+1] = cdata[index+2];
+            xOff[index+2] = cdata[index+1];
+            xOff[index+3] = cdata[index];
+        }
+    }
+    else
+    {
+        std::copy(cdata, cdata+4*nSamples, xOff);
+    }
+    SFF_INSTRUMENT_COUNT(RECORDS_ENCODED, 1);
 }
 
 /// Sets the trace header and data
@@ -248,15 +297,22 @@ void Trace::set(int len, const char x[])
                                   + std::to_string(lenEst) + "\n");
     }
     pImpl->mHeader = header;
-    pImpl->mSamples = nSamplesEst;
-    if (pImpl->mData){free(pImpl->mData);}
-    pImpl->mData = alignedAllocFloat(pImpl->mSamples);
+    // The samples are overwritten so shared samples are not copied
+    if (static_cast<int> (pImpl->mData.size()) != nSamplesEst ||
+        pImpl->mData.isShared())
+    {
+        pImpl->mData.clear();
+        pImpl->mData.resize(nSamplesEst);
+        SFF_INSTRUMENT_COUNT(ALLOCATIONS, 1);
+    }
     const char *xOff = x+240;
-    auto data = pImpl->mData;
+    auto data = pImpl->mData.mutableData();
     auto lswap = pImpl->mSwapBytes;
     char *__attribute__((aligned(64))) cdata = reinterpret_cast<char *> (data);
     if (lswap)
     {
+        SFF_INSTRUMENT_SCOPE(SWAP);
+        SFF_INSTRUMENT_COUNT(BYTE_SWAPS, nSamplesEst);
         #pragma omp simd aligned(cdata: 64)
         for (int i=0; i<nSamplesEst; ++i)
         {
@@ -3,12 +3,27 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <algorithm>
 #include <fstream>
 #include <limits>
+#include <future>
+#include <thread>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include "sff/segy/silixa/traceGroup.hpp"
 #include "sff/segy/silixa/trace.hpp"
+#include "sff/segy/silixa/traceHeader.hpp"
 #include "sff/segy/silixa/binaryFileHeader.hpp"
 #include "sff/segy/textualFileHeader.hpp"
+#include "sff/utilities/decimator.hpp"
+#include "private/fileIO.hpp"
+#include "private/instrumentation.hpp"
 #if __has_include(<filesystem>)
  #include <filesystem>
  namespace fs = std::filesystem;
@@ -21,9 +36,469 @@
 
 using namespace SFF::SEGY::Silixa;
 
+namespace
+{
+
+/// O_DIRECT requires the buffer, offset, and length be block aligned
+constexpr size_t BLOCK_SIZE = 4096;
+/// Target size of each packed buffer
+constexpr size_t CHUNK_SIZE = 32*1024*1024;
+/// The trace length, 240 + 4*nSamples, must fit in an int
+constexpr int MAX_SAMPLES = (std::numeric_limits<int>::max() - 240)/4;
+/// The number of channels unpacked and decimated at once
+constexpr int DECIMATION_BLOCK = 64;
+
+/// A page aligned buffer suitable for O_DIRECT
+class DirectBuffer
+{
+public:
+    explicit DirectBuffer(const size_t size) :
+        mSize(size)
+    {
+        mData = static_cast<char *> (std::aligned_alloc(BLOCK_SIZE, mSize));
+        if (mData == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate write buffer");
+        }
+    }
+    ~DirectBuffer(){std::free(mData);}
+    DirectBuffer(const DirectBuffer &) = delete;
+    DirectBuffer& operator=(const DirectBuffer &) = delete;
+    [[nodiscard]] char *data() noexcept{return mData;}
+    [[nodiscard]] size_t size() const noexcept{return mSize;}
+private:
+    char *mData{nullptr};
+    size_t mSize{0};
+};
+
+/// Verifies the file size matches the binary file header.  This is done
+/// in 64-bit arithmetic since long, dense acquisitions exceed 2 GB.
+bool checkSize(const int64_t nTraces, const int nSamples,
+               const int64_t firstTraceOffset, const int64_t fileSize)
+{
+    if (nTraces < 0 || nTraces > std::numeric_limits<int>::max())
+    {
+        return false;
+    }
+    if (nSamples < 0 || nSamples > MAX_SAMPLES){return false;}
+    auto traceLength = 240 + 4*static_cast<int64_t> (nSamples);
+    return firstTraceOffset + nTraces*traceLength == fileSize;
+}
+
+/// Checks the traces can be written to a single file and returns the
+/// number of samples per trace and the sample interval in microseconds
+std::pair<int, int> checkTraces(const std::vector<Trace> &traces)
+{
+    if (traces.empty()){return std::pair(0, 0);}
+    auto nSamples = traces[0].getNumberOfSamples();
+    auto dt = traces[0].getSamplingPeriod();
+    for (size_t i = 1; i < traces.size(); ++i)
+    {
+        if (traces[i].getNumberOfSamples() != nSamples)
+        {
+            throw std::invalid_argument("Trace " + std::to_string(i)
+                                      + " has " 
+                                      + std::to_string(
+                                          traces[i].getNumberOfSamples())
+                                      + " samples; expecting "
+                                      + std::to_string(nSamples));
+        }
+        if (std::abs(traces[i].getSamplingPeriod() - dt) > 1.e-7)
+        {
+            throw std::invalid_argument("Trace " + std::to_string(i)
+                                      + " has a different sampling period");
+        }
+    }
+    auto sampleInterval = std::lround(dt*1.e6);
+    if (traces.size() > static_cast<size_t> (std::numeric_limits<int>::max()))
+    {
+        throw std::invalid_argument("Too many traces for the binary header");
+    }
+    if (nSamples > MAX_SAMPLES)
+    {
+        throw std::invalid_argument("Too many samples for the binary header");
+    }
+    if (sampleInterval < 1 ||
+        sampleInterval > std::numeric_limits<int16_t>::max())
+    {
+        throw std::invalid_argument("Sampling period cannot be represented");
+    }
+    return std::pair(nSamples, static_cast<int> (sampleInterval));
+}
+
+/// Byte ranges separated by at most this many bytes are read with a single
+/// system call.  Skipping less than a page does not save any I/O.
+constexpr int64_t MAX_GAP = 4096;
+/// The maximum number of buffers in a preadv (Linux's UIO_MAXIOV)
+constexpr size_t MAX_IOVECS = 1024;
+
+/// A range of bytes in a file and the memory into which it is read
+struct ByteRange
+{
+    int64_t offset{0};
+    size_t length{0};
+    char *destination{nullptr};
+};
+
+/// Opens a file for reading and closes it when this goes out of scope
+class ReadOnlyFile
+{
+public:
+    explicit ReadOnlyFile(const std::string &fileName)
+    {
+#if USE_FILESYSTEM == 1
+        if (!fs::exists(fileName))
+        {
+            throw std::invalid_argument("SEGY file = " + fileName
+                                      + " does not exist");
+        }
+#endif
+        mDescriptor = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (mDescriptor < 0)
+        {
+            throw std::invalid_argument("Could not open " + fileName + ": "
+                                      + std::strerror(errno));
+        }
+        struct stat status{};
+        if (::fstat(mDescriptor, &status) != 0)
+        {
+            ::close(mDescriptor);
+            throw std::runtime_error("Could not stat " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        mSize = static_cast<int64_t> (status.st_size);
+    }
+    ~ReadOnlyFile(){::close(mDescriptor);}
+    ReadOnlyFile(const ReadOnlyFile &) = delete;
+    ReadOnlyFile& operator=(const ReadOnlyFile &) = delete;
+    [[nodiscard]] int descriptor() const noexcept{return mDescriptor;}
+    [[nodiscard]] int64_t size() const noexcept{return mSize;}
+private:
+    int mDescriptor{-1};
+    int64_t mSize{0};
+};
+
+/// Fills the buffers with the bytes beginning at offset, retrying on
+/// partial reads
+void preadvAll(const int fd, std::vector<struct iovec> &iovecs,
+               int64_t offset, const std::string &fileName)
+{
+    size_t first = 0;
+    while (first < iovecs.size())
+    {
+        auto nRead = ::preadv(fd, iovecs.data() + first,
+                              static_cast<int> (iovecs.size() - first),
+                              static_cast<off_t> (offset));
+        if (nRead < 0)
+        {
+            if (errno == EINTR){continue;}
+            throw std::runtime_error("Failed to read " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        if (nRead == 0)
+        {
+            throw std::runtime_error("Unexpected end of file " + fileName);
+        }
+        offset = offset + nRead;
+        // Skip the filled buffers and trim the partially filled buffer
+        auto remaining = static_cast<size_t> (nRead);
+        while (remaining > 0 && first < iovecs.size())
+        {
+            auto &iov = iovecs[first];
+            if (remaining >= iov.iov_len)
+            {
+                remaining = remaining - iov.iov_len;
+                first = first + 1;
+            }
+            else
+            {
+                iov.iov_base = static_cast<char *> (iov.iov_base) + remaining;
+                iov.iov_len = iov.iov_len - remaining;
+                remaining = 0;
+            }
+        }
+    }
+}
+
+/// Reads the byte ranges which must be sorted by offset and must not
+/// overlap.  Nearby ranges are gathered into one preadv and the bytes
+/// between them are scattered into a scratch buffer.
+/// @result The number of bytes read from the file.
+int64_t scatterRead(const int fd, const std::vector<ByteRange> &ranges,
+                    const std::string &fileName)
+{
+    std::vector<char> scratch(MAX_GAP);
+    std::vector<struct iovec> iovecs;
+    iovecs.reserve(MAX_IOVECS);
+    int64_t nBytesRead = 0;
+    size_t i = 0;
+    while (i < ranges.size())
+    {
+        iovecs.clear();
+        auto offset = ranges[i].offset;
+        auto end = offset;
+        for (; i < ranges.size(); ++i)
+        {
+            auto gap = ranges[i].offset - end;
+            if (!iovecs.empty())
+            {
+                if (gap > MAX_GAP || iovecs.size() + 2 > MAX_IOVECS){break;}
+                if (gap > 0)
+                {
+                    iovecs.push_back(iovec{scratch.data(),
+                                           static_cast<size_t> (gap)});
+                }
+            }
+            iovecs.push_back(iovec{ranges[i].destination, ranges[i].length});
+            end = ranges[i].offset + static_cast<int64_t> (ranges[i].length);
+        }
+        preadvAll(fd, iovecs, offset, fileName);
+        nBytesRead = nBytesRead + (end - offset);
+    }
+    return nBytesRead;
+}
+
+}
+
 class TraceGroup::TraceGroupImpl
 {
 public:
+    /// Unpacks the 3200 byte textual and 400 byte binary file headers
+    void setFileHeaders(const char textHeader[], const char binaryFileHeader[])
+    {
+        try 
+        {
+            SFF_INSTRUMENT_SCOPE(HEADER);
+            mTextualFileHeader.setEBCDIC(textHeader);
+        }
+        catch (const std::exception &e)
+        {
+            auto errmsg = std::string(e.what())
+                        + "EBCDIC header is malformed\n";
+            throw std::invalid_argument(errmsg);
+        }
+        try
+        {
+            SFF_INSTRUMENT_SCOPE(HEADER);
+            mBinaryFileHeader.set(binaryFileHeader);
+        }
+        catch (const std::exception &e)
+        {
+            auto errmsg = std::string(e.what())
+                        + "Binary file header is malformed\n";
+            throw std::invalid_argument(errmsg);
+        } 
+    }
+    /// Reads and unpacks the file headers of an open file then verifies
+    /// the file size
+    void readFileHeaders(const ReadOnlyFile &file,
+                         const std::string &fileName)
+    {
+        if (file.size() < 3600)
+        {
+            throw std::invalid_argument("File must be at least 3600 bytes\n");
+        }
+        std::array<char, 3600> headers{};
+        std::vector<ByteRange> ranges{ByteRange{0, headers.size(),
+                                                headers.data()}};
+        [[maybe_unused]]
+        auto nBytes = scatterRead(file.descriptor(), ranges, fileName);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, nBytes);
+        setFileHeaders(headers.data(), headers.data() + 3200);
+        auto nTraces = mBinaryFileHeader.getNumberOfTraces();
+        auto nSamples = mBinaryFileHeader.getNumberOfSamplesPerTrace();
+        auto offset = mBinaryFileHeader.getFirstTraceOffset();
+        if (!checkSize(nTraces, nSamples, offset, file.size()))
+        {
+            throw std::invalid_argument("File size is incorrect\n");
+        }
+    }
+    /// Checks the channel range is in the file
+    void checkChannelRange(const int firstChannel, const int lastChannel) const
+    {
+        auto nTraces = mBinaryFileHeader.getNumberOfTraces();
+        if (firstChannel < 0 || firstChannel > lastChannel ||
+            lastChannel >= nTraces)
+        {
+            throw std::invalid_argument("Channel range = ["
+                                      + std::to_string(firstChannel) + ","
+                                      + std::to_string(lastChannel)
+                                      + "] must be in [0,"
+                                      + std::to_string(nTraces - 1) + "]\n");
+        }
+    }
+    /// Reads the header of the index'th trace in the file
+    TraceHeader readTraceHeader(const ReadOnlyFile &file,
+                                const int64_t index,
+                                const std::string &fileName) const
+    {
+        auto nSamples = mBinaryFileHeader.getNumberOfSamplesPerTrace();
+        auto traceLength = 240 + 4*static_cast<int64_t> (nSamples);
+        std::array<char, 240> bytes{};
+        auto offset = mBinaryFileHeader.getFirstTraceOffset()
+                    + index*traceLength;
+        std::vector<ByteRange> ranges{ByteRange{offset, bytes.size(),
+                                                bytes.data()}};
+        [[maybe_unused]]
+        auto nBytes = scatterRead(file.descriptor(), ranges, fileName);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, nBytes);
+        TraceHeader header;
+        header.set(bytes.data());
+        return header;
+    }
+    /// Reads the samples [firstSample, lastSample] of the traces
+    /// [firstChannel, lastChannel].  The ranges must have been checked.
+    void readSubset(const ReadOnlyFile &file,
+                    const std::string &fileName,
+                    const int firstChannel, const int lastChannel,
+                    const int firstSample, const int lastSample,
+                    std::pmr::memory_resource *resource)
+    {
+        auto nSamples = mBinaryFileHeader.getNumberOfSamplesPerTrace();
+        auto offset = mBinaryFileHeader.getFirstTraceOffset();
+        auto traceLength = 240 + 4*static_cast<int64_t> (nSamples);
+        auto nChannels = lastChannel - firstChannel + 1;
+        auto nWindow = lastSample - firstSample + 1;
+        // Lay each trace out in memory as it would be in a file with only
+        // the requested samples then read the header and sample window of
+        // each trace into place
+        auto subsetLength = 240 + 4*static_cast<size_t> (nWindow);
+        std::vector<char> buffer(static_cast<size_t> (nChannels)*subsetLength);
+        std::vector<ByteRange> ranges;
+        ranges.reserve(2*static_cast<size_t> (nChannels));
+        for (int i = 0; i < nChannels; ++i)
+        {
+            auto traceOffset = offset + (firstChannel + i)*traceLength;
+            char *destination = buffer.data() + i*subsetLength;
+            ranges.push_back(ByteRange{traceOffset, 240, destination});
+            ranges.push_back(ByteRange{traceOffset + 240 + 4*firstSample,
+                                       subsetLength - 240,
+                                       destination + 240});
+        }
+        [[maybe_unused]]
+        auto nBytes = scatterRead(file.descriptor(), ranges, fileName);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, nBytes);
+        // Unpack the traces.  The trace headers are updated for the window.
+        mTraces.resize(nChannels);
+        TraceHeader header;
+        for (int i = 0; i < nChannels; ++i)
+        {
+            char *bytes = buffer.data() + i*subsetLength;
+            try
+            {
+                header.set(bytes);
+                auto startTime = header.getStartTime();
+                if (nWindow != nSamples)
+                {
+                    header.setNumberOfSamples(nWindow);
+                    header.get(&bytes);
+                }
+                mTraces[i].setMemoryResource(resource);
+                mTraces[i].set(static_cast<int> (subsetLength), bytes);
+                if (firstSample > 0)
+                {
+                    auto dt = mTraces[i].getSamplingPeriod();
+                    mTraces[i].setStartTime(startTime + firstSample*dt);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                auto errmsg = std::string(e.what())
+                            + "Failed to set trace "
+                            + std::to_string(firstChannel + i);
+                throw std::invalid_argument(errmsg);
+            }
+            SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
+        }
+        mBinaryFileHeader.setNumberOfTraces(nChannels);
+        mBinaryFileHeader.setNumberOfSamplesPerTrace(nWindow);
+    }
+    /// Reads the traces in blocks of channels and decimates them
+    void readDecimated(const ReadOnlyFile &file,
+                       const std::string &fileName,
+                       SFF::Utilities::Decimator &decimator,
+                       std::pmr::memory_resource *resource)
+    {
+        auto nTraces = static_cast<int> (mBinaryFileHeader.getNumberOfTraces());
+        auto nSamples = mBinaryFileHeader.getNumberOfSamplesPerTrace();
+        auto offset = mBinaryFileHeader.getFirstTraceOffset();
+        auto traceLength = 240 + 4*static_cast<size_t> (nSamples);
+        if (!decimator.isInitialized())
+        {
+            throw std::invalid_argument("Decimator not initialized\n");
+        }
+        if (decimator.getNumberOfChannels() != nTraces)
+        {
+            throw std::invalid_argument("Decimator has "
+                                  + std::to_string(
+                                       decimator.getNumberOfChannels())
+                                  + " channels but file has "
+                                  + std::to_string(nTraces) + "\n");
+        }
+        if (nTraces == 0){return;}
+        auto factor = decimator.getDecimationFactor();
+        auto phase = decimator.getPhase(0);
+        auto nOut = decimator.getNumberOfOutputSamples(0, nSamples);
+        auto delay = decimator.getGroupDelay();
+        std::vector<char> buffer(static_cast<size_t> (
+                                    std::min(nTraces, DECIMATION_BLOCK))
+                                *traceLength);
+        std::vector<Trace> fullRate(std::min(nTraces, DECIMATION_BLOCK));
+        std::vector<float> decimated(fullRate.size()*std::max(nOut, 1));
+        std::vector<const float *> x(fullRate.size());
+        std::vector<float *> y(fullRate.size());
+        mTraces.resize(nTraces);
+        TraceHeader header;
+        for (int c0 = 0; c0 < nTraces; c0 = c0 + DECIMATION_BLOCK)
+        {
+            auto nBlock = std::min(DECIMATION_BLOCK, nTraces - c0);
+            std::vector<ByteRange> ranges{ByteRange{
+                offset + c0*static_cast<int64_t> (traceLength),
+                nBlock*traceLength, buffer.data()}};
+            [[maybe_unused]]
+            auto nBytes = scatterRead(file.descriptor(), ranges, fileName);
+            SFF_INSTRUMENT_COUNT(BYTES_READ, nBytes);
+            for (int i = 0; i < nBlock; ++i)
+            {
+                try
+                {
+                    fullRate[i].set(static_cast<int> (traceLength),
+                                    buffer.data() + i*traceLength);
+                }
+                catch (const std::exception &e)
+                {
+                    throw std::invalid_argument(std::string(e.what())
+                                              + "Failed to set trace "
+                                              + std::to_string(c0 + i));
+                }
+                SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
+                x[i] = fullRate[i].getDataPointer();
+                y[i] = decimated.data() + static_cast<size_t> (i)*nOut;
+            }
+            decimator.process(c0, nBlock, nSamples, x.data(), y.data());
+            // The decimated traces keep the full-rate trace headers
+            for (int i = 0; i < nBlock; ++i)
+            {
+                char *bytes = buffer.data() + i*traceLength;
+                header.set(bytes);
+                auto startTime = header.getStartTime();
+                header.setNumberOfSamples(0);
+                header.get(&bytes);
+                auto &trace = mTraces[c0 + i];
+                trace.setMemoryResource(resource);
+                trace.set(240, bytes);
+                trace.setData(nOut, y[i]);
+                trace.setSamplingPeriod(fullRate[i].getSamplingPeriod()
+                                       *factor);
+                trace.setStartTime(startTime
+                                 + (phase - delay)
+                                  *fullRate[i].getSamplingPeriod());
+            }
+        }
+        mBinaryFileHeader.setNumberOfSamplesPerTrace(nOut);
+        mBinaryFileHeader.setSampleInterval(static_cast<int16_t> (
+            mBinaryFileHeader.getSampleInterval()*factor));
+    }
     SFF::SEGY::TextualFileHeader mTextualFileHeader;
     SFF::SEGY::Silixa::BinaryFileHeader mBinaryFileHeader;
     std::vector<SFF::SEGY::Silixa::Trace> mTraces;
@@ -86,6 +561,13 @@ void TraceGroup::clearTraces() noexcept
 
 /// Load the file
 void TraceGroup::read(const std::string &fileName)
+{
+    read(fileName, nullptr);
+}
+
+/// Load the file into the given memory resource
+void TraceGroup::read(const std::string &fileName,
+                      std::pmr::memory_resource *resource)
 {
     clear();
 #if USE_FILESYSTEM == 1
@@ -95,6 +577,7 @@ void TraceGroup::read(const std::string &fileName)
         throw std::invalid_argument(errmsg);
     }
 #endif     
+    SFF_INSTRUMENT_SCOPE(READ);
     // Read the file
     std::ifstream segyfl(fileName, std::ios::in | std::ios::binary);
     if (segyfl)
@@ -111,47 +594,40 @@ void TraceGroup::read(const std::string &fileName)
         std::array<char, 400> binaryFileHeader{};
         segyfl.read(textHeader.data(), 3200);
         segyfl.read(binaryFileHeader.data(), 400);
-        try 
-        {
-            pImpl->mTextualFileHeader.setEBCDIC(textHeader.data());
-        }
-        catch (const std::exception &e)
-        {
-            clear();
-            auto errmsg = std::string(e.what())
-                        + "EBCDIC header is malformed\n";
-            throw std::invalid_argument(errmsg);
-        }
+        SFF_INSTRUMENT_COUNT(BYTES_READ, 3600);
         try
         {
-            pImpl->mBinaryFileHeader.set(binaryFileHeader.data());
+            pImpl->setFileHeaders(textHeader.data(), binaryFileHeader.data());
         }
-        catch (const std::exception &e)
+        catch (...)
         {
             clear();
-            auto errmsg = std::string(e.what())
-                        + "Binary file header is malformed\n";
-            throw std::invalid_argument(errmsg);
-        } 
+            throw;
+        }
         // If I haven't choked yet I can now unpack the traces
         auto nTraces = pImpl->mBinaryFileHeader.getNumberOfTraces();
         auto nSamples = pImpl->mBinaryFileHeader.getNumberOfSamplesPerTrace();
-        auto estSize = 3600 + nTraces*(240 + 4*nSamples);
-        if (estSize != length)
+        auto offset = pImpl->mBinaryFileHeader.getFirstTraceOffset();
+        if (!checkSize(nTraces, nSamples, offset,
+                       static_cast<int64_t> (length)))
         {
             clear();
             throw std::invalid_argument("File size is incorrect\n");
         }
+        // Skip the extended textual headers
+        segyfl.seekg(offset, segyfl.beg);
         // Now take it down
         int traceLen = 240 + 4*nSamples;
         std::vector<char> cdata(traceLen);
         pImpl->mTraces.resize(nTraces);
-        for (int i=0; i<nTraces; ++i)
+        for (int64_t i = 0; i < nTraces; ++i)
         {
             //int offset = 0*traceLen*i;
             segyfl.read(cdata.data(), traceLen);
+            SFF_INSTRUMENT_COUNT(BYTES_READ, traceLen);
             try
             {
+                pImpl->mTraces[i].setMemoryResource(resource);
                 pImpl->mTraces[i].set(traceLen, cdata.data());
             }
             catch (const std::exception &e)
@@ -162,6 +638,7 @@ void TraceGroup::read(const std::string &fileName)
                             + std::to_string(i);
                 throw std::invalid_argument(errmsg);
             }
+            SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
         }
         segyfl.close();
     }
@@ -171,6 +648,359 @@ void TraceGroup::read(const std::string &fileName)
     }   
 }
 
+/// Load a subset of the channels and samples
+void TraceGroup::read(const std::string &fileName,
+                      const int firstChannel, const int lastChannel,
+                      const int firstSample, const int lastSample,
+                      std::pmr::memory_resource *resource)
+{
+    clear();
+    SFF_INSTRUMENT_SCOPE(READ);
+    ReadOnlyFile file(fileName);
+    try
+    {
+        pImpl->readFileHeaders(file, fileName);
+        pImpl->checkChannelRange(firstChannel, lastChannel);
+        auto nSamples = pImpl->mBinaryFileHeader.getNumberOfSamplesPerTrace();
+        if (firstSample < 0 || firstSample > lastSample ||
+            lastSample >= nSamples)
+        {
+            throw std::invalid_argument("Sample range = ["
+                                      + std::to_string(firstSample) + ","
+                                      + std::to_string(lastSample)
+                                      + "] must be in [0,"
+                                      + std::to_string(nSamples - 1) + "]\n");
+        }
+        pImpl->readSubset(file, fileName, firstChannel, lastChannel,
+                          firstSample, lastSample, resource);
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
+
+/// Load a subset of the channels in a time window
+void TraceGroup::read(const std::string &fileName,
+                      const int firstChannel, const int lastChannel,
+                      const SFF::Utilities::Time &startTime,
+                      const SFF::Utilities::Time &endTime,
+                      std::pmr::memory_resource *resource)
+{
+    clear();
+    SFF_INSTRUMENT_SCOPE(READ);
+    ReadOnlyFile file(fileName);
+    try
+    {
+        pImpl->readFileHeaders(file, fileName);
+        pImpl->checkChannelRange(firstChannel, lastChannel);
+        // The traces share a start time and sampling period so the window
+        // is computed from the first requested trace
+        auto header = pImpl->readTraceHeader(file, firstChannel, fileName);
+        auto dt = static_cast<double> (header.getSampleInterval())*1.e-6;
+        if (dt <= 0)
+        {
+            throw std::invalid_argument("Sampling period not set in trace "
+                                      + std::to_string(firstChannel) + "\n");
+        }
+        // Times are only resolved to the microsecond
+        constexpr double tolerance = 1.e-6;
+        auto t0 = header.getStartTime().getEpoch();
+        auto nSamples = pImpl->mBinaryFileHeader.getNumberOfSamplesPerTrace();
+        auto first = std::ceil((startTime.getEpoch() - t0 - tolerance)/dt);
+        auto last = std::floor((endTime.getEpoch() - t0 + tolerance)/dt);
+        first = std::max(0.0, first);
+        last = std::min(static_cast<double> (nSamples - 1), last);
+        if (first > last)
+        {
+            throw std::invalid_argument("Time window contains no samples\n");
+        }
+        pImpl->readSubset(file, fileName, firstChannel, lastChannel,
+                          static_cast<int> (first), static_cast<int> (last),
+                          resource);
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
+
+/// Load and decimate the file
+void TraceGroup::read(const std::string &fileName,
+                      SFF::Utilities::Decimator &decimator,
+                      std::pmr::memory_resource *resource)
+{
+    clear();
+    SFF_INSTRUMENT_SCOPE(READ);
+    ReadOnlyFile file(fileName);
+    try
+    {
+        pImpl->readFileHeaders(file, fileName);
+        auto sampleInterval = static_cast<int64_t> (
+            pImpl->mBinaryFileHeader.getSampleInterval())
+                            *decimator.getDecimationFactor();
+        if (sampleInterval > std::numeric_limits<int16_t>::max())
+        {
+            throw std::invalid_argument("Decimated sampling period cannot be "
+                                        "represented\n");
+        }
+        pImpl->readDecimated(file, fileName, decimator, resource);
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
+
+/// Sets the traces
+void TraceGroup::setTraces(const std::vector<Trace> &traces)
+{
+    auto copy = traces;
+    setTraces(std::move(copy));
+}
+
+void TraceGroup::setTraces(std::vector<Trace> &&traces)
+{
+    auto [nSamples, sampleInterval] = checkTraces(traces);
+    pImpl->mBinaryFileHeader.setNumberOfTraces(
+        static_cast<int64_t> (traces.size()));
+    pImpl->mBinaryFileHeader.setNumberOfSamplesPerTrace(nSamples);
+    if (sampleInterval > 0)
+    {
+        pImpl->mBinaryFileHeader.setSampleInterval(
+            static_cast<int16_t> (sampleInterval));
+    }
+    pImpl->mTraces = std::move(traces);
+}
+
+/// Writes the file
+void TraceGroup::write(const std::string &fileName,
+                       const bool useDirectIO,
+                       const int nThreadsIn) const
+{
+    const auto &traces = pImpl->mTraces;
+    if (traces.empty()){throw std::invalid_argument("No traces to write");}
+    auto [nSamples, sampleInterval] = checkTraces(traces);
+    SFF_INSTRUMENT_SCOPE(WRITE);
+    // Pack the file headers
+    auto binaryFileHeader = pImpl->mBinaryFileHeader;
+    binaryFileHeader.setNumberOfTraces(static_cast<int64_t> (traces.size()));
+    binaryFileHeader.setNumberOfSamplesPerTrace(nSamples);
+    binaryFileHeader.setSampleInterval(static_cast<int16_t> (sampleInterval));
+    // Extended textual headers are not retained so the traces follow the
+    // binary file header
+    binaryFileHeader.setNumberOfExtendedTextualHeaders(0);
+    auto textualHeader = pImpl->mTextualFileHeader.getEBCDIC();
+    textualHeader.resize(3200, ' ');
+    auto binaryHeader = binaryFileHeader.get();
+    // Each chunk holds the bytes carried from the previous chunk followed
+    // by whole traces
+    auto traceLength = 240 + 4*static_cast<size_t> (nSamples);
+    auto bufferSize = std::max(CHUNK_SIZE, traceLength + 2*BLOCK_SIZE);
+    bufferSize = ((bufferSize + BLOCK_SIZE - 1)/BLOCK_SIZE)*BLOCK_SIZE;
+    auto tracesPerChunk = (bufferSize - BLOCK_SIZE)/traceLength;
+    auto nThreads = nThreadsIn;
+    if (nThreads < 1)
+    {
+        nThreads = std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+    }
+    // Open the file
+#if USE_FILESYSTEM == 1
+    fs::path path(fileName);
+    if (path.has_parent_path() && !fs::exists(path.parent_path()))
+    {
+        fs::create_directories(path.parent_path());
+    }
+#endif
+    constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    bool direct = false;
+    int fd = -1;
+#ifdef O_DIRECT
+    if (useDirectIO)
+    {
+        fd = ::open(fileName.c_str(), flags | O_DIRECT, 0644);
+        direct = fd >= 0;
+    }
+#endif
+    if (fd < 0){fd = ::open(fileName.c_str(), flags, 0644);}
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open " + fileName + ": "
+                               + std::strerror(errno));
+    }
+    std::array<DirectBuffer, 2> buffers{DirectBuffer(bufferSize),
+                                        DirectBuffer(bufferSize)};
+    std::future<void> pendingWrite;
+    try
+    {
+        // The first chunk begins with the file headers
+        std::copy(textualHeader.data(), textualHeader.data() + 3200,
+                  buffers[0].data());
+        std::copy(binaryHeader.data(), binaryHeader.data() + 400,
+                  buffers[0].data() + 3200);
+        size_t carry = 3600;
+        size_t nTotalBytes = 3600 + traces.size()*traceLength;
+        size_t nTracesPacked = 0;
+        for (int chunk = 0; nTracesPacked < traces.size(); ++chunk)
+        {
+            auto &buffer = buffers[chunk%2];
+            auto nPack = std::min(tracesPerChunk,
+                                  traces.size() - nTracesPacked);
+            // Pack the traces in parallel
+            auto pack = [&](const size_t i0, const size_t i1)
+            {
+                for (auto i = i0; i < i1; ++i)
+                {
+                    char *destination = buffer.data() + carry
+                                      + i*traceLength;
+                    traces[nTracesPacked + i].get(
+                        static_cast<int> (traceLength), &destination);
+                }
+            };
+            auto nWorkers = std::min(static_cast<size_t> (nThreads), nPack);
+            std::vector<std::future<void>> packers;
+            for (size_t worker = 1; worker < nWorkers; ++worker)
+            {
+                packers.push_back(std::async(std::launch::async, pack,
+                                             worker*nPack/nWorkers,
+                                             (worker + 1)*nPack/nWorkers));
+            }
+            pack(0, nPack/nWorkers);
+            for (auto &packer : packers){packer.get();}
+            nTracesPacked = nTracesPacked + nPack;
+            // Wait for the previous write then hand this buffer off.  With
+            // O_DIRECT only whole blocks are written; the remainder is
+            // carried into the next buffer.
+            if (pendingWrite.valid()){pendingWrite.get();}
+            auto nBytes = carry + nPack*traceLength;
+            auto nWrite = nBytes;
+            if (direct && nTracesPacked < traces.size())
+            {
+                nWrite = (nBytes/BLOCK_SIZE)*BLOCK_SIZE;
+            }
+            else if (direct)
+            {
+                // Pad the final block then truncate
+                nWrite = ((nBytes + BLOCK_SIZE - 1)/BLOCK_SIZE)*BLOCK_SIZE;
+                std::fill(buffer.data() + nBytes, buffer.data() + nWrite, 0);
+            }
+            carry = 0;
+            if (nBytes > nWrite)
+            {
+                carry = nBytes - nWrite;
+                std::copy(buffer.data() + nWrite, buffer.data() + nBytes,
+                          buffers[(chunk + 1)%2].data());
+            }
+            pendingWrite = std::async(std::launch::async,
+                                      [fd, &buffer, nWrite, &fileName]()
+            {
+                writeAll(fd, buffer.data(), nWrite, fileName);
+            });
+        }
+        pendingWrite.get();
+        if (direct && ::ftruncate(fd, static_cast<off_t> (nTotalBytes)) != 0)
+        {
+            throw std::runtime_error("Failed to truncate " + fileName + ": "
+                                   + std::strerror(errno));
+        }
+        SFF_INSTRUMENT_COUNT(BYTES_WRITTEN, nTotalBytes);
+    }
+    catch (...)
+    {
+        if (pendingWrite.valid()){pendingWrite.wait();}
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0)
+    {
+        throw std::runtime_error("Failed to close " + fileName + ": "
+                               + std::strerror(errno));
+    }
+}
+
+/// Unpacks a file from memory
+void TraceGroup::set(const size_t nBytes, const char bytes[],
+                     std::pmr::memory_resource *resource)
+{
+    clear();
+    if (nBytes < 3600)
+    {
+        throw std::invalid_argument("File must be at least 3600 bytes\n");
+    }
+    if (bytes == nullptr){throw std::invalid_argument("bytes is NULL");}
+    try
+    {
+        pImpl->setFileHeaders(bytes, bytes + 3200);
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+    auto nTraces = pImpl->mBinaryFileHeader.getNumberOfTraces();
+    auto nSamples = pImpl->mBinaryFileHeader.getNumberOfSamplesPerTrace();
+    auto offset = pImpl->mBinaryFileHeader.getFirstTraceOffset();
+    if (!checkSize(nTraces, nSamples, offset, static_cast<int64_t> (nBytes)))
+    {
+        clear();
+        throw std::invalid_argument("File size is incorrect\n");
+    }
+    auto traceLen = static_cast<size_t> (240 + 4*nSamples);
+    pImpl->mTraces.resize(nTraces);
+    for (int64_t i = 0; i < nTraces; ++i)
+    {
+        try
+        {
+            pImpl->mTraces[i].setMemoryResource(resource);
+            pImpl->mTraces[i].set(static_cast<int> (traceLen),
+                                  bytes + offset + i*traceLen);
+        }
+        catch (const std::exception &e)
+        {
+            clear();
+            auto errmsg = std::string(e.what())
+                        + "Failed to set trace "
+                        + std::to_string(i);
+            throw std::invalid_argument(errmsg);
+        }
+        SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
+    }
+}
+
+/// Loads a file asynchronously
+std::future<TraceGroup>
+TraceGroup::readAsync(const std::string &fileName,
+                      SFF::Utilities::AsyncReader &reader,
+                      std::pmr::memory_resource *resource)
+{
+    auto promise = std::make_shared<std::promise<TraceGroup>> ();
+    auto future = promise->get_future();
+    reader.readFile(fileName,
+                    [promise, resource](std::vector<char> &&bytes,
+                                        std::exception_ptr error)
+                    {
+                        if (error)
+                        {
+                            promise->set_exception(error);
+                            return;
+                        }
+                        try
+                        {
+                            TraceGroup group;
+                            group.set(bytes.size(), bytes.data(), resource);
+                            promise->set_value(std::move(group));
+                        }
+                        catch (...)
+                        {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+    return future;
+}
+
 /// Gets the number of samples in each trace
 int TraceGroup::getNumberOfSamplesPerTrace() const
 {
@@ -183,6 +1013,41 @@ int TraceGroup::getNumberOfTraces() const
     return static_cast<int> (pImpl->mTraces.size());
 }
 
+/// Gets the data as a matrix
+void TraceGroup::getData(const int nTraces, const int nSamplesPerTrace,
+                         float *dataIn[]) const
+{
+    if (nTraces != getNumberOfTraces())
+    {
+        throw std::invalid_argument("nTraces = " + std::to_string(nTraces)
+                                  + " must equal "
+                                  + std::to_string(getNumberOfTraces()));
+    }
+    if (nTraces == 0){return;}
+    if (nSamplesPerTrace != getNumberOfSamplesPerTrace())
+    {
+        throw std::invalid_argument("nSamplesPerTrace = "
+                                  + std::to_string(nSamplesPerTrace)
+                                  + " must equal "
+                                  + std::to_string(getNumberOfSamplesPerTrace()));
+    }
+    if (nSamplesPerTrace == 0){return;}
+    float *data = *dataIn;
+    if (data == nullptr){throw std::invalid_argument("data is NULL");}
+    for (int i = 0; i < nTraces; ++i)
+    {
+        const auto &trace = pImpl->mTraces[i];
+        if (trace.getNumberOfSamples() != nSamplesPerTrace)
+        {
+            throw std::invalid_argument("Trace " + std::to_string(i)
+                                      + " has wrong number of samples");
+        }
+        auto tracePtr = trace.getDataPointer();
+        std::copy(tracePtr, tracePtr + nSamplesPerTrace,
+                  data + static_cast<size_t> (i)*nSamplesPerTrace);
+    }
+}
+
 /// Iterators
 TraceIterator<SFF::SEGY::Silixa::Trace> TraceGroup::begin()
 {
@@ -2,6 +2,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <array>
+#include <limits>
 #include "sff/segy/silixa/traceHeader.hpp"
 #include "sff/utilities/time.hpp"
 #include "private/byteSwap.hpp"
@@ -33,7 +34,7 @@ public:
         packInt(mReceiverNorthing, mHeader.data() + 84, mSwapBytes);
 
         packShort(mCoordinateUnits, mHeader.data() + 88,  mSwapBytes);
-        packShort(mSamples,         mHeader.data() + 114, mSwapBytes);
+        packShort(getSamples16(),   mHeader.data() + 114, mSwapBytes);
         packShort(mSampleInterval,  mHeader.data() + 116, mSwapBytes);
         packShort(mCorrelated,      mHeader.data() + 124, mCorrelated);
 
@@ -42,6 +43,13 @@ public:
         packInt(mSamples,            mHeader.data()+232, mSwapBytes);
         packInt(mDistanceAlongFiber, mHeader.data()+236, mSwapBytes);
     }
+    /// The 16-bit number of samples is zeroed when it cannot hold the count;
+    /// readers should use the 32-bit count at 232
+    int16_t getSamples16() const noexcept
+    {
+        if (mSamples > std::numeric_limits<int16_t>::max()){return 0;}
+        return static_cast<int16_t> (mSamples);
+    }
     /// Convenience utility to pack the start time
     void packStartTime()
     {
@@ -50,7 +58,7 @@ public:
         packShort(mStartTime.getHour(),      mHeader.data()+160, mSwapBytes);
         packShort(mStartTime.getMinute(),    mHeader.data()+162, mSwapBytes);
         packShort(mStartTime.getSecond(),    mHeader.data()+164, mSwapBytes);
-        packShort(mTimeBasisCode,            mHeader.data()+168, mSwapBytes);
+        packShort(mTimeBasisCode,            mHeader.data()+166, mSwapBytes);
     }
 //private:
     std::array<char, 240> mHeader{};
@@ -206,9 +214,10 @@ void TraceHeader::setNumberOfSamples(const int nSamples)
         throw std::invalid_argument("nSamples = " + std::to_string(nSamples)
                                   + " cannot be negative\n");
     }
-    packShort(nSamples, pImpl->mHeader.data()+114, pImpl->mSwapBytes);
-    packInt(nSamples,   pImpl->mHeader.data()+232, pImpl->mSwapBytes);
     pImpl->mSamples = nSamples;
+    packShort(pImpl->getSamples16(), pImpl->mHeader.data()+114,
+              pImpl->mSwapBytes);
+    packInt(nSamples,   pImpl->mHeader.data()+232, pImpl->mSwapBytes);
 }
 
 int TraceHeader::getNumberOfSamples() const
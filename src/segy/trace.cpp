@@ -0,0 +1,288 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <array>
+#include <algorithm>
+#include "sff/segy/trace.hpp"
+#include "sff/utilities/alignedBuffer.hpp"
+#include "private/copyTo.hpp"
+
+using namespace SFF::SEGY;
+
+class Trace::TraceImpl
+{
+public:
+    void clear() noexcept
+    {
+        mData32f.clear();
+        mData32i.clear();
+        std::fill(mHeader.begin(), mHeader.end(), 0);
+        mStartTime = SFF::Utilities::Time();
+        mSamplingPeriod = 0;
+        mTraceNumber = 0;
+        mFormat = SampleFormat::IEEE_FLOAT32;
+        mPrecision = SFF::Precision::FLOAT32;
+    }
+    SFF::Utilities::AlignedBuffer<float> mData32f;
+    SFF::Utilities::AlignedBuffer<int> mData32i;
+    std::array<char, 240> mHeader{};
+    SFF::Utilities::Time mStartTime;
+    double mSamplingPeriod = 0;
+    int mTraceNumber = 0;
+    SampleFormat mFormat = SampleFormat::IEEE_FLOAT32;
+    SFF::Precision mPrecision = SFF::Precision::FLOAT32;
+};
+
+namespace
+{
+template<typename T>
+void copyTraceTo(const Trace &trace, std::span<T> x, const size_t stride,
+                 const size_t offset = 0,
+                 const size_t count = std::dynamic_extent)
+{
+    if (trace.getPrecision() == SFF::Precision::INT32)
+    {
+        copyToStrided(trace.getDataSpan32i(), x, stride, offset, count);
+    }
+    else
+    {
+        copyToStrided(trace.getDataSpan32f(), x, stride, offset, count);
+    }
+}
+
+template<typename T>
+void getTraceData(const Trace &trace, const int nSamples, T *xIn[])
+{
+    auto nSamplesRef = trace.getNumberOfSamples();
+    if (nSamples != nSamplesRef)
+    {
+        throw std::invalid_argument("nSamples = " + std::to_string(nSamples)
+                                  + " must equal " + std::to_string(nSamplesRef)
+                                  + "\n");
+    }
+    if (nSamples == 0){return;}
+    auto x = *xIn;
+    if (x == nullptr){throw std::invalid_argument("x is NULL\n");}
+    copyTraceTo(trace, std::span<T> (x, static_cast<size_t> (nSamples)), 1);
+}
+}
+
+/// Constructor
+Trace::Trace() :
+    pImpl(std::make_unique<TraceImpl> ())
+{
+}
+
+/// Copy c'tor
+Trace::Trace(const Trace &trace)
+{
+    *this = trace;
+}
+
+/// Move c'tor
+Trace::Trace(Trace &&trace) noexcept
+{
+    *this = std::move(trace);
+}
+
+/// Copy assignment operator
+Trace& Trace::operator=(const Trace &trace)
+{
+    if (&trace == this){return *this;}
+    pImpl = std::make_unique<TraceImpl> (*trace.pImpl);
+    return *this;
+}
+
+/// Move assignment operator
+Trace& Trace::operator=(Trace &&trace) noexcept
+{
+    if (&trace == this){return *this;}
+    pImpl = std::move(trace.pImpl);
+    return *this;
+}
+
+/// Destructor
+Trace::~Trace() = default;
+
+/// Clears the class
+void Trace::clear() noexcept
+{
+    pImpl->clear();
+}
+
+/// Trace header
+void Trace::setTraceHeader(const char header[240])
+{
+    if (header == nullptr){throw std::invalid_argument("header is NULL\n");}
+    std::copy(header, header + 240, pImpl->mHeader.begin());
+}
+
+std::string Trace::getTraceHeader() const noexcept
+{
+    return std::string(pImpl->mHeader.data(), pImpl->mHeader.size());
+}
+
+/// Trace number
+void Trace::setTraceNumber(const int traceNumber) noexcept
+{
+    pImpl->mTraceNumber = traceNumber;
+}
+
+int Trace::getTraceNumber() const noexcept
+{
+    return pImpl->mTraceNumber;
+}
+
+/// Sample format
+void Trace::setSampleFormat(const SampleFormat format) noexcept
+{
+    pImpl->mFormat = format;
+}
+
+SampleFormat Trace::getSampleFormat() const noexcept
+{
+    return pImpl->mFormat;
+}
+
+/// Sets the data
+void Trace::setData(const int nSamples, const float x[])
+{
+    if (nSamples < 0)
+    {
+        throw std::invalid_argument("Number of samples = "
+                                  + std::to_string(nSamples)
+                                  + " must be positive\n");
+    }
+    if (nSamples > 0 && x == nullptr)
+    {
+        throw std::invalid_argument("x is NULL\n");
+    }
+    pImpl->mData32i.clear();
+    pImpl->mData32f.resize(nSamples);
+    pImpl->mPrecision = SFF::Precision::FLOAT32;
+    std::copy(x, x + nSamples, pImpl->mData32f.data());
+}
+
+void Trace::setData(const int nSamples, const int x[])
+{
+    if (nSamples < 0)
+    {
+        throw std::invalid_argument("Number of samples = "
+                                  + std::to_string(nSamples)
+                                  + " must be positive\n");
+    }
+    if (nSamples > 0 && x == nullptr)
+    {
+        throw std::invalid_argument("x is NULL\n");
+    }
+    pImpl->mData32f.clear();
+    pImpl->mData32i.resize(nSamples);
+    pImpl->mPrecision = SFF::Precision::INT32;
+    std::copy(x, x + nSamples, pImpl->mData32i.data());
+}
+
+/// Gets the data
+void Trace::getData(const int nSamples, double *x[]) const
+{
+    getTraceData(*this, nSamples, x);
+}
+
+void Trace::getData(const int nSamples, float *x[]) const
+{
+    getTraceData(*this, nSamples, x);
+}
+
+/// Views of the data
+std::span<const float> Trace::getDataSpan32f() const
+{
+    if (pImpl->mPrecision != SFF::Precision::FLOAT32)
+    {
+        throw std::runtime_error("Precision is not FLOAT32\n");
+    }
+    return pImpl->mData32f.getSpan();
+}
+
+std::span<const int> Trace::getDataSpan32i() const
+{
+    if (pImpl->mPrecision != SFF::Precision::INT32)
+    {
+        throw std::runtime_error("Precision is not INT32\n");
+    }
+    return pImpl->mData32i.getSpan();
+}
+
+std::span<const double> Trace::getDataSpan64f() const
+{
+    throw std::runtime_error("Precision is not FLOAT64\n");
+}
+
+/// Strided copies
+void Trace::copyTo(std::span<double> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyTraceTo(*this, x, stride, offset, count);
+}
+
+void Trace::copyTo(std::span<float> x, const size_t stride,
+                   const size_t offset, const size_t count) const
+{
+    copyTraceTo(*this, x, stride, offset, count);
+}
+
+/// Precision
+SFF::Precision Trace::getPrecision() const noexcept
+{
+    return pImpl->mPrecision;
+}
+
+/// Number of samples
+int Trace::getNumberOfSamples() const noexcept
+{
+    if (pImpl->mPrecision == SFF::Precision::INT32)
+    {
+        return static_cast<int> (pImpl->mData32i.size());
+    }
+    return static_cast<int> (pImpl->mData32f.size());
+}
+
+/// Sampling period
+void Trace::setSamplingPeriod(const double dt)
+{
+    if (dt <= 0)
+    {
+        throw std::invalid_argument("dt = " + std::to_string(dt)
+                                  + " must be positive\n");
+    }
+    pImpl->mSamplingPeriod = dt;
+}
+
+double Trace::getSamplingPeriod() const
+{
+    if (pImpl->mSamplingPeriod <= 0)
+    {
+        throw std::runtime_error("Sampling period not set\n");
+    }
+    return pImpl->mSamplingPeriod;
+}
+
+double Trace::getSamplingRate() const
+{
+    return 1/getSamplingPeriod();
+}
+
+/// Start time
+void Trace::setStartTime(const SFF::Utilities::Time &time)
+{
+    pImpl->mStartTime = time;
+}
+
+SFF::Utilities::Time Trace::getStartTime() const
+{
+    return pImpl->mStartTime;
+}
+
+/// Format
+SFF::Format Trace::getFormat() const noexcept
+{
+    return SFF::Format::SEGY;
+}
@@ -0,0 +1,631 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "sff/segy/traceGroup.hpp"
+#include "sff/segy/trace.hpp"
+#include "sff/segy/textualFileHeader.hpp"
+#include "sff/utilities/alignedBuffer.hpp"
+#include "sff/utilities/time.hpp"
+#include "private/byteSwap.hpp"
+#include "private/fileIO.hpp"
+#include "private/instrumentation.hpp"
+
+using namespace SFF::SEGY;
+
+namespace
+{
+
+/// The rev2 integer constant at bytes 3297-3300 used to detect byte order
+constexpr int32_t BYTE_ORDER_CONSTANT = 16909060; // 0x01020304
+
+/// The size of a sample on disk in bytes
+int getBytesPerSample(const SampleFormat format)
+{
+    if (format == SampleFormat::INT16){return 2;}
+    if (format == SampleFormat::INT8){return 1;}
+    return 4;
+}
+
+/// Converts an IBM hexadecimal float to an IEEE float.  The 24-bit
+/// fraction is exact in a double and scaling by a power of 16 is exact so
+/// the only rounding is the narrowing to float; overflow and underflow
+/// become infinity and (sub)normals.  This is branch free so the loops
+/// below vectorize.
+#pragma omp declare simd
+[[nodiscard]] inline float ibmToIEEE(const uint32_t ibm)
+{
+    auto fraction = static_cast<double> (ibm & 0x00ffffffU);
+    // value = fraction*16^(exponent - 64)*2^-24
+    auto exponent = static_cast<uint64_t> ((ibm >> 24) & 0x7fU);
+    auto scale = std::bit_cast<double> ((4*exponent - 280 + 1023) << 52);
+    auto value = static_cast<float> (fraction*scale);
+    return (ibm & 0x80000000U) ? -value : value;
+}
+
+/// Loads a sample and optionally reverses its bytes.  Unlike the union
+/// based unpack functions this compiles to vector loads and shuffles.
+template<typename T, bool Swap>
+[[nodiscard]] inline T loadSample(const char *c) noexcept
+{
+    T value;
+    std::memcpy(&value, c, sizeof(T));
+    if constexpr (Swap)
+    {
+        if constexpr (sizeof(T) == 4)
+        {
+            value = std::bit_cast<T> (__builtin_bswap32(
+                        std::bit_cast<uint32_t> (value)));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            value = std::bit_cast<T> (__builtin_bswap16(
+                        std::bit_cast<uint16_t> (value)));
+        }
+    }
+    return value;
+}
+
+/// Decodes floating-point samples to y and integer samples to yi
+template<bool Swap>
+void decodeSamples(const char *bytes, const int nSamples,
+                   const SampleFormat format, float *y, int *yi)
+{
+    if (format == SampleFormat::IBM_FLOAT32)
+    {
+        #pragma omp simd
+        for (int i = 0; i < nSamples; ++i)
+        {
+            y[i] = ibmToIEEE(loadSample<uint32_t, Swap> (bytes + 4*i));
+        }
+    }
+    else if (format == SampleFormat::IEEE_FLOAT32)
+    {
+        #pragma omp simd
+        for (int i = 0; i < nSamples; ++i)
+        {
+            y[i] = loadSample<float, Swap> (bytes + 4*i);
+        }
+    }
+    else if (format == SampleFormat::INT32)
+    {
+        #pragma omp simd
+        for (int i = 0; i < nSamples; ++i)
+        {
+            yi[i] = loadSample<int32_t, Swap> (bytes + 4*i);
+        }
+    }
+    else if (format == SampleFormat::INT16)
+    {
+        #pragma omp simd
+        for (int i = 0; i < nSamples; ++i)
+        {
+            yi[i] = loadSample<int16_t, Swap> (bytes + 2*i);
+        }
+    }
+    else
+    {
+        #pragma omp simd
+        for (int i = 0; i < nSamples; ++i)
+        {
+            yi[i] = loadSample<int8_t, Swap> (bytes + i);
+        }
+    }
+}
+
+/// Unpacks the samples following a trace header
+void unpackSamples(const char *bytes, const int nSamples,
+                   const SampleFormat format, const bool swap,
+                   Trace *trace)
+{
+    SFF_INSTRUMENT_SCOPE(SWAP);
+    bool isFloat = (format == SampleFormat::IBM_FLOAT32 ||
+                    format == SampleFormat::IEEE_FLOAT32);
+    SFF::Utilities::AlignedBuffer<float> work(isFloat ? nSamples : 0);
+    SFF::Utilities::AlignedBuffer<int> worki(isFloat ? 0 : nSamples);
+    if (swap)
+    {
+        SFF_INSTRUMENT_COUNT(BYTE_SWAPS, nSamples);
+        decodeSamples<true> (bytes, nSamples, format,
+                             work.data(), worki.data());
+    }
+    else
+    {
+        decodeSamples<false> (bytes, nSamples, format,
+                              work.data(), worki.data());
+    }
+    if (isFloat)
+    {
+        trace->setData(nSamples, work.data());
+    }
+    else
+    {
+        trace->setData(nSamples, worki.data());
+    }
+    trace->setSampleFormat(format);
+}
+
+/// Unpacks the trace's start time.  Invalid times yield the epoch.
+SFF::Utilities::Time unpackStartTime(const char header[240], const bool swap)
+{
+    SFF::Utilities::Time time(0.0);
+    auto year   = unpackShort(header + 156, swap);
+    auto jday   = unpackShort(header + 158, swap);
+    auto hour   = unpackShort(header + 160, swap);
+    auto minute = unpackShort(header + 162, swap);
+    auto second = unpackShort(header + 164, swap);
+    if (year >= 1900 && jday >= 1 && jday <= 366 &&
+        hour >= 0 && hour < 24 && minute >= 0 && minute < 60 &&
+        second >= 0 && second < 60)
+    {
+        time.setYear(year);
+        time.setDayOfYear(jday);
+        time.setHour(hour);
+        time.setMinute(minute);
+        time.setSecond(second);
+    }
+    return time;
+}
+
+}
+
+class TraceGroup::TraceGroupImpl
+{
+public:
+    TraceGroupImpl() = default;
+    TraceGroupImpl(const TraceGroupImpl &impl)
+    {
+        *this = impl;
+    }
+    TraceGroupImpl& operator=(const TraceGroupImpl &impl)
+    {
+        if (&impl == this){return *this;}
+        close();
+        mFileName = impl.mFileName;
+        mTextualFileHeader = impl.mTextualFileHeader;
+        mOffsets = impl.mOffsets;
+        mSamples = impl.mSamples;
+        mFileSize = impl.mFileSize;
+        mSampleInterval = impl.mSampleInterval;
+        mFormat = impl.mFormat;
+        mRevision = impl.mRevision;
+        mSwapBytes = impl.mSwapBytes;
+        mBigEndian = impl.mBigEndian;
+        mBytes = impl.mBytes;
+        // Share the file but not the descriptor
+        if (impl.mDescriptor >= 0)
+        {
+            mDescriptor = ::dup(impl.mDescriptor);
+            if (mDescriptor < 0)
+            {
+                throw std::runtime_error("Failed to duplicate descriptor for "
+                                       + mFileName);
+            }
+        }
+        return *this;
+    }
+    ~TraceGroupImpl()
+    {
+        close();
+    }
+    void close() noexcept
+    {
+        if (mDescriptor >= 0){::close(mDescriptor);}
+        mDescriptor =-1;
+    }
+    void clear() noexcept
+    {
+        close();
+        mBytes.reset();
+        mFileName.clear();
+        mTextualFileHeader.clear();
+        mOffsets.clear();
+        mSamples.clear();
+        mFileSize = 0;
+        mSampleInterval = 0;
+        mFormat = SampleFormat::IEEE_FLOAT32;
+        mRevision = 0;
+        mSwapBytes = testByteOrder() == LITTLE_ENDIAN;
+        mBigEndian = true;
+    }
+    /// Unpacks the trace header and samples
+    void unpack(const char *bytes, const int nSamples, Trace *trace) const
+    {
+        trace->setTraceHeader(bytes);
+        trace->setTraceNumber(unpackInt(bytes, mSwapBytes));
+        auto sampleInterval
+            = static_cast<uint16_t> (unpackShort(bytes + 116, mSwapBytes));
+        if (sampleInterval == 0){sampleInterval = mSampleInterval;}
+        if (sampleInterval > 0)
+        {
+            trace->setSamplingPeriod(sampleInterval*1.e-6);
+        }
+        trace->setStartTime(unpackStartTime(bytes, mSwapBytes));
+        unpackSamples(bytes + 240, nSamples, mFormat, mSwapBytes, trace);
+        SFF_INSTRUMENT_COUNT(RECORDS_DECODED, 1);
+    }
+    /// True if a file is open or the contents of a file were set
+    [[nodiscard]] bool isOpen() const noexcept
+    {
+        return mDescriptor >= 0 || mBytes != nullptr;
+    }
+    /// Reads exactly nBytes starting at the given offset from the file or
+    /// the buffered contents
+    void read(char *buffer, const size_t nBytes, const int64_t offset) const
+    {
+        if (mBytes)
+        {
+            if (offset < 0 ||
+                static_cast<size_t> (offset) + nBytes > mBytes->size())
+            {
+                throw std::runtime_error("Unexpected end of buffer");
+            }
+            std::copy(mBytes->data() + offset,
+                      mBytes->data() + offset + nBytes, buffer);
+            return;
+        }
+        preadAll(mDescriptor, buffer, nBytes, offset, mFileName);
+        SFF_INSTRUMENT_COUNT(BYTES_READ, nBytes);
+    }
+    /// Reads the file headers and indexes the traces
+    void index(int64_t fileSize);
+    void checkIndex(const int64_t index) const
+    {
+        if (index < 0 || index >= static_cast<int64_t> (mOffsets.size()))
+        {
+            throw std::invalid_argument("index = " + std::to_string(index)
+                                      + " must be in range [0,"
+                                      + std::to_string(mOffsets.size())
+                                      + "-1]");
+        }
+    }
+    std::string mFileName;
+    // The contents of the file when they were set from memory.  This is
+    // shared by copies.
+    std::shared_ptr<const std::vector<char>> mBytes;
+    TextualFileHeader mTextualFileHeader;
+    std::vector<int64_t> mOffsets;
+    std::vector<int> mSamples;
+    int64_t mFileSize = 0;
+    int mDescriptor =-1;
+    int mSampleInterval = 0;
+    SampleFormat mFormat = SampleFormat::IEEE_FLOAT32;
+    int mRevision = 0;
+    bool mSwapBytes = testByteOrder() == LITTLE_ENDIAN;
+    bool mBigEndian = true;
+};
+
+/// Constructor
+TraceGroup::TraceGroup() :
+    pImpl(std::make_unique<TraceGroupImpl> ())
+{
+}
+
+/// Copy c'tor
+TraceGroup::TraceGroup(const TraceGroup &group)
+{
+    *this = group;
+}
+
+/// Move c'tor
+TraceGroup::TraceGroup(TraceGroup &&group) noexcept
+{
+    *this = std::move(group);
+}
+
+/// Copy assignment
+TraceGroup& TraceGroup::operator=(const TraceGroup &group)
+{
+    if (&group == this){return *this;}
+    pImpl = std::make_unique<TraceGroupImpl> (*group.pImpl);
+    return *this;
+}
+
+/// Move assignment
+TraceGroup& TraceGroup::operator=(TraceGroup &&group) noexcept
+{
+    if (&group == this){return *this;}
+    pImpl = std::move(group.pImpl);
+    return *this;
+}
+
+/// Destructor
+TraceGroup::~TraceGroup() = default;
+
+/// Clears the class
+void TraceGroup::clear() noexcept
+{
+    pImpl->clear();
+}
+
+/// Opens the file and indexes the traces
+void TraceGroup::open(const std::string &fileName)
+{
+    clear();
+    SFF_INSTRUMENT_SCOPE(READ);
+    auto fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::invalid_argument("SEGY file = " + fileName
+                                  + " could not be opened");
+    }
+    pImpl->mDescriptor = fd;
+    pImpl->mFileName = fileName;
+    try
+    {
+        struct stat status;
+        if (::fstat(fd, &status) != 0)
+        {
+            throw std::runtime_error("Failed to stat " + fileName);
+        }
+        pImpl->index(static_cast<int64_t> (status.st_size));
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
+
+/// Indexes the traces in a file that was read into memory
+void TraceGroup::set(const size_t nBytes, const char bytes[])
+{
+    clear();
+    if (bytes == nullptr){throw std::invalid_argument("bytes is NULL");}
+    SFF_INSTRUMENT_SCOPE(READ);
+    pImpl->mBytes
+        = std::make_shared<const std::vector<char>> (bytes, bytes + nBytes);
+    try
+    {
+        pImpl->index(static_cast<int64_t> (nBytes));
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
+
+/// Reads the file headers and indexes the traces
+void TraceGroup::TraceGroupImpl::index(const int64_t fileSize)
+{
+    if (fileSize < 3600)
+    {
+        throw std::invalid_argument("File must be at least 3600 bytes\n");
+    }
+    std::array<char, 3600> fileHeader;
+    read(fileHeader.data(), fileHeader.size(), 0);
+    // Textual header is EBCDIC unless it begins with an ASCII C
+    if (fileHeader[0] == 'C')
+    {
+        mTextualFileHeader.setASCII(fileHeader.data());
+    }
+    else
+    {
+        mTextualFileHeader.setEBCDIC(fileHeader.data());
+    }
+    // Binary header.  Files are big-endian unless rev2's byte order
+    // constant says otherwise.
+    const char *binary = fileHeader.data() + 3200;
+    auto nativeSwap = testByteOrder() == LITTLE_ENDIAN;
+    bool swap = nativeSwap;
+    if (unpackInt(binary + 96, nativeSwap) != BYTE_ORDER_CONSTANT &&
+        unpackInt(binary + 96, !nativeSwap) == BYTE_ORDER_CONSTANT)
+    {
+        swap = !nativeSwap;
+    }
+    mSwapBytes = swap;
+    mBigEndian = (swap == nativeSwap);
+    mRevision = static_cast<uint8_t> (binary[300]);
+    auto revision = mRevision;
+    auto formatCode = unpackShort(binary + 24, swap);
+    if (formatCode != 1 && formatCode != 2 && formatCode != 3 &&
+        formatCode != 5 && formatCode != 8)
+    {
+        throw std::invalid_argument("Sample format code "
+                                  + std::to_string(formatCode)
+                                  + " not supported\n");
+    }
+    mFormat = static_cast<SampleFormat> (formatCode);
+    mSampleInterval
+        = static_cast<uint16_t> (unpackShort(binary + 16, swap));
+    int nSamples = static_cast<uint16_t> (unpackShort(binary + 20, swap));
+    if (revision >= 2 && unpackInt(binary + 68, swap) > 0)
+    {
+        nSamples = unpackInt(binary + 68, swap);
+    }
+    bool fixedLength = false;
+    int nExtendedHeaders = 0;
+    if (revision >= 1)
+    {
+        fixedLength = unpackShort(binary + 302, swap) == 1;
+        nExtendedHeaders = unpackShort(binary + 304, swap);
+        if (nExtendedHeaders < 0)
+        {
+            throw std::invalid_argument(
+                "Variable number of extended textual headers not supported\n");
+        }
+    }
+    auto firstTraceOffset = 3600 + 3200*static_cast<int64_t> (nExtendedHeaders);
+    if (revision >= 2)
+    {
+        if (unpackInt(binary + 306, swap) > 0)
+        {
+            throw std::invalid_argument(
+                "Additional trace headers not supported\n");
+        }
+        auto offset = unpackLong(binary + 320, swap);
+        if (offset > 0){firstTraceOffset = offset;}
+    }
+    if (firstTraceOffset > fileSize)
+    {
+        throw std::invalid_argument("File is truncated\n");
+    }
+    // Index the traces
+    SFF_INSTRUMENT_SCOPE(HEADER);
+    auto bytesPerSample = getBytesPerSample(mFormat);
+    if (fixedLength)
+    {
+        if (nSamples < 1)
+        {
+            throw std::invalid_argument(
+                "Fixed length traces require samples per trace\n");
+        }
+        auto traceLength = 240 + bytesPerSample*static_cast<int64_t> (nSamples);
+        auto nBytes = fileSize - firstTraceOffset;
+        if (nBytes%traceLength != 0)
+        {
+            throw std::invalid_argument("File size is incorrect\n");
+        }
+        auto nTraces = nBytes/traceLength;
+        mOffsets.resize(nTraces);
+        mSamples.resize(nTraces, nSamples);
+        for (int64_t i = 0; i < nTraces; ++i)
+        {
+            mOffsets[i] = firstTraceOffset + i*traceLength;
+        }
+    }
+    else
+    {
+        std::array<char, 240> traceHeader;
+        auto offset = firstTraceOffset;
+        while (offset < fileSize)
+        {
+            if (fileSize - offset < 240)
+            {
+                throw std::invalid_argument("Trace header "
+                                  + std::to_string(mOffsets.size())
+                                  + " is truncated\n");
+            }
+            read(traceHeader.data(), traceHeader.size(), offset);
+            int nTraceSamples = static_cast<uint16_t>
+                                (unpackShort(traceHeader.data() + 114, swap));
+            if (nTraceSamples == 0){nTraceSamples = nSamples;}
+            auto traceLength = 240
+                + bytesPerSample*static_cast<int64_t> (nTraceSamples);
+            if (offset + traceLength > fileSize)
+            {
+                throw std::invalid_argument("Trace "
+                                  + std::to_string(mOffsets.size())
+                                  + " is truncated\n");
+            }
+            mOffsets.push_back(offset);
+            mSamples.push_back(nTraceSamples);
+            offset = offset + traceLength;
+        }
+    }
+    mFileSize = fileSize;
+}
+
+/// Is the file open?
+bool TraceGroup::isOpen() const noexcept
+{
+    return pImpl->isOpen();
+}
+
+/// Reads a trace
+Trace TraceGroup::getTrace(const int64_t index) const
+{
+    if (!isOpen()){throw std::runtime_error("File not open");}
+    pImpl->checkIndex(index);
+    SFF_INSTRUMENT_SCOPE(READ);
+    auto nSamples = pImpl->mSamples[index];
+    Trace trace;
+    // Buffered contents were checked while indexing
+    if (pImpl->mBytes)
+    {
+        pImpl->unpack(pImpl->mBytes->data() + pImpl->mOffsets[index],
+                      nSamples, &trace);
+        return trace;
+    }
+    auto traceLength = 240
+                     + static_cast<size_t> (getBytesPerSample(pImpl->mFormat))
+                      *static_cast<size_t> (nSamples);
+    std::vector<char> bytes(traceLength);
+    pImpl->read(bytes.data(), bytes.size(), pImpl->mOffsets[index]);
+    pImpl->unpack(bytes.data(), nSamples, &trace);
+    return trace;
+}
+
+/// Reads all the traces
+std::vector<Trace> TraceGroup::getTraces() const
+{
+    if (!isOpen()){throw std::runtime_error("File not open");}
+    std::vector<Trace> traces(pImpl->mOffsets.size());
+    if (traces.empty()){return traces;}
+    SFF_INSTRUMENT_SCOPE(READ);
+    if (pImpl->mBytes)
+    {
+        for (size_t i = 0; i < traces.size(); ++i)
+        {
+            pImpl->unpack(pImpl->mBytes->data() + pImpl->mOffsets[i],
+                          pImpl->mSamples[i], &traces[i]);
+        }
+        return traces;
+    }
+    auto firstOffset = pImpl->mOffsets.front();
+    std::vector<char> bytes(static_cast<size_t> (pImpl->mFileSize - firstOffset));
+    pImpl->read(bytes.data(), bytes.size(), firstOffset);
+    for (size_t i = 0; i < traces.size(); ++i)
+    {
+        pImpl->unpack(bytes.data() + (pImpl->mOffsets[i] - firstOffset),
+                      pImpl->mSamples[i], &traces[i]);
+    }
+    return traces;
+}
+
+/// Textual file header
+TextualFileHeader TraceGroup::getTextualFileHeader() const
+{
+    if (!isOpen()){throw std::runtime_error("File not open");}
+    return pImpl->mTextualFileHeader;
+}
+
+/// Number of traces
+int64_t TraceGroup::getNumberOfTraces() const noexcept
+{
+    return static_cast<int64_t> (pImpl->mOffsets.size());
+}
+
+/// Number of samples in a trace
+int TraceGroup::getNumberOfSamples(const int64_t index) const
+{
+    pImpl->checkIndex(index);
+    return pImpl->mSamples[index];
+}
+
+/// Byte offset of a trace
+int64_t TraceGroup::getTraceOffset(const int64_t index) const
+{
+    pImpl->checkIndex(index);
+    return pImpl->mOffsets[index];
+}
+
+/// Sample format
+SampleFormat TraceGroup::getSampleFormat() const
+{
+    if (!isOpen()){throw std::runtime_error("File not open");}
+    return pImpl->mFormat;
+}
+
+/// Revision
+int TraceGroup::getRevision() const noexcept
+{
+    return pImpl->mRevision;
+}
+
+/// Byte order
+bool TraceGroup::isBigEndian() const noexcept
+{
+    return pImpl->mBigEndian;
+}
@@ -0,0 +1,621 @@
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <condition_variable>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#if __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+ #include <linux/io_uring.h>
+ #include <sys/mman.h>
+ #include <sys/syscall.h>
+ #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+  #define USE_IO_URING 1
+ #endif
+#endif
+#include "sff/utilities/asyncReader.hpp"
+
+using namespace SFF::Utilities;
+
+namespace
+{
+
+/// Runs tasks on a fixed set of threads.  The destructor finishes all
+/// queued tasks before joining.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(const int nThreads)
+    {
+        for (int i = 0; i < nThreads; ++i)
+        {
+            mThreads.emplace_back([this]() {run();});
+        }
+    }
+    void post(std::function<void ()> task)
+    {
+        {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTasks.push(std::move(task));
+        }
+        mConditionVariable.notify_one();
+    }
+    ~ThreadPool()
+    {
+        {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+        }
+        mConditionVariable.notify_all();
+        for (auto &thread : mThreads){thread.join();}
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool& operator=(const ThreadPool &) = delete;
+private:
+    void run()
+    {
+        while (true)
+        {
+            std::function<void ()> task;
+            {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mConditionVariable.wait(lock,
+                                    [this]() {return mStop || !mTasks.empty();});
+            if (mTasks.empty()){return;}
+            task = std::move(mTasks.front());
+            mTasks.pop();
+            }
+            task();
+        }
+    }
+    std::mutex mMutex;
+    std::condition_variable mConditionVariable;
+    std::queue<std::function<void ()>> mTasks;
+    std::vector<std::thread> mThreads;
+    bool mStop = false;
+};
+
+/// A file being read
+struct Request
+{
+    std::string fileName;
+    AsyncReader::Callback callback;
+    std::vector<char> bytes;
+    std::exception_ptr error{nullptr};
+    size_t offset = 0;
+    int fd = -1;
+    struct iovec iov{};
+};
+
+/// Opens a file and sizes the buffer
+void openFile(Request &request)
+{
+    request.fd = ::open(request.fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (request.fd < 0)
+    {
+        throw std::invalid_argument("Could not open " + request.fileName
+                                  + ": " + std::strerror(errno));
+    }
+    struct stat status{};
+    if (::fstat(request.fd, &status) != 0)
+    {
+        throw std::runtime_error("Could not stat " + request.fileName
+                               + ": " + std::strerror(errno));
+    }
+    request.bytes.resize(static_cast<size_t> (status.st_size));
+}
+
+void closeFile(Request &request) noexcept
+{
+    if (request.fd >= 0){::close(request.fd);}
+    request.fd = -1;
+}
+
+/// Blocking read of the remainder of the file
+void preadFile(Request &request)
+{
+    while (request.offset < request.bytes.size())
+    {
+        auto nRead = ::pread(request.fd,
+                             request.bytes.data() + request.offset,
+                             request.bytes.size() - request.offset,
+                             static_cast<off_t> (request.offset));
+        if (nRead < 0)
+        {
+            if (errno == EINTR){continue;}
+            throw std::runtime_error("Failed to read " + request.fileName
+                                   + ": " + std::strerror(errno));
+        }
+        if (nRead == 0)
+        {
+            throw std::runtime_error("Unexpected end of file in "
+                                   + request.fileName);
+        }
+        request.offset = request.offset + static_cast<size_t> (nRead);
+    }
+}
+
+#ifdef USE_IO_URING
+/// A minimal io_uring built directly on the system calls so that liburing
+/// is not required.
+class IOUring
+{
+public:
+    explicit IOUring(const unsigned int nEntries)
+    {
+        struct io_uring_params parameters{};
+        mFileDescriptor = static_cast<int> (
+            ::syscall(__NR_io_uring_setup, nEntries, &parameters));
+        if (mFileDescriptor < 0)
+        {
+            throw std::runtime_error("io_uring_setup failed: "
+                                   + std::string(std::strerror(errno)));
+        }
+        mSubmissionRingSize = parameters.sq_off.array
+                            + parameters.sq_entries*sizeof(unsigned int);
+        mCompletionRingSize = parameters.cq_off.cqes
+                            + parameters.cq_entries
+                             *sizeof(struct io_uring_cqe);
+        bool singleMap = (parameters.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap)
+        {
+            mSubmissionRingSize = std::max(mSubmissionRingSize,
+                                           mCompletionRingSize);
+            mCompletionRingSize = mSubmissionRingSize;
+        }
+        mSubmissionRing = ::mmap(nullptr, mSubmissionRingSize,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE,
+                                 mFileDescriptor, IORING_OFF_SQ_RING);
+        if (mSubmissionRing == MAP_FAILED)
+        {
+            ::close(mFileDescriptor);
+            throw std::runtime_error("Failed to map submission ring");
+        }
+        mCompletionRing = mSubmissionRing;
+        if (!singleMap)
+        {
+            mCompletionRing = ::mmap(nullptr, mCompletionRingSize,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     mFileDescriptor, IORING_OFF_CQ_RING);
+            if (mCompletionRing == MAP_FAILED)
+            {
+                ::munmap(mSubmissionRing, mSubmissionRingSize);
+                ::close(mFileDescriptor);
+                throw std::runtime_error("Failed to map completion ring");
+            }
+        }
+        mSubmissionEntriesSize = parameters.sq_entries
+                                *sizeof(struct io_uring_sqe);
+        auto entries = ::mmap(nullptr, mSubmissionEntriesSize,
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE,
+                              mFileDescriptor, IORING_OFF_SQES);
+        if (entries == MAP_FAILED)
+        {
+            unmapRings();
+            ::close(mFileDescriptor);
+            throw std::runtime_error("Failed to map submission entries");
+        }
+        mSubmissionEntries = static_cast<struct io_uring_sqe *> (entries);
+        auto sq = static_cast<char *> (mSubmissionRing);
+        mSubmissionHead = reinterpret_cast<unsigned int *> (
+            sq + parameters.sq_off.head);
+        mSubmissionTail = reinterpret_cast<unsigned int *> (
+            sq + parameters.sq_off.tail);
+        mSubmissionMask = *reinterpret_cast<unsigned int *> (
+            sq + parameters.sq_off.ring_mask);
+        mSubmissionArray = reinterpret_cast<unsigned int *> (
+            sq + parameters.sq_off.array);
+        auto cq = static_cast<char *> (mCompletionRing);
+        mCompletionHead = reinterpret_cast<unsigned int *> (
+            cq + parameters.cq_off.head);
+        mCompletionTail = reinterpret_cast<unsigned int *> (
+            cq + parameters.cq_off.tail);
+        mCompletionMask = *reinterpret_cast<unsigned int *> (
+            cq + parameters.cq_off.ring_mask);
+        mCompletionEntries = reinterpret_cast<struct io_uring_cqe *> (
+            cq + parameters.cq_off.cqes);
+    }
+    ~IOUring()
+    {
+        ::munmap(mSubmissionEntries, mSubmissionEntriesSize);
+        unmapRings();
+        ::close(mFileDescriptor);
+    }
+    IOUring(const IOUring &) = delete;
+    IOUring& operator=(const IOUring &) = delete;
+    /// Queues a readv.  The caller guarantees there is space in the ring.
+    void queueRead(Request *request)
+    {
+        auto remaining = request->bytes.size() - request->offset;
+        request->iov.iov_base = request->bytes.data() + request->offset;
+        request->iov.iov_len = std::min(remaining, size_t {1} << 30);
+        auto tail = *mSubmissionTail;
+        auto index = tail & mSubmissionMask;
+        auto entry = &mSubmissionEntries[index];
+        std::memset(entry, 0, sizeof(struct io_uring_sqe));
+        entry->opcode = IORING_OP_READV;
+        entry->fd = request->fd;
+        entry->addr = reinterpret_cast<uint64_t> (&request->iov);
+        entry->len = 1;
+        entry->off = request->offset;
+        entry->user_data = reinterpret_cast<uint64_t> (request);
+        mSubmissionArray[index] = index;
+        std::atomic_ref<unsigned int> (*mSubmissionTail).store(
+            tail + 1, std::memory_order_release);
+        mToSubmit = mToSubmit + 1;
+    }
+    /// Submits queued reads and optionally waits for a completion
+    void submit(const bool wait)
+    {
+        unsigned int flags = wait ? IORING_ENTER_GETEVENTS : 0;
+        unsigned int minComplete = wait ? 1 : 0;
+        while (true)
+        {
+            auto result = ::syscall(__NR_io_uring_enter, mFileDescriptor,
+                                    mToSubmit, minComplete, flags,
+                                    nullptr, 0);
+            if (result >= 0)
+            {
+                mToSubmit = mToSubmit - static_cast<unsigned int> (result);
+                return;
+            }
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+            {
+                if (!wait){return;}
+                continue;
+            }
+            throw std::runtime_error("io_uring_enter failed: "
+                                   + std::string(std::strerror(errno)));
+        }
+    }
+    /// Processes completions
+    template<typename F>
+    void reap(F &&f)
+    {
+        auto head = std::atomic_ref<unsigned int> (*mCompletionHead).load(
+            std::memory_order_relaxed);
+        auto tail = std::atomic_ref<unsigned int> (*mCompletionTail).load(
+            std::memory_order_acquire);
+        while (head != tail)
+        {
+            const auto &entry = mCompletionEntries[head & mCompletionMask];
+            auto request = reinterpret_cast<Request *> (entry.user_data);
+            auto result = entry.res;
+            head = head + 1;
+            std::atomic_ref<unsigned int> (*mCompletionHead).store(
+                head, std::memory_order_release);
+            f(request, result);
+        }
+    }
+private:
+    void unmapRings() noexcept
+    {
+        if (mCompletionRing != mSubmissionRing)
+        {
+            ::munmap(mCompletionRing, mCompletionRingSize);
+        }
+        ::munmap(mSubmissionRing, mSubmissionRingSize);
+    }
+    void *mSubmissionRing{nullptr};
+    void *mCompletionRing{nullptr};
+    struct io_uring_sqe *mSubmissionEntries{nullptr};
+    struct io_uring_cqe *mCompletionEntries{nullptr};
+    unsigned int *mSubmissionHead{nullptr};
+    unsigned int *mSubmissionTail{nullptr};
+    unsigned int *mSubmissionArray{nullptr};
+    unsigned int *mCompletionHead{nullptr};
+    unsigned int *mCompletionTail{nullptr};
+    size_t mSubmissionRingSize{0};
+    size_t mCompletionRingSize{0};
+    size_t mSubmissionEntriesSize{0};
+    unsigned int mSubmissionMask{0};
+    unsigned int mCompletionMask{0};
+    unsigned int mToSubmit{0};
+    int mFileDescriptor{-1};
+};
+#endif
+
+}
+
+class AsyncReader::AsyncReaderImpl
+{
+public:
+    /// Hands the result to a worker
+    void complete(std::unique_ptr<Request> request)
+    {
+        closeFile(*request);
+        std::shared_ptr<Request> finished(std::move(request));
+        mWorkers->post([this, finished]()
+        {
+            try
+            {
+                finished->callback(std::move(finished->bytes),
+                                   finished->error);
+            }
+            catch (...)
+            {
+                // Callbacks are not allowed to throw
+            }
+            std::lock_guard<std::mutex> lock(mOutstandingMutex);
+            mOutstanding = mOutstanding - 1;
+            if (mOutstanding == 0){mOutstandingConditionVariable.notify_all();}
+        });
+    }
+    /// Blocking read on an I/O thread
+    void readWithThreadPool(std::unique_ptr<Request> request)
+    {
+        try
+        {
+            openFile(*request);
+            preadFile(*request);
+        }
+        catch (...)
+        {
+            request->error = std::current_exception();
+            request->bytes.clear();
+        }
+        complete(std::move(request));
+    }
+#ifdef USE_IO_URING
+    /// Owns the ring; admits requests up to the queue depth and reaps
+    /// completions.
+    void runRing()
+    {
+        int nInFlight = 0;
+        std::vector<std::unique_ptr<Request>> admitted;
+        while (true)
+        {
+            {
+            std::unique_lock<std::mutex> lock(mQueueMutex);
+            if (nInFlight == 0)
+            {
+                mQueueConditionVariable.wait(lock, [this]()
+                {
+                    return mStop || !mQueue.empty();
+                });
+                if (mQueue.empty()){return;} // Stopping with nothing to do
+            }
+            while (!mQueue.empty() && nInFlight < mQueueDepth)
+            {
+                admitted.push_back(std::move(mQueue.front()));
+                mQueue.pop_front();
+                nInFlight = nInFlight + 1;
+            }
+            }
+            for (auto &request : admitted)
+            {
+                try
+                {
+                    openFile(*request);
+                }
+                catch (...)
+                {
+                    request->error = std::current_exception();
+                    request->bytes.clear();
+                }
+                if (request->error || request->bytes.empty())
+                {
+                    nInFlight = nInFlight - 1;
+                    complete(std::move(request));
+                    continue;
+                }
+                mRing->queueRead(request.release());
+            }
+            admitted.clear();
+            mRing->submit(nInFlight > 0);
+            mRing->reap([&](Request *pointer, const int result)
+            {
+                if (result == -EINTR || result == -EAGAIN)
+                {
+                    mRing->queueRead(pointer);
+                    return;
+                }
+                std::unique_ptr<Request> request(pointer);
+                if (result <= 0)
+                {
+                    auto message = result < 0 ?
+                                   std::string(std::strerror(-result)) :
+                                   std::string("unexpected end of file");
+                    request->error = std::make_exception_ptr(
+                        std::runtime_error("Failed to read "
+                                         + request->fileName + ": "
+                                         + message));
+                    request->bytes.clear();
+                }
+                else
+                {
+                    request->offset = request->offset
+                                    + static_cast<size_t> (result);
+                    if (request->offset < request->bytes.size())
+                    {
+                        mRing->queueRead(request.release());
+                        return;
+                    }
+                }
+                nInFlight = nInFlight - 1;
+                complete(std::move(request));
+            });
+        }
+    }
+    std::unique_ptr<IOUring> mRing;
+#endif
+    std::unique_ptr<ThreadPool> mWorkers;
+    std::unique_ptr<ThreadPool> mIOThreads;
+    std::thread mRingThread;
+    std::mutex mQueueMutex;
+    std::condition_variable mQueueConditionVariable;
+    std::deque<std::unique_ptr<Request>> mQueue;
+    std::mutex mOutstandingMutex;
+    std::condition_variable mOutstandingConditionVariable;
+    int64_t mOutstanding = 0;
+    int mQueueDepth = 64;
+    Backend mBackend = Backend::THREAD_POOL;
+    bool mStop = false;
+};
+
+/// Constructor
+AsyncReader::AsyncReader(const int queueDepth, const int nWorkers,
+                         const Backend backend) :
+    pImpl(std::make_unique<AsyncReaderImpl> ())
+{
+    if (queueDepth < 1)
+    {
+        throw std::invalid_argument("Queue depth must be positive");
+    }
+    pImpl->mQueueDepth = queueDepth;
+    auto nThreads = nWorkers;
+    if (nThreads < 1)
+    {
+        nThreads = std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+    }
+    if (backend == Backend::IO_URING && !isIOUringAvailable())
+    {
+        throw std::runtime_error("io_uring is not available");
+    }
+    pImpl->mBackend = Backend::THREAD_POOL;
+#ifdef USE_IO_URING
+    if (backend != Backend::THREAD_POOL && isIOUringAvailable())
+    {
+        try
+        {
+            pImpl->mRing = std::make_unique<IOUring> (
+                static_cast<unsigned int> (queueDepth));
+            pImpl->mBackend = Backend::IO_URING;
+        }
+        catch (const std::exception &)
+        {
+            if (backend == Backend::IO_URING){throw;}
+        }
+    }
+#endif
+    pImpl->mWorkers = std::make_unique<ThreadPool> (nThreads);
+    if (pImpl->mBackend == Backend::THREAD_POOL)
+    {
+        pImpl->mIOThreads = std::make_unique<ThreadPool> (queueDepth);
+    }
+#ifdef USE_IO_URING
+    else
+    {
+        pImpl->mRingThread = std::thread([this]() {pImpl->runRing();});
+    }
+#endif
+}
+
+/// Destructor
+AsyncReader::~AsyncReader()
+{
+    wait();
+    {
+    std::lock_guard<std::mutex> lock(pImpl->mQueueMutex);
+    pImpl->mStop = true;
+    }
+    pImpl->mQueueConditionVariable.notify_all();
+    if (pImpl->mRingThread.joinable()){pImpl->mRingThread.join();}
+    pImpl->mIOThreads.reset();
+    pImpl->mWorkers.reset();
+}
+
+/// Read with a callback
+void AsyncReader::readFile(const std::string &fileName, Callback callback)
+{
+    if (!callback){throw std::invalid_argument("Callback is empty");}
+    auto request = std::make_unique<Request> ();
+    request->fileName = fileName;
+    request->callback = std::move(callback);
+    {
+    std::lock_guard<std::mutex> lock(pImpl->mOutstandingMutex);
+    pImpl->mOutstanding = pImpl->mOutstanding + 1;
+    }
+    if (pImpl->mBackend == Backend::THREAD_POOL)
+    {
+        std::shared_ptr<Request> pending(std::move(request));
+        pImpl->mIOThreads->post([this, pending]()
+        {
+            auto owned = std::make_unique<Request> (std::move(*pending));
+            pImpl->readWithThreadPool(std::move(owned));
+        });
+        return;
+    }
+    {
+    std::lock_guard<std::mutex> lock(pImpl->mQueueMutex);
+    pImpl->mQueue.push_back(std::move(request));
+    }
+    pImpl->mQueueConditionVariable.notify_one();
+}
+
+/// Read with a future
+std::future<std::vector<char>>
+AsyncReader::readFile(const std::string &fileName)
+{
+    auto promise = std::make_shared<std::promise<std::vector<char>>> ();
+    auto future = promise->get_future();
+    readFile(fileName,
+             [promise](std::vector<char> &&bytes, std::exception_ptr error)
+             {
+                 if (error)
+                 {
+                     promise->set_exception(error);
+                 }
+                 else
+                 {
+                     promise->set_value(std::move(bytes));
+                 }
+             });
+    return future;
+}
+
+/// Wait for everything to finish
+void AsyncReader::wait()
+{
+    std::unique_lock<std::mutex> lock(pImpl->mOutstandingMutex);
+    pImpl->mOutstandingConditionVariable.wait(lock, [this]()
+    {
+        return pImpl->mOutstanding == 0;
+    });
+}
+
+/// Backend
+AsyncReader::Backend AsyncReader::getBackend() const noexcept
+{
+    return pImpl->mBackend;
+}
+
+/// Queue depth
+int AsyncReader::getQueueDepth() const noexcept
+{
+    return pImpl->mQueueDepth;
+}
+
+/// Can the kernel do io_uring?
+bool AsyncReader::isIOUringAvailable() noexcept
+{
+#ifdef USE_IO_URING
+    static const bool available = []()
+    {
+        try
+        {
+            IOUring ring(1);
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
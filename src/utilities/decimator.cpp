@@ -0,0 +1,315 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+#include "sff/utilities/decimator.hpp"
+
+using namespace SFF::Utilities;
+
+namespace
+{
+
+/// Designs a Hamming windowed sinc low-pass filter with unit gain at DC
+std::vector<double> designLowPass(const int factor)
+{
+    if (factor == 1){return std::vector<double> {1};}
+    // Pass 80 percent of the output band
+    auto nTaps = 20*factor + 1;
+    auto cutoff = 0.8*0.5/static_cast<double> (factor);
+    auto center = static_cast<double> (nTaps - 1)/2;
+    std::vector<double> taps(nTaps);
+    double sum = 0;
+    for (int i = 0; i < nTaps; ++i)
+    {
+        auto t = static_cast<double> (i) - center;
+        auto sinc = 2*cutoff;
+        if (t != 0)
+        {
+            sinc = std::sin(2*std::numbers::pi*cutoff*t)/(std::numbers::pi*t);
+        }
+        auto window = 0.54
+                    - 0.46*std::cos(2*std::numbers::pi*i/(nTaps - 1));
+        taps[i] = sinc*window;
+        sum = sum + taps[i];
+    }
+    for (auto &tap : taps){tap = tap/sum;}
+    return taps;
+}
+
+}
+
+class Decimator::DecimatorImpl
+{
+public:
+    void clear() noexcept
+    {
+        mTaps.clear();
+        mHistory.clear();
+        mPhase.clear();
+        mWork.clear();
+        mSum.clear();
+        mTapsDouble.clear();
+        mChannels = 0;
+        mFactor = 0;
+    }
+    void checkChannel(const int channel) const
+    {
+        if (channel < 0 || channel >= mChannels)
+        {
+            throw std::invalid_argument("channel = " + std::to_string(channel)
+                                      + " must be in [0,"
+                                      + std::to_string(mChannels - 1) + "]");
+        }
+    }
+    /// The taps in float precision
+    std::vector<float> mTaps;
+    /// The last nTaps - 1 input samples of each channel.  This is a row
+    /// major [nChannels x (nTaps - 1)] matrix.
+    std::vector<float> mHistory;
+    /// The input samples preceding the next output of each channel
+    std::vector<int> mPhase;
+    /// Workspace holding a block's history and input with the channels
+    /// contiguous, i.e., a row major [nTaps - 1 + nSamples x nChannels]
+    /// matrix
+    std::vector<float> mWork;
+    std::vector<float> mSum;
+    std::vector<double> mTapsDouble;
+    int mChannels = 0;
+    int mFactor = 0;
+};
+
+/// Constructors
+Decimator::Decimator() :
+    pImpl(std::make_unique<DecimatorImpl> ())
+{
+}
+
+Decimator::Decimator(const int nChannels, const int factor) :
+    pImpl(std::make_unique<DecimatorImpl> ())
+{
+    initialize(nChannels, factor);
+}
+
+/// Copy c'tor
+Decimator::Decimator(const Decimator &decimator)
+{
+    *this = decimator;
+}
+
+/// Move c'tor
+Decimator::Decimator(Decimator &&decimator) noexcept
+{
+    *this = std::move(decimator);
+}
+
+/// Copy assignment
+Decimator& Decimator::operator=(const Decimator &decimator)
+{
+    if (&decimator == this){return *this;}
+    pImpl = std::make_unique<DecimatorImpl> (*decimator.pImpl);
+    return *this;
+}
+
+/// Move assignment
+Decimator& Decimator::operator=(Decimator &&decimator) noexcept
+{
+    if (&decimator == this){return *this;}
+    pImpl = std::move(decimator.pImpl);
+    return *this;
+}
+
+/// Destructor
+Decimator::~Decimator() = default;
+
+/// Clears the class
+void Decimator::clear() noexcept
+{
+    pImpl->clear();
+}
+
+/// Initialize with the default filter
+void Decimator::initialize(const int nChannels, const int factor)
+{
+    if (factor < 1)
+    {
+        throw std::invalid_argument("factor = " + std::to_string(factor)
+                                  + " must be positive");
+    }
+    initialize(nChannels, factor, designLowPass(factor));
+}
+
+/// Initialize with the given filter
+void Decimator::initialize(const int nChannels, const int factor,
+                           const std::vector<double> &taps)
+{
+    if (nChannels < 1)
+    {
+        throw std::invalid_argument("nChannels = " + std::to_string(nChannels)
+                                  + " must be positive");
+    }
+    if (factor < 1)
+    {
+        throw std::invalid_argument("factor = " + std::to_string(factor)
+                                  + " must be positive");
+    }
+    if (taps.empty()){throw std::invalid_argument("No filter taps");}
+    clear();
+    pImpl->mChannels = nChannels;
+    pImpl->mFactor = factor;
+    pImpl->mTapsDouble = taps;
+    pImpl->mTaps.resize(taps.size());
+    std::transform(taps.begin(), taps.end(), pImpl->mTaps.begin(),
+                   [](const double tap){return static_cast<float> (tap);});
+    pImpl->mHistory.assign(static_cast<size_t> (nChannels)*(taps.size() - 1),
+                           0);
+    pImpl->mPhase.assign(nChannels, 0);
+}
+
+/// Initialized?
+bool Decimator::isInitialized() const noexcept
+{
+    return pImpl->mChannels > 0;
+}
+
+/// Number of channels
+int Decimator::getNumberOfChannels() const noexcept
+{
+    return pImpl->mChannels;
+}
+
+/// Decimation factor
+int Decimator::getDecimationFactor() const noexcept
+{
+    return pImpl->mFactor;
+}
+
+/// Filter taps
+std::vector<double> Decimator::getFilterTaps() const
+{
+    return pImpl->mTapsDouble;
+}
+
+/// Group delay
+double Decimator::getGroupDelay() const noexcept
+{
+    if (pImpl->mTaps.empty()){return 0;}
+    return static_cast<double> (pImpl->mTaps.size() - 1)/2;
+}
+
+/// Reset the filter state
+void Decimator::reset() noexcept
+{
+    std::fill(pImpl->mHistory.begin(), pImpl->mHistory.end(), 0);
+    std::fill(pImpl->mPhase.begin(), pImpl->mPhase.end(), 0);
+}
+
+/// Phase
+int Decimator::getPhase(const int channel) const
+{
+    pImpl->checkChannel(channel);
+    return pImpl->mPhase[channel];
+}
+
+/// Number of outputs for the next block
+int Decimator::getNumberOfOutputSamples(const int channel,
+                                        const int nSamples) const
+{
+    pImpl->checkChannel(channel);
+    if (nSamples < 0)
+    {
+        throw std::invalid_argument("nSamples = " + std::to_string(nSamples)
+                                  + " cannot be negative");
+    }
+    auto phase = pImpl->mPhase[channel];
+    if (nSamples <= phase){return 0;}
+    return (nSamples - 1 - phase)/pImpl->mFactor + 1;
+}
+
+/// Filter and downsample
+void Decimator::process(const int firstChannel, const int nChannels,
+                        const int nSamples,
+                        const float *const x[], float *const y[])
+{
+    if (!isInitialized())
+    {
+        throw std::invalid_argument("Decimator not initialized");
+    }
+    if (nChannels < 1 || firstChannel < 0 ||
+        firstChannel + nChannels > pImpl->mChannels)
+    {
+        throw std::invalid_argument("Channel block is out of bounds");
+    }
+    auto nOut = getNumberOfOutputSamples(firstChannel, nSamples);
+    auto phase = pImpl->mPhase[firstChannel];
+    for (int i = 1; i < nChannels; ++i)
+    {
+        if (pImpl->mPhase[firstChannel + i] != phase)
+        {
+            throw std::invalid_argument("Channels in block are not in phase");
+        }
+    }
+    if (nSamples == 0){return;}
+    if (x == nullptr){throw std::invalid_argument("x is NULL");}
+    if (nOut > 0 && y == nullptr){throw std::invalid_argument("y is NULL");}
+    for (int i = 0; i < nChannels; ++i)
+    {
+        if (x[i] == nullptr){throw std::invalid_argument("x[i] is NULL");}
+        if (nOut > 0 && y[i] == nullptr)
+        {
+            throw std::invalid_argument("y[i] is NULL");
+        }
+    }
+    auto nTaps = static_cast<int> (pImpl->mTaps.size());
+    auto nHistory = nTaps - 1;
+    auto nRows = nHistory + nSamples;
+    auto nc = static_cast<size_t> (nChannels);
+    // Transpose the history and input so the channels are contiguous
+    pImpl->mWork.resize(static_cast<size_t> (nRows)*nc);
+    auto work = pImpl->mWork.data();
+    for (int i = 0; i < nChannels; ++i)
+    {
+        const auto history = pImpl->mHistory.data()
+                           + static_cast<size_t> (firstChannel + i)*nHistory;
+        for (int k = 0; k < nHistory; ++k){work[k*nc + i] = history[k];}
+        const auto xi = x[i];
+        for (int k = 0; k < nSamples; ++k)
+        {
+            work[(nHistory + k)*nc + i] = xi[k];
+        }
+    }
+    // Compute the retained outputs.  The inner loop is over channels.
+    pImpl->mSum.resize(nc);
+    auto sum = pImpl->mSum.data();
+    const auto taps = pImpl->mTaps.data();
+    for (int j = 0; j < nOut; ++j)
+    {
+        // The newest sample in the filter is the n'th sample of the block
+        auto n = phase + j*pImpl->mFactor;
+        std::fill(sum, sum + nc, 0.0f);
+        for (int k = 0; k < nTaps; ++k)
+        {
+            const auto tap = taps[k];
+            const auto row = work + static_cast<size_t> (nHistory + n - k)*nc;
+            #pragma omp simd
+            for (size_t i = 0; i < nc; ++i)
+            {
+                sum[i] = sum[i] + tap*row[i];
+            }
+        }
+        for (size_t i = 0; i < nc; ++i){y[i][j] = sum[i];}
+    }
+    // Save the newest samples for the next block
+    for (int i = 0; i < nChannels; ++i)
+    {
+        auto history = pImpl->mHistory.data()
+                     + static_cast<size_t> (firstChannel + i)*nHistory;
+        for (int k = 0; k < nHistory; ++k)
+        {
+            history[k] = work[static_cast<size_t> (nSamples + k)*nc + i];
+        }
+        pImpl->mPhase[firstChannel + i] = phase + nOut*pImpl->mFactor
+                                        - nSamples;
+    }
+}
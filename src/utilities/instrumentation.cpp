@@ -0,0 +1,230 @@
+#include <array>
+#include <atomic>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include "sff/utilities/instrumentation.hpp"
+#include "private/instrumentation.hpp"
+
+using namespace SFF::Utilities::Instrumentation;
+
+namespace
+{
+
+constexpr size_t N_COUNTERS = static_cast<size_t> (Counter::BYTE_SWAPS) + 1;
+constexpr size_t N_TIMERS = static_cast<size_t> (Timer::SWAP) + 1;
+
+/// Each counter gets its own cache line so that threads updating different
+/// counters do not contend.
+struct alignas(64) AtomicCounter
+{
+    std::atomic<uint64_t> value{0};
+};
+
+std::array<AtomicCounter, N_COUNTERS> counters;
+std::array<AtomicCounter, N_TIMERS> timerNanoseconds;
+std::array<AtomicCounter, N_TIMERS> timerCalls;
+
+}
+
+class Snapshot::SnapshotImpl
+{
+public:
+    std::array<uint64_t, N_COUNTERS> mCounters{};
+    std::array<uint64_t, N_TIMERS> mNanoseconds{};
+    std::array<uint64_t, N_TIMERS> mCalls{};
+};
+
+/// Constructor
+Snapshot::Snapshot() :
+    pImpl(std::make_unique<SnapshotImpl> ())
+{
+}
+
+/// Copy constructor
+Snapshot::Snapshot(const Snapshot &snapshot)
+{
+    *this = snapshot;
+}
+
+/// Move constructor
+Snapshot::Snapshot(Snapshot &&snapshot) noexcept
+{
+    *this = std::move(snapshot);
+}
+
+/// Copy assignment
+Snapshot& Snapshot::operator=(const Snapshot &snapshot)
+{
+    if (&snapshot == this){return *this;}
+    pImpl = std::make_unique<SnapshotImpl> (*snapshot.pImpl);
+    return *this;
+}
+
+/// Move assignment
+Snapshot& Snapshot::operator=(Snapshot &&snapshot) noexcept
+{
+    if (&snapshot == this){return *this;}
+    pImpl = std::move(snapshot.pImpl);
+    return *this;
+}
+
+/// Destructor
+Snapshot::~Snapshot() = default;
+
+/// Counters
+void Snapshot::setCount(const Counter counter, const uint64_t value) noexcept
+{
+    pImpl->mCounters[static_cast<size_t> (counter)] = value;
+}
+
+uint64_t Snapshot::getCount(const Counter counter) const noexcept
+{
+    return pImpl->mCounters[static_cast<size_t> (counter)];
+}
+
+/// Timers
+void Snapshot::setElapsedTime(const Timer timer,
+                              const std::chrono::nanoseconds elapsed,
+                              const uint64_t nCalls) noexcept
+{
+    auto index = static_cast<size_t> (timer);
+    pImpl->mNanoseconds[index] = static_cast<uint64_t> (elapsed.count());
+    pImpl->mCalls[index] = nCalls;
+}
+
+std::chrono::nanoseconds
+Snapshot::getElapsedTime(const Timer timer) const noexcept
+{
+    auto nanoseconds = pImpl->mNanoseconds[static_cast<size_t> (timer)];
+    return std::chrono::nanoseconds(static_cast<int64_t> (nanoseconds));
+}
+
+uint64_t Snapshot::getNumberOfCalls(const Timer timer) const noexcept
+{
+    return pImpl->mCalls[static_cast<size_t> (timer)];
+}
+
+/// JSON
+std::string Snapshot::toJSON() const
+{
+    std::string result = "{\"enabled\": ";
+    result = result + (isEnabled() ? "true" : "false") + ",\n";
+    result = result + " \"counters\": {";
+    for (size_t i = 0; i < N_COUNTERS; ++i)
+    {
+        auto counter = static_cast<Counter> (i);
+        if (i > 0){result = result + ", ";}
+        result = result + "\"" + toString(counter) + "\": "
+               + std::to_string(getCount(counter));
+    }
+    result = result + "},\n \"timers\": {";
+    for (size_t i = 0; i < N_TIMERS; ++i)
+    {
+        auto timer = static_cast<Timer> (i);
+        if (i > 0){result = result + ", ";}
+        result = result + "\"" + toString(timer) + "\": {\"calls\": "
+               + std::to_string(getNumberOfCalls(timer))
+               + ", \"nanoseconds\": "
+               + std::to_string(getElapsedTime(timer).count()) + "}";
+    }
+    result = result + "}}\n";
+    return result;
+}
+
+/// Compiled with instrumentation?
+bool SFF::Utilities::Instrumentation::isEnabled() noexcept
+{
+#ifdef SFF_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// Update a counter
+void SFF::Utilities::Instrumentation::increment(const Counter counter,
+                                                const uint64_t value) noexcept
+{
+    counters[static_cast<size_t> (counter)].value.fetch_add(
+        value, std::memory_order_relaxed);
+}
+
+/// Update a timer
+void SFF::Utilities::Instrumentation::addElapsedTime(
+    const Timer timer, const std::chrono::nanoseconds elapsed) noexcept
+{
+    auto index = static_cast<size_t> (timer);
+    timerNanoseconds[index].value.fetch_add(
+        static_cast<uint64_t> (elapsed.count()), std::memory_order_relaxed);
+    timerCalls[index].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Snapshot the counters
+Snapshot SFF::Utilities::Instrumentation::getSnapshot() noexcept
+{
+    Snapshot snapshot;
+    for (size_t i = 0; i < N_COUNTERS; ++i)
+    {
+        snapshot.setCount(static_cast<Counter> (i),
+                          counters[i].value.load(std::memory_order_relaxed));
+    }
+    for (size_t i = 0; i < N_TIMERS; ++i)
+    {
+        auto nanoseconds
+            = timerNanoseconds[i].value.load(std::memory_order_relaxed);
+        snapshot.setElapsedTime(
+            static_cast<Timer> (i),
+            std::chrono::nanoseconds(static_cast<int64_t> (nanoseconds)),
+            timerCalls[i].value.load(std::memory_order_relaxed));
+    }
+    return snapshot;
+}
+
+/// Reset the counters
+void SFF::Utilities::Instrumentation::reset() noexcept
+{
+    for (auto &counter : counters){counter.value.store(0);}
+    for (auto &timer : timerNanoseconds){timer.value.store(0);}
+    for (auto &timer : timerCalls){timer.value.store(0);}
+}
+
+/// Write the JSON
+void SFF::Utilities::Instrumentation::dumpJSON(const std::string &fileName)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    file << getSnapshot().toJSON();
+    if (!file){throw std::runtime_error("Failed to write " + fileName);}
+}
+
+/// Names
+std::string SFF::Utilities::Instrumentation::toString(const Counter counter)
+{
+    switch (counter)
+    {
+        case Counter::BYTES_READ: return "bytes_read";
+        case Counter::BYTES_WRITTEN: return "bytes_written";
+        case Counter::RECORDS_DECODED: return "records_decoded";
+        case Counter::RECORDS_ENCODED: return "records_encoded";
+        case Counter::ALLOCATIONS: return "allocations";
+        case Counter::BYTE_SWAPS: return "byte_swaps";
+    }
+    throw std::invalid_argument("Unhandled counter");
+}
+
+std::string SFF::Utilities::Instrumentation::toString(const Timer timer)
+{
+    switch (timer)
+    {
+        case Timer::READ: return "read";
+        case Timer::WRITE: return "write";
+        case Timer::HEADER: return "header";
+        case Timer::DECODE: return "decode";
+        case Timer::SWAP: return "swap";
+    }
+    throw std::invalid_argument("Unhandled timer");
+}
@@ -0,0 +1,152 @@
+#include <mutex>
+#include <new>
+#include <cstdint>
+#include <stdexcept>
+#include <memory_resource>
+#include "sff/utilities/memoryResource.hpp"
+
+using namespace SFF::Utilities;
+
+namespace
+{
+/// Rounds bytes up to a multiple of the alignment, which is a power of 2
+[[nodiscard]] size_t roundUp(const size_t bytes, const size_t alignment) noexcept
+{
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+}
+
+class ArenaResource::ArenaResourceImpl
+{
+public:
+    ArenaResourceImpl(const size_t initialBlockSize,
+                      std::pmr::memory_resource *upstream) :
+        mArena(initialBlockSize, upstream)
+    {
+    }
+    std::mutex mMutex;
+    std::pmr::monotonic_buffer_resource mArena;
+    size_t mBytesAllocated = 0;
+};
+
+class PoolResource::PoolResourceImpl
+{
+public:
+    PoolResourceImpl(const size_t largestPooledBlock,
+                     std::pmr::memory_resource *upstream) :
+        mPool(std::pmr::pool_options{0, largestPooledBlock}, upstream)
+    {
+    }
+    std::pmr::synchronized_pool_resource mPool;
+};
+
+///--------------------------------------------------------------------------///
+///                                 Arena                                    ///
+///--------------------------------------------------------------------------///
+
+/// Constructor
+ArenaResource::ArenaResource(const size_t initialBlockSize,
+                             std::pmr::memory_resource *upstream)
+{
+    if (initialBlockSize < 1)
+    {
+        throw std::invalid_argument("Initial block size must be positive");
+    }
+    if (upstream == nullptr){upstream = std::pmr::new_delete_resource();}
+    pImpl = std::make_unique<ArenaResourceImpl> (initialBlockSize, upstream);
+}
+
+/// Destructor
+ArenaResource::~ArenaResource() = default;
+
+/// Release
+void ArenaResource::release()
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    pImpl->mArena.release();
+    pImpl->mBytesAllocated = 0;
+}
+
+/// Bytes allocated
+size_t ArenaResource::getBytesAllocated() const noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    return pImpl->mBytesAllocated;
+}
+
+/// Allocate
+void *ArenaResource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    auto result = pImpl->mArena.allocate(bytes, alignment);
+    pImpl->mBytesAllocated = pImpl->mBytesAllocated + bytes;
+    return result;
+}
+
+/// Deallocate is a no-op
+void ArenaResource::do_deallocate(void *, size_t, size_t)
+{
+}
+
+/// Equality
+bool ArenaResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+///--------------------------------------------------------------------------///
+///                                  Pool                                    ///
+///--------------------------------------------------------------------------///
+
+/// Constructor
+PoolResource::PoolResource(const size_t largestPooledBlock,
+                           std::pmr::memory_resource *upstream)
+{
+    if (largestPooledBlock < 1)
+    {
+        throw std::invalid_argument("Largest pooled block must be positive");
+    }
+    if (upstream == nullptr){upstream = std::pmr::new_delete_resource();}
+    pImpl = std::make_unique<PoolResourceImpl> (largestPooledBlock, upstream);
+}
+
+/// Destructor
+PoolResource::~PoolResource() = default;
+
+/// Release
+void PoolResource::release()
+{
+    pImpl->mPool.release();
+}
+
+/// Allocate
+void *PoolResource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    // The pools only align blocks to their block size so, e.g., an 80 byte
+    // request with 64 byte alignment can land on a 16 byte boundary.
+    // Requesting a multiple of the alignment selects a pool whose blocks
+    // are aligned.
+    auto nBytes = roundUp(bytes, alignment);
+    auto p = pImpl->mPool.allocate(nBytes, alignment);
+    if (reinterpret_cast<uintptr_t> (p)%alignment != 0)
+    {
+        pImpl->mPool.deallocate(p, nBytes, alignment);
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/// Deallocate
+void PoolResource::do_deallocate(void *p, const size_t bytes,
+                                 const size_t alignment)
+{
+    pImpl->mPool.deallocate(p, roundUp(bytes, alignment), alignment);
+}
+
+/// Equality
+bool PoolResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "sff/utilities/reader.hpp"
+#include "sff/abstractBaseClass/trace.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/binaryFileHeader.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/traceGroup.hpp"
+#include "sff/segy/trace.hpp"
+#include "private/byteSwap.hpp"
+#include "private/parallelFor.hpp"
+#ifdef USE_MSEED
+#include "sff/miniseed/sncl.hpp"
+#include "sff/miniseed/trace.hpp"
+#include "sff/miniseed/traceGroup.hpp"
+#endif
+
+using namespace SFF::Utilities;
+
+namespace
+{
+
+using TraceList = std::vector<std::unique_ptr<SFF::AbstractBaseClass::ITrace>>;
+
+/// Enough of the file to identify all formats
+constexpr size_t SNIFF_SIZE = 3600;
+
+/// SAC files are 632 bytes of header followed by npts floats
+[[nodiscard]] bool isSAC(const char *header, const size_t nRead,
+                         const size_t fileSize)
+{
+    if (nRead < 632 || fileSize < 632){return false;}
+    for (bool swap : {false, true})
+    {
+        auto npts = unpackInt(header + 316, swap);
+        if (npts < 0){continue;}
+        if (632 + 4*static_cast<size_t> (npts) == fileSize){return true;}
+    }
+    return false;
+}
+
+/// Silixa files are 3600 bytes of header followed by equal length traces
+[[nodiscard]] bool isSilixaSEGY(const char *header, const size_t nRead,
+                                const size_t fileSize)
+{
+    if (nRead < 3600 || fileSize < 3600){return false;}
+    SFF::SEGY::Silixa::BinaryFileHeader binaryFileHeader;
+    try
+    {
+        binaryFileHeader.set(header + 3200);
+    }
+    catch (const std::exception &e)
+    {
+        return false;
+    }
+    auto nTraces = binaryFileHeader.getNumberOfTraces();
+    auto nSamples = binaryFileHeader.getNumberOfSamplesPerTrace();
+    auto offset = binaryFileHeader.getFirstTraceOffset();
+    if (nTraces < 0 || nSamples < 0 || offset < 3600){return false;}
+    auto estSize = static_cast<size_t> (offset)
+                 + static_cast<size_t> (nTraces)
+                  *(240 + 4*static_cast<size_t> (nSamples));
+    return estSize == fileSize;
+}
+
+/// Standard SEG-Y files begin with a textual header whose first card starts
+/// with a C in EBCDIC or ASCII.  The binary file header's sample format
+/// code is big-endian unless the rev2 byte order constant is little-endian.
+[[nodiscard]] bool isSEGY(const char *header, const size_t nRead,
+                          const size_t fileSize)
+{
+    if (nRead < 3600 || fileSize < 3600){return false;}
+    auto first = static_cast<unsigned char> (header[0]);
+    if (first != 0xC3 && first != 'C'){return false;}
+    auto binary = reinterpret_cast<const unsigned char *> (header + 3200);
+    int formatCode = (binary[24] << 8) | binary[25];
+    if (binary[96] == 4 && binary[97] == 3 &&
+        binary[98] == 2 && binary[99] == 1)
+    {
+        formatCode = (binary[25] << 8) | binary[24];
+    }
+    return formatCode == 1 || formatCode == 2 || formatCode == 3 ||
+           formatCode == 5 || formatCode == 8;
+}
+
+/// MiniSEED 2 records start with a sequence number and quality indicator
+/// while miniSEED 3 records start with "MS" and the version.
+[[nodiscard]] bool isMiniSEED(const char *header, const size_t nRead)
+{
+    if (nRead < 48){return false;}
+    if (header[0] == 'M' && header[1] == 'S' && header[2] == 3){return true;}
+    for (int i = 0; i < 6; ++i)
+    {
+        if (!((header[i] >= '0' && header[i] <= '9') || header[i] == ' '))
+        {
+            return false;
+        }
+    }
+    auto quality = header[6];
+    if (quality != 'D' && quality != 'R' && quality != 'Q' && quality != 'M')
+    {
+        return false;
+    }
+    return header[7] == ' ' || header[7] == '\0';
+}
+
+TraceList readSAC(const std::string &fileName)
+{
+    auto waveform = std::make_unique<SFF::SAC::Waveform> ();
+    waveform->read(fileName);
+    TraceList result;
+    result.push_back(std::move(waveform));
+    return result;
+}
+
+TraceList readSilixaSEGY(const std::string &fileName)
+{
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(fileName);
+    TraceList result;
+    result.reserve(group.getNumberOfTraces());
+    for (auto &trace : group)
+    {
+        result.push_back(
+            std::make_unique<SFF::SEGY::Silixa::Trace> (std::move(trace)));
+    }
+    return result;
+}
+
+TraceList readSEGY(const std::string &fileName)
+{
+    SFF::SEGY::TraceGroup group;
+    group.open(fileName);
+    auto traces = group.getTraces();
+    TraceList result;
+    result.reserve(traces.size());
+    for (auto &trace : traces)
+    {
+        result.push_back(
+            std::make_unique<SFF::SEGY::Trace> (std::move(trace)));
+    }
+    return result;
+}
+
+TraceList readMiniSEED([[maybe_unused]] const std::string &fileName)
+{
+#ifdef USE_MSEED
+    SFF::MiniSEED::TraceGroup group;
+    group.read(fileName);
+    auto sncls = group.getSNCLs();
+    TraceList result;
+    result.reserve(sncls.size());
+    for (const auto &sncl : sncls)
+    {
+        result.push_back(
+            std::make_unique<SFF::MiniSEED::Trace> (group.getTrace(sncl)));
+    }
+    return result;
+#else
+    throw std::runtime_error("Library not compiled with miniSEED support");
+#endif
+}
+
+}
+
+/// Determines the file format
+SFF::Format SFF::Utilities::detectFormat(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        throw std::invalid_argument("File = " + fileName
+                                  + " could not be opened");
+    }
+    file.seekg(0, file.end);
+    auto fileSize = static_cast<size_t> (file.tellg());
+    file.seekg(0, file.beg);
+    std::array<char, SNIFF_SIZE> header{};
+    file.read(header.data(), std::min(fileSize, SNIFF_SIZE));
+    auto nRead = static_cast<size_t> (file.gcount());
+    file.close();
+    if (isSAC(header.data(), nRead, fileSize)){return SFF::Format::SAC;}
+    if (isSilixaSEGY(header.data(), nRead, fileSize))
+    {
+        return SFF::Format::SILIXA_SEGY;
+    }
+    if (isMiniSEED(header.data(), nRead)){return SFF::Format::MINISEED;}
+    if (isSEGY(header.data(), nRead, fileSize)){return SFF::Format::SEGY;}
+    throw std::invalid_argument("Could not determine format of " + fileName);
+}
+
+/// Reads the traces in a file
+TraceList SFF::Utilities::readTraces(const std::string &fileName)
+{
+    auto format = detectFormat(fileName);
+    if (format == SFF::Format::SAC)
+    {
+        return readSAC(fileName);
+    }
+    else if (format == SFF::Format::SILIXA_SEGY)
+    {
+        return readSilixaSEGY(fileName);
+    }
+    else if (format == SFF::Format::SEGY)
+    {
+        return readSEGY(fileName);
+    }
+    return readMiniSEED(fileName);
+}
+
+/// Reads the traces in many files
+TraceList SFF::Utilities::readTraces(const std::vector<std::string> &fileNames,
+                                     const int nThreads)
+{
+    auto nFiles = static_cast<int> (fileNames.size());
+    std::vector<TraceList> traces(nFiles);
+    forEachInParallel(nFiles, nThreads, [&](const int i)
+    {
+        traces[i] = readTraces(fileNames[i]);
+    });
+    // Flatten
+    TraceList result;
+    size_t nTraces = 0;
+    for (const auto &fileTraces : traces){nTraces = nTraces + fileTraces.size();}
+    result.reserve(nTraces);
+    for (auto &fileTraces : traces)
+    {
+        for (auto &trace : fileTraces){result.push_back(std::move(trace));}
+    }
+    return result;
+}
+
+/// Reads a file with one trace
+std::unique_ptr<SFF::AbstractBaseClass::ITrace>
+SFF::Utilities::readTrace(const std::string &fileName)
+{
+    auto traces = readTraces(fileName);
+    if (traces.size() != 1)
+    {
+        throw std::invalid_argument(fileName + " has "
+                                  + std::to_string(traces.size())
+                                  + " traces; expected 1");
+    }
+    return std::move(traces[0]);
+}
@@ -0,0 +1,691 @@
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#if __has_include(<filesystem>)
+ #include <filesystem>
+ namespace fs = std::filesystem;
+ #define USE_FILESYSTEM 1
+#elif __has_include(<experimental/filesystem>)
+ #include <experimental/filesystem>
+ namespace fs = std::experimental::filesystem;
+ #define USE_FILESYSTEM 1
+#endif
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/sac/enums.hpp"
+#include "sff/segy/textualFileHeader.hpp"
+#include "sff/segy/silixa/binaryFileHeader.hpp"
+#include "sff/segy/silixa/traceHeader.hpp"
+#include "sff/hypoinverse2000/eventSummary.hpp"
+#include "sff/hypoinverse2000/eventSummaryLine.hpp"
+#include "sff/hypoinverse2000/stationArchiveLine.hpp"
+#include "sff/hypoinverse2000/archiveWriter.hpp"
+
+using namespace SFF::Utilities;
+
+namespace
+{
+
+/// A portable random number generator so files are reproducible everywhere
+[[nodiscard]] uint64_t splitMix64(uint64_t &state) noexcept
+{
+    state = state + 0x9E3779B97F4A7C15ULL;
+    auto z = state;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/// Uniform random number in [0,1)
+[[nodiscard]] double uniform(uint64_t &state) noexcept
+{
+    return static_cast<double> (splitMix64(state) >> 11)*0x1.0p-53;
+}
+
+[[nodiscard]] std::string makeStationName(const int channel)
+{
+    std::array<char, 8> station{};
+    std::snprintf(station.data(), station.size(), "S%04d", (channel + 1)%10000);
+    return std::string(station.data());
+}
+
+void packBigEndian16(const uint16_t value, char *c) noexcept
+{
+    c[0] = static_cast<char> ((value >> 8) & 0xFF);
+    c[1] = static_cast<char> (value & 0xFF);
+}
+
+void packBigEndian32(const uint32_t value, char *c) noexcept
+{
+    c[0] = static_cast<char> ((value >> 24) & 0xFF);
+    c[1] = static_cast<char> ((value >> 16) & 0xFF);
+    c[2] = static_cast<char> ((value >> 8) & 0xFF);
+    c[3] = static_cast<char> (value & 0xFF);
+}
+
+void packBigEndianFloat(const float value, char *c) noexcept
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(float));
+    packBigEndian32(bits, c);
+}
+
+/// Steim2 word layouts ordered from most to fewest differences per word
+struct Steim2Layout
+{
+    int count;     // Number of differences in the word
+    int bits;      // Bits per difference
+    uint32_t code; // Nibble in the frame's control word
+    uint32_t dnib; // Sub-code in the top two bits of the data word
+};
+constexpr std::array<Steim2Layout, 7> STEIM2_LAYOUTS
+{
+    Steim2Layout {7,  4, 3, 2},
+    Steim2Layout {6,  5, 3, 1},
+    Steim2Layout {5,  6, 3, 0},
+    Steim2Layout {4,  8, 1, 0},
+    Steim2Layout {3, 10, 2, 3},
+    Steim2Layout {2, 15, 2, 2},
+    Steim2Layout {1, 30, 2, 1}
+};
+
+/// @brief Packs as many samples as fit into nFrames Steim2 frames.
+/// @param[in] n         The number of samples available.
+/// @param[in] x         The samples.  This is an array of dimension [n].
+/// @param[in] previous  The sample preceding x[0] in a contiguous segment.
+///                      This defines the first difference.
+/// @param[in] nFrames   The number of 64 byte frames.
+/// @param[out] frames   The packed frames.  This has dimension [64*nFrames].
+/// @result The number of samples that were packed.
+int packSteim2(const int n, const int *x, const int previous,
+               const int nFrames, char *frames)
+{
+    std::vector<uint32_t> words(16*static_cast<size_t> (nFrames), 0);
+    auto difference = [&](const int i) -> int64_t
+    {
+        if (i == 0){return static_cast<int64_t> (x[0]) - previous;}
+        return static_cast<int64_t> (x[i]) - x[i - 1];
+    };
+    int i = 0;
+    for (int frame = 0; frame < nFrames && i < n; ++frame)
+    {
+        uint32_t control = 0;
+        // The first frame holds the forward and reverse integration constants
+        for (int w = (frame == 0 ? 3 : 1); w < 16 && i < n; ++w)
+        {
+            bool packed = false;
+            for (const auto &layout : STEIM2_LAYOUTS)
+            {
+                if (layout.count > n - i){continue;}
+                auto maxValue = (int64_t {1} << (layout.bits - 1)) - 1;
+                auto minValue = -(int64_t {1} << (layout.bits - 1));
+                bool fits = true;
+                for (int k = 0; k < layout.count; ++k)
+                {
+                    auto d = difference(i + k);
+                    if (d < minValue || d > maxValue){fits = false; break;}
+                }
+                if (!fits){continue;}
+                uint32_t mask = (layout.bits == 32) ?
+                                0xFFFFFFFF : ((1U << layout.bits) - 1);
+                uint32_t word = (layout.code == 1) ? 0 : (layout.dnib << 30);
+                for (int k = 0; k < layout.count; ++k)
+                {
+                    auto d = static_cast<uint32_t> (difference(i + k));
+                    word = word | ((d & mask)
+                                   << (layout.bits*(layout.count - 1 - k)));
+                }
+                words[16*frame + w] = word;
+                control = control | (layout.code << (30 - 2*w));
+                i = i + layout.count;
+                packed = true;
+                break;
+            }
+            if (!packed)
+            {
+                throw std::invalid_argument(
+                    "Sample difference exceeds 30 bits");
+            }
+        }
+        words[16*frame] = control;
+    }
+    if (i > 0)
+    {
+        words[1] = static_cast<uint32_t> (x[0]);
+        words[2] = static_cast<uint32_t> (x[i - 1]);
+    }
+    for (size_t k = 0; k < words.size(); ++k)
+    {
+        packBigEndian32(words[k], frames + 4*k);
+    }
+    return i;
+}
+
+/// Packs the 48 byte fixed header and blockette 1000 of a miniSEED 2 record
+void packMiniSEEDHeader(const int sequenceNumber,
+                        const std::string &network,
+                        const std::string &station,
+                        const std::string &channel,
+                        const std::string &location,
+                        const Time &startTime,
+                        const int nSamples,
+                        const int16_t sampleRateFactor,
+                        const int16_t sampleRateMultiplier,
+                        const int recordLength,
+                        char *record)
+{
+    auto pad = [](const std::string &s, const size_t n)
+    {
+        auto result = s.substr(0, n);
+        result.resize(n, ' ');
+        return result;
+    };
+    std::array<char, 8> sequence{};
+    std::snprintf(sequence.data(), sequence.size(), "%06d",
+                  sequenceNumber%1000000);
+    std::copy(sequence.begin(), sequence.begin() + 6, record);
+    record[6] = 'D';
+    record[7] = ' ';
+    auto fields = pad(station, 5) + pad(location, 2)
+                + pad(channel, 3) + pad(network, 2);
+    std::copy(fields.begin(), fields.end(), record + 8);
+    // BTIME
+    packBigEndian16(static_cast<uint16_t> (startTime.getYear()), record + 20);
+    packBigEndian16(static_cast<uint16_t> (startTime.getDayOfYear()),
+                    record + 22);
+    record[24] = static_cast<char> (startTime.getHour());
+    record[25] = static_cast<char> (startTime.getMinute());
+    record[26] = static_cast<char> (startTime.getSecond());
+    record[27] = 0;
+    packBigEndian16(static_cast<uint16_t> (startTime.getMicroSecond()/100),
+                    record + 28);
+    packBigEndian16(static_cast<uint16_t> (nSamples), record + 30);
+    packBigEndian16(static_cast<uint16_t> (sampleRateFactor), record + 32);
+    packBigEndian16(static_cast<uint16_t> (sampleRateMultiplier), record + 34);
+    record[36] = 0; // Activity flags
+    record[37] = 0; // I/O flags
+    record[38] = 0; // Data quality flags
+    record[39] = 1; // Number of blockettes
+    packBigEndian32(0, record + 40); // Time correction
+    packBigEndian16(64, record + 44); // Beginning of data
+    packBigEndian16(48, record + 46); // First blockette
+    // Blockette 1000
+    packBigEndian16(1000, record + 48);
+    packBigEndian16(0, record + 50);
+    record[52] = 11; // Steim2
+    record[53] = 1;  // Big endian
+    record[54] = static_cast<char> (std::lround(std::log2(recordLength)));
+    record[55] = 0;
+    std::fill(record + 56, record + 64, 0);
+}
+
+}
+
+class SyntheticDataGenerator::SyntheticDataGeneratorImpl
+{
+public:
+    /// The segments as [first sample, number of samples, offset in samples]
+    [[nodiscard]] std::vector<std::array<int64_t, 3>> getSegments() const
+    {
+        std::vector<std::array<int64_t, 3>> segments;
+        if (mSegmentLength < 1)
+        {
+            segments.push_back({0, mSamples, 0});
+            return segments;
+        }
+        int64_t gapOffset = 0;
+        for (int64_t i = 0; i < mSamples; i = i + mSegmentLength)
+        {
+            auto nSamples = std::min(mSegmentLength, mSamples - i);
+            segments.push_back({i, nSamples, i + gapOffset});
+            gapOffset = gapOffset + mGapLength;
+        }
+        return segments;
+    }
+    /// Time of the sample at the given offset from the start
+    [[nodiscard]] Time getTime(const int64_t offset) const
+    {
+        return Time(mStartTime.getEpoch()
+                  + static_cast<double> (offset)/mSamplingRate);
+    }
+    Time mStartTime{1577836800.0};
+    uint64_t mSeed = 0;
+    int64_t mSamples = 1000;
+    int64_t mSegmentLength = 0;
+    int64_t mGapLength = 0;
+    double mSamplingRate = 100;
+    int mChannels = 1;
+};
+
+/// Constructor
+SyntheticDataGenerator::SyntheticDataGenerator() :
+    pImpl(std::make_unique<SyntheticDataGeneratorImpl> ())
+{
+}
+
+/// Copy constructor
+SyntheticDataGenerator::SyntheticDataGenerator(
+    const SyntheticDataGenerator &generator)
+{
+    *this = generator;
+}
+
+/// Move constructor
+SyntheticDataGenerator::SyntheticDataGenerator(
+    SyntheticDataGenerator &&generator) noexcept
+{
+    *this = std::move(generator);
+}
+
+/// Copy assignment
+SyntheticDataGenerator& SyntheticDataGenerator::operator=(
+    const SyntheticDataGenerator &generator)
+{
+    if (&generator == this){return *this;}
+    pImpl = std::make_unique<SyntheticDataGeneratorImpl> (*generator.pImpl);
+    return *this;
+}
+
+/// Move assignment
+SyntheticDataGenerator& SyntheticDataGenerator::operator=(
+    SyntheticDataGenerator &&generator) noexcept
+{
+    if (&generator == this){return *this;}
+    pImpl = std::move(generator.pImpl);
+    return *this;
+}
+
+/// Destructor
+SyntheticDataGenerator::~SyntheticDataGenerator() = default;
+
+/// Reset class
+void SyntheticDataGenerator::clear() noexcept
+{
+    pImpl = std::make_unique<SyntheticDataGeneratorImpl> ();
+}
+
+/// Seed
+void SyntheticDataGenerator::setSeed(const uint64_t seed) noexcept
+{
+    pImpl->mSeed = seed;
+}
+
+uint64_t SyntheticDataGenerator::getSeed() const noexcept
+{
+    return pImpl->mSeed;
+}
+
+/// Number of channels
+void SyntheticDataGenerator::setNumberOfChannels(const int nChannels)
+{
+    if (nChannels < 1)
+    {
+        throw std::invalid_argument("Number of channels must be positive");
+    }
+    pImpl->mChannels = nChannels;
+}
+
+int SyntheticDataGenerator::getNumberOfChannels() const noexcept
+{
+    return pImpl->mChannels;
+}
+
+/// Number of samples
+void SyntheticDataGenerator::setNumberOfSamples(const int64_t nSamples)
+{
+    if (nSamples < 1)
+    {
+        throw std::invalid_argument("Number of samples must be positive");
+    }
+    pImpl->mSamples = nSamples;
+}
+
+int64_t SyntheticDataGenerator::getNumberOfSamples() const noexcept
+{
+    return pImpl->mSamples;
+}
+
+/// Sampling rate
+void SyntheticDataGenerator::setSamplingRate(const double samplingRate)
+{
+    if (samplingRate <= 0)
+    {
+        throw std::invalid_argument("Sampling rate must be positive");
+    }
+    pImpl->mSamplingRate = samplingRate;
+}
+
+double SyntheticDataGenerator::getSamplingRate() const noexcept
+{
+    return pImpl->mSamplingRate;
+}
+
+/// Start time
+void SyntheticDataGenerator::setStartTime(const Time &startTime)
+{
+    pImpl->mStartTime = startTime;
+}
+
+Time SyntheticDataGenerator::getStartTime() const
+{
+    return pImpl->mStartTime;
+}
+
+/// Gap pattern
+void SyntheticDataGenerator::setGapPattern(const int64_t segmentLength,
+                                           const int64_t gapLength)
+{
+    if (gapLength < 0)
+    {
+        throw std::invalid_argument("Gap length cannot be negative");
+    }
+    pImpl->mSegmentLength = std::max(int64_t {0}, segmentLength);
+    pImpl->mGapLength = pImpl->mSegmentLength > 0 ? gapLength : 0;
+}
+
+int64_t SyntheticDataGenerator::getSegmentLength() const noexcept
+{
+    return pImpl->mSegmentLength;
+}
+
+int64_t SyntheticDataGenerator::getGapLength() const noexcept
+{
+    return pImpl->mGapLength;
+}
+
+/// Generates a channel's time series
+std::vector<int> SyntheticDataGenerator::generate(const int channel) const
+{
+    if (channel < 0 || channel >= getNumberOfChannels())
+    {
+        throw std::invalid_argument("Channel = " + std::to_string(channel)
+                                  + " must be in range [0,"
+                                  + std::to_string(getNumberOfChannels())
+                                  + ")");
+    }
+    uint64_t state = pImpl->mSeed
+                   ^ (0xD1B54A32D192ED03ULL*static_cast<uint64_t> (channel + 1));
+    std::vector<int> x(pImpl->mSamples);
+    // A mean reverting random walk with triangular increments
+    int64_t value = 0;
+    for (auto &sample : x)
+    {
+        auto r = splitMix64(state);
+        auto step = static_cast<int64_t> (r & 0x3FF)
+                  + static_cast<int64_t> ((r >> 10) & 0x3FF) - 1023;
+        value = value - value/256 + step;
+        sample = static_cast<int> (value);
+    }
+    return x;
+}
+
+/// Writes SAC files
+std::vector<std::string>
+SyntheticDataGenerator::writeSAC(const std::string &directory) const
+{
+#if USE_FILESYSTEM == 1
+    if (!directory.empty() && !fs::exists(directory))
+    {
+        fs::create_directories(directory);
+    }
+#endif
+    std::vector<std::string> fileNames;
+    auto segments = pImpl->getSegments();
+    for (int channel = 0; channel < getNumberOfChannels(); ++channel)
+    {
+        auto x = generate(channel);
+        auto station = makeStationName(channel);
+        for (int iSegment = 0; iSegment < static_cast<int> (segments.size());
+             ++iSegment)
+        {
+            const auto &segment = segments[iSegment];
+            if (segment[1] > std::numeric_limits<int>::max())
+            {
+                throw std::invalid_argument("SAC segment is too long");
+            }
+            std::vector<float> data(x.begin() + segment[0],
+                                    x.begin() + segment[0] + segment[1]);
+            SFF::SAC::Waveform waveform;
+            waveform.setData(static_cast<int> (data.size()), data.data());
+            waveform.setSamplingRate(pImpl->mSamplingRate);
+            waveform.setStartTime(pImpl->getTime(segment[2]));
+            waveform.setHeader(SFF::SAC::Character::KNETWK, "XX");
+            waveform.setHeader(SFF::SAC::Character::KSTNM, station);
+            waveform.setHeader(SFF::SAC::Character::KCMPNM, "HHZ");
+            waveform.setHeader(SFF::SAC::Character::KHOLE, "00");
+            auto fileName = "XX." + station + ".HHZ.00."
+                          + std::to_string(iSegment) + ".sac";
+            if (!directory.empty()){fileName = directory + "/" + fileName;}
+            waveform.write(fileName);
+            fileNames.push_back(fileName);
+        }
+    }
+    return fileNames;
+}
+
+/// Writes a miniSEED file
+void SyntheticDataGenerator::writeMiniSEED(const std::string &fileName,
+                                           const int recordLength) const
+{
+    if (recordLength < 256 || recordLength > 65536 ||
+        (recordLength & (recordLength - 1)) != 0)
+    {
+        throw std::invalid_argument("Record length = "
+                                  + std::to_string(recordLength)
+                                  + " must be a power of 2 in [256,65536]");
+    }
+    // Represent the sampling rate with the factor and multiplier
+    int16_t factor = 0;
+    int16_t multiplier = 1;
+    auto rate = pImpl->mSamplingRate;
+    if (rate >= 1 && std::abs(rate - std::round(rate)) < 1.e-10 &&
+        rate <= 32767)
+    {
+        factor = static_cast<int16_t> (std::lround(rate));
+    }
+    else if (rate < 1 &&
+             std::abs(1/rate - std::round(1/rate)) < 1.e-10 &&
+             1/rate <= 32767)
+    {
+        factor = static_cast<int16_t> (-std::lround(1/rate));
+    }
+    else
+    {
+        throw std::invalid_argument(
+            "Sampling rate must be an integer or have an integer period");
+    }
+    std::ofstream file(fileName, std::ios::out | std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    auto nFrames = (recordLength - 64)/64;
+    std::vector<char> record(recordLength);
+    auto segments = pImpl->getSegments();
+    int sequenceNumber = 1;
+    for (int channel = 0; channel < getNumberOfChannels(); ++channel)
+    {
+        auto x = generate(channel);
+        auto station = makeStationName(channel);
+        for (const auto &segment : segments)
+        {
+            int64_t i = 0;
+            while (i < segment[1])
+            {
+                auto iSample = segment[0] + i;
+                auto nRemaining = static_cast<int> (
+                    std::min(segment[1] - i, int64_t {65535}));
+                auto previous = i > 0 ? x[iSample - 1] : x[iSample];
+                std::fill(record.begin(), record.end(), 0);
+                auto nPacked = packSteim2(nRemaining, x.data() + iSample,
+                                          previous, nFrames,
+                                          record.data() + 64);
+                packMiniSEEDHeader(sequenceNumber, "XX", station, "HHZ", "00",
+                                   pImpl->getTime(segment[2] + i),
+                                   nPacked, factor, multiplier,
+                                   recordLength, record.data());
+                file.write(record.data(), recordLength);
+                sequenceNumber = sequenceNumber + 1;
+                i = i + nPacked;
+            }
+        }
+    }
+    if (!file){throw std::runtime_error("Failed to write " + fileName);}
+}
+
+/// Writes a Silixa SEGY file
+void SyntheticDataGenerator::writeSilixaSEGY(const std::string &fileName) const
+{
+    auto nTraces = getNumberOfChannels();
+    auto nSamples = getNumberOfSamples();
+    // The trace length, 240 + 4*nSamples, must fit in an int
+    if (nSamples > (std::numeric_limits<int>::max() - 240)/4)
+    {
+        throw std::invalid_argument("Too many samples for a Silixa SEGY file");
+    }
+    auto sampleInterval = std::lround(1.e6/pImpl->mSamplingRate);
+    if (sampleInterval < 1 ||
+        sampleInterval > std::numeric_limits<int16_t>::max())
+    {
+        throw std::invalid_argument("Sampling rate cannot be represented");
+    }
+    std::ofstream file(fileName, std::ios::out | std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    SFF::SEGY::TextualFileHeader textualFileHeader;
+    auto textualHeader = textualFileHeader.getEBCDIC();
+    textualHeader.resize(3200, ' ');
+    file.write(textualHeader.data(), 3200);
+    SFF::SEGY::Silixa::BinaryFileHeader binaryFileHeader;
+    binaryFileHeader.setNumberOfTraces(nTraces);
+    binaryFileHeader.setSampleInterval(static_cast<int16_t> (sampleInterval));
+    binaryFileHeader.setNumberOfSamplesPerTrace(static_cast<int> (nSamples));
+    auto binaryHeader = binaryFileHeader.get();
+    file.write(binaryHeader.data(), 400);
+    std::vector<char> trace(240 + 4*static_cast<size_t> (nSamples));
+    for (int channel = 0; channel < nTraces; ++channel)
+    {
+        auto x = generate(channel);
+        SFF::SEGY::Silixa::TraceHeader traceHeader;
+        traceHeader.setTraceNumber(channel + 1);
+        traceHeader.setNumberOfSamples(static_cast<int> (nSamples));
+        traceHeader.setSampleInterval(static_cast<int16_t> (sampleInterval));
+        traceHeader.setStartTime(pImpl->mStartTime);
+        auto tracePtr = trace.data();
+        traceHeader.get(&tracePtr);
+        for (int64_t i = 0; i < nSamples; ++i)
+        {
+            packBigEndianFloat(static_cast<float> (x[i]),
+                               trace.data() + 240 + 4*i);
+        }
+        file.write(trace.data(), trace.size());
+    }
+    if (!file){throw std::runtime_error("Failed to write " + fileName);}
+}
+
+/// Writes a HypoInverse2000 archive
+void SyntheticDataGenerator::writeHypoInverse2000Archive(
+    const std::string &fileName, const int nEvents,
+    const int nPicksPerEvent) const
+{
+    if (nEvents < 0)
+    {
+        throw std::invalid_argument("Number of events cannot be negative");
+    }
+    if (nPicksPerEvent < 0 || nPicksPerEvent > getNumberOfChannels())
+    {
+        throw std::invalid_argument("Number of picks per event must be in "
+                                  "range [0,"
+                                  + std::to_string(getNumberOfChannels())
+                                  + "]");
+    }
+    // Stations are on a grid in the Utah region
+    auto nStations = getNumberOfChannels();
+    auto nColumns = static_cast<int> (std::ceil(std::sqrt(nStations)));
+    std::vector<double> stationLatitudes(nStations);
+    std::vector<double> stationLongitudes(nStations);
+    for (int i = 0; i < nStations; ++i)
+    {
+        stationLatitudes[i] = 37 + 5.0*(i/nColumns)/std::max(1, nColumns);
+        stationLongitudes[i] = -114 + 5.0*(i%nColumns)/std::max(1, nColumns);
+    }
+    // Events are spread over the time span of the data
+    auto segments = pImpl->getSegments();
+    const auto &lastSegment = segments.back();
+    auto duration = static_cast<double> (lastSegment[2] + lastSegment[1])
+                   /pImpl->mSamplingRate;
+    auto t0 = pImpl->mStartTime.getEpoch();
+    uint64_t state = pImpl->mSeed ^ 0x5DEECE66DULL;
+    SFF::HypoInverse2000::ArchiveWriter writer;
+    writer.open(fileName);
+    constexpr double kmPerDegree = 111.19;
+    for (int iEvent = 0; iEvent < nEvents; ++iEvent)
+    {
+        auto latitude = 37 + 5*uniform(state);
+        auto longitude = -114 + 5*uniform(state);
+        auto depth = 15*uniform(state);
+        auto magnitude = -0.5 + 4*uniform(state);
+        auto originTime = t0 + duration*(iEvent + 0.5)/nEvents;
+        SFF::HypoInverse2000::EventSummaryLine origin;
+        origin.setLatitude(latitude);
+        origin.setLongitude(longitude);
+        origin.setDepth(depth);
+        origin.setOriginTime(Time(originTime));
+        origin.setPreferredMagnitude(std::round(magnitude*100)/100);
+        origin.setPreferredMagnitudeLabel('L');
+        origin.setEventIdentifier(60000000 + static_cast<uint64_t> (iEvent));
+        SFF::HypoInverse2000::EventSummary event;
+        event.setEventInformation(origin);
+        // Pick the stations in a random window
+        auto firstStation = static_cast<int> (
+            uniform(state)*(nStations - nPicksPerEvent + 1));
+        for (int k = 0; k < nPicksPerEvent; ++k)
+        {
+            auto iStation = std::min(nStations - 1, firstStation + k);
+            auto dLatitude = (stationLatitudes[iStation] - latitude)
+                            *kmPerDegree;
+            auto dLongitude = (stationLongitudes[iStation] - longitude)
+                             *kmPerDegree*std::cos(latitude*M_PI/180);
+            auto distance = std::hypot(dLatitude, dLongitude);
+            auto azimuth = std::fmod(std::atan2(dLongitude, dLatitude)*180/M_PI
+                                   + 360, 360);
+            auto hypocentralDistance = std::hypot(distance, depth);
+            SFF::HypoInverse2000::StationArchiveLine pick;
+            pick.setNetworkName("XX");
+            pick.setStationName(makeStationName(iStation));
+            pick.setChannelName("HHZ");
+            pick.setLocationCode("00");
+            pick.setEpicentralDistance(std::min(999.9, distance));
+            pick.setAzimuth(std::min(359.0, std::round(azimuth)));
+            auto residual = std::round((uniform(state) - 0.5)*20)/100;
+            if (k%2 == 0)
+            {
+                pick.setPPickTime(Time(originTime + hypocentralDistance/6.0));
+                pick.setPRemark("IP");
+                pick.setFirstMotion(uniform(state) < 0.5 ? 'U' : 'D');
+                pick.setPWeightCode(0);
+                pick.setPResidual(residual);
+                event.addPPick(pick);
+            }
+            else
+            {
+                pick.setSPickTime(Time(originTime + hypocentralDistance/3.5));
+                pick.setSRemark("ES");
+                pick.setSWeightCode(1);
+                pick.setSResidual(residual);
+                event.addSPick(pick);
+            }
+        }
+        writer.write(event);
+    }
+    writer.close();
+}
@@ -0,0 +1,398 @@
+#include <cmath>
+#include <list>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <variant>
+#include <stdexcept>
+#include <filesystem>
+#include <unordered_map>
+#include "sff/utilities/traceCache.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/miniseed/sncl.hpp"
+#include "sff/miniseed/trace.hpp"
+
+using namespace SFF::Utilities;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+using Value = std::variant<std::shared_ptr<const SFF::SAC::Waveform>,
+                           std::shared_ptr<const SFF::MiniSEED::Trace>,
+                           std::shared_ptr<const SFF::SEGY::Silixa::TraceGroup>>;
+
+constexpr double EVERYTHING_START = std::numeric_limits<double>::lowest();
+constexpr double EVERYTHING_END = std::numeric_limits<double>::max();
+
+struct Entry
+{
+    std::string key;
+    double startTime;
+    double endTime;
+    Value value;
+    size_t nBytes;
+};
+
+/// Creates the key from the file's identity and modification time
+[[nodiscard]] std::string makeKey(const std::string &fileName,
+                                  const char type,
+                                  const std::string &sncl = "")
+{
+    fs::path path(fileName);
+    std::error_code error;
+    auto modified = fs::last_write_time(path, error);
+    if (error)
+    {
+        throw std::invalid_argument("File = " + fileName + " does not exist");
+    }
+    auto absolute = fs::absolute(path, error).lexically_normal().string();
+    return std::string(1, type) + '\0' + absolute + '\0'
+         + std::to_string(modified.time_since_epoch().count()) + '\0' + sncl;
+}
+
+#ifdef USE_MSEED
+[[nodiscard]] std::string toString(const SFF::MiniSEED::SNCL &sncl)
+{
+    std::string result;
+    result.append(sncl.getNetwork()).append(".")
+          .append(sncl.getStation()).append(".")
+          .append(sncl.getChannel()).append(".")
+          .append(sncl.getLocationCode());
+    return result;
+}
+#endif
+
+/// Computes the samples [i0, i1) in the window with the same conventions as
+/// SAC::Waveform::read()
+void getWindow(const double traceStart, const double dt, const int npts,
+               const double t0, const double t1, int *i0, int *i1)
+{
+    auto traceEnd = traceStart + std::max(0, npts - 1)*dt;
+    if (traceStart > t1)
+    {
+        throw std::invalid_argument(
+            "Desired start time is after trace end time");
+    }
+    if (traceEnd < t0)
+    {
+        throw std::invalid_argument(
+            "Desired end time is before trace start time");
+    }
+    *i0 = 0;
+    *i1 = npts;
+    if (t0 > traceStart)
+    {
+        *i0 = std::max(0, static_cast<int> (
+                              std::round((t0 - dt/4 - traceStart)/dt)));
+    }
+    if (t1 < traceEnd)
+    {
+        *i1 = std::min(npts, static_cast<int> (
+                                 std::round((t1 + dt/4 - traceStart)/dt)) + 1);
+    }
+    if (*i1 <= *i0)
+    {
+        throw std::invalid_argument("No samples in the desired window");
+    }
+}
+
+[[nodiscard]] std::shared_ptr<const SFF::SAC::Waveform>
+cut(const std::shared_ptr<const SFF::SAC::Waveform> &waveform,
+    const double t0, const double t1)
+{
+    if (t0 == EVERYTHING_START && t1 == EVERYTHING_END){return waveform;}
+    auto npts = waveform->getNumberOfSamples();
+    auto dt = waveform->getSamplingPeriod();
+    auto startTime = waveform->getStartTime();
+    int i0, i1;
+    getWindow(startTime.getEpoch(), dt, npts, t0, t1, &i0, &i1);
+    if (i0 == 0 && i1 == npts){return waveform;}
+    auto result = std::make_shared<SFF::SAC::Waveform> (*waveform);
+    auto data = waveform->getDataSpan();
+    result->setData(i1 - i0, data.data() + i0);
+    startTime.setEpoch(startTime.getEpoch() + i0*dt);
+    result->setStartTime(startTime);
+    return result;
+}
+
+#ifdef USE_MSEED
+[[nodiscard]] std::shared_ptr<const SFF::MiniSEED::Trace>
+cut(const std::shared_ptr<const SFF::MiniSEED::Trace> &trace,
+    const double t0, const double t1)
+{
+    if (t0 == EVERYTHING_START && t1 == EVERYTHING_END){return trace;}
+    auto npts = trace->getNumberOfSamples();
+    auto dt = trace->getSamplingPeriod();
+    auto startTime = trace->getStartTime();
+    int i0, i1;
+    getWindow(startTime.getEpoch(), dt, npts, t0, t1, &i0, &i1);
+    if (i0 == 0 && i1 == npts){return trace;}
+    auto result = std::make_shared<SFF::MiniSEED::Trace> (*trace);
+    auto nSamples = static_cast<size_t> (i1 - i0);
+    auto precision = trace->getPrecision();
+    if (precision == SFF::Precision::FLOAT64)
+    {
+        result->setData(nSamples, trace->getDataSpan64f().data() + i0);
+    }
+    else if (precision == SFF::Precision::FLOAT32)
+    {
+        result->setData(nSamples, trace->getDataSpan32f().data() + i0);
+    }
+    else
+    {
+        result->setData(nSamples, trace->getDataSpan32i().data() + i0);
+    }
+    startTime.setEpoch(startTime.getEpoch() + i0*dt);
+    result->setStartTime(startTime);
+    return result;
+}
+#endif
+
+}
+
+class TraceCache::TraceCacheImpl
+{
+public:
+    /// Finds an entry whose window contains [t0, t1] and marks it as most
+    /// recently used
+    [[nodiscard]] bool find(const std::string &key,
+                            const double t0, const double t1,
+                            Value *value)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto [first, last] = mIndex.equal_range(key);
+        for (auto it = first; it != last; ++it)
+        {
+            auto entry = it->second;
+            if (entry->startTime <= t0 && t1 <= entry->endTime)
+            {
+                mEntries.splice(mEntries.begin(), mEntries, entry);
+                *value = entry->value;
+                mHits = mHits + 1;
+                return true;
+            }
+        }
+        mMisses = mMisses + 1;
+        return false;
+    }
+    /// Adds an entry then evicts until the cache fits
+    void insert(Entry &&entry)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (entry.nBytes > mCapacity){return;}
+        // Another thread may have inserted this while we were reading
+        auto [first, last] = mIndex.equal_range(entry.key);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second->startTime == entry.startTime &&
+                it->second->endTime == entry.endTime)
+            {
+                return;
+            }
+        }
+        mSize = mSize + entry.nBytes;
+        mEntries.push_front(std::move(entry));
+        mIndex.emplace(mEntries.front().key, mEntries.begin());
+        while (mSize > mCapacity)
+        {
+            auto victim = std::prev(mEntries.end());
+            auto [vFirst, vLast] = mIndex.equal_range(victim->key);
+            for (auto it = vFirst; it != vLast; ++it)
+            {
+                if (it->second == victim)
+                {
+                    mIndex.erase(it);
+                    break;
+                }
+            }
+            mSize = mSize - victim->nBytes;
+            mEntries.erase(victim);
+            mEvictions = mEvictions + 1;
+        }
+    }
+    mutable std::mutex mMutex;
+    std::list<Entry> mEntries;
+    std::unordered_multimap<std::string, std::list<Entry>::iterator> mIndex;
+    size_t mCapacity = 256*1024*1024;
+    size_t mSize = 0;
+    int64_t mHits = 0;
+    int64_t mMisses = 0;
+    int64_t mEvictions = 0;
+};
+
+/// Constructor
+TraceCache::TraceCache(const size_t capacity) :
+    pImpl(std::make_unique<TraceCacheImpl> ())
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("Capacity must be positive");
+    }
+    pImpl->mCapacity = capacity;
+}
+
+/// Destructor
+TraceCache::~TraceCache() = default;
+
+/// SAC
+std::shared_ptr<const SFF::SAC::Waveform>
+TraceCache::getWaveform(const std::string &fileName)
+{
+    return getWaveform(fileName, Time(EVERYTHING_START), Time(EVERYTHING_END));
+}
+
+std::shared_ptr<const SFF::SAC::Waveform>
+TraceCache::getWaveform(const std::string &fileName,
+                        const Time &t0, const Time &t1)
+{
+    auto t0Epoch = t0.getEpoch();
+    auto t1Epoch = t1.getEpoch();
+    if (t0Epoch >= t1Epoch)
+    {
+        throw std::invalid_argument("t0 must be less than t1");
+    }
+    auto key = makeKey(fileName, 'S');
+    Value value;
+    if (pImpl->find(key, t0Epoch, t1Epoch, &value))
+    {
+        return cut(std::get<std::shared_ptr<const SFF::SAC::Waveform>> (value),
+                   t0Epoch, t1Epoch);
+    }
+    auto waveform = std::make_shared<SFF::SAC::Waveform> ();
+    waveform->read(fileName, t0, t1);
+    auto nBytes = 632 + sizeof(float)*static_cast<size_t> (
+                            std::max(0, waveform->getNumberOfSamples()));
+    std::shared_ptr<const SFF::SAC::Waveform> result(std::move(waveform));
+    pImpl->insert(Entry{key, t0Epoch, t1Epoch, result, nBytes});
+    return result;
+}
+
+/// MiniSEED
+std::shared_ptr<const SFF::MiniSEED::Trace>
+TraceCache::getTrace(const std::string &fileName,
+                     const SFF::MiniSEED::SNCL &sncl)
+{
+    return getTrace(fileName, sncl,
+                    Time(EVERYTHING_START), Time(EVERYTHING_END));
+}
+
+std::shared_ptr<const SFF::MiniSEED::Trace>
+TraceCache::getTrace([[maybe_unused]] const std::string &fileName,
+                     [[maybe_unused]] const SFF::MiniSEED::SNCL &sncl,
+                     [[maybe_unused]] const Time &t0,
+                     [[maybe_unused]] const Time &t1)
+{
+#ifdef USE_MSEED
+    auto t0Epoch = t0.getEpoch();
+    auto t1Epoch = t1.getEpoch();
+    if (t0Epoch >= t1Epoch)
+    {
+        throw std::invalid_argument("t0 must be less than t1");
+    }
+    // The reader has no window so the whole trace is cached and every
+    // window is cut from it
+    auto key = makeKey(fileName, 'M', toString(sncl));
+    Value value;
+    if (pImpl->find(key, t0Epoch, t1Epoch, &value))
+    {
+        return cut(std::get<std::shared_ptr<const SFF::MiniSEED::Trace>> (value),
+                   t0Epoch, t1Epoch);
+    }
+    auto trace = std::make_shared<SFF::MiniSEED::Trace> ();
+    trace->read(fileName, sncl);
+    size_t sampleSize = sizeof(int);
+    if (trace->getPrecision() == SFF::Precision::FLOAT64)
+    {
+        sampleSize = sizeof(double);
+    }
+    auto nBytes = sizeof(SFF::MiniSEED::Trace) + sampleSize*static_cast<size_t>
+                  (std::max(0, trace->getNumberOfSamples()));
+    std::shared_ptr<const SFF::MiniSEED::Trace> result(std::move(trace));
+    pImpl->insert(Entry{key, EVERYTHING_START, EVERYTHING_END,
+                        result, nBytes});
+    return cut(result, t0Epoch, t1Epoch);
+#else
+    throw std::runtime_error("Library not compiled with miniSEED support");
+#endif
+}
+
+/// Silixa
+std::shared_ptr<const SFF::SEGY::Silixa::TraceGroup>
+TraceCache::getTraceGroup(const std::string &fileName)
+{
+    auto key = makeKey(fileName, 'X');
+    Value value;
+    if (pImpl->find(key, EVERYTHING_START, EVERYTHING_END, &value))
+    {
+        return std::get<std::shared_ptr<const SFF::SEGY::Silixa::TraceGroup>>
+               (value);
+    }
+    auto group = std::make_shared<SFF::SEGY::Silixa::TraceGroup> ();
+    group->read(fileName);
+    auto nBytes = 3600
+                + static_cast<size_t> (group->getNumberOfTraces())
+                 *(240 + sizeof(float)*static_cast<size_t>
+                         (group->getNumberOfSamplesPerTrace()));
+    std::shared_ptr<const SFF::SEGY::Silixa::TraceGroup>
+        result(std::move(group));
+    pImpl->insert(Entry{key, EVERYTHING_START, EVERYTHING_END,
+                        result, nBytes});
+    return result;
+}
+
+/// Statistics
+size_t TraceCache::getCapacity() const noexcept
+{
+    return pImpl->mCapacity;
+}
+
+size_t TraceCache::getSize() const noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    return pImpl->mSize;
+}
+
+size_t TraceCache::getNumberOfEntries() const noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    return pImpl->mEntries.size();
+}
+
+int64_t TraceCache::getNumberOfHits() const noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    return pImpl->mHits;
+}
+
+int64_t TraceCache::getNumberOfMisses() const noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    return pImpl->mMisses;
+}
+
+int64_t TraceCache::getNumberOfEvictions() const noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    return pImpl->mEvictions;
+}
+
+void TraceCache::resetStatistics() noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    pImpl->mHits = 0;
+    pImpl->mMisses = 0;
+    pImpl->mEvictions = 0;
+}
+
+/// Clear
+void TraceCache::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(pImpl->mMutex);
+    pImpl->mIndex.clear();
+    pImpl->mEntries.clear();
+    pImpl->mSize = 0;
+}
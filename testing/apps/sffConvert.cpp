@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/sac/enums.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/silixa/trace.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+/// Runs sff-convert with the given arguments and returns its exit status
+[[nodiscard]] int convert(const std::vector<std::string> &arguments)
+{
+    std::string command = std::string{"\""} + SFF_CONVERT_EXECUTABLE + "\"";
+    for (const auto &argument : arguments)
+    {
+        command = command + " \"" + argument + "\"";
+    }
+    command = command + " > /dev/null 2>&1";
+    return std::system(command.c_str());
+}
+
+void compare(const SFF::SAC::Waveform &reference,
+             const SFF::SAC::Waveform &waveform)
+{
+    EXPECT_NEAR(waveform.getSamplingRate(), reference.getSamplingRate(),
+                1.e-10);
+    EXPECT_NEAR(waveform.getStartTime().getEpoch(),
+                reference.getStartTime().getEpoch(), 1.e-4);
+    auto x = waveform.getDataSpan();
+    auto y = reference.getDataSpan();
+    ASSERT_EQ(x.size(), y.size());
+    for (size_t i = 0; i < x.size(); ++i){EXPECT_EQ(x[i], y[i]);}
+}
+
+TEST(Apps, SFFConvertRoundTrip)
+{
+    auto root = fs::temp_directory_path()/"sffConvertTest";
+    fs::remove_all(root);
+    auto input = root/"input";
+    auto output = root/"output";
+    fs::create_directories(input/"das");
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setSeed(39);
+    generator.setNumberOfChannels(3);
+    generator.setNumberOfSamples(400);
+    generator.setSamplingRate(50);
+    generator.setStartTime(SFF::Utilities::Time(1577836800.5));
+    auto sacFiles = generator.writeSAC((input/"sac").string());
+    ASSERT_EQ(sacFiles.size(), 3);
+    generator.writeSilixaSEGY((input/"das"/"gather.sgy").string());
+    // The directory structure under the input is preserved
+    EXPECT_EQ(convert({input.string(), output.string(), "--threads", "2"}),
+              0);
+    for (const auto &sacFile : sacFiles)
+    {
+        SFF::SAC::Waveform reference;
+        reference.read(sacFile);
+        SFF::SAC::Waveform waveform;
+        auto fileName = output/"sac"/fs::path(sacFile).filename();
+        ASSERT_TRUE(fs::exists(fileName)) << fileName;
+        waveform.read(fileName.string());
+        compare(reference, waveform);
+    }
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read((input/"das"/"gather.sgy").string());
+    ASSERT_EQ(group.getNumberOfTraces(), 3);
+    for (int i = 0; i < group.getNumberOfTraces(); ++i)
+    {
+        const auto &trace = group.at(i);
+        SFF::SAC::Waveform reference;
+        reference.setSamplingRate(trace.getSamplingRate());
+        reference.setStartTime(trace.getStartTime());
+        auto data = trace.getDataSpan();
+        reference.setData(static_cast<int> (data.size()), data.data());
+        auto fileName = output/"das"/("gather.0000" + std::to_string(i)
+                                    + ".sac");
+        ASSERT_TRUE(fs::exists(fileName)) << fileName;
+        SFF::SAC::Waveform waveform;
+        waveform.read(fileName.string());
+        compare(reference, waveform);
+        EXPECT_EQ(waveform.getHeader(SFF::SAC::Character::KSTNM),
+                  std::to_string(trace.getTraceNumber()));
+    }
+    // The same file name in two directories would write the same output
+    fs::create_directories(root/"other");
+    auto duplicate = root/"other"/fs::path(sacFiles[0]).filename();
+    fs::copy_file(sacFiles[0], duplicate);
+    auto collisions = root/"collisions";
+    EXPECT_NE(convert({sacFiles[0], duplicate.string(),
+                       collisions.string()}), 0);
+    std::vector<fs::path> written;
+    for (const auto &entry : fs::directory_iterator(collisions))
+    {
+        written.push_back(entry.path());
+    }
+    ASSERT_EQ(written.size(), 1);
+    EXPECT_EQ(written[0].filename(), fs::path(sacFiles[0]).filename());
+    fs::remove_all(root);
+}
+
+}
@@ -0,0 +1,417 @@
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+#include "sff/compressed/lossyReader.hpp"
+#include "sff/compressed/lossyWriter.hpp"
+#include "sff/compressed/reader.hpp"
+#include "sff/compressed/writer.hpp"
+#include "sff/sac/enums.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/silixa/trace.hpp"
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/time.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Compressed;
+
+/// Lossless means the bits are identical; this also handles NaN
+bool isIdentical(const float x, const float y)
+{
+    return std::bit_cast<uint32_t> (x) == std::bit_cast<uint32_t> (y);
+}
+
+/// Makes channels that exercise the codec: a smooth signal, white noise,
+/// integer counts, a constant, and special values
+std::vector<std::vector<float>> makeChannels(const int nSamples)
+{
+    std::mt19937 generator(4923);
+    std::normal_distribution<float> noise(0, 1);
+    std::vector<std::vector<float>> channels(5, std::vector<float> (nSamples));
+    for (int i = 0; i < nSamples; ++i)
+    {
+        channels[0][i] = static_cast<float>
+                         (std::sin(2*std::numbers::pi*0.003*i));
+        channels[1][i] = noise(generator);
+        channels[2][i] = std::round(1000*noise(generator));
+        channels[3][i] = 7;
+        channels[4][i] = static_cast<float> (i%11);
+    }
+    channels[4][3] = std::numeric_limits<float>::quiet_NaN();
+    channels[4][4] = std::numeric_limits<float>::infinity();
+    channels[4][5] =-0.0f;
+    channels[4][6] = std::numeric_limits<float>::denorm_min();
+    return channels;
+}
+
+TEST(Compressed, RoundTrip)
+{
+    constexpr int nSamples = 1037;
+    const std::string fileName = "compressedRoundTrip.sffc";
+    auto channels = makeChannels(nSamples);
+    std::vector<std::span<const float>> spans(channels.begin(), channels.end());
+    std::vector<std::string> names{"a", "", "counts", "constant", "special"};
+    SFF::Utilities::Time startTime(1556323208.25);
+    for (const auto transform : {Transform::NONE, Transform::BYTE_SHUFFLE,
+                                 Transform::XOR_DELTA})
+    {
+        Writer writer;
+        writer.setTransform(transform);
+        writer.setChunkLength(100);
+        writer.setNumberOfThreads(3);
+        EXPECT_EQ(writer.getTransform(), transform);
+        EXPECT_EQ(writer.getChunkLength(), 100);
+        EXPECT_EQ(writer.getNumberOfThreads(), 3);
+        writer.write(fileName, spans, 0.004, startTime, names);
+
+        Reader reader;
+        EXPECT_FALSE(reader.isOpen());
+        reader.open(fileName);
+        EXPECT_TRUE(reader.isOpen());
+        EXPECT_EQ(reader.getTransform(), transform);
+        EXPECT_EQ(reader.getChunkLength(), 100);
+        EXPECT_EQ(reader.getNumberOfChannels(), 5);
+        EXPECT_EQ(reader.getNumberOfSamples(), nSamples);
+        EXPECT_NEAR(reader.getSamplingPeriod(), 0.004, 1.e-14);
+        EXPECT_NEAR(reader.getStartTime().getEpoch(), startTime.getEpoch(),
+                    1.e-6);
+        EXPECT_EQ(reader.getUncompressedSize(), 4*5*nSamples);
+        EXPECT_LT(reader.getCompressedSize(), reader.getUncompressedSize());
+        for (int c = 0; c < 5; ++c)
+        {
+            EXPECT_EQ(reader.getChannelName(c), names[c]);
+        }
+        // Everything in parallel
+        auto all = reader.readAll(4);
+        ASSERT_EQ(all.size(), 5*static_cast<size_t> (nSamples));
+        for (int c = 0; c < 5; ++c)
+        {
+            for (int i = 0; i < nSamples; ++i)
+            {
+                EXPECT_TRUE(isIdentical(all[c*nSamples + i], channels[c][i]));
+            }
+        }
+        // Ranges within a chunk, across chunks, and in the last partial chunk
+        auto copy = reader;
+        for (const auto &[first, last] : std::vector<std::pair<int, int>>
+             {{0, 0}, {5, 50}, {99, 100}, {150, 749}, {1000, 1036},
+              {0, 1036}})
+        {
+            for (int c = 0; c < 5; ++c)
+            {
+                auto x = copy.read(c, first, last);
+                ASSERT_EQ(x.size(), static_cast<size_t> (last - first + 1));
+                for (int i = first; i <= last; ++i)
+                {
+                    EXPECT_TRUE(isIdentical(x[i - first], channels[c][i]));
+                }
+            }
+        }
+        EXPECT_THROW(static_cast<void> (reader.read(5)),
+                     std::invalid_argument);
+        EXPECT_THROW(static_cast<void> (reader.read(0, 10, 9)),
+                     std::invalid_argument);
+        EXPECT_THROW(static_cast<void> (reader.read(0, 0, nSamples)),
+                     std::invalid_argument);
+        reader.close();
+        EXPECT_FALSE(reader.isOpen());
+        EXPECT_TRUE(copy.isOpen());
+        EXPECT_THROW(static_cast<void> (reader.readAll()), std::runtime_error);
+    }
+    // A truncated file is detected
+    {
+        std::ifstream in(fileName, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char> (in)),
+                                std::istreambuf_iterator<char> ());
+        in.close();
+        std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize> (bytes.size() - 7));
+        out.close();
+        Reader reader;
+        EXPECT_ANY_THROW(reader.open(fileName));
+        EXPECT_FALSE(reader.isOpen());
+    }
+    // Invalid input
+    Writer writer;
+    EXPECT_THROW(writer.setChunkLength(1), std::invalid_argument);
+    EXPECT_THROW(writer.write(fileName, {}, 0.004, startTime),
+                 std::invalid_argument);
+    std::vector<std::span<const float>> ragged{spans[0], spans[1].first(10)};
+    EXPECT_THROW(writer.write(fileName, ragged, 0.004, startTime),
+                 std::invalid_argument);
+    EXPECT_THROW(writer.write(fileName, spans, 0, startTime),
+                 std::invalid_argument);
+    EXPECT_THROW(writer.write(fileName, spans, 0.004, startTime, {"a"}),
+                 std::invalid_argument);
+    std::remove(fileName.c_str());
+}
+
+TEST(Compressed, SilixaTraceGroup)
+{
+    const std::string segyFile = "compressedSilixa.sgy";
+    const std::string fileName = "compressedSilixa.sffc";
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(23);
+    generator.setNumberOfSamples(3001);
+    generator.setSamplingRate(1000);
+    generator.setStartTime(SFF::Utilities::Time(1556323208));
+    generator.writeSilixaSEGY(segyFile);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(segyFile);
+    Writer writer;
+    writer.setTransform(Transform::XOR_DELTA);
+    writer.setChunkLength(512);
+    writer.write(fileName, group);
+    Reader reader;
+    reader.open(fileName);
+    EXPECT_EQ(reader.getNumberOfChannels(), 23);
+    EXPECT_EQ(reader.getNumberOfSamples(), 3001);
+    EXPECT_NEAR(reader.getSamplingPeriod(), 0.001, 1.e-12);
+    EXPECT_NEAR(reader.getStartTime().getEpoch(), 1556323208, 1.e-6);
+    // The low mantissa bytes of integer counts are zero and compress
+    EXPECT_LT(3*reader.getCompressedSize(), 2*reader.getUncompressedSize());
+    auto all = reader.readAll();
+    const auto &constGroup = group;
+    for (int c = 0; c < 23; ++c)
+    {
+        const auto &trace = constGroup[c];
+        EXPECT_EQ(reader.getChannelName(c),
+                  std::to_string(trace.getTraceNumber()));
+        auto x = trace.getDataSpan();
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            EXPECT_TRUE(isIdentical(all[c*3001 + i], x[i]));
+        }
+    }
+    std::remove(segyFile.c_str());
+    std::remove(fileName.c_str());
+}
+
+TEST(Compressed, SACWaveform)
+{
+    const std::string fileName = "compressedSAC.sffc";
+    SFF::SAC::Waveform waveform;
+    waveform.read("data/debug.sac");
+    Writer writer;
+    writer.write(fileName, waveform);
+    Reader reader;
+    reader.open(fileName);
+    EXPECT_EQ(reader.getNumberOfChannels(), 1);
+    EXPECT_EQ(reader.getNumberOfSamples(), waveform.getNumberOfSamples());
+    EXPECT_NEAR(reader.getSamplingPeriod(), waveform.getSamplingPeriod(),
+                1.e-12);
+    EXPECT_NEAR(reader.getStartTime().getEpoch(),
+                waveform.getStartTime().getEpoch(), 1.e-6);
+    auto station = waveform.getHeader(SFF::SAC::Character::KSTNM);
+    EXPECT_NE(reader.getChannelName(0).find("." + station + "."),
+              std::string::npos);
+    auto x = reader.read(0);
+    auto y = waveform.getDataSpan();
+    ASSERT_EQ(x.size(), y.size());
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_TRUE(isIdentical(x[i], y[i]));
+    }
+    std::remove(fileName.c_str());
+}
+
+/// Makes DAS-like channels: a plane wave moving across the array with
+/// incoherent noise
+std::vector<std::vector<float>> makeArray(const int nChannels,
+                                          const int nSamples)
+{
+    std::mt19937 generator(8302);
+    std::normal_distribution<float> noise(0, 0.01f);
+    std::vector<std::vector<float>> channels(nChannels,
+                                             std::vector<float> (nSamples));
+    for (int c = 0; c < nChannels; ++c)
+    {
+        for (int i = 0; i < nSamples; ++i)
+        {
+            auto phase = 2*std::numbers::pi*0.01*(i - 2*c);
+            channels[c][i] = static_cast<float> (std::sin(phase))
+                           + noise(generator);
+        }
+    }
+    return channels;
+}
+
+TEST(Compressed, LossyRoundTrip)
+{
+    constexpr int nChannels = 45;
+    constexpr int nSamples = 1003;
+    const std::string fileName = "compressedLossy.sffl";
+    auto channels = makeArray(nChannels, nSamples);
+    channels[7][11] = std::numeric_limits<float>::quiet_NaN();
+    channels[7][12] = std::numeric_limits<float>::infinity();
+    channels[8][13] = 1.e30f;
+    std::vector<std::span<const float>> spans(channels.begin(), channels.end());
+    std::vector<std::string> names;
+    for (int c = 0; c < nChannels; ++c){names.push_back(std::to_string(c));}
+    SFF::Utilities::Time startTime(1556323208.25);
+    constexpr double tolerance = 1.e-3;
+    for (const auto predictor : {Predictor::LORENZO, Predictor::TIME})
+    {
+        LossyWriter writer;
+        EXPECT_THROW(writer.write(fileName, spans, 0.004, startTime),
+                     std::runtime_error);
+        EXPECT_THROW(static_cast<void> (writer.getCompressionRatio()),
+                     std::runtime_error);
+        writer.setErrorBound(ErrorBound::ABSOLUTE, tolerance);
+        writer.setPredictor(predictor);
+        writer.setChannelBlockSize(16);
+        writer.setNumberOfThreads(3);
+        EXPECT_EQ(writer.getErrorBound(), ErrorBound::ABSOLUTE);
+        EXPECT_NEAR(writer.getTolerance(), tolerance, 1.e-14);
+        EXPECT_EQ(writer.getPredictor(), predictor);
+        EXPECT_EQ(writer.getChannelBlockSize(), 16);
+        EXPECT_EQ(writer.getNumberOfThreads(), 3);
+        writer.write(fileName, spans, 0.004, startTime, names);
+        EXPECT_NEAR(writer.getAbsoluteError(), tolerance, 1.e-14);
+        EXPECT_LE(writer.getMaximumError(), tolerance);
+        EXPECT_GT(writer.getMaximumError(), 0);
+        EXPECT_EQ(writer.getUncompressedSize(), 4*nChannels*nSamples);
+        // The noise is about 10 quanta so 32 bit floats become ~6 bit codes
+        EXPECT_GT(writer.getCompressionRatio(), 4);
+
+        LossyReader reader;
+        EXPECT_FALSE(reader.isOpen());
+        reader.open(fileName);
+        EXPECT_TRUE(reader.isOpen());
+        EXPECT_EQ(reader.getNumberOfChannels(), nChannels);
+        EXPECT_EQ(reader.getNumberOfSamples(), nSamples);
+        EXPECT_EQ(reader.getPredictor(), predictor);
+        EXPECT_EQ(reader.getChannelBlockSize(), 16);
+        EXPECT_NEAR(reader.getAbsoluteError(), tolerance, 1.e-14);
+        EXPECT_NEAR(reader.getSamplingPeriod(), 0.004, 1.e-14);
+        EXPECT_NEAR(reader.getStartTime().getEpoch(), startTime.getEpoch(),
+                    1.e-6);
+        EXPECT_EQ(reader.getUncompressedSize(), 4*nChannels*nSamples);
+        EXPECT_LT(reader.getCompressedSize(), writer.getCompressedSize());
+        auto all = reader.readAll(4);
+        ASSERT_EQ(all.size(), static_cast<size_t> (nChannels)*nSamples);
+        auto copy = reader;
+        reader.close();
+        for (int c = 0; c < nChannels; ++c)
+        {
+            EXPECT_EQ(copy.getChannelName(c), names[c]);
+            auto x = copy.read(c);
+            ASSERT_EQ(x.size(), static_cast<size_t> (nSamples));
+            for (int i = 0; i < nSamples; ++i)
+            {
+                EXPECT_TRUE(isIdentical(x[i], all[c*nSamples + i]));
+                if (std::isfinite(channels[c][i]) &&
+                    std::abs(channels[c][i]) < 1.e20f)
+                {
+                    EXPECT_LE(std::abs(x[i] - channels[c][i]), tolerance);
+                }
+                else
+                {
+                    EXPECT_TRUE(isIdentical(x[i], channels[c][i]));
+                }
+            }
+        }
+        EXPECT_THROW(static_cast<void> (copy.read(nChannels)),
+                     std::invalid_argument);
+        EXPECT_THROW(static_cast<void> (reader.readAll()), std::runtime_error);
+    }
+    // A relative bound is scaled by the data's range
+    {
+        auto clean = makeArray(nChannels, nSamples);
+        std::vector<std::span<const float>> cleanSpans(clean.begin(),
+                                                       clean.end());
+        LossyWriter writer;
+        writer.setErrorBound(ErrorBound::RELATIVE, 1.e-4);
+        writer.write(fileName, cleanSpans, 0.004, startTime);
+        EXPECT_GT(writer.getAbsoluteError(), 2.e-4);
+        EXPECT_LT(writer.getAbsoluteError(), 3.e-4);
+        EXPECT_LE(writer.getMaximumError(), writer.getAbsoluteError());
+        LossyReader reader;
+        reader.open(fileName);
+        EXPECT_TRUE(reader.getChannelName(0).empty());
+        auto x = reader.read(44);
+        for (int i = 0; i < nSamples; ++i)
+        {
+            EXPECT_LE(std::abs(x[i] - clean[44][i]),
+                      reader.getAbsoluteError());
+        }
+    }
+    // A truncated file is detected
+    {
+        std::ifstream in(fileName, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char> (in)),
+                                std::istreambuf_iterator<char> ());
+        in.close();
+        std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize> (bytes.size() - 7));
+        out.close();
+        LossyReader reader;
+        EXPECT_ANY_THROW(reader.open(fileName));
+        EXPECT_FALSE(reader.isOpen());
+    }
+    // Invalid input
+    LossyWriter writer;
+    EXPECT_THROW(writer.setErrorBound(ErrorBound::ABSOLUTE, 0),
+                 std::invalid_argument);
+    EXPECT_THROW(writer.setChannelBlockSize(0), std::invalid_argument);
+    writer.setErrorBound(ErrorBound::RELATIVE, 1.e-3);
+    std::vector<float> constant(100, 3);
+    EXPECT_THROW(writer.write(fileName, {constant}, 0.004, startTime),
+                 std::invalid_argument);
+    std::vector<std::span<const float>> ragged{spans[0], spans[1].first(10)};
+    EXPECT_THROW(writer.write(fileName, ragged, 0.004, startTime),
+                 std::invalid_argument);
+    EXPECT_THROW(writer.write(fileName, spans, 0, startTime),
+                 std::invalid_argument);
+    std::remove(fileName.c_str());
+}
+
+TEST(Compressed, LossySilixaTraceGroup)
+{
+    const std::string segyFile = "compressedLossySilixa.sgy";
+    const std::string fileName = "compressedLossySilixa.sffl";
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(40);
+    generator.setNumberOfSamples(2001);
+    generator.setSamplingRate(1000);
+    generator.setStartTime(SFF::Utilities::Time(1556323208));
+    generator.writeSilixaSEGY(segyFile);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(segyFile);
+    LossyWriter writer;
+    writer.setErrorBound(ErrorBound::ABSOLUTE, 2);
+    writer.write(fileName, group);
+    EXPECT_LE(writer.getMaximumError(), 2);
+    EXPECT_GT(writer.getCompressionRatio(), 2);
+    LossyReader reader;
+    reader.open(fileName);
+    EXPECT_EQ(reader.getNumberOfChannels(), 40);
+    EXPECT_EQ(reader.getNumberOfSamples(), 2001);
+    EXPECT_NEAR(reader.getSamplingPeriod(), 0.001, 1.e-12);
+    EXPECT_NEAR(reader.getStartTime().getEpoch(), 1556323208, 1.e-6);
+    auto all = reader.readAll();
+    const auto &constGroup = group;
+    for (int c = 0; c < 40; ++c)
+    {
+        const auto &trace = constGroup[c];
+        EXPECT_EQ(reader.getChannelName(c),
+                  std::to_string(trace.getTraceNumber()));
+        auto x = trace.getDataSpan();
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            EXPECT_LE(std::abs(all[c*2001 + i] - x[i]), 2);
+        }
+    }
+    std::remove(segyFile.c_str());
+    std::remove(fileName.c_str());
+}
+
+}
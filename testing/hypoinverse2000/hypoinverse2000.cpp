@@ -1,9 +1,18 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <fstream>
+#include <array>
+#include <iterator>
+#include <random>
+#include <cmath>
+#include <algorithm>
 #include "sff/hypoinverse2000/eventSummaryLine.hpp"
 #include "sff/hypoinverse2000/stationArchiveLine.hpp"
 #include "sff/hypoinverse2000/eventSummary.hpp"
+#include "sff/hypoinverse2000/catalog.hpp"
+#include "sff/hypoinverse2000/archiveWriter.hpp"
+#include "sff/hypoinverse2000/spatioTemporalIndex.hpp"
 #include "sff/utilities/time.hpp"
 #include <gtest/gtest.h>
 
@@ -156,6 +165,272 @@ catch (const std::exception &e)
     sstring = sPick.packString();
     EXPECT_EQ(pstring, pPickStringMS);
     EXPECT_EQ(sstring, sPickStringMS);
+
+    // Codes are truncated to their field widths and trailing blanks removed
+    StationArchiveLine line;
+    line.setNetworkName("UUU");
+    line.setStationName("ABCDEFG");
+    line.setChannelName("HH ");
+    line.setLocationCode("   ");
+    auto lineCopy = line;
+    line.clear();
+    EXPECT_EQ(lineCopy.getNetworkName(), "UU");
+    EXPECT_EQ(lineCopy.getStationName(), "ABCDE");
+    EXPECT_EQ(lineCopy.getChannelName(), "HH");
+    EXPECT_FALSE(lineCopy.haveLocationCode());
+}
+
+TEST(Hypo2000, Catalog)
+{
+    const std::string originLine = "202003181320217640 4594112  399  771    24 83  4  1633184  88154 5  44298     33    1  44  87  4     100    47       D 24 L237 20         60363637L237  20        5FUUP1";
+    std::string pPickString("RBU  UU  EHZ IPU0202003181320 2596 -14198        0                   0     218110 0      84 85227    300     D 02");
+    std::string sPickString("NOQ  UU  HHN    4202003181320             2689ES 2  -8   1424 0 24       0 1341210  14     199   251       0J L01");
+    EventSummary event;
+    EXPECT_NO_THROW(event.unpackString(
+        std::vector<std::string> {originLine, pPickString, sPickString}));
+    EventSummary event2;
+    EXPECT_NO_THROW(event2.unpackString(
+        std::vector<std::string> {originLine, pPickString}));
+    std::vector<EventSummary> events{event, event2};
+
+    Catalog catalog(events);
+    EXPECT_EQ(catalog.getNumberOfEvents(), 2);
+    EXPECT_EQ(catalog.getNumberOfPicks(), 3);
+    EXPECT_EQ(catalog.getPickOffsets().size(), 3);
+    EXPECT_EQ(catalog.getPickOffsets().at(1), 2);
+    EXPECT_EQ(catalog.getOriginTimes().at(0), 1584537621760000000);
+    EXPECT_EQ(catalog.getPPickTimes().at(0), 1584537625960000000);
+    EXPECT_EQ(catalog.getPPickTimes().at(1), Catalog::MISSING_TIME);
+    EXPECT_EQ(catalog.getSPickTimes().at(1), 1584537626890000000);
+    EXPECT_NEAR(catalog.getLatitudes().at(1), 40.7657, 1.e-4);
+    EXPECT_EQ(catalog.getEventIdentifiers().at(0), 60363637);
+    // Station codes are interned
+    EXPECT_EQ(catalog.getNetworkCodes().size(), 1);
+    EXPECT_EQ(catalog.getStationCodes().size(), 2);
+    EXPECT_EQ(catalog.getPickStationIndices().at(0),
+              catalog.getPickStationIndices().at(2));
+    // Filtering
+    auto picks = catalog.findPicks("UU", "NOQ");
+    EXPECT_EQ(picks, (std::vector<int> {1}));
+    EXPECT_NEAR(catalog.getSResiduals().at(picks[0]), -0.08, 1.e-2);
+    EXPECT_TRUE(catalog.findPicks("UU", "FORK").empty());
+    picks = catalog.findPicksInTimeRange(1584537625000000000,
+                                         1584537626000000000);
+    EXPECT_EQ(picks, (std::vector<int> {0, 2}));
+    EXPECT_EQ(catalog.findEventsInMagnitudeRange(2, 3).size(), 2);
+    EXPECT_TRUE(catalog.findEventsInMagnitudeRange(3, 4).empty());
+    EXPECT_EQ(catalog.findEventsInRegion(40, 41, -113, -111).size(), 2);
+    // The whole globe returns every event with a known location
+    {
+        std::vector<EventSummary> globe;
+        for (const auto longitude : {-179.5, -112.0, 0.0, 45.0, 179.5})
+        {
+            EventSummaryLine origin;
+            origin.setLatitude(10);
+            origin.setLongitude(longitude);
+            EventSummary summary;
+            summary.setEventInformation(origin);
+            globe.push_back(summary);
+        }
+        globe.push_back(EventSummary {});
+        Catalog globeCatalog(globe);
+        std::vector<int> located{0, 1, 2, 3, 4};
+        EXPECT_EQ(globeCatalog.findEventsInRegion(-90, 90, -180, 180), located);
+        EXPECT_EQ(globeCatalog.findEventsInRegion(-90, 90, 0, 360), located);
+        EXPECT_EQ(globeCatalog.findEventsInRegion(-90, 90, -540, 540),
+                  located);
+        EXPECT_EQ(globeCatalog.findEventsInRegion(-90, 90, 170, 190),
+                  (std::vector<int> {0, 4}));
+    }
+    EXPECT_TRUE(catalog.findEventsInRegion(40, 41, -111, -110).empty());
+    EXPECT_EQ(catalog.findEventsInTimeRange(1584537621760000000,
+                                            1584537621760000000).size(), 2);
+    // Convert back
+    auto eventsBack = catalog.getEvents();
+    ASSERT_EQ(eventsBack.size(), events.size());
+    for (int i = 0; i < static_cast<int> (events.size()); ++i)
+    {
+        EXPECT_EQ(eventsBack[i].packString(), events[i].packString());
+    }
+}
+
+TEST(Hypo2000, ArchiveWriter)
+{
+    const std::string originLine = "202003181320217640 4594112  399  771    24 83  4  1633184  88154 5  44298     33    1  44  87  4     100    47       D 24 L237 20         60363637L237  20        5FUUP1";
+    std::string pPickString("RBU  UU  EHZ IPU0202003181320 2596 -14198        0                   0     218110 0      84 85227    300     D 02");
+    std::string sPickString("NOQ  UU  HHN    4202003181320             2689ES 2  -8   1424 0 24       0 1341210  14     199   251       0J L01");
+    EventSummary event;
+    event.unpackString(
+        std::vector<std::string> {originLine, pPickString, sPickString});
+    // Pack into fixed-width buffers
+    StationArchiveLine pick;
+    pick.unpackString(pPickString);
+    std::array<char, StationArchiveLine::PACKED_LENGTH> pickBuffer;
+    EXPECT_EQ(pick.packString(pickBuffer.data(), pickBuffer.size()),
+              StationArchiveLine::PACKED_LENGTH);
+    EXPECT_EQ(std::string(pickBuffer.begin(), pickBuffer.end()),
+              pick.packString());
+    EXPECT_THROW(pick.packString(pickBuffer.data(), 10),
+                 std::invalid_argument);
+    std::string iteratorString;
+    pick.packString(std::back_inserter(iteratorString));
+    EXPECT_EQ(iteratorString, pPickString);
+    auto origin = event.getEventInformation();
+    std::vector<char> originBuffer(EventSummaryLine::PACKED_LENGTH);
+    origin.packString(originBuffer.data(), originBuffer.size());
+    EXPECT_EQ(std::string(originBuffer.begin(), originBuffer.end()),
+              origin.packString());
+    std::vector<char> eventBuffer(event.getPackedLength());
+    EXPECT_EQ(event.packString(eventBuffer.data(), eventBuffer.size()),
+              event.getPackedLength());
+    EXPECT_EQ(std::string(eventBuffer.begin(), eventBuffer.end()),
+              event.packString());
+    // Stream a few events with a tiny buffer to force several flushes
+    const std::string fileName{"hypo2000ArchiveWriterTest.arc"};
+    const int nEvents = 5;
+    {
+    ArchiveWriter writer;
+    EXPECT_NO_THROW(writer.open(fileName, 200));
+    EXPECT_TRUE(writer.isOpen());
+    for (int i = 0; i < nEvents; ++i){EXPECT_NO_THROW(writer.write(event));}
+    }
+    std::ifstream archive(fileName, std::ios::binary);
+    std::string contents{std::istreambuf_iterator<char>(archive),
+                         std::istreambuf_iterator<char>()};
+    std::string reference;
+    for (int i = 0; i < nEvents; ++i){reference = reference + event.packString();}
+    EXPECT_EQ(contents, reference);
+    archive.close();
+    std::remove(fileName.c_str());
+}
+
+TEST(Hypo2000, SpatioTemporalIndex)
+{
+    // Make a synthetic catalog around the Utah region
+    const int nEvents = 5000;
+    std::mt19937 generator(4082);
+    std::uniform_real_distribution<double> latitudeDistribution(36.5, 42.5);
+    std::uniform_real_distribution<double> longitudeDistribution(-114.5, -108.5);
+    std::uniform_real_distribution<double> depthDistribution(0, 20);
+    std::uniform_real_distribution<double> magnitudeDistribution(-0.5, 4);
+    std::uniform_int_distribution<int64_t> timeDistribution(0, 86400000000000);
+    std::vector<int64_t> times(nEvents);
+    std::vector<double> latitudes(nEvents), longitudes(nEvents),
+                        depths(nEvents), magnitudes(nEvents);
+    for (int i = 0; i < nEvents; ++i)
+    {
+        times[i] = timeDistribution(generator);
+        latitudes[i] = latitudeDistribution(generator);
+        longitudes[i] = longitudeDistribution(generator) + 360;
+        depths[i] = depthDistribution(generator);
+        magnitudes[i] = magnitudeDistribution(generator);
+    }
+    // Brute force distance
+    auto distance = [&](const int i, const double lat, const double lon)
+    {
+        const double d2r = M_PI/180;
+        auto sinDLat = std::sin(0.5*(latitudes[i] - lat)*d2r);
+        auto sinDLon = std::sin(0.5*(longitudes[i] - lon)*d2r);
+        auto a = sinDLat*sinDLat
+               + std::cos(lat*d2r)*std::cos(latitudes[i]*d2r)*sinDLon*sinDLon;
+        return 2*6371.0*std::asin(std::sqrt(a));
+    };
+
+    SpatioTemporalIndex index;
+    EXPECT_FALSE(index.isInitialized());
+    EXPECT_NO_THROW(index.initialize(times, latitudes, longitudes,
+                                     depths, magnitudes, 0.1));
+    EXPECT_TRUE(index.isInitialized());
+    EXPECT_EQ(index.getNumberOfEvents(), nEvents);
+    // Time query
+    const int64_t t0 = 3600000000000;
+    const int64_t t1 = 7200000000000;
+    auto timeIndices = index.findEventsInTimeRange(t0, t1);
+    std::vector<int> reference;
+    for (int i = 0; i < nEvents; ++i)
+    {
+        if (times[i] >= t0 && times[i] <= t1){reference.push_back(i);}
+    }
+    EXPECT_EQ(timeIndices.size(), reference.size());
+    EXPECT_TRUE(std::is_sorted(timeIndices.begin(), timeIndices.end(),
+                               [&](const int lhs, const int rhs)
+                               {
+                                   return times[lhs] < times[rhs];
+                               }));
+    std::sort(timeIndices.begin(), timeIndices.end());
+    EXPECT_EQ(timeIndices, reference);
+    // Range query; note the negative longitude
+    const double lat = 40.76;
+    const double lon = -111.89;
+    for (const auto radius : std::vector<double> {20, 150, 2000})
+    {
+        auto indices = index.findEvents(lat, lon, radius, t0, t1, 2);
+        reference.clear();
+        for (int i = 0; i < nEvents; ++i)
+        {
+            if (times[i] >= t0 && times[i] <= t1 && magnitudes[i] >= 2 &&
+                distance(i, lat, lon) <= radius)
+            {
+                reference.push_back(i);
+            }
+        }
+        EXPECT_EQ(indices, reference);
+    }
+    // Nearest neighbors
+    const double depth = 5;
+    auto nearest = index.findNearestEvents(lat, lon, depth, 10);
+    ASSERT_EQ(nearest.size(), 10);
+    std::vector<std::pair<double, int>> distances;
+    for (int i = 0; i < nEvents; ++i)
+    {
+        auto epicentralDistance = distance(i, lat, lon);
+        auto dz = depths[i] - depth;
+        distances.push_back(
+            std::pair(std::sqrt(epicentralDistance*epicentralDistance + dz*dz),
+                      i));
+    }
+    std::sort(distances.begin(), distances.end());
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(nearest[i], distances[i].second);
+    }
+    EXPECT_EQ(index.findNearestEvents(lat, lon, depth, 2*nEvents).size(),
+              nEvents);
+}
+
+
+TEST(Hypo2000, SpatioTemporalIndexLongitudeSeam)
+{
+    // 0.7 degrees does not divide 360 so the last column of cells is
+    // narrower than the others.  Put events on each side of the seam.
+    std::vector<int64_t> times{0, 0, 0, 0};
+    std::vector<double> latitudes{0, 0, 0, 0};
+    std::vector<double> longitudes{-0.3, 359.75, 0.3, 1.5};
+    std::vector<double> depths(4, 0);
+    std::vector<double> magnitudes(4, 1);
+    const std::vector<int> reference{0, 1, 2};
+    SpatioTemporalIndex index;
+    // Few occupied cells so the occupied cells are scanned
+    index.initialize(times, latitudes, longitudes, depths, magnitudes, 0.7);
+    EXPECT_EQ(index.findEvents(0, 0.1, 50, 0, 0), reference);
+    EXPECT_EQ(index.findEvents(0, 360.1, 50, 0, 0), reference);
+    // Many occupied cells so the candidate cells are visited
+    std::mt19937 generator(3632);
+    std::uniform_real_distribution<double> latitudeDistribution(20, 80);
+    std::uniform_real_distribution<double> longitudeDistribution(-180, 180);
+    for (int i = 0; i < 2000; ++i)
+    {
+        times.push_back(0);
+        latitudes.push_back(latitudeDistribution(generator));
+        longitudes.push_back(longitudeDistribution(generator));
+        depths.push_back(0);
+        magnitudes.push_back(1);
+    }
+    index.initialize(times, latitudes, longitudes, depths, magnitudes, 0.7);
+    EXPECT_EQ(index.findEvents(0, 0.1, 50, 0, 0), reference);
+    EXPECT_EQ(index.findEvents(0, -359.9, 50, 0, 0), reference);
+    // Every event is within 20000 km of the antipode
+    EXPECT_EQ(index.findEvents(0, 180, 20000, 0, 0).size(), times.size());
 }
 
 }
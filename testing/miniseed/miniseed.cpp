@@ -4,6 +4,8 @@
 #include <cmath>
 #include <fstream>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
 #include <vector>
 #include "sff/miniseed/sncl.hpp"
 #include "sff/miniseed/trace.hpp"
@@ -62,10 +64,48 @@ TEST(LibraryDataReadersMiniSEED, SNCL)
     sncl.setChannel(channelTooBig);
     sncl.setLocationCode(locationTooBig);
     EXPECT_FALSE(sncl == snclCopy);
-    EXPECT_STREQ(sncl.getNetwork().c_str(), "1234567891");
-    ASSERT_STREQ(sncl.getStation().c_str(), "1234567891");
-    ASSERT_STREQ(sncl.getChannel().c_str(), "1234567891");
-    ASSERT_STREQ(sncl.getLocationCode().c_str(), "1234567891");
+    EXPECT_EQ(sncl.getNetwork(), "1234567891");
+    ASSERT_EQ(sncl.getStation(), "1234567891");
+    ASSERT_EQ(sncl.getChannel(), "1234567891");
+    ASSERT_EQ(sncl.getLocationCode(), "1234567891");
+    // Embedded NULLs end a code
+    sncl.setNetwork(std::string {"WY\0\0\0", 5});
+    EXPECT_EQ(sncl.getNetwork(), "WY");
+    sncl.clear();
+    EXPECT_TRUE(sncl.isEmpty());
+}
+
+TEST(LibraryDataReadersMiniSEED, SNCLValueType)
+{
+    static_assert(std::is_trivially_copyable_v<MiniSEED::SNCL>);
+    constexpr auto sncl = []()
+    {
+        MiniSEED::SNCL result;
+        result.setNetwork("UU");
+        result.setStation("DUG");
+        result.setChannel("HHZ");
+        result.setLocationCode("01");
+        return result;
+    }();
+    static_assert(sncl.getStation() == "DUG");
+    static_assert(sncl == sncl);
+    static_assert(sncl.hash() != MiniSEED::SNCL {}.hash());
+    // Ordered by network, station, channel, then location
+    auto other = sncl;
+    other.setStation("DUGA");
+    EXPECT_TRUE(sncl < other);
+    other = sncl;
+    other.setNetwork("WY");
+    other.setStation("AAA");
+    EXPECT_TRUE(sncl < other);
+    other = sncl;
+    other.setLocationCode("");
+    EXPECT_TRUE(other < sncl);
+    EXPECT_TRUE(MiniSEED::SNCL {} < sncl);
+    // Hashable
+    std::unordered_set<MiniSEED::SNCL> sncls{sncl, other, sncl};
+    EXPECT_EQ(sncls.size(), 2);
+    EXPECT_TRUE(sncls.contains(other));
 }
 
 TEST(LibraryDataReadersMiniSEED, Trace)
@@ -478,4 +478,69 @@ TEST(SAC, waveform)
     EXPECT_NEAR(resmax8, 0.0, 1.e-7);
 }
 
+TEST(SAC, dataSpan)
+{
+    SAC::Waveform waveform;
+    EXPECT_TRUE(waveform.getDataSpan().empty());
+    EXPECT_EQ(waveform.getPrecision(), SFF::Precision::FLOAT32);
+    std::vector<double> data{1, 2, 3, 4, 5};
+    waveform.setData(static_cast<int> (data.size()), data.data());
+    waveform.setHeader(SAC::Double::DELTA, 0.01);
+    auto span = waveform.getDataSpan();
+    EXPECT_EQ(span.size(), data.size());
+    EXPECT_EQ(span.data(), waveform.getDataPointer());
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        EXPECT_NEAR(span[i], data[i], 1.e-7);
+    }
+    // Copy into the second column of a [5 x 3] row major matrix
+    const SFF::AbstractBaseClass::ITrace &trace = waveform;
+    std::vector<double> matrix(3*data.size(), -1);
+    trace.copyTo(std::span<double> (matrix.data() + 1, matrix.size() - 1), 3);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        EXPECT_NEAR(matrix[3*i],     -1,      1.e-14);
+        EXPECT_NEAR(matrix[3*i + 1], data[i], 1.e-14);
+        EXPECT_NEAR(matrix[3*i + 2], -1,      1.e-14);
+    }
+    std::vector<float> dense(data.size());
+    trace.copyTo(std::span<float> (dense));
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        EXPECT_NEAR(dense[i], data[i], 1.e-7);
+    }
+    std::vector<float> tooSmall(data.size() - 1);
+    EXPECT_THROW(trace.copyTo(std::span<float> (tooSmall)),
+                 std::invalid_argument);
+    EXPECT_THROW(trace.copyTo(std::span<float> (dense), 0),
+                 std::invalid_argument);
+    // Copy samples 1, 2, 3 into every other element
+    std::vector<double> window(5, -1);
+    trace.copyTo(std::span<double> (window), 2, 1, 3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_NEAR(window[2*i], data[i + 1], 1.e-14);
+        if (i < 2){EXPECT_NEAR(window[2*i + 1], -1, 1.e-14);}
+    }
+    // The remaining samples from an offset
+    std::vector<float> tail(2);
+    trace.copyTo(std::span<float> (tail), 1, 3);
+    EXPECT_NEAR(tail[0], data[3], 1.e-7);
+    EXPECT_NEAR(tail[1], data[4], 1.e-7);
+    EXPECT_NO_THROW(trace.copyTo(std::span<float> (), 1, data.size(), 0));
+    EXPECT_THROW(trace.copyTo(std::span<float> (dense), 1, data.size() + 1),
+                 std::invalid_argument);
+    EXPECT_THROW(trace.copyTo(std::span<float> (dense), 1, 2, 4),
+                 std::invalid_argument);
+    EXPECT_THROW(trace.copyTo(std::span<double> (window), 3, 1, 3),
+                 std::invalid_argument);
+    // Typed views
+    EXPECT_EQ(trace.getDataSpan32f().data(), span.data());
+    EXPECT_EQ(trace.getDataSpan32f().size(), data.size());
+    EXPECT_THROW(static_cast<void> (trace.getDataSpan64f()),
+                 std::runtime_error);
+    EXPECT_THROW(static_cast<void> (trace.getDataSpan32i()),
+                 std::runtime_error);
+}
+
 }
@@ -0,0 +1,251 @@
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <fstream>
+#include "sff/segy/traceGroup.hpp"
+#include "sff/segy/trace.hpp"
+#include "sff/segy/textualFileHeader.hpp"
+#include "sff/utilities/reader.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+/// Writes value to c in big or little-endian order
+template<typename T>
+void pack(const T value, char *c, const bool bigEndian = true)
+{
+    auto u = static_cast<uint64_t> (value);
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        auto shift = bigEndian ? 8*(sizeof(T) - 1 - i) : 8*i;
+        c[i] = static_cast<char> ((u >> shift) & 0xff);
+    }
+}
+
+/// Makes the textual and binary file headers
+std::vector<char> makeFileHeader(const int16_t format,
+                                  const int16_t nSamples,
+                                  const int16_t sampleInterval,
+                                  const int revision,
+                                  const bool fixedLength,
+                                  const bool bigEndian = true)
+{
+    // Write EBCDIC and ASCII textual headers
+    SFF::SEGY::TextualFileHeader textualHeader;
+    textualHeader.setASCII("C 1 CLIENT SFF");
+    auto text = bigEndian ? textualHeader.getEBCDIC() :
+                            textualHeader.getASCII();
+    std::vector<char> header(3600, 0);
+    std::fill_n(header.begin(), 3200, ' ');
+    std::copy_n(text.begin(), std::min<size_t> (text.size(), 3200),
+                header.begin());
+    auto binary = header.data() + 3200;
+    pack<int16_t>(sampleInterval, binary + 16, bigEndian);
+    pack<int16_t>(nSamples, binary + 20, bigEndian);
+    pack<int16_t>(format, binary + 24, bigEndian);
+    pack<int32_t>(16909060, binary + 96, bigEndian);
+    binary[300] = static_cast<char> (revision);
+    pack<int16_t>(fixedLength ? 1 : 0, binary + 302, bigEndian);
+    return header;
+}
+
+/// Appends a trace header
+void appendTraceHeader(std::vector<char> &file, const int traceNumber,
+                       const int nSamples, const bool bigEndian = true)
+{
+    std::vector<char> header(240, 0);
+    pack<int32_t>(traceNumber, header.data(), bigEndian);
+    pack<uint16_t>(static_cast<uint16_t> (nSamples), header.data() + 114,
+                   bigEndian);
+    pack<int16_t>(2019, header.data() + 156, bigEndian);
+    pack<int16_t>(117, header.data() + 158, bigEndian);
+    pack<int16_t>(0, header.data() + 160, bigEndian);
+    pack<int16_t>(0, header.data() + 162, bigEndian);
+    pack<int16_t>(8, header.data() + 164, bigEndian);
+    file.insert(file.end(), header.begin(), header.end());
+}
+
+void writeFile(const std::string &fileName, const std::vector<char> &bytes)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::binary);
+    file.write(bytes.data(), bytes.size());
+}
+
+TEST(SEGY, IBMFloat)
+{
+    // Reference values from the SEG-Y standard.  IBM's largest value
+    // overflows an IEEE float and its smallest underflows.
+    const std::vector<uint32_t> ibm{0x41100000, 0xC276A000, 0x40280000,
+                                    0x00000000, 0x42640000, 0xC1100000,
+                                    0x3F100000, 0x7FFFFFFF, 0x00100000};
+    const std::vector<float> reference{1, -118.625f, 0.15625f,
+                                       0, 100, -1,
+                                       1.f/256, std::numeric_limits<float>::infinity(),
+                                       0};
+    auto file = makeFileHeader(1, static_cast<int16_t> (ibm.size()), 1000, 1,
+                               true);
+    for (int trace = 0; trace < 3; ++trace)
+    {
+        appendTraceHeader(file, trace + 1, static_cast<int> (ibm.size()));
+        for (const auto &word : ibm)
+        {
+            std::array<char, 4> c;
+            pack<uint32_t>(word, c.data());
+            file.insert(file.end(), c.begin(), c.end());
+        }
+    }
+    const std::string fileName{"ibm.sgy"};
+    writeFile(fileName, file);
+    EXPECT_EQ(SFF::Utilities::detectFormat(fileName), SFF::Format::SEGY);
+    SFF::SEGY::TraceGroup group;
+    group.open(fileName);
+    ASSERT_TRUE(group.isOpen());
+    EXPECT_EQ(group.getSampleFormat(), SFF::SEGY::SampleFormat::IBM_FLOAT32);
+    EXPECT_EQ(group.getRevision(), 1);
+    EXPECT_TRUE(group.isBigEndian());
+    EXPECT_EQ(group.getTextualFileHeader().getASCII().substr(0, 14),
+              "C 1 CLIENT SFF");
+    ASSERT_EQ(group.getNumberOfTraces(), 3);
+    auto trace = group.getTrace(2);
+    EXPECT_EQ(trace.getTraceNumber(), 3);
+    EXPECT_EQ(trace.getPrecision(), SFF::Precision::FLOAT32);
+    EXPECT_NEAR(trace.getSamplingPeriod(), 0.001, 1.e-12);
+    EXPECT_NEAR(trace.getStartTime().getEpoch(), 1556323208, 1.e-6);
+    EXPECT_EQ(trace.getFormat(), SFF::Format::SEGY);
+    auto x = trace.getDataSpan32f();
+    ASSERT_EQ(x.size(), reference.size());
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_EQ(x[i], reference[i]);
+    }
+    EXPECT_THROW(static_cast<void> (group.getTrace(3)), std::invalid_argument);
+    std::remove(fileName.c_str());
+}
+
+TEST(SEGY, VariableLengthIntegers)
+{
+    // Rev0 files with int16 samples and a different length for each trace
+    auto file = makeFileHeader(3, 0, 250, 0, false);
+    std::vector<int64_t> offsets;
+    for (int trace = 0; trace < 5; ++trace)
+    {
+        offsets.push_back(static_cast<int64_t> (file.size()));
+        auto nSamples = 10 + 7*trace;
+        appendTraceHeader(file, trace + 1, nSamples);
+        for (int i = 0; i < nSamples; ++i)
+        {
+            std::array<char, 2> c;
+            pack<int16_t>(static_cast<int16_t> (1000*trace - i), c.data());
+            file.insert(file.end(), c.begin(), c.end());
+        }
+    }
+    const std::string fileName{"variable.sgy"};
+    writeFile(fileName, file);
+    SFF::SEGY::TraceGroup group;
+    group.open(fileName);
+    ASSERT_EQ(group.getNumberOfTraces(), 5);
+    // Random access in reverse
+    for (int trace = 4; trace >= 0; --trace)
+    {
+        EXPECT_EQ(group.getTraceOffset(trace), offsets[trace]);
+        EXPECT_EQ(group.getNumberOfSamples(trace), 10 + 7*trace);
+        auto t = group.getTrace(trace);
+        EXPECT_EQ(t.getPrecision(), SFF::Precision::INT32);
+        EXPECT_EQ(t.getSampleFormat(), SFF::SEGY::SampleFormat::INT16);
+        auto x = t.getDataSpan32i();
+        ASSERT_EQ(static_cast<int> (x.size()), 10 + 7*trace);
+        for (int i = 0; i < static_cast<int> (x.size()); ++i)
+        {
+            EXPECT_EQ(x[i], 1000*trace - i);
+        }
+    }
+    auto traces = group.getTraces();
+    ASSERT_EQ(traces.size(), 5);
+    EXPECT_EQ(traces[3].getNumberOfSamples(), 31);
+    // Integer samples convert on a partial copy through the interface
+    const SFF::AbstractBaseClass::ITrace &iTrace = traces[3];
+    EXPECT_THROW(static_cast<void> (iTrace.getDataSpan32f()),
+                 std::runtime_error);
+    EXPECT_THROW(static_cast<void> (iTrace.getDataSpan64f()),
+                 std::runtime_error);
+    std::vector<double> window(4);
+    iTrace.copyTo(std::span<double> (window), 1, 27);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_NEAR(window[i], 3000 - (27 + i), 1.e-14);
+    }
+    EXPECT_THROW(iTrace.copyTo(std::span<double> (window), 1, 28, 4),
+                 std::invalid_argument);
+    // Copies read the same file
+    auto copy = group;
+    group.clear();
+    EXPECT_FALSE(group.isOpen());
+    EXPECT_EQ(copy.getTrace(1).getDataSpan32i()[2], 998);
+    // The same file indexed from memory
+    SFF::SEGY::TraceGroup memoryGroup;
+    memoryGroup.set(file.size(), file.data());
+    EXPECT_TRUE(memoryGroup.isOpen());
+    ASSERT_EQ(memoryGroup.getNumberOfTraces(), 5);
+    auto memoryTraces = memoryGroup.getTraces();
+    for (int trace = 0; trace < 5; ++trace)
+    {
+        EXPECT_EQ(memoryGroup.getTraceOffset(trace), offsets[trace]);
+        auto memoryTrace = memoryGroup.getTrace(trace);
+        auto fileTrace = copy.getTrace(trace);
+        auto x = memoryTrace.getDataSpan32i();
+        auto y = fileTrace.getDataSpan32i();
+        EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin(), y.end()));
+        EXPECT_EQ(memoryTraces[trace].getNumberOfSamples(), 10 + 7*trace);
+    }
+    // Truncated files are detected while indexing
+    file.resize(file.size() - 1);
+    writeFile(fileName, file);
+    EXPECT_THROW(group.open(fileName), std::invalid_argument);
+    EXPECT_THROW(memoryGroup.set(file.size(), file.data()),
+                 std::invalid_argument);
+    EXPECT_FALSE(memoryGroup.isOpen());
+    std::remove(fileName.c_str());
+}
+
+TEST(SEGY, LittleEndianRevision2)
+{
+    auto file = makeFileHeader(2, 6, 500, 2, true, false);
+    // One extended textual header
+    pack<int16_t>(1, file.data() + 3200 + 304, false);
+    file.resize(file.size() + 3200, ' ');
+    for (int trace = 0; trace < 2; ++trace)
+    {
+        appendTraceHeader(file, trace + 1, 6, false);
+        for (int i = 0; i < 6; ++i)
+        {
+            std::array<char, 4> c;
+            pack<int32_t>(-100000000 + trace*i, c.data(), false);
+            file.insert(file.end(), c.begin(), c.end());
+        }
+    }
+    const std::string fileName{"littleEndian.sgy"};
+    writeFile(fileName, file);
+    EXPECT_EQ(SFF::Utilities::detectFormat(fileName), SFF::Format::SEGY);
+    SFF::SEGY::TraceGroup group;
+    group.open(fileName);
+    EXPECT_FALSE(group.isBigEndian());
+    EXPECT_EQ(group.getTextualFileHeader().getASCII().substr(0, 14),
+              "C 1 CLIENT SFF");
+    EXPECT_EQ(group.getRevision(), 2);
+    ASSERT_EQ(group.getNumberOfTraces(), 2);
+    EXPECT_EQ(group.getTraceOffset(0), 3600 + 3200);
+    auto trace = group.getTrace(1);
+    auto x = trace.getDataSpan32i();
+    ASSERT_EQ(x.size(), 6);
+    for (int i = 0; i < 6; ++i){EXPECT_EQ(x[i], -100000000 + i);}
+    auto traces = SFF::Utilities::readTraces(fileName);
+    EXPECT_EQ(traces.size(), 2);
+    std::remove(fileName.c_str());
+}
+
+}
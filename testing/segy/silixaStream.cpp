@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/utilities/decimator.hpp"
+#include "sff/segy/silixa/stream.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+/// Writes nFiles consecutive one second files and returns the file names
+/// and the concatenated samples of each channel
+std::vector<std::string>
+    writeFiles(const int nFiles, const int nChannels,
+               const SFF::Utilities::Time &startTime,
+               std::vector<std::vector<float>> &stream)
+{
+    std::vector<std::string> fileNames;
+    stream.assign(nChannels, std::vector<float> ());
+    for (int file = 0; file < nFiles; ++file)
+    {
+        SFF::Utilities::SyntheticDataGenerator generator;
+        generator.setSeed(100 + file);
+        generator.setNumberOfChannels(nChannels);
+        generator.setNumberOfSamples(500);
+        generator.setSamplingRate(500);
+        generator.setStartTime(startTime + static_cast<double> (file));
+        auto fileName = "silixaStream" + std::to_string(file) + ".sgy";
+        generator.writeSilixaSEGY(fileName);
+        fileNames.push_back(fileName);
+        for (int channel = 0; channel < nChannels; ++channel)
+        {
+            auto x = generator.generate(channel);
+            stream[channel].insert(stream[channel].end(), x.begin(), x.end());
+        }
+    }
+    return fileNames;
+}
+
+TEST(SEGY, SilixaStream)
+{
+    constexpr int nChannels = 7;
+    SFF::Utilities::Time startTime(1556323208);
+    std::vector<std::vector<float>> reference;
+    auto fileNames = writeFiles(4, nChannels, startTime, reference);
+    // Give the files out of order
+    std::vector<std::string> shuffled{fileNames[2], fileNames[0],
+                                      fileNames[3], fileNames[1]};
+    SFF::SEGY::Silixa::Stream stream;
+    EXPECT_FALSE(stream.isOpen());
+    stream.open(shuffled);
+    EXPECT_TRUE(stream.isOpen());
+    EXPECT_EQ(stream.getFileNames(), fileNames);
+    EXPECT_EQ(stream.getNumberOfChannels(), nChannels);
+    EXPECT_EQ(stream.getNumberOfSamples(), 2000);
+    EXPECT_NEAR(stream.getSamplingPeriod(), 0.002, 1.e-12);
+    EXPECT_NEAR(stream.getStartTime().getEpoch(), startTime.getEpoch(), 1.e-6);
+    // Overlapping windows that straddle the file boundaries and windows
+    // that skip samples
+    for (const auto &[length, step] : std::vector<std::pair<int, int>>
+                                      {{300, 200}, {100, 350}, {2000, 1}})
+    {
+        stream.setWindow(length, step);
+        int nWindows = 0;
+        while (stream.nextWindow())
+        {
+            auto start = stream.getWindowStartSample();
+            EXPECT_EQ(start, static_cast<int64_t> (nWindows)*step);
+            EXPECT_NEAR(stream.getWindowStartTime().getEpoch(),
+                        startTime.getEpoch() + start*0.002, 1.e-6);
+            auto window = stream.getWindow();
+            ASSERT_EQ(window.size(), static_cast<size_t> (nChannels*length));
+            for (int channel = 0; channel < nChannels; ++channel)
+            {
+                for (int i = 0; i < length; ++i)
+                {
+                    EXPECT_EQ(window[channel*length + i],
+                              reference[channel][start + i]);
+                }
+            }
+            nWindows = nWindows + 1;
+        }
+        EXPECT_EQ(nWindows, (2000 - length)/step + 1);
+    }
+    stream.close();
+    EXPECT_FALSE(stream.isOpen());
+    // Gaps are detected
+    EXPECT_THROW(stream.open({fileNames[0], fileNames[2]}),
+                 std::invalid_argument);
+    EXPECT_THROW(stream.open(std::vector<std::string> {}),
+                 std::invalid_argument);
+    for (const auto &fileName : fileNames){std::remove(fileName.c_str());}
+}
+
+TEST(SEGY, SilixaStreamDecimated)
+{
+    constexpr int nChannels = 70;
+    constexpr int factor = 5;
+    SFF::Utilities::Time startTime(1556323208);
+    std::vector<std::vector<float>> stream;
+    auto fileNames = writeFiles(3, nChannels, startTime, stream);
+    // Decimate each channel of the concatenated files in one pass
+    SFF::Utilities::Decimator decimator(nChannels, factor);
+    auto nOut = decimator.getNumberOfOutputSamples(0, 1500);
+    ASSERT_EQ(nOut, 300);
+    std::vector<std::vector<float>> reference(nChannels,
+                                              std::vector<float> (nOut));
+    std::vector<const float *> x;
+    std::vector<float *> y;
+    for (int c = 0; c < nChannels; ++c)
+    {
+        x.push_back(stream[c].data());
+        y.push_back(reference[c].data());
+    }
+    decimator.process(0, nChannels, 1500, x.data(), y.data());
+    auto delay = decimator.getGroupDelay()*0.002;
+    // The filter state carries across the files in the trace group reader
+    decimator.reset();
+    int i0 = 0;
+    for (const auto &fileName : fileNames)
+    {
+        SFF::SEGY::Silixa::TraceGroup group;
+        group.read(fileName, decimator);
+        ASSERT_EQ(group.getNumberOfTraces(), nChannels);
+        ASSERT_EQ(group.getNumberOfSamplesPerTrace(), 100);
+        for (int c = 0; c < nChannels; ++c)
+        {
+            const auto &trace = group[c];
+            EXPECT_NEAR(trace.getSamplingPeriod(), 0.01, 1.e-12);
+            EXPECT_NEAR(trace.getStartTime().getEpoch(),
+                        startTime.getEpoch() + i0*0.01 - delay, 1.e-6);
+            auto z = trace.getDataSpan();
+            ASSERT_EQ(z.size(), 100);
+            for (size_t j = 0; j < z.size(); ++j)
+            {
+                EXPECT_NEAR(z[j], reference[c][i0 + j], 1.e-5);
+            }
+        }
+        i0 = i0 + 100;
+    }
+    SFF::SEGY::Silixa::TraceGroup group;
+    SFF::Utilities::Decimator wrongChannels(nChannels + 1, factor);
+    EXPECT_THROW(group.read(fileNames[0], wrongChannels),
+                 std::invalid_argument);
+    // And in the stream
+    SFF::SEGY::Silixa::Stream decimatedStream;
+    decimatedStream.setDecimationFactor(factor);
+    decimatedStream.open(fileNames);
+    EXPECT_EQ(decimatedStream.getNumberOfSamples(), nOut);
+    EXPECT_NEAR(decimatedStream.getSamplingPeriod(), 0.01, 1.e-12);
+    EXPECT_NEAR(decimatedStream.getStartTime().getEpoch(),
+                startTime.getEpoch() - delay, 1.e-6);
+    decimatedStream.setWindow(120, 45);
+    int nWindows = 0;
+    while (decimatedStream.nextWindow())
+    {
+        auto start = decimatedStream.getWindowStartSample();
+        auto window = decimatedStream.getWindow();
+        for (int c = 0; c < nChannels; ++c)
+        {
+            for (int i = 0; i < 120; ++i)
+            {
+                EXPECT_NEAR(window[c*120 + i], reference[c][start + i],
+                            1.e-5);
+            }
+        }
+        nWindows = nWindows + 1;
+    }
+    EXPECT_EQ(nWindows, (nOut - 120)/45 + 1);
+    for (const auto &fileName : fileNames){std::remove(fileName.c_str());}
+}
+
+}
@@ -0,0 +1,247 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/silixa/trace.hpp"
+#include "sff/segy/silixa/binaryFileHeader.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+[[nodiscard]] std::vector<char> readBytes(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    file.seekg(0, file.end);
+    std::vector<char> bytes(static_cast<size_t> (file.tellg()));
+    file.seekg(0, file.beg);
+    file.read(bytes.data(), bytes.size());
+    return bytes;
+}
+
+TEST(SEGY, TraceGroupWrite)
+{
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(37);
+    generator.setNumberOfSamples(1001);
+    generator.setSamplingRate(1000);
+    const std::string referenceName{"silixaWriterReference.sgy"};
+    const std::string fileName{"silixaWriter.sgy"};
+    generator.writeSilixaSEGY(referenceName);
+    auto reference = readBytes(referenceName);
+    SFF::SEGY::Silixa::TraceGroup group;
+    EXPECT_THROW(group.write(fileName), std::invalid_argument);
+    group.read(referenceName);
+    // Byte for byte identical for buffered and direct I/O and any number
+    // of threads
+    for (const auto direct : {false, true})
+    {
+        for (const auto nThreads : {1, 3})
+        {
+            group.write(fileName, direct, nThreads);
+            EXPECT_EQ(readBytes(fileName), reference);
+        }
+    }
+    std::remove(referenceName.c_str());
+    std::remove(fileName.c_str());
+}
+
+TEST(SEGY, TraceGroupWriteLarge)
+{
+    // Spans two 32 MB packing buffers
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(1200);
+    generator.setNumberOfSamples(8000);
+    const std::string referenceName{"silixaWriterLargeReference.sgy"};
+    const std::string fileName{"silixaWriterLarge.sgy"};
+    generator.writeSilixaSEGY(referenceName);
+    auto reference = readBytes(referenceName);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(referenceName);
+    group.write(fileName, true);
+    EXPECT_TRUE(readBytes(fileName) == reference);
+    std::remove(referenceName.c_str());
+    std::remove(fileName.c_str());
+}
+
+TEST(SEGY, TraceGroupSetTraces)
+{
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(6);
+    generator.setNumberOfSamples(400);
+    generator.setSamplingRate(500);
+    const std::string fileName{"silixaSetTraces.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(fileName);
+    // Keep every other sample of the odd channels
+    std::vector<SFF::SEGY::Silixa::Trace> traces;
+    for (int i = 1; i < 6; i = i + 2)
+    {
+        auto trace = group[i];
+        auto data = trace.getDataSpan();
+        std::vector<float> decimated;
+        for (size_t j = 0; j < data.size(); j = j + 2)
+        {
+            decimated.push_back(data[j]);
+        }
+        trace.setData(static_cast<int> (decimated.size()), decimated.data());
+        trace.setSamplingPeriod(2*trace.getSamplingPeriod());
+        traces.push_back(std::move(trace));
+    }
+    auto inconsistent = traces;
+    inconsistent[1].setData(3, std::vector<float>{1, 2, 3}.data());
+    EXPECT_THROW(group.setTraces(inconsistent), std::invalid_argument);
+    group.setTraces(std::move(traces));
+    EXPECT_EQ(group.getNumberOfTraces(), 3);
+    EXPECT_EQ(group.getNumberOfSamplesPerTrace(), 200);
+    group.write(fileName);
+    SFF::SEGY::Silixa::TraceGroup copy;
+    copy.read(fileName);
+    ASSERT_EQ(copy.getNumberOfTraces(), 3);
+    ASSERT_EQ(copy.getNumberOfSamplesPerTrace(), 200);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto x = generator.generate(2*i + 1);
+        auto trace = copy[i];
+        EXPECT_NEAR(trace.getSamplingRate(), 250, 1.e-8);
+        auto y = trace.getDataSpan();
+        for (size_t j = 0; j < y.size(); ++j)
+        {
+            EXPECT_NEAR(y[j], x[2*j], 1.e-7);
+        }
+    }
+    std::remove(fileName.c_str());
+}
+
+TEST(SEGY, TraceGroupExtendedCounts)
+{
+    // The counts overflow the rev1 16-bit fields
+    SFF::SEGY::Silixa::BinaryFileHeader header;
+    header.setNumberOfTraces(70000);
+    header.setNumberOfSamplesPerTrace(40000);
+    header.setSampleInterval(250);
+    auto bytes = header.get();
+    SFF::SEGY::Silixa::BinaryFileHeader copy;
+    copy.set(bytes.data());
+    EXPECT_EQ(copy.getNumberOfTraces(), 70000);
+    EXPECT_EQ(copy.getNumberOfSamplesPerTrace(), 40000);
+    EXPECT_EQ(copy.getNumberOfExtendedTextualHeaders(), 0);
+    EXPECT_EQ(copy.getFirstTraceOffset(), 3600);
+    EXPECT_EQ(static_cast<int> (bytes[300]), 2);
+
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(3);
+    generator.setNumberOfSamples(40000);
+    const std::string fileName{"silixaExtended.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(fileName);
+    ASSERT_EQ(group.getNumberOfTraces(), 3);
+    ASSERT_EQ(group.getNumberOfSamplesPerTrace(), 40000);
+    auto reference = readBytes(fileName);
+    group.write(fileName);
+    EXPECT_TRUE(readBytes(fileName) == reference);
+
+    // Insert two extended textual headers and read from memory
+    header.set(reference.data() + 3200);
+    header.setNumberOfExtendedTextualHeaders(2);
+    EXPECT_EQ(header.getFirstTraceOffset(), 3600 + 2*3200);
+    auto binary = header.get();
+    std::vector<char> extended(reference.begin(), reference.begin() + 3200);
+    extended.insert(extended.end(), binary.begin(), binary.end());
+    extended.resize(extended.size() + 2*3200, ' ');
+    extended.insert(extended.end(), reference.begin() + 3600, reference.end());
+    SFF::SEGY::Silixa::TraceGroup fromMemory;
+    fromMemory.set(extended.size(), extended.data());
+    ASSERT_EQ(fromMemory.getNumberOfTraces(), 3);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto traceFromFile = group[i];
+        auto traceFromMemory = fromMemory[i];
+        auto x = traceFromFile.getDataSpan();
+        auto y = traceFromMemory.getDataSpan();
+        ASSERT_EQ(x.size(), y.size());
+        EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+    }
+    std::remove(fileName.c_str());
+}
+
+TEST(SEGY, TraceGroupReadSubset)
+{
+    SFF::Utilities::SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(50);
+    generator.setNumberOfSamples(2000);
+    generator.setSamplingRate(1000);
+    const std::string fileName{"silixaSubset.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(fileName);
+    auto compare = [&](const SFF::SEGY::Silixa::TraceGroup &subset,
+                       const int firstChannel, const int lastChannel,
+                       const int firstSample, const int lastSample,
+                       const bool checkStartTime = true)
+    {
+        auto nChannels = lastChannel - firstChannel + 1;
+        auto nWindow = lastSample - firstSample + 1;
+        ASSERT_EQ(subset.getNumberOfTraces(), nChannels);
+        ASSERT_EQ(subset.getNumberOfSamplesPerTrace(), nWindow);
+        for (int i = 0; i < nChannels; ++i)
+        {
+            const auto &reference = group[firstChannel + i];
+            const auto &trace = subset[i];
+            EXPECT_EQ(trace.getTraceNumber(), reference.getTraceNumber());
+            EXPECT_NEAR(trace.getSamplingPeriod(),
+                        reference.getSamplingPeriod(), 1.e-12);
+            if (checkStartTime)
+            {
+                EXPECT_NEAR(trace.getStartTime().getEpoch(),
+                            reference.getStartTime().getEpoch()
+                          + firstSample*reference.getSamplingPeriod(), 1.e-6);
+            }
+            auto x = reference.getDataSpan();
+            auto y = trace.getDataSpan();
+            ASSERT_EQ(static_cast<int> (y.size()), nWindow);
+            EXPECT_TRUE(std::equal(y.begin(), y.end(), x.begin() + firstSample));
+        }
+    };
+    SFF::SEGY::Silixa::TraceGroup subset;
+    // Interior window
+    subset.read(fileName, 10, 20, 300, 899);
+    compare(subset, 10, 20, 300, 899);
+    // Nearly whole traces so the reads are coalesced
+    subset.read(fileName, 0, 49, 1, 1998);
+    compare(subset, 0, 49, 1, 1998);
+    subset.read(fileName, 49, 49, 0, 1999);
+    compare(subset, 49, 49, 0, 1999);
+    // Time window
+    auto t0 = group[0].getStartTime();
+    subset.read(fileName, 5, 7, t0 + 0.2995, t0 + 0.6);
+    compare(subset, 5, 7, 300, 600);
+    // Windows are clipped to the traces
+    subset.read(fileName, 5, 7, t0 - 10, t0 + 10);
+    compare(subset, 5, 7, 0, 1999);
+    // The subset can be written and read back.  Note, the trace header
+    // only stores the start time to the nearest second.
+    const std::string subsetName{"silixaSubsetWrite.sgy"};
+    subset.read(fileName, 3, 8, 100, 199);
+    subset.write(subsetName);
+    SFF::SEGY::Silixa::TraceGroup copy;
+    copy.read(subsetName);
+    compare(copy, 3, 8, 100, 199, false);
+    // Invalid ranges
+    EXPECT_THROW(subset.read(fileName, 10, 50, 0, 10), std::invalid_argument);
+    EXPECT_THROW(subset.read(fileName, 10, 9, 0, 10), std::invalid_argument);
+    EXPECT_THROW(subset.read(fileName, 0, 1, -1, 10), std::invalid_argument);
+    EXPECT_THROW(subset.read(fileName, 0, 1, 0, 2000), std::invalid_argument);
+    EXPECT_THROW(subset.read(fileName, 0, 1, t0 + 3, t0 + 4),
+                 std::invalid_argument);
+    EXPECT_EQ(subset.getNumberOfTraces(), 0);
+    std::remove(fileName.c_str());
+    std::remove(subsetName.c_str());
+}
+
+}
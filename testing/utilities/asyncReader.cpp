@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <future>
+#include "sff/utilities/asyncReader.hpp"
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities;
+
+[[nodiscard]] std::vector<AsyncReader::Backend> getBackends()
+{
+    std::vector<AsyncReader::Backend> backends{AsyncReader::Backend::THREAD_POOL};
+    if (AsyncReader::isIOUringAvailable())
+    {
+        backends.push_back(AsyncReader::Backend::IO_URING);
+    }
+    return backends;
+}
+
+TEST(UtilitiesAsyncReader, Properties)
+{
+    EXPECT_THROW(AsyncReader reader(0), std::invalid_argument);
+    AsyncReader reader(8, 2);
+    EXPECT_EQ(reader.getQueueDepth(), 8);
+    EXPECT_NE(reader.getBackend(), AsyncReader::Backend::AUTOMATIC);
+    if (AsyncReader::isIOUringAvailable())
+    {
+        EXPECT_EQ(reader.getBackend(), AsyncReader::Backend::IO_URING);
+    }
+    else
+    {
+        EXPECT_EQ(reader.getBackend(), AsyncReader::Backend::THREAD_POOL);
+        EXPECT_THROW(AsyncReader uring(8, 2, AsyncReader::Backend::IO_URING),
+                     std::runtime_error);
+    }
+}
+
+TEST(UtilitiesAsyncReader, Errors)
+{
+    for (const auto backend : getBackends())
+    {
+        AsyncReader reader(4, 1, backend);
+        auto future = reader.readFile("data/does_not_exist.sac");
+        EXPECT_THROW(future.get(), std::invalid_argument);
+        auto waveform = SFF::SAC::Waveform::readAsync("data/does_not_exist.sac",
+                                                      reader);
+        EXPECT_THROW(waveform.get(), std::invalid_argument);
+    }
+}
+
+TEST(UtilitiesAsyncReader, SAC)
+{
+    SFF::SAC::Waveform reference;
+    reference.read("data/debug.sac");
+    for (const auto backend : getBackends())
+    {
+        // More reads than slots so that requests queue
+        AsyncReader reader(4, 2, backend);
+        std::vector<std::future<SFF::SAC::Waveform>> futures;
+        for (int i = 0; i < 64; ++i)
+        {
+            futures.push_back(
+                SFF::SAC::Waveform::readAsync("data/debug.sac", reader));
+        }
+        for (auto &future : futures)
+        {
+            auto waveform = future.get();
+            ASSERT_EQ(waveform.getNumberOfSamples(),
+                      reference.getNumberOfSamples());
+            EXPECT_NEAR(waveform.getSamplingPeriod(),
+                        reference.getSamplingPeriod(), 1.e-10);
+            auto x = waveform.getDataSpan();
+            auto y = reference.getDataSpan();
+            for (size_t i = 0; i < x.size(); ++i)
+            {
+                EXPECT_NEAR(x[i], y[i], 1.e-7);
+            }
+        }
+        // Callbacks
+        std::atomic<int> nBytes{0};
+        for (int i = 0; i < 16; ++i)
+        {
+            reader.readFile("data/debug.sac",
+                            [&nBytes](std::vector<char> &&bytes,
+                                      std::exception_ptr error)
+                            {
+                                if (!error)
+                                {
+                                    nBytes += static_cast<int> (bytes.size());
+                                }
+                            });
+        }
+        reader.wait();
+        EXPECT_EQ(nBytes.load(), 16*(632 + 100*4));
+    }
+}
+
+TEST(UtilitiesAsyncReader, Silixa)
+{
+    SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(16);
+    generator.setNumberOfSamples(500);
+    const std::string fileName{"asyncReader.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    for (const auto backend : getBackends())
+    {
+        AsyncReader reader(16, 4, backend);
+        std::vector<std::future<SFF::SEGY::Silixa::TraceGroup>> futures;
+        for (int i = 0; i < 32; ++i)
+        {
+            futures.push_back(
+                SFF::SEGY::Silixa::TraceGroup::readAsync(fileName, reader));
+        }
+        auto x = generator.generate(5);
+        for (auto &future : futures)
+        {
+            auto group = future.get();
+            ASSERT_EQ(group.getNumberOfTraces(), 16);
+            EXPECT_EQ(group.getNumberOfSamplesPerTrace(), 500);
+            auto trace = group.begin() + 5;
+            auto y = trace->getDataSpan();
+            ASSERT_EQ(y.size(), x.size());
+            for (size_t i = 0; i < y.size(); ++i)
+            {
+                EXPECT_NEAR(y[i], x[i], 1.e-7);
+            }
+        }
+    }
+    std::remove(fileName.c_str());
+}
+
+}
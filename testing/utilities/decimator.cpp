@@ -0,0 +1,150 @@
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+#include "sff/utilities/decimator.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities;
+
+/// Filters and downsamples with a direct convolution
+std::vector<double> reference(const std::vector<double> &taps,
+                              const std::vector<float> &x, const int factor)
+{
+    std::vector<double> y;
+    for (size_t n = 0; n < x.size(); n = n + factor)
+    {
+        double sum = 0;
+        for (size_t k = 0; k < taps.size() && k <= n; ++k)
+        {
+            sum = sum + taps[k]*x[n - k];
+        }
+        y.push_back(sum);
+    }
+    return y;
+}
+
+TEST(UtilitiesDecimator, Initialization)
+{
+    Decimator decimator;
+    EXPECT_FALSE(decimator.isInitialized());
+    EXPECT_THROW(decimator.initialize(0, 2), std::invalid_argument);
+    EXPECT_THROW(decimator.initialize(2, 0), std::invalid_argument);
+    EXPECT_THROW(decimator.initialize(2, 2, std::vector<double> {}),
+                 std::invalid_argument);
+    decimator.initialize(3, 5);
+    EXPECT_TRUE(decimator.isInitialized());
+    EXPECT_EQ(decimator.getNumberOfChannels(), 3);
+    EXPECT_EQ(decimator.getDecimationFactor(), 5);
+    auto taps = decimator.getFilterTaps();
+    ASSERT_EQ(taps.size(), 101);
+    EXPECT_NEAR(decimator.getGroupDelay(), 50, 1.e-14);
+    // Unit gain at DC and linear phase
+    double sum = 0;
+    for (size_t i = 0; i < taps.size(); ++i)
+    {
+        sum = sum + taps[i];
+        EXPECT_NEAR(taps[i], taps[taps.size() - 1 - i], 1.e-14);
+    }
+    EXPECT_NEAR(sum, 1, 1.e-12);
+    EXPECT_EQ(decimator.getNumberOfOutputSamples(0, 0), 0);
+    EXPECT_EQ(decimator.getNumberOfOutputSamples(0, 1), 1);
+    EXPECT_EQ(decimator.getNumberOfOutputSamples(0, 11), 3);
+    EXPECT_THROW(static_cast<void> (decimator.getNumberOfOutputSamples(3, 1)),
+                 std::invalid_argument);
+}
+
+TEST(UtilitiesDecimator, Blocks)
+{
+    // Many channels processed in uneven blocks must match a direct
+    // convolution of each whole channel
+    constexpr int nChannels = 37;
+    constexpr int nSamples = 2003;
+    constexpr int factor = 4;
+    std::mt19937 generator(8302);
+    std::normal_distribution<float> noise(0, 1);
+    std::vector<std::vector<float>> x(nChannels, std::vector<float> (nSamples));
+    for (auto &channel : x)
+    {
+        for (auto &sample : channel){sample = noise(generator);}
+    }
+    Decimator decimator(nChannels, factor);
+    auto taps = decimator.getFilterTaps();
+    std::vector<std::vector<float>> y(nChannels);
+    const std::vector<int> blockSizes{1, 3, 250, 17, 1000, 2, 730};
+    int i0 = 0;
+    for (const auto blockSize : blockSizes)
+    {
+        auto nOut = decimator.getNumberOfOutputSamples(0, blockSize);
+        std::vector<std::vector<float>> block(nChannels,
+                                              std::vector<float> (nOut));
+        // Process the channels in two groups
+        for (const auto &[c0, nBlock] : std::vector<std::pair<int, int>>
+                                        {{0, 30}, {30, 7}})
+        {
+            std::vector<const float *> xPointers;
+            std::vector<float *> yPointers;
+            for (int c = c0; c < c0 + nBlock; ++c)
+            {
+                xPointers.push_back(x[c].data() + i0);
+                yPointers.push_back(block[c].data());
+            }
+            decimator.process(c0, nBlock, blockSize,
+                              xPointers.data(), yPointers.data());
+        }
+        for (int c = 0; c < nChannels; ++c)
+        {
+            y[c].insert(y[c].end(), block[c].begin(), block[c].end());
+        }
+        i0 = i0 + blockSize;
+    }
+    ASSERT_EQ(i0, nSamples);
+    for (int c = 0; c < nChannels; ++c)
+    {
+        auto yRef = reference(taps, x[c], factor);
+        ASSERT_EQ(y[c].size(), yRef.size());
+        for (size_t j = 0; j < yRef.size(); ++j)
+        {
+            EXPECT_NEAR(y[c][j], yRef[j], 1.e-4);
+        }
+    }
+}
+
+TEST(UtilitiesDecimator, AntiAlias)
+{
+    // A tone in the pass band is retained while a tone that would alias is
+    // removed
+    constexpr int factor = 10;
+    constexpr int nSamples = 10000;
+    std::vector<float> passBand(nSamples);
+    std::vector<float> stopBand(nSamples);
+    for (int i = 0; i < nSamples; ++i)
+    {
+        passBand[i] = static_cast<float> (std::sin(2*std::numbers::pi*0.01*i));
+        stopBand[i] = static_cast<float> (std::sin(2*std::numbers::pi*0.09*i));
+    }
+    Decimator decimator(2, factor);
+    std::vector<float> y0(nSamples/factor);
+    std::vector<float> y1(nSamples/factor);
+    std::vector<const float *> x{passBand.data(), stopBand.data()};
+    std::vector<float *> y{y0.data(), y1.data()};
+    decimator.process(0, 2, nSamples, x.data(), y.data());
+    double powerPass = 0;
+    double maxStop = 0;
+    // Skip the filter's start up transient
+    for (size_t j = 50; j < y0.size(); ++j)
+    {
+        powerPass = powerPass + static_cast<double> (y0[j])*y0[j];
+        maxStop = std::max(maxStop, std::abs(static_cast<double> (y1[j])));
+    }
+    auto rmsPass = std::sqrt(powerPass/static_cast<double> (y0.size() - 50));
+    EXPECT_NEAR(rmsPass, 1/std::sqrt(2.0), 0.01);
+    EXPECT_LT(maxStop, 0.01);
+    // Reset starts a new signal
+    decimator.reset();
+    EXPECT_EQ(decimator.getPhase(0), 0);
+}
+
+}
@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include "sff/utilities/instrumentation.hpp"
+#include "sff/sac/waveform.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities::Instrumentation;
+
+TEST(UtilitiesInstrumentation, Snapshot)
+{
+    Snapshot snapshot;
+    EXPECT_EQ(snapshot.getCount(Counter::BYTES_READ), 0);
+    snapshot.setCount(Counter::BYTE_SWAPS, 12);
+    snapshot.setElapsedTime(Timer::DECODE, std::chrono::nanoseconds(500), 3);
+    Snapshot copy(snapshot);
+    EXPECT_EQ(copy.getCount(Counter::BYTE_SWAPS), 12);
+    EXPECT_EQ(copy.getElapsedTime(Timer::DECODE).count(), 500);
+    EXPECT_EQ(copy.getNumberOfCalls(Timer::DECODE), 3);
+    auto json = copy.toJSON();
+    EXPECT_NE(json.find("\"byte_swaps\": 12"), std::string::npos);
+    EXPECT_NE(json.find("\"decode\": {\"calls\": 3, \"nanoseconds\": 500}"),
+              std::string::npos);
+    EXPECT_EQ(toString(Counter::BYTES_READ), "bytes_read");
+    EXPECT_EQ(toString(Timer::HEADER), "header");
+}
+
+TEST(UtilitiesInstrumentation, Counters)
+{
+    reset();
+    SFF::SAC::Waveform waveform;
+    waveform.read("data/debug.sac");
+    auto snapshot = getSnapshot();
+    if (isEnabled())
+    {
+        EXPECT_EQ(snapshot.getCount(Counter::BYTES_READ), 632 + 4*100);
+        EXPECT_EQ(snapshot.getCount(Counter::RECORDS_DECODED), 1);
+        EXPECT_EQ(snapshot.getCount(Counter::ALLOCATIONS), 1);
+        EXPECT_EQ(snapshot.getNumberOfCalls(Timer::READ), 1);
+        EXPECT_EQ(snapshot.getNumberOfCalls(Timer::HEADER), 1);
+    }
+    else
+    {
+        EXPECT_EQ(snapshot.getCount(Counter::BYTES_READ), 0);
+        EXPECT_EQ(snapshot.getNumberOfCalls(Timer::READ), 0);
+    }
+    reset();
+    EXPECT_EQ(getSnapshot().getCount(Counter::BYTES_READ), 0);
+    const std::string fileName{"instrumentation.json"};
+    dumpJSON(fileName);
+    std::ifstream file(fileName);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    EXPECT_EQ(buffer.str(), getSnapshot().toJSON());
+    file.close();
+    std::remove(fileName.c_str());
+}
+
+}
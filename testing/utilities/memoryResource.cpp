@@ -0,0 +1,190 @@
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "sff/utilities/alignedBuffer.hpp"
+#include "sff/utilities/memoryResource.hpp"
+#include "sff/utilities/sharedBuffer.hpp"
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/segy/silixa/trace.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities;
+
+[[nodiscard]] bool isAligned(const void *p)
+{
+    return reinterpret_cast<uintptr_t> (p)%64 == 0;
+}
+
+TEST(UtilitiesMemoryResource, AlignedBuffer)
+{
+    AlignedBuffer<float> buffer(5);
+    EXPECT_EQ(buffer.size(), 5);
+    EXPECT_TRUE(isAligned(buffer.data()));
+    EXPECT_EQ(buffer.getMemoryResource(), std::pmr::get_default_resource());
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        EXPECT_EQ(buffer[i], 0);
+        buffer[i] = static_cast<float> (i + 1);
+    }
+    // Resizing keeps the leading samples
+    buffer.resize(7);
+    EXPECT_TRUE(isAligned(buffer.data()));
+    EXPECT_NEAR(buffer[4], 5, 1.e-7);
+    EXPECT_NEAR(buffer[6], 0, 1.e-7);
+    // Copies are deep
+    AlignedBuffer<float> copy(buffer);
+    EXPECT_NE(copy.data(), buffer.data());
+    EXPECT_EQ(copy.size(), buffer.size());
+    EXPECT_NEAR(copy[3], 4, 1.e-7);
+    // Moves steal
+    auto data = copy.data();
+    AlignedBuffer<float> moved(std::move(copy));
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(copy.empty());
+    // Changing the resource moves the samples
+    ArenaResource arena(4096);
+    moved.setMemoryResource(&arena);
+    EXPECT_EQ(moved.getMemoryResource(), &arena);
+    EXPECT_NE(moved.data(), data);
+    EXPECT_NEAR(moved[2], 3, 1.e-7);
+    EXPECT_EQ(arena.getBytesAllocated(), 7*sizeof(float));
+    moved.clear();
+    EXPECT_EQ(moved.getMemoryResource(), &arena);
+}
+
+TEST(UtilitiesMemoryResource, SharedBuffer)
+{
+    SharedBuffer<float> buffer(5);
+    EXPECT_EQ(buffer.size(), 5);
+    EXPECT_FALSE(buffer.isShared());
+    auto data = buffer.mutableData();
+    for (int i = 0; i < 5; ++i){data[i] = static_cast<float> (i);}
+    // Copies share the samples
+    auto copy = buffer;
+    EXPECT_TRUE(buffer.isShared());
+    EXPECT_EQ(copy.data(), buffer.data());
+    // Writing detaches the copy and leaves the original intact
+    copy.mutableData()[0] = 10;
+    EXPECT_FALSE(buffer.isShared());
+    EXPECT_FALSE(copy.isShared());
+    EXPECT_NE(copy.data(), buffer.data());
+    EXPECT_NEAR(buffer[0], 0, 1.e-14);
+    EXPECT_NEAR(copy[0], 10, 1.e-14);
+    EXPECT_NEAR(copy[4], 4, 1.e-14);
+    // Resizing a shared buffer keeps the samples of both
+    copy = buffer;
+    copy.resize(7);
+    EXPECT_EQ(buffer.size(), 5);
+    EXPECT_EQ(copy.size(), 7);
+    EXPECT_NEAR(copy[4], 4, 1.e-14);
+    EXPECT_NEAR(copy[6], 0, 1.e-14);
+    // Moving to another resource only affects this buffer
+    ArenaResource arena;
+    copy = buffer;
+    copy.setMemoryResource(&arena);
+    EXPECT_EQ(arena.getBytesAllocated(), 5*sizeof(float));
+    EXPECT_NE(copy.data(), buffer.data());
+    EXPECT_NEAR(copy[3], 3, 1.e-14);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.getMemoryResource(), &arena);
+    EXPECT_EQ(buffer.size(), 5);
+
+    // Traces share their samples until one is modified
+    SFF::SEGY::Silixa::Trace trace;
+    std::vector<float> x{1, 2, 3};
+    trace.setData(static_cast<int> (x.size()), x.data());
+    auto traceCopy = trace;
+    EXPECT_EQ(traceCopy.getDataPointer(), trace.getDataPointer());
+    std::vector<float> y{4, 5, 6, 7};
+    traceCopy.setData(static_cast<int> (y.size()), y.data());
+    EXPECT_EQ(trace.getNumberOfSamples(), 3);
+    EXPECT_NEAR(trace.getDataSpan()[2], 3, 1.e-14);
+    EXPECT_NEAR(traceCopy.getDataSpan()[3], 7, 1.e-14);
+}
+
+TEST(UtilitiesMemoryResource, ArenaResource)
+{
+    ArenaResource arena(1024);
+    std::vector<AlignedBuffer<double>> buffers;
+    for (int i = 1; i < 50; ++i)
+    {
+        buffers.emplace_back(static_cast<size_t> (i), &arena);
+        EXPECT_TRUE(isAligned(buffers.back().data()));
+    }
+    EXPECT_EQ(arena.getBytesAllocated(), 8*(49*50)/2);
+    buffers.clear();
+    arena.release();
+    EXPECT_EQ(arena.getBytesAllocated(), 0);
+}
+
+TEST(UtilitiesMemoryResource, PoolResource)
+{
+    PoolResource pool(1024*1024);
+    AlignedBuffer<int> buffer(1000, &pool);
+    EXPECT_TRUE(isAligned(buffer.data()));
+    auto data = buffer.data();
+    buffer.clear();
+    // The freed block is recycled
+    buffer.resize(1000);
+    EXPECT_EQ(buffer.data(), data);
+    // Large allocations go upstream
+    AlignedBuffer<int> big(1024*1024, &pool);
+    EXPECT_TRUE(isAligned(big.data()));
+    // Sizes that are not a multiple of the alignment, e.g., short traces
+    std::vector<AlignedBuffer<float>> buffers;
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        for (size_t n = 17; n < 32; ++n)
+        {
+            buffers.emplace_back(n, &pool);
+            EXPECT_TRUE(isAligned(buffers.back().data()));
+        }
+    }
+}
+
+TEST(UtilitiesMemoryResource, Readers)
+{
+    ArenaResource arena;
+    SFF::SAC::Waveform waveform;
+    waveform.setMemoryResource(&arena);
+    waveform.read("data/debug.sac");
+    EXPECT_EQ(waveform.getMemoryResource(), &arena);
+    EXPECT_EQ(arena.getBytesAllocated(), 100*sizeof(float));
+    EXPECT_NEAR(waveform.getDataSpan()[99], 100, 1.e-7);
+    // Copies share the resource
+    auto copy = waveform;
+    EXPECT_EQ(copy.getMemoryResource(), &arena);
+    // and the samples without allocating
+    EXPECT_EQ(copy.getDataPointer(), waveform.getDataPointer());
+    EXPECT_EQ(arena.getBytesAllocated(), 100*sizeof(float));
+    waveform.setMemoryResource(nullptr);
+    EXPECT_EQ(waveform.getMemoryResource(), std::pmr::get_default_resource());
+    EXPECT_NEAR(waveform.getDataSpan()[99], 100, 1.e-7);
+    EXPECT_NEAR(copy.getDataSpan()[99], 100, 1.e-7);
+
+    SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(8);
+    generator.setNumberOfSamples(200);
+    const std::string fileName{"arena.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    arena.release();
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(fileName, &arena);
+    EXPECT_EQ(arena.getBytesAllocated(), 8*200*sizeof(float));
+    for (const auto &trace : group)
+    {
+        EXPECT_EQ(trace.getMemoryResource(), &arena);
+    }
+    auto x = generator.generate(7);
+    auto trace = group.begin() + 7;
+    EXPECT_NEAR(trace->getDataSpan()[10], x[10], 1.e-7);
+    std::remove(fileName.c_str());
+}
+
+}
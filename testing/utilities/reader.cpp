@@ -0,0 +1,50 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include "sff/utilities/reader.hpp"
+#include "sff/abstractBaseClass/trace.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities;
+
+TEST(UtilitiesReader, DetectFormat)
+{
+    EXPECT_EQ(detectFormat("data/debug.sac"), SFF::Format::SAC);
+    EXPECT_EQ(detectFormat("data/WY.YWB.EHZ.01.mseed"), SFF::Format::MINISEED);
+    EXPECT_THROW(static_cast<void> (detectFormat("data/WY.YWB.EHZ.01.txt")),
+                 std::invalid_argument);
+    EXPECT_THROW(static_cast<void> (detectFormat("data/doesNotExist.sac")),
+                 std::invalid_argument);
+}
+
+TEST(UtilitiesReader, ReadTraces)
+{
+    auto trace = readTrace("data/debug.sac");
+    EXPECT_EQ(trace->getFormat(), SFF::Format::SAC);
+    EXPECT_EQ(trace->getNumberOfSamples(), 100);
+    std::vector<double> data(trace->getNumberOfSamples());
+    auto dataPtr = data.data();
+    trace->getData(data.size(), &dataPtr);
+    for (int i = 0; i < static_cast<int> (data.size()); ++i)
+    {
+        EXPECT_NEAR(data[i], i + 1, 1.e-7);
+    }
+    // Parallel reads preserve the file order
+    std::vector<std::string> fileNames(5, "data/debug.sac");
+    auto traces = readTraces(fileNames, 3);
+    EXPECT_EQ(traces.size(), fileNames.size());
+    for (const auto &t : traces)
+    {
+        EXPECT_EQ(t->getFormat(), SFF::Format::SAC);
+        EXPECT_EQ(t->getNumberOfSamples(), 100);
+    }
+    fileNames.push_back("data/WY.YWB.EHZ.01.txt");
+    EXPECT_THROW(static_cast<void> (readTraces(fileNames, 2)),
+                 std::invalid_argument);
+}
+
+}
@@ -0,0 +1,170 @@
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/reader.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include "sff/hypoinverse2000/eventSummaryLine.hpp"
+#include "sff/hypoinverse2000/stationArchiveLine.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities;
+
+[[nodiscard]] std::vector<char> readBytes(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    return std::vector<char> (std::istreambuf_iterator<char> (file),
+                              std::istreambuf_iterator<char> ());
+}
+
+TEST(UtilitiesSyntheticDataGenerator, Generate)
+{
+    SyntheticDataGenerator generator;
+    generator.setSeed(4408);
+    generator.setNumberOfChannels(3);
+    generator.setNumberOfSamples(5000);
+    EXPECT_EQ(generator.getSeed(), 4408);
+    EXPECT_EQ(generator.getNumberOfChannels(), 3);
+    EXPECT_EQ(generator.getNumberOfSamples(), 5000);
+    EXPECT_NEAR(generator.getSamplingRate(), 100, 1.e-14);
+    auto x0 = generator.generate(0);
+    auto x1 = generator.generate(1);
+    EXPECT_EQ(x0.size(), 5000);
+    EXPECT_NE(x0, x1);
+    // Same seed gives the same data
+    SyntheticDataGenerator copy(generator);
+    EXPECT_EQ(copy.generate(0), x0);
+    copy.setSeed(4409);
+    EXPECT_NE(copy.generate(0), x0);
+    EXPECT_THROW(static_cast<void> (generator.generate(3)), std::invalid_argument);
+}
+
+TEST(UtilitiesSyntheticDataGenerator, SAC)
+{
+    SyntheticDataGenerator generator;
+    generator.setSeed(20);
+    generator.setNumberOfChannels(2);
+    generator.setNumberOfSamples(250);
+    generator.setSamplingRate(40);
+    generator.setGapPattern(100, 20);
+    auto fileNames = generator.writeSAC("syntheticSAC");
+    ASSERT_EQ(fileNames.size(), 6);
+    EXPECT_EQ(fileNames[0], "syntheticSAC/XX.S0001.HHZ.00.0.sac");
+    auto x = generator.generate(1);
+    SFF::SAC::Waveform waveform;
+    waveform.read(fileNames[5]);
+    EXPECT_EQ(waveform.getNumberOfSamples(), 50);
+    EXPECT_NEAR(waveform.getSamplingRate(), 40, 1.e-5);
+    auto startTime = generator.getStartTime().getEpoch() + (200 + 2*20)/40.0;
+    EXPECT_NEAR(waveform.getStartTime().getEpoch(), startTime, 1.e-3);
+    auto data = waveform.getDataSpan();
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_NEAR(data[i], x[200 + i], 1.e-7);
+    }
+    EXPECT_EQ(detectFormat(fileNames[0]), SFF::Format::SAC);
+    std::filesystem::remove_all("syntheticSAC");
+}
+
+TEST(UtilitiesSyntheticDataGenerator, SilixaSEGY)
+{
+    SyntheticDataGenerator generator;
+    generator.setSeed(7);
+    generator.setNumberOfChannels(4);
+    generator.setNumberOfSamples(300);
+    generator.setSamplingRate(2000);
+    const std::string fileName{"synthetic.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    EXPECT_EQ(detectFormat(fileName), SFF::Format::SILIXA_SEGY);
+    SFF::SEGY::Silixa::TraceGroup group;
+    group.read(fileName);
+    ASSERT_EQ(group.getNumberOfTraces(), 4);
+    ASSERT_EQ(group.getNumberOfSamplesPerTrace(), 300);
+    std::vector<float> data(4*300);
+    auto dataPtr = data.data();
+    group.getData(4, 300, &dataPtr);
+    for (int channel = 0; channel < 4; ++channel)
+    {
+        auto x = generator.generate(channel);
+        for (int i = 0; i < 300; ++i)
+        {
+            EXPECT_NEAR(data[channel*300 + i], x[i], 1.e-7);
+        }
+    }
+    // Deterministic
+    auto bytes = readBytes(fileName);
+    generator.writeSilixaSEGY(fileName);
+    EXPECT_EQ(readBytes(fileName), bytes);
+    std::remove(fileName.c_str());
+}
+
+TEST(UtilitiesSyntheticDataGenerator, MiniSEED)
+{
+    SyntheticDataGenerator generator;
+    generator.setSeed(11);
+    generator.setNumberOfChannels(2);
+    generator.setNumberOfSamples(10000);
+    generator.setGapPattern(3000, 100);
+    EXPECT_THROW(generator.writeMiniSEED("synthetic.mseed", 1000),
+                 std::invalid_argument);
+    const std::string fileName{"synthetic.mseed"};
+    generator.writeMiniSEED(fileName, 512);
+    EXPECT_EQ(detectFormat(fileName), SFF::Format::MINISEED);
+    auto bytes = readBytes(fileName);
+    ASSERT_EQ(bytes.size()%512, 0);
+    // Every record has a blockette 1000 with Steim2 encoding
+    for (size_t i = 0; i < bytes.size(); i = i + 512)
+    {
+        EXPECT_EQ(bytes[i + 6], 'D');
+        EXPECT_EQ(bytes[i + 52], 11);
+        EXPECT_EQ(bytes[i + 54], 9);
+    }
+    generator.writeMiniSEED(fileName, 512);
+    EXPECT_EQ(readBytes(fileName), bytes);
+    std::remove(fileName.c_str());
+}
+
+TEST(UtilitiesSyntheticDataGenerator, HypoInverse2000)
+{
+    SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(12);
+    const std::string fileName{"synthetic.arc"};
+    generator.writeHypoInverse2000Archive(fileName, 3, 5);
+    EXPECT_THROW(generator.writeHypoInverse2000Archive(fileName, 3, 13),
+                 std::invalid_argument);
+    std::ifstream file(fileName);
+    std::string line;
+    int nEvents = 0;
+    int nPicks = 0;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == ' ' || line[0] == '$'){continue;}
+        // Event summary lines begin with the origin year
+        if (std::isdigit(line[0]))
+        {
+            SFF::HypoInverse2000::EventSummaryLine origin;
+            EXPECT_NO_THROW(origin.unpackString(line));
+            nEvents = nEvents + 1;
+        }
+        else
+        {
+            SFF::HypoInverse2000::StationArchiveLine pick;
+            EXPECT_NO_THROW(pick.unpackString(line));
+            EXPECT_EQ(pick.getNetworkName(), "XX");
+            nPicks = nPicks + 1;
+        }
+    }
+    EXPECT_EQ(nEvents, 3);
+    EXPECT_EQ(nPicks, 15);
+    std::remove(fileName.c_str());
+}
+
+}
@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include "sff/utilities/traceCache.hpp"
+#include "sff/utilities/syntheticDataGenerator.hpp"
+#include "sff/utilities/time.hpp"
+#include "sff/sac/waveform.hpp"
+#include "sff/segy/silixa/traceGroup.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+using namespace SFF::Utilities;
+
+TEST(UtilitiesTraceCache, SAC)
+{
+    EXPECT_THROW(TraceCache bad(0), std::invalid_argument);
+    SFF::SAC::Waveform reference;
+    reference.read("data/debug.sac");
+    TraceCache cache;
+    auto waveform = cache.getWaveform("data/debug.sac");
+    EXPECT_EQ(cache.getNumberOfMisses(), 1);
+    EXPECT_EQ(cache.getNumberOfHits(), 0);
+    EXPECT_EQ(cache.getNumberOfEntries(), 1);
+    EXPECT_EQ(cache.getSize(), 632 + 100*sizeof(float));
+    // Exact hits share the object
+    auto again = cache.getWaveform("data/debug.sac");
+    EXPECT_EQ(again.get(), waveform.get());
+    EXPECT_EQ(cache.getNumberOfHits(), 1);
+    // Sub-windows are cut from the cached superset and match the reader
+    auto dt = reference.getSamplingPeriod();
+    auto t0 = reference.getStartTime();
+    Time t1(t0.getEpoch() + 10*dt);
+    Time t2(t0.getEpoch() + 20*dt);
+    auto window = cache.getWaveform("data/debug.sac", t1, t2);
+    EXPECT_EQ(cache.getNumberOfHits(), 2);
+    EXPECT_EQ(cache.getNumberOfMisses(), 1);
+    SFF::SAC::Waveform windowReference;
+    windowReference.read("data/debug.sac", t1, t2);
+    ASSERT_EQ(window->getNumberOfSamples(),
+              windowReference.getNumberOfSamples());
+    EXPECT_NEAR(window->getStartTime().getEpoch(),
+                windowReference.getStartTime().getEpoch(), 1.e-6);
+    for (int i = 0; i < window->getNumberOfSamples(); ++i)
+    {
+        EXPECT_NEAR(window->getDataSpan()[i],
+                    windowReference.getDataSpan()[i], 1.e-7);
+    }
+    EXPECT_THROW(static_cast<void> (cache.getWaveform("data/debug.sac", t2, t1)),
+                 std::invalid_argument);
+    EXPECT_THROW(static_cast<void> (cache.getWaveform("data/doesNotExist.sac")),
+                 std::invalid_argument);
+    cache.resetStatistics();
+    EXPECT_EQ(cache.getNumberOfHits(), 0);
+    cache.clear();
+    EXPECT_EQ(cache.getNumberOfEntries(), 0);
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST(UtilitiesTraceCache, WindowedMiss)
+{
+    SFF::SAC::Waveform reference;
+    reference.read("data/debug.sac");
+    auto dt = reference.getSamplingPeriod();
+    auto t0 = reference.getStartTime().getEpoch();
+    TraceCache cache;
+    // A windowed read caches only that window
+    auto narrow = cache.getWaveform("data/debug.sac",
+                                    Time(t0 + 10*dt), Time(t0 + 50*dt));
+    EXPECT_EQ(narrow->getNumberOfSamples(), 41);
+    auto inner = cache.getWaveform("data/debug.sac",
+                                   Time(t0 + 20*dt), Time(t0 + 30*dt));
+    EXPECT_EQ(cache.getNumberOfHits(), 1);
+    EXPECT_EQ(inner->getNumberOfSamples(), 11);
+    EXPECT_NEAR(inner->getDataSpan()[0], reference.getDataSpan()[20], 1.e-7);
+    // This is not contained so it is a miss
+    auto full = cache.getWaveform("data/debug.sac");
+    EXPECT_EQ(cache.getNumberOfMisses(), 2);
+    EXPECT_EQ(full->getNumberOfSamples(), 100);
+}
+
+TEST(UtilitiesTraceCache, EvictionAndInvalidation)
+{
+    namespace fs = std::filesystem;
+    std::vector<std::string> fileNames{"cache0.sac", "cache1.sac", "cache2.sac"};
+    for (const auto &fileName : fileNames)
+    {
+        fs::copy_file("data/debug.sac", fileName,
+                      fs::copy_options::overwrite_existing);
+    }
+    // Room for two waveforms
+    TraceCache cache(2*(632 + 100*sizeof(float)));
+    auto w0 = cache.getWaveform(fileNames[0]);
+    auto w1 = cache.getWaveform(fileNames[1]);
+    auto h0 = cache.getWaveform(fileNames[0]); // 0 is now most recent
+    auto w2 = cache.getWaveform(fileNames[2]); // Evicts 1
+    EXPECT_EQ(cache.getNumberOfEvictions(), 1);
+    EXPECT_EQ(cache.getNumberOfEntries(), 2);
+    // Evicted objects remain valid for their holders
+    EXPECT_EQ(w1->getNumberOfSamples(), 100);
+    cache.resetStatistics();
+    auto again0 = cache.getWaveform(fileNames[0]);
+    auto again1 = cache.getWaveform(fileNames[1]);
+    EXPECT_EQ(cache.getNumberOfHits(), 1);
+    EXPECT_EQ(cache.getNumberOfMisses(), 1);
+    // Rewriting the file invalidates the entry
+    auto modified = fs::last_write_time(fileNames[1]);
+    fs::last_write_time(fileNames[1], modified + std::chrono::seconds(10));
+    cache.resetStatistics();
+    auto reread = cache.getWaveform(fileNames[1]);
+    EXPECT_EQ(cache.getNumberOfMisses(), 1);
+    EXPECT_NE(reread.get(), again1.get());
+    // Entries larger than the capacity are returned but not retained
+    TraceCache tiny(16);
+    auto big = tiny.getWaveform(fileNames[0]);
+    EXPECT_EQ(big->getNumberOfSamples(), 100);
+    EXPECT_EQ(tiny.getNumberOfEntries(), 0);
+    for (const auto &fileName : fileNames){std::remove(fileName.c_str());}
+}
+
+TEST(UtilitiesTraceCache, SilixaThreaded)
+{
+    SyntheticDataGenerator generator;
+    generator.setNumberOfChannels(8);
+    generator.setNumberOfSamples(300);
+    const std::string fileName{"traceCache.sgy"};
+    generator.writeSilixaSEGY(fileName);
+    TraceCache cache;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&cache, &fileName]()
+        {
+            for (int j = 0; j < 20; ++j)
+            {
+                auto group = cache.getTraceGroup(fileName);
+                EXPECT_EQ(group->getNumberOfTraces(), 8);
+            }
+        });
+    }
+    for (auto &thread : threads){thread.join();}
+    EXPECT_EQ(cache.getNumberOfHits() + cache.getNumberOfMisses(), 160);
+    EXPECT_GE(cache.getNumberOfHits(), 152);
+    EXPECT_EQ(cache.getNumberOfEntries(), 1);
+    auto group = cache.getTraceGroup(fileName);
+    auto x = generator.generate(3);
+    auto trace = group->begin() + 3;
+    EXPECT_NEAR(trace->getDataSpan()[17], x[17], 1.e-7);
+    std::remove(fileName.c_str());
+}
+
+}